@@ -0,0 +1,755 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "Sorting.h"
+#include "../allocators/AllocatorStorage.h"
+#include "../allocators/CppAllocator.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Sorting of more values than can be held in memory, only a fixed memory budget is used whatever the amount of values.
+// - The values are accumulated into the budget, a full budget is sorted in place and spilled to disk as a run
+// - The runs are merged with a loser tree, every run is read in blocks that are double buffered on an IO thread
+// - When there are more runs than the budget has blocks for, the runs are first merged into larger runs
+MIST_NAMESPACE
+
+struct ExternalSortSettings {
+	// The memory used for the values, this is the size of the runs spilled to disk and of all the blocks of the merge
+	size_t m_MemoryBudget = 256 * 1024 * 1024;
+	// The size of the reads and writes of the merge, every merged run holds two blocks.
+	// Large blocks keep the reads sequential, small blocks merge more runs at once.
+	size_t m_BlockSize = 4 * 1024 * 1024;
+	// The directory of the run files, the runs use the anonymous temporary files of the system if it's empty
+	std::string m_TemporaryDirectory;
+};
+
+// -Orderings-
+
+// Sorts the runs with the QuickSort and merges them with the comparison
+template< typename CompareType = std::less<> >
+struct CompareOrdering {
+
+	// The run sort doesn't need a scratch buffer, the whole memory budget is used for the run
+	static constexpr bool REQUIRES_SCRATCH = false;
+
+	template< typename ValueType >
+	bool operator()(const ValueType& left, const ValueType& right) const { return m_Compare(left, right); }
+
+	template< typename ValueType >
+	void SortRun(ValueType* begin, ValueType* end, ValueType*) const { QuickSort(begin, end, m_Compare); }
+
+	CompareType m_Compare = CompareType();
+};
+
+// Sorts the runs with the RadixSort by the key of the values and merges them by comparing the keys
+// @Detail: The radix sort needs a scratch buffer as large as the run, the runs are half the memory budget.
+//  The keys are compared through the same conversion as the radix sort, the order of the floats is the same.
+template< typename KeyExtractorType = Detail::IdentityKey >
+struct RadixKeyOrdering {
+
+	static constexpr bool REQUIRES_SCRATCH = true;
+
+	template< typename ValueType >
+	bool operator()(const ValueType& left, const ValueType& right) const {
+
+		using KeyType = typename std::decay<decltype(m_KeyExtractor(left))>::type;
+		return Detail::RadixKeyTraits<KeyType>::ToUnsigned(m_KeyExtractor(left)) < Detail::RadixKeyTraits<KeyType>::ToUnsigned(m_KeyExtractor(right));
+	}
+
+	template< typename ValueType >
+	void SortRun(ValueType* begin, ValueType* end, ValueType* scratch) const { RadixSort(begin, end, scratch, m_KeyExtractor); }
+
+	KeyExtractorType m_KeyExtractor = KeyExtractorType();
+};
+
+// -Implementation Details-
+
+namespace Detail {
+
+	// A sorted run spilled to disk
+	struct ExternalRun {
+		FILE* m_File;
+		// Empty for the anonymous temporary files, they are deleted when closed
+		std::string m_Path;
+		size_t m_Count;
+	};
+
+	inline void CloseRun(ExternalRun* run) {
+
+		fclose(run->m_File);
+		if (run->m_Path.empty() == false) {
+			remove(run->m_Path.c_str());
+		}
+	}
+
+	// One of the two blocks of a run being merged
+	template< typename ValueType >
+	struct ExternalReadBlock {
+		ValueType* m_Values;
+		size_t m_Count;
+		bool m_IsRequested;
+		// Set by the IO thread once the values are read
+		std::atomic<bool> m_IsReady;
+	};
+
+	// Reads the blocks of the runs on a dedicated thread. The merge asks for the next block of a run as soon as it
+	// starts consuming the other block, the disk works while the merge compares the values.
+	// @Detail: This is a thread and not a job, a job blocked on the disk would take a worker away from the JobScheduler.
+	//  The requests are served in order, the blocks of a run are read sequentially.
+	template< typename ValueType >
+	class ExternalBlockReader {
+
+	public:
+
+		// -Public API-
+
+		// Read the count next values of the file into the block
+		void Request(FILE* file, ExternalReadBlock<ValueType>* block, size_t count);
+
+		// Wait until the requested block is read
+		void WaitFor(ExternalReadBlock<ValueType>* block);
+
+		// A read returned less values than requested
+		bool HasFailed() const { return m_HasFailed.load(std::memory_order_acquire); }
+
+		// -Structors-
+
+		ExternalBlockReader();
+		~ExternalBlockReader();
+
+		ExternalBlockReader(const ExternalBlockReader&) = delete;
+		ExternalBlockReader& operator=(const ExternalBlockReader&) = delete;
+
+	private:
+
+		struct ReadRequest {
+			FILE* m_File;
+			ExternalReadBlock<ValueType>* m_Block;
+			size_t m_Count;
+		};
+
+		void ReaderMain();
+
+		std::mutex m_Mutex;
+		std::condition_variable m_RequestCondition;
+		std::condition_variable m_ReadyCondition;
+		std::vector<ReadRequest> m_Requests;
+		size_t m_NextRequest = 0;
+		bool m_IsRunning = true;
+		std::atomic<bool> m_HasFailed{ false };
+		// Started last, every other member is constructed before the thread uses them
+		std::thread m_Thread;
+	};
+
+	// A run being merged, the merge consumes the active block while the other block is being read
+	template< typename ValueType >
+	struct ExternalMergeSource {
+		FILE* m_File;
+		// The values of the run that weren't requested yet
+		size_t m_Unrequested;
+		ExternalReadBlock<ValueType> m_Blocks[2];
+		size_t m_ActiveBlock;
+		// The current value of the run, null once the run is exhausted
+		const ValueType* m_Current;
+		const ValueType* m_End;
+	};
+
+	// A tournament tree of the losers of the merged runs, the next value of the winning run only plays
+	// against the log2(k) losers on it's path to the root instead of the k - 1 other runs.
+	// @Detail: The runs are the leaves k to 2k - 1 of an implicit binary tree, every internal node keeps the loser
+	//  of the match played there. Exhausted runs lose against everything, ties are won by the first run.
+	template< typename ValueType, typename OrderingType >
+	class ExternalLoserTree {
+
+	public:
+
+		// -Public API-
+
+		void Initialize(ExternalMergeSource<ValueType>* sources, size_t sourceCount, const OrderingType* ordering);
+
+		// The run holding the smallest current value
+		size_t Winner() const { return m_Winner; }
+
+		// Replay the matches of the winner after it's run moved to the next value
+		void Replay();
+
+	private:
+
+		bool Beats(size_t left, size_t right) const;
+
+		// Play every match of the subtree, returns the winner of the subtree
+		size_t Build(size_t node);
+
+		ExternalMergeSource<ValueType>* m_Sources = nullptr;
+		size_t m_SourceCount = 0;
+		const OrderingType* m_Ordering = nullptr;
+		std::vector<size_t> m_Losers;
+		size_t m_Winner = 0;
+	};
+}
+
+// -External Sorter-
+
+// Sorts any amount of values inside a fixed memory budget, the values overflowing the budget are sorted in runs
+// that are spilled to the temporary directory and merged back once every value was pushed.
+// The values must be trivially copyable, they are written to disk and read back bitwise.
+// @Detail: The runs are sorted in place (QuickSort or RadixSort depending on the ordering) and written with a single
+//  write of the whole run. The merge splits the budget into blocks, two per merged run and one for the output,
+//  a budget with too few blocks for every run merges the runs in multiple passes.
+//  When every value fits in the budget nothing is written to disk. Equal values of different runs are merged in the
+//  order they were pushed, the sort is stable when the run sort is (Such as with the RadixKeyOrdering).
+// @Example: Sorting the records of a build step would look like:
+//
+//		ExternalSortSettings settings;
+//		settings.m_MemoryBudget = 1024 * 1024 * 1024;
+//		settings.m_TemporaryDirectory = "D:/Scratch";
+//		ExternalSorter<AssetRecord, RadixKeyOrdering<AssetKey>> sorter(settings);
+//		while (ReadRecords(&records)) {
+//			sorter.Push(records.data(), records.size());
+//		}
+//		sorter.Finish([&](const AssetRecord* sorted, size_t count) { WriteRecords(sorted, count); });
+template< typename ValueType, typename OrderingType = CompareOrdering<>, typename Allocator = CppAllocator >
+class ExternalSorter : private Detail::AllocatorStorage<Allocator> {
+	static_assert(std::is_trivially_copyable<ValueType>::value, "The values of an external sort are written to disk bitwise.");
+
+public:
+
+	// -Public API-
+
+	// Add values to the sort, a full memory budget is sorted and spilled to disk as a run.
+	// Returns false if a run couldn't be written, the sort has failed and the values are dropped.
+	bool Push(const ValueType* values, size_t count);
+	bool Push(const ValueType& value);
+
+	// Merge the values and hand them in order to the output as consecutive blocks, output(const ValueType* values, size_t count).
+	// Returns false if a run couldn't be written or read back, the output might have received part of the values.
+	// The sorter is empty after the call and can sort again.
+	template< typename OutputType >
+	bool Finish(OutputType&& output);
+
+	// The amount of values pushed since the last finish
+	size_t Size() const;
+	// The amount of runs spilled to disk since the last finish
+	size_t RunCount() const;
+
+	// -Structors-
+
+	explicit ExternalSorter(const ExternalSortSettings& settings = ExternalSortSettings(), OrderingType ordering = OrderingType(), const Allocator& allocator = Allocator());
+	~ExternalSorter();
+
+	ExternalSorter(const ExternalSorter&) = delete;
+	ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+private:
+
+	using Detail::AllocatorStorage<Allocator>::GetAllocator;
+
+	// Sort the values held in memory and write them to a new run
+	bool SpillRun();
+
+	bool CreateRunFile(Detail::ExternalRun* run);
+
+	// Merge the runs in the budget, the output receives the merged values in blocks
+	template< typename OutputType >
+	bool MergeRuns(Detail::ExternalRun* runs, size_t runCount, OutputType& output);
+
+	// Close the runs and free the budget
+	void Reset();
+
+	ExternalSortSettings m_Settings;
+	OrderingType m_Ordering;
+
+	// The whole memory budget, allocated on the first push
+	ValueType* m_Memory = nullptr;
+	// The size of the budget in values and how many of them one run holds
+	size_t m_MemoryCapacity;
+	size_t m_RunCapacity;
+
+	// The values held in memory and the total pushed
+	size_t m_ValueCount = 0;
+	size_t m_TotalCount = 0;
+
+	std::vector<Detail::ExternalRun> m_Runs;
+	// Names the run files of the sorter
+	size_t m_RunId = 0;
+	bool m_HasFailed = false;
+};
+
+// Sort a file of values into another file, only the memory budget (And one block to read the input) is held in memory.
+// The input and output must be different files, returns false if a file couldn't be read or written.
+template< typename ValueType, typename OrderingType = CompareOrdering<> >
+bool ExternalSortFile(const char* inputPath, const char* outputPath, const ExternalSortSettings& settings = ExternalSortSettings(), OrderingType ordering = OrderingType());
+
+
+// -Implementation-
+
+namespace Detail {
+
+	template< typename ValueType >
+	ExternalBlockReader<ValueType>::ExternalBlockReader() {
+
+		m_Thread = std::thread(&ExternalBlockReader::ReaderMain, this);
+	}
+
+	template< typename ValueType >
+	ExternalBlockReader<ValueType>::~ExternalBlockReader() {
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_IsRunning = false;
+		}
+		m_RequestCondition.notify_one();
+		m_Thread.join();
+	}
+
+	template< typename ValueType >
+	void ExternalBlockReader<ValueType>::Request(FILE* file, ExternalReadBlock<ValueType>* block, size_t count) {
+
+		block->m_IsRequested = true;
+		block->m_IsReady.store(false, std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Requests.push_back({ file, block, count });
+		}
+		m_RequestCondition.notify_one();
+	}
+
+	template< typename ValueType >
+	void ExternalBlockReader<ValueType>::WaitFor(ExternalReadBlock<ValueType>* block) {
+
+		MIST_ASSERT(block->m_IsRequested);
+		if (block->m_IsReady.load(std::memory_order_acquire) == false) {
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_ReadyCondition.wait(lock, [block]() { return block->m_IsReady.load(std::memory_order_acquire); });
+		}
+		block->m_IsRequested = false;
+	}
+
+	template< typename ValueType >
+	void ExternalBlockReader<ValueType>::ReaderMain() {
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		while (true) {
+			m_RequestCondition.wait(lock, [this]() { return m_NextRequest < m_Requests.size() || m_IsRunning == false; });
+			if (m_IsRunning == false) {
+				return;
+			}
+
+			ReadRequest request = m_Requests[m_NextRequest++];
+			if (m_NextRequest == m_Requests.size()) {
+				m_Requests.clear();
+				m_NextRequest = 0;
+			}
+
+			lock.unlock();
+			size_t readCount = fread(request.m_Block->m_Values, sizeof(ValueType), request.m_Count, request.m_File);
+			if (readCount != request.m_Count) {
+				m_HasFailed.store(true, std::memory_order_release);
+			}
+			request.m_Block->m_Count = readCount;
+			lock.lock();
+
+			// The flag is set under the lock, the merge can't miss the notification between it's check and it's wait
+			request.m_Block->m_IsReady.store(true, std::memory_order_release);
+			m_ReadyCondition.notify_all();
+		}
+	}
+
+	template< typename ValueType, typename OrderingType >
+	void ExternalLoserTree<ValueType, OrderingType>::Initialize(ExternalMergeSource<ValueType>* sources, size_t sourceCount, const OrderingType* ordering) {
+
+		MIST_ASSERT(sourceCount > 0);
+		m_Sources = sources;
+		m_SourceCount = sourceCount;
+		m_Ordering = ordering;
+		m_Losers.assign(sourceCount, 0);
+		m_Winner = Build(1);
+	}
+
+	template< typename ValueType, typename OrderingType >
+	void ExternalLoserTree<ValueType, OrderingType>::Replay() {
+
+		size_t winner = m_Winner;
+		for (size_t node = (winner + m_SourceCount) / 2; node > 0; node /= 2) {
+			if (Beats(m_Losers[node], winner)) {
+				std::swap(m_Losers[node], winner);
+			}
+		}
+		m_Winner = winner;
+	}
+
+	template< typename ValueType, typename OrderingType >
+	bool ExternalLoserTree<ValueType, OrderingType>::Beats(size_t left, size_t right) const {
+
+		const ValueType* leftValue = m_Sources[left].m_Current;
+		const ValueType* rightValue = m_Sources[right].m_Current;
+		if (leftValue == nullptr || rightValue == nullptr) {
+			return rightValue == nullptr && (leftValue != nullptr || left < right);
+		}
+
+		if ((*m_Ordering)(*leftValue, *rightValue)) {
+			return true;
+		}
+		return (*m_Ordering)(*rightValue, *leftValue) == false && left < right;
+	}
+
+	template< typename ValueType, typename OrderingType >
+	size_t ExternalLoserTree<ValueType, OrderingType>::Build(size_t node) {
+
+		if (node >= m_SourceCount) {
+			return node - m_SourceCount;
+		}
+
+		size_t left = Build(node * 2);
+		size_t right = Build(node * 2 + 1);
+		if (Beats(left, right)) {
+			m_Losers[node] = right;
+			return left;
+		}
+		m_Losers[node] = left;
+		return right;
+	}
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+ExternalSorter<ValueType, OrderingType, Allocator>::ExternalSorter(const ExternalSortSettings& settings, OrderingType ordering, const Allocator& allocator)
+	: Detail::AllocatorStorage<Allocator>(allocator)
+	, m_Settings(settings)
+	, m_Ordering(ordering) {
+
+	// The merge needs at least two runs with two blocks each and the output block
+	m_MemoryCapacity = m_Settings.m_MemoryBudget / sizeof(ValueType);
+	MIST_ASSERT(m_MemoryCapacity >= 5);
+	m_RunCapacity = OrderingType::REQUIRES_SCRATCH ? m_MemoryCapacity / 2 : m_MemoryCapacity;
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+ExternalSorter<ValueType, OrderingType, Allocator>::~ExternalSorter() {
+
+	Reset();
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+bool ExternalSorter<ValueType, OrderingType, Allocator>::Push(const ValueType* values, size_t count) {
+
+	if (m_HasFailed) {
+		return false;
+	}
+
+	if (m_Memory == nullptr && count > 0) {
+		m_Memory = reinterpret_cast<ValueType*>(Detail::AllocateAligned(GetAllocator(), m_MemoryCapacity * sizeof(ValueType), CACHE_LINE_ALIGNMENT));
+	}
+
+	m_TotalCount += count;
+	while (count > 0) {
+		size_t copyCount = m_RunCapacity - m_ValueCount;
+		copyCount = copyCount < count ? copyCount : count;
+		memcpy(m_Memory + m_ValueCount, values, copyCount * sizeof(ValueType));
+		m_ValueCount += copyCount;
+		values += copyCount;
+		count -= copyCount;
+
+		if (m_ValueCount == m_RunCapacity && SpillRun() == false) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+bool ExternalSorter<ValueType, OrderingType, Allocator>::Push(const ValueType& value) {
+
+	return Push(&value, 1);
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+template< typename OutputType >
+bool ExternalSorter<ValueType, OrderingType, Allocator>::Finish(OutputType&& output) {
+
+	bool isSuccessful = m_HasFailed == false;
+
+	// Everything fits in memory, there's no need to touch the disk
+	if (isSuccessful && m_Runs.empty()) {
+		if (m_ValueCount > 0) {
+			m_Ordering.SortRun(m_Memory, m_Memory + m_ValueCount, m_Memory + m_RunCapacity);
+			output(static_cast<const ValueType*>(m_Memory), m_ValueCount);
+		}
+		Reset();
+		return true;
+	}
+
+	if (isSuccessful && m_ValueCount > 0) {
+		isSuccessful = SpillRun();
+	}
+
+	// Every merged run holds two blocks and the output holds one, the blocks shrink if the budget can't merge two runs
+	size_t blockCapacity = m_Settings.m_BlockSize / sizeof(ValueType);
+	blockCapacity = blockCapacity > 0 ? blockCapacity : 1;
+	if (m_MemoryCapacity / blockCapacity < 5) {
+		blockCapacity = m_MemoryCapacity / 5;
+	}
+	size_t maxMergeCount = (m_MemoryCapacity / blockCapacity - 1) / 2;
+
+	// Merge consecutive groups of runs into larger runs until a single pass can merge all of them,
+	// every pass reads each value once and the merged runs stay in the order of the values
+	while (isSuccessful && m_Runs.size() > maxMergeCount) {
+		std::vector<Detail::ExternalRun> mergedRuns;
+		mergedRuns.reserve((m_Runs.size() + maxMergeCount - 1) / maxMergeCount);
+
+		size_t groupBegin = 0;
+		for (; isSuccessful && groupBegin < m_Runs.size(); groupBegin += maxMergeCount) {
+			size_t groupCount = m_Runs.size() - groupBegin;
+			groupCount = groupCount < maxMergeCount ? groupCount : maxMergeCount;
+
+			// A lone run at the end is already sorted, it moves to the next pass untouched
+			if (groupCount == 1) {
+				mergedRuns.push_back(m_Runs[groupBegin]);
+				continue;
+			}
+
+			Detail::ExternalRun mergedRun;
+			if (CreateRunFile(&mergedRun) == false) {
+				isSuccessful = false;
+				break;
+			}
+
+			FILE* mergedFile = mergedRun.m_File;
+			bool isWritten = true;
+			auto writeRun = [mergedFile, &isWritten](const ValueType* values, size_t count) {
+				isWritten = isWritten && fwrite(values, sizeof(ValueType), count, mergedFile) == count;
+			};
+
+			isSuccessful = MergeRuns(m_Runs.data() + groupBegin, groupCount, writeRun) && isWritten && fseek(mergedFile, 0, SEEK_SET) == 0;
+			mergedRun.m_Count = 0;
+			for (size_t i = groupBegin; i < groupBegin + groupCount; i++) {
+				mergedRun.m_Count += m_Runs[i].m_Count;
+				Detail::CloseRun(&m_Runs[i]);
+			}
+			mergedRuns.push_back(mergedRun);
+		}
+
+		// The runs that weren't merged after a failure are kept so that Reset closes them
+		mergedRuns.insert(mergedRuns.end(), m_Runs.begin() + (groupBegin < m_Runs.size() ? groupBegin : m_Runs.size()), m_Runs.end());
+		m_Runs = std::move(mergedRuns);
+	}
+
+	if (isSuccessful) {
+		isSuccessful = MergeRuns(m_Runs.data(), m_Runs.size(), output);
+	}
+
+	Reset();
+	return isSuccessful;
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+size_t ExternalSorter<ValueType, OrderingType, Allocator>::Size() const {
+
+	return m_TotalCount;
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+size_t ExternalSorter<ValueType, OrderingType, Allocator>::RunCount() const {
+
+	return m_Runs.size();
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+bool ExternalSorter<ValueType, OrderingType, Allocator>::SpillRun() {
+
+	m_Ordering.SortRun(m_Memory, m_Memory + m_ValueCount, m_Memory + m_RunCapacity);
+
+	Detail::ExternalRun run;
+	if (CreateRunFile(&run) == false) {
+		m_HasFailed = true;
+		return false;
+	}
+	run.m_Count = m_ValueCount;
+	m_Runs.push_back(run);
+
+	// The whole run is written at once, the stream is unbuffered and the write goes straight to the file
+	if (fwrite(m_Memory, sizeof(ValueType), m_ValueCount, run.m_File) != m_ValueCount || fseek(run.m_File, 0, SEEK_SET) != 0) {
+		m_HasFailed = true;
+		return false;
+	}
+
+	m_ValueCount = 0;
+	return true;
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+bool ExternalSorter<ValueType, OrderingType, Allocator>::CreateRunFile(Detail::ExternalRun* run) {
+
+	if (m_Settings.m_TemporaryDirectory.empty()) {
+		run->m_File = tmpfile();
+	}
+	else {
+		// The address of the sorter and the time keep the names of multiple sorters and processes apart
+		uint64_t time = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+		run->m_Path = m_Settings.m_TemporaryDirectory + "/MistSort_" + std::to_string(time) + "_"
+			+ std::to_string(reinterpret_cast<uintptr_t>(this)) + "_" + std::to_string(m_RunId++) + ".run";
+		run->m_File = fopen(run->m_Path.c_str(), "w+b");
+	}
+
+	if (run->m_File == nullptr) {
+		return false;
+	}
+	setvbuf(run->m_File, nullptr, _IONBF, 0);
+	return true;
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+template< typename OutputType >
+bool ExternalSorter<ValueType, OrderingType, Allocator>::MergeRuns(Detail::ExternalRun* runs, size_t runCount, OutputType& output) {
+
+	// The budget is split into the output block followed by two blocks per run
+	size_t blockCapacity = m_MemoryCapacity / (runCount * 2 + 1);
+	size_t configuredCapacity = m_Settings.m_BlockSize / sizeof(ValueType);
+	blockCapacity = configuredCapacity > 0 && configuredCapacity < blockCapacity ? configuredCapacity : blockCapacity;
+	MIST_ASSERT(blockCapacity > 0);
+
+	ValueType* outputBlock = m_Memory;
+	size_t outputCount = 0;
+
+	std::vector<Detail::ExternalMergeSource<ValueType>> sources(runCount);
+	Detail::ExternalBlockReader<ValueType> reader;
+	for (size_t i = 0; i < runCount; i++) {
+		Detail::ExternalMergeSource<ValueType>& source = sources[i];
+		source.m_File = runs[i].m_File;
+		source.m_Unrequested = runs[i].m_Count;
+		source.m_ActiveBlock = 0;
+		source.m_Current = nullptr;
+		source.m_End = nullptr;
+		for (size_t block = 0; block < 2; block++) {
+			source.m_Blocks[block].m_Values = m_Memory + blockCapacity * (1 + i * 2 + block);
+			source.m_Blocks[block].m_Count = 0;
+			source.m_Blocks[block].m_IsRequested = false;
+			source.m_Blocks[block].m_IsReady.store(false, std::memory_order_relaxed);
+
+			if (source.m_Unrequested > 0) {
+				size_t requestCount = source.m_Unrequested < blockCapacity ? source.m_Unrequested : blockCapacity;
+				source.m_Unrequested -= requestCount;
+				reader.Request(source.m_File, &source.m_Blocks[block], requestCount);
+			}
+		}
+	}
+
+	// Move a run to it's next block, the block that was consumed starts reading the block after it
+	auto nextBlock = [&](Detail::ExternalMergeSource<ValueType>& source) {
+		Detail::ExternalReadBlock<ValueType>& consumedBlock = source.m_Blocks[source.m_ActiveBlock];
+		if (source.m_Unrequested > 0) {
+			size_t requestCount = source.m_Unrequested < blockCapacity ? source.m_Unrequested : blockCapacity;
+			source.m_Unrequested -= requestCount;
+			reader.Request(source.m_File, &consumedBlock, requestCount);
+		}
+
+		source.m_ActiveBlock ^= 1;
+		Detail::ExternalReadBlock<ValueType>& block = source.m_Blocks[source.m_ActiveBlock];
+		source.m_Current = nullptr;
+		if (block.m_IsRequested) {
+			reader.WaitFor(&block);
+			if (block.m_Count > 0) {
+				source.m_Current = block.m_Values;
+				source.m_End = block.m_Values + block.m_Count;
+			}
+		}
+	};
+
+	// The merge starts with the first block of every run while the second block keeps reading
+	for (Detail::ExternalMergeSource<ValueType>& source : sources) {
+		Detail::ExternalReadBlock<ValueType>& block = source.m_Blocks[0];
+		if (block.m_IsRequested) {
+			reader.WaitFor(&block);
+			if (block.m_Count > 0) {
+				source.m_Current = block.m_Values;
+				source.m_End = block.m_Values + block.m_Count;
+			}
+		}
+	}
+
+	Detail::ExternalLoserTree<ValueType, OrderingType> tree;
+	tree.Initialize(sources.data(), runCount, &m_Ordering);
+	while (true) {
+		Detail::ExternalMergeSource<ValueType>& source = sources[tree.Winner()];
+		if (source.m_Current == nullptr) {
+			// The winner is only exhausted when every run is
+			break;
+		}
+
+		outputBlock[outputCount++] = *source.m_Current;
+		if (outputCount == blockCapacity) {
+			output(static_cast<const ValueType*>(outputBlock), outputCount);
+			outputCount = 0;
+		}
+
+		if (++source.m_Current == source.m_End) {
+			nextBlock(source);
+		}
+		tree.Replay();
+	}
+
+	if (outputCount > 0) {
+		output(static_cast<const ValueType*>(outputBlock), outputCount);
+	}
+	return reader.HasFailed() == false;
+}
+
+template< typename ValueType, typename OrderingType, typename Allocator >
+void ExternalSorter<ValueType, OrderingType, Allocator>::Reset() {
+
+	for (Detail::ExternalRun& run : m_Runs) {
+		Detail::CloseRun(&run);
+	}
+	m_Runs.clear();
+
+	if (m_Memory != nullptr) {
+		Detail::FreeAligned(GetAllocator(), m_Memory, CACHE_LINE_ALIGNMENT);
+		m_Memory = nullptr;
+	}
+	m_ValueCount = 0;
+	m_TotalCount = 0;
+	m_HasFailed = false;
+}
+
+template< typename ValueType, typename OrderingType >
+bool ExternalSortFile(const char* inputPath, const char* outputPath, const ExternalSortSettings& settings, OrderingType ordering) {
+
+	FILE* input = fopen(inputPath, "rb");
+	if (input == nullptr) {
+		return false;
+	}
+
+	ExternalSorter<ValueType, OrderingType> sorter(settings, ordering);
+	size_t blockCapacity = settings.m_BlockSize / sizeof(ValueType);
+	std::vector<ValueType> block(blockCapacity > 0 ? blockCapacity : 1);
+
+	bool isSuccessful = true;
+	size_t readCount;
+	while (isSuccessful && (readCount = fread(block.data(), sizeof(ValueType), block.size(), input)) > 0) {
+		isSuccessful = sorter.Push(block.data(), readCount);
+	}
+	isSuccessful = isSuccessful && ferror(input) == 0;
+	fclose(input);
+
+	FILE* output = fopen(outputPath, "wb");
+	if (output == nullptr) {
+		return false;
+	}
+
+	bool isWritten = true;
+	isSuccessful = isSuccessful && sorter.Finish([output, &isWritten](const ValueType* values, size_t count) {
+		isWritten = isWritten && fwrite(values, sizeof(ValueType), count, output) == count;
+	});
+	isSuccessful = fclose(output) == 0 && isSuccessful && isWritten;
+	return isSuccessful;
+}
+
+MIST_NAMESPACE_END
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <Mist_Common/include/UtilityMacros.h>
+#include "SortingNetworks.h"
+#include "../threading/JobScheduler.h"
+#include <cstdint>
+#include <cstring>
 #include <type_traits>
 #include <iterator>
-#include <stack>
+#include <functional>
+#include <vector>
 #include <utility>
 
 // This file implements a series of sorting algorithms useful for sorting different
@@ -13,7 +18,10 @@
 // - InsertionSort
 // - HeapSort
 // - BucketSort
-// Possibly: Limited amount of memory sort, external sorting
+// - RadixSort
+// Selection algorithms are also available: NthElement, PartialSort and TopK
+// SortPermutation sorts the indices of a range instead of the range itself
+// Sorting with a limited amount of memory (External sorting) is implemented by the ExternalSorter in ExternalSort.h
 MIST_NAMESPACE
 
 namespace Detail {
@@ -53,213 +61,607 @@ bool IsSorted(IteratorType begin, IteratorType end) {
 
 // -Merge Sort-
 
-// The main implementation of merge sort will not be recursive, it uses O(n) extra memory
-// the original collection is modified.
-// @Detail: the implementation uses a swapping read and write buffers of size n and swaps between
-//   them every change in block size.
-template< typename CollectionType, typename IndexType = size_t >
-void MergeSort(CollectionType* collection) {
+namespace Detail {
 
-	const size_t collectionSize = collection->size();
-	size_t blockSize = 1;
+	// Determine how many merge passes are needed to sort a collection of collectionSize elements
+	// when the blocks of initialBlockSize are already sorted
+	inline size_t MergePassCount(size_t collectionSize, size_t initialBlockSize = 1) {
+		size_t passCount = 0;
+		for (size_t blockSize = initialBlockSize; blockSize < collectionSize; blockSize += blockSize) {
+			++passCount;
+		}
+		return passCount;
+	}
 
-	// Create our block iterators
-	IndexType first, last, firstNext, lastNext;
-	IndexType writeHead = 0;
+	// Sort every pair of elements in place, this is the same as a merge pass with a block size of 1.
+	// @Detail: Doing the first pass in place flips the parity of the amount of passes, this is used to always
+	//  land the final pass in the original collection and skip the copy back.
+	template< typename TargetType >
+	void SortPairsInPlace(TargetType& target, size_t collectionSize) {
+		for (size_t i = 0; i + 1 < collectionSize; i += 2) {
+			if (target[i + 1] < target[i]) {
+				std::swap(target[i], target[i + 1]);
+			}
+		}
+	}
 
-	// Create our working area
-	CollectionType workingArea(collectionSize);
+	// Prepare the first merge pass of a range, returns the size of the blocks that are already sorted
+	// The read and write targets are swapped when the sorted blocks are written to the scratch buffer
+	// @Detail: The first pass is done in place when the amount of passes is odd, this assures that the
+	//  last pass writes into the range and that nothing has to be copied back.
+	template< typename ValueType >
+	size_t SortInitialBlocks(ValueType* begin, size_t collectionSize, ValueType**, ValueType**, std::false_type) {
+		if (MergePassCount(collectionSize) % 2 == 1) {
+			SortPairsInPlace(begin, collectionSize);
+			return 2;
+		}
+		return 1;
+	}
 
-	CollectionType* writeTarget = &workingArea;
-	CollectionType* readTarget = &*collection;
+	// int32_t and float sort their first blocks with the sorting networks
+	template< typename ValueType >
+	size_t SortInitialBlocks(ValueType* begin, size_t collectionSize, ValueType** readTarget, ValueType** writeTarget, std::true_type) {
+		const size_t blockSize = MAX_SORTING_NETWORK_SIZE;
+		if (MergePassCount(collectionSize, blockSize) % 2 == 1) {
+			std::swap(*readTarget, *writeTarget);
+		}
 
-	// Keep going until we've passed the collection size for a block
-	while (blockSize < collectionSize) {
+		// @Detail: The networks copy the values through their own buffer, the blocks can be written straight into the read target
+		for (size_t blockBegin = 0; blockBegin < collectionSize; blockBegin += blockSize) {
+			size_t blockEnd = Min(blockBegin + blockSize, collectionSize);
+			SortingNetworkRange(begin + blockBegin, begin + blockEnd, *readTarget + blockBegin);
+		}
+		return blockSize;
+	}
+
+	// Merge every pair of blocks of blockSize from the read target into the write target
+	template< typename IndexType, typename ReadType, typename WriteType >
+	void MergePass(ReadType& readTarget, WriteType& writeTarget, size_t collectionSize, size_t blockSize) {
+
+		// Create our block iterators
+		IndexType first, last, firstNext, lastNext;
+		IndexType writeHead = 0;
 
 		// Loop through all the block pairs in intervals of 2
-		// Integer division will truncate which is expected behaviour
-		size_t numBlocks = collectionSize / blockSize;
-		for (size_t i = 0; i < numBlocks; i+=2) {
+		// Round up in order to include the last partial block
+		size_t numBlocks = (collectionSize + blockSize - 1) / blockSize;
+		for (size_t i = 0; i < numBlocks; i += 2) {
 			// Select our first blocks
 			first = i * blockSize;
-			last = (i + 1) * blockSize;
+			last = Min((i + 1) * blockSize, collectionSize);
 
 			// Select our next blocks
-			firstNext = (i + 1) * blockSize;
+			firstNext = last;
 			// Assure that we don't go over the bounds of the collection
-			lastNext = Detail::Min((i + 2) * blockSize, collectionSize);
+			lastNext = Min((i + 2) * blockSize, collectionSize);
 
 			// Loop through both ranges and determine which part goes into the write first
 			// keep going until we've written all of them
 			while (firstNext != lastNext || first != last) {
 				// if we've run out of the next block, write all the previous block
 				if (firstNext == lastNext) {
-					(*writeTarget)[writeHead++] = (*readTarget)[first++];
+					writeTarget[writeHead++] = readTarget[first++];
 				}
 				// if we've run out of the previous block, write all of the next block
 				else if (first == last) {
-					(*writeTarget)[writeHead++] = (*readTarget)[firstNext++];
+					writeTarget[writeHead++] = readTarget[firstNext++];
 				}
 				// if the first is lower, that means we write that one and advance the write head
-				else if ((*readTarget)[firstNext] < (*readTarget)[first]) {
-					(*writeTarget)[writeHead++] = (*readTarget)[firstNext++];
+				else if (readTarget[firstNext] < readTarget[first]) {
+					writeTarget[writeHead++] = readTarget[firstNext++];
 				}
 				else {
-					(*writeTarget)[writeHead++] = (*readTarget)[first++];
+					writeTarget[writeHead++] = readTarget[first++];
 				}
 			}
 		}
+	}
+}
+
+// The main implementation of merge sort will not be recursive, it uses O(n) extra memory
+// the original collection is modified.
+// @Detail: the implementation uses a swapping read and write buffers of size n and swaps between
+//   them every change in block size. The first pass is done in place when the amount of passes is odd,
+//   this assures that the last pass writes into the collection and that nothing has to be copied back.
+//   This version allocates the working area, use the range version with a scratch buffer to avoid it.
+template< typename CollectionType, typename IndexType = size_t >
+void MergeSort(CollectionType* collection) {
+
+	const size_t collectionSize = collection->size();
+	if (collectionSize < 2) {
+		return;
+	}
 
-		// swap our read and write bodies and reset the write head
+	// Create our working area
+	CollectionType workingArea(collectionSize);
+
+	CollectionType* writeTarget = &workingArea;
+	CollectionType* readTarget = &*collection;
+
+	size_t blockSize = 1;
+	if (Detail::MergePassCount(collectionSize) % 2 == 1) {
+		Detail::SortPairsInPlace(*collection, collectionSize);
+		blockSize = 2;
+	}
+
+	// Keep going until we've passed the collection size for a block
+	for (; blockSize < collectionSize; blockSize += blockSize) {
+
+		Detail::MergePass<IndexType>(*readTarget, *writeTarget, collectionSize, blockSize);
+
+		// swap our read and write bodies
 		std::swap(writeTarget, readTarget);
-		writeHead = 0;
+	}
+
+	MIST_ASSERT(readTarget == collection);
+}
+
+
+// The main implementation of merge sort will not be recursive, it uses the caller's scratch buffer
+// of at least (end - begin) elements as it's working area and doesn't allocate.
+// This is the version that sorts an array range, the original range is modified.
+// @Detail: the implementation uses a swapping read and write buffers of size n and swaps between
+//   them every change in block size. The first pass is done in place when the amount of passes is odd,
+//   this assures that the last pass writes into the range and that nothing has to be copied back.
+//   int32_t and float ranges start with blocks sorted by the sorting networks, the order of floats
+//   that compare equal (0.0 and -0.0) is not kept.
+// @Example: Sorting every frame with a persistent scratch buffer would look like:
+//
+//		scratch.Resize(values.Size());
+//		MergeSort(values.begin(), values.end(), scratch.AsRawArray());
+template< typename ValueType, typename IndexType = size_t >
+void MergeSort(ValueType* begin, ValueType* end, ValueType* scratch) {
+
+	const size_t collectionSize = static_cast<size_t>(end - begin);
+	if (collectionSize < 2) {
+		return;
+	}
+
+	MIST_ASSERT(scratch != nullptr);
+
+	ValueType* writeTarget = scratch;
+	ValueType* readTarget = begin;
+
+	size_t blockSize = Detail::SortInitialBlocks(begin, collectionSize, &readTarget, &writeTarget,
+		Detail::HasSortingNetwork<ValueType, std::less<ValueType>>());
 
-		// Increase our block size by the current blockSize
-		blockSize += blockSize;
+	// Keep going until we've passed the collection size for a block
+	for (; blockSize < collectionSize; blockSize += blockSize) {
+
+		Detail::MergePass<IndexType>(readTarget, writeTarget, collectionSize, blockSize);
+
+		// swap our read and write bodies
+		std::swap(writeTarget, readTarget);
 	}
 
-	std::copy(std::begin(*readTarget), std::end(*readTarget), std::begin(*collection));
+	MIST_ASSERT(readTarget == begin);
 }
 
 
 // The main implementation of merge sort will not be recursive, it uses O(n) extra memory
 // the original collection is also modified. This is the version that sorts an array range
-// @Detail: the implementation uses a swapping read and write buffers of size n and swaps between
-//   them every change in block size.
+// This version allocates the working area, use the version with a scratch buffer to avoid it.
 template< typename ValueType, typename IndexType = size_t >
 void MergeSort(ValueType* begin, ValueType* end) {
 
+	// Create our working area, use a vector for the resource management and it's cleaner than std::unique_ptr<ValueType[]>
+	std::vector<ValueType> workingArea(static_cast<size_t>(end - begin));
+	MergeSort<ValueType, IndexType>(begin, end, workingArea.data());
+}
+
+
+
+// -Parallel Merge Sort-
+
+namespace Detail {
+
+	// Ranges smaller than this are not worth splitting across threads
+	constexpr size_t DEFAULT_PARALLEL_GRAIN_SIZE = 16384;
+
+	// Call the function with every worker index from 0 to workerCount on the threads of the default job scheduler,
+	// the calling thread helps until every worker index is done
+	template< typename FunctionType >
+	void RunOnWorkers(size_t workerCount, FunctionType&& function) {
+
+		JobScheduler::Default().ParallelFor(0, workerCount, 1, [&function](size_t begin, size_t end) {
+			for (size_t worker = begin; worker < end; ++worker) {
+				function(worker);
+			}
+		});
+	}
+
+	// Merge path partitioning, determine how many elements of the left run are part of the first
+	// outputIndex elements of the merged output. This allows multiple threads to merge the same pair of runs.
+	// @Detail: When elements are equal the left run comes first, this keeps the merge stable.
+	template< typename ValueType >
+	size_t MergePathSplit(const ValueType* left, size_t leftSize, const ValueType* right, size_t rightSize, size_t outputIndex) {
+
+		size_t low = outputIndex > rightSize ? outputIndex - rightSize : 0;
+		size_t high = Min(outputIndex, leftSize);
+		while (low < high) {
+			size_t middle = low + (high - low) / 2;
+			// If the left element doesn't come after the right element, more left elements are needed
+			if ((right[outputIndex - middle - 1] < left[middle]) == false) {
+				low = middle + 1;
+			}
+			else {
+				high = middle;
+			}
+		}
+		return low;
+	}
+
+	// Merge the elements [outputBegin, outputEnd) of the merged output of the left and right runs
+	template< typename ValueType >
+	void MergeSlice(const ValueType* left, size_t leftSize, const ValueType* right, size_t rightSize,
+		size_t outputBegin, size_t outputEnd, ValueType* writeTarget) {
+
+		size_t leftIndex = MergePathSplit(left, leftSize, right, rightSize, outputBegin);
+		size_t rightIndex = outputBegin - leftIndex;
+
+		for (size_t writeHead = outputBegin; writeHead < outputEnd; ++writeHead) {
+			// if we've run out of the right run or the left is not greater, write the left element
+			if (rightIndex == rightSize || (leftIndex < leftSize && (right[rightIndex] < left[leftIndex]) == false)) {
+				writeTarget[writeHead] = left[leftIndex++];
+			}
+			else {
+				writeTarget[writeHead] = right[rightIndex++];
+			}
+		}
+	}
+}
+
+// The parallel merge sort splits the range into one run per worker thread and sorts the runs with the
+// merge sort. The runs are then merged in pairs, every merge pass is split into equal slices of the
+// output using merge path partitioning, this keeps every thread busy even for the final merge.
+// The sort uses O(n) extra memory and is stable, except for float ranges where the runs start with blocks
+// sorted by the sorting networks like MergeSort, the order of floats that compare equal (0.0 and -0.0) is not kept.
+// @Detail: The grain size is the minimum amount of elements per worker, ranges smaller than
+//  the grain size use less workers. With a single worker this is the same as MergeSort.
+//  The workers are jobs of the default JobScheduler, by default there's one worker per thread of the scheduler.
+template< typename ValueType >
+void ParallelMergeSort(ValueType* begin, ValueType* end, size_t threadCount = JobScheduler::Default().ThreadCount(),
+	size_t grainSize = Detail::DEFAULT_PARALLEL_GRAIN_SIZE) {
+
 	const size_t collectionSize = static_cast<size_t>(end - begin);
-	size_t blockSize = 1;
+	if (collectionSize < 2) {
+		return;
+	}
+
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+
+	// Determine how many workers can be kept busy by the range
+	size_t workerCount = Detail::Min(threadCount, collectionSize / grainSize);
+	if (workerCount <= 1) {
+		MergeSort(begin, end);
+		return;
+	}
 
-	// Create our block iterators
-	IndexType first, last, firstNext, lastNext;
-	IndexType writeHead = 0;
+	// Sort every run independently
+	// runBoundaries[i] is the beginning of run i, the last boundary is the end of the collection
+	std::vector<size_t> runBoundaries(workerCount + 1);
+	for (size_t i = 0; i <= workerCount; ++i) {
+		runBoundaries[i] = collectionSize * i / workerCount;
+	}
 
 	// Create our working area, use a vector for the resource management and it's cleaner than std::unique_ptr<ValueType[]>
 	std::vector<ValueType> workingArea(collectionSize);
 
+	// Every run uses it's own part of the working area as it's scratch buffer
+	Detail::RunOnWorkers(workerCount, [begin, &runBoundaries, &workingArea](size_t worker) {
+		MergeSort(begin + runBoundaries[worker], begin + runBoundaries[worker + 1], workingArea.data() + runBoundaries[worker]);
+	});
+
 	ValueType* writeTarget = workingArea.data();
 	ValueType* readTarget = begin;
 
-	// Keep going until we've passed the collection size for a block
-	while (blockSize < collectionSize) {
+	// Keep merging pairs of runs until only one is left
+	while (runBoundaries.size() > 2) {
 
-		// Loop through all the block pairs in intervals of 2
-		// Integer division will truncate which is expected behaviour
-		size_t numBlocks = collectionSize / blockSize;
-		for (size_t i = 0; i < numBlocks; i += 2) {
-			// Select our first blocks
-			first = i * blockSize;
-			last = (i + 1) * blockSize;
+		const size_t runCount = runBoundaries.size() - 1;
+		Detail::RunOnWorkers(workerCount, [&](size_t worker) {
 
-			// Select our next blocks
-			firstNext = (i + 1) * blockSize;
-			// Assure that we don't go over the bounds of the collection
-			lastNext = Detail::Min((i + 2) * blockSize, collectionSize);
+			size_t sliceBegin = collectionSize * worker / workerCount;
+			size_t sliceEnd = collectionSize * (worker + 1) / workerCount;
 
-			// Loop through both ranges and determine which part goes into the write first
-			// keep going until we've written all of them
-			while (firstNext != lastNext || first != last) {
-				// if we've run out of the next block, write all the previous block
-				if (firstNext == lastNext) {
-					writeTarget[writeHead++] = readTarget[first++];
-				}
-				// if we've run out of the previous block, write all of the next block
-				else if (first == last) {
-					writeTarget[writeHead++] = readTarget[firstNext++];
-				}
-				// if the first is lower, that means we write that one and advance the write head
-				else if (readTarget[firstNext] < readTarget[first]) {
-					writeTarget[writeHead++] = readTarget[firstNext++];
-				}
-				else {
-					writeTarget[writeHead++] = readTarget[first++];
+			// Merge the part of every pair of runs that overlaps our slice of the output
+			for (size_t run = 0; run < runCount; run += 2) {
+
+				size_t pairBegin = runBoundaries[run];
+				size_t pairMiddle = runBoundaries[run + 1];
+				// An odd run at the end doesn't have a pair, it's simply copied
+				size_t pairEnd = run + 2 <= runCount ? runBoundaries[run + 2] : pairMiddle;
+
+				if (pairEnd <= sliceBegin || pairBegin >= sliceEnd) {
+					continue;
 				}
+
+				// The overlap of our slice and the pair, relative to the beginning of the pair
+				size_t outputBegin = (sliceBegin > pairBegin ? sliceBegin : pairBegin) - pairBegin;
+				size_t outputEnd = Detail::Min(sliceEnd, pairEnd) - pairBegin;
+
+				Detail::MergeSlice(readTarget + pairBegin, pairMiddle - pairBegin, readTarget + pairMiddle, pairEnd - pairMiddle,
+					outputBegin, outputEnd, writeTarget + pairBegin);
 			}
+		});
+
+		// Every pair of runs is now a single run
+		std::vector<size_t> mergedBoundaries;
+		for (size_t i = 0; i < runBoundaries.size(); i += 2) {
+			mergedBoundaries.push_back(runBoundaries[i]);
+		}
+		if (mergedBoundaries.back() != collectionSize) {
+			mergedBoundaries.push_back(collectionSize);
 		}
+		runBoundaries.swap(mergedBoundaries);
 
-		// swap our read and write bodies and reset the write head
+		// swap our read and write bodies
 		std::swap(writeTarget, readTarget);
-		writeHead = 0;
-
-		// Increase our block size by the current blockSize
-		blockSize += blockSize;
 	}
 
-	// Loop through the read target and write it to the passed in pointer
-	for (size_t i = 0; i < collectionSize; i++) {
-		begin[i] = readTarget[i];
+	// If the last pass landed in the working area, write it back to the passed in pointer
+	if (readTarget != begin) {
+		Detail::RunOnWorkers(workerCount, [&](size_t worker) {
+			size_t sliceBegin = collectionSize * worker / workerCount;
+			size_t sliceEnd = collectionSize * (worker + 1) / workerCount;
+			std::copy(readTarget + sliceBegin, readTarget + sliceEnd, begin + sliceBegin);
+		});
 	}
 }
 
+// -Quick Sort-
 
+namespace Detail {
 
-// -Quick Sort-
+	// Ranges smaller than this are insertion sorted, the overhead of partitioning isn't worth it at that size
+	constexpr size_t INSERTION_SORT_THRESHOLD = 16;
+	// Ranges larger than this use the median of three medians (ninther) as the pivot
+	constexpr size_t NINTHER_THRESHOLD = 128;
 
-// The main implementation of quick sort will be an in place quick sort. The implementation takes a
-// begin and end iterator in order to sort the items in place.
-template< typename IteratorType >
-void QuickSort(IteratorType begin, IteratorType end) {
+	// Integer log2, used to determine the depth limit of the quick sort
+	inline size_t Log2(size_t value) {
+		size_t result = 0;
+		while (value >>= 1) {
+			++result;
+		}
+		return result;
+	}
 
-	// Implementation:
-	// push a start and end range for the sort into a queue
-	// Pick the first range of the queue
-	// pick the last element of the range as the pivot
-	// go through every item from the start to the end
-	// keep in place if the item is greater than the pivot
-	// swap with the first greater if the item is lower than the pivot if there is a first greater item
-	// push the right range and the left range into the queue if their size is greater than one
-
-
-	// Create the queue and push the intial range
-	std::stack<std::pair<IteratorType, IteratorType>> sortingRanges;
-	sortingRanges.push(std::make_pair(begin, end));
-
-	// keep looping until the queue has been emptied
-	while (sortingRanges.empty() == false) {
-		// Get the most recent range and remove it
-		std::pair<IteratorType, IteratorType> currentRange = sortingRanges.top();
-		sortingRanges.pop();
-
-		// Grab a pivot in the range from the back
-		IteratorType pivot = currentRange.second - 1;
-		IteratorType compareTarget = currentRange.first;
-		
-		// Initialize the first largest to the pivot to assure that we don't have a first largest as a smaller element
-		IteratorType firstLargest = pivot;
-
-		// Compare the target with the pivot
-		// If the current target is smaller than the pivot, swap it with the first largest
-		// If the current target is larger than the pivot, leave it in place
-		for (; compareTarget != currentRange.second; ++compareTarget) {
-			// Swap them if they aren't the same
-			if (*compareTarget <= *pivot && firstLargest != pivot && compareTarget != pivot) {
-				std::swap(*compareTarget, *firstLargest);
-				// move the first largest forward since it is now smaller
-				++firstLargest;
+	// Simple insertion sort, this is very fast for small and nearly sorted ranges
+	template< typename IteratorType, typename CompareType >
+	void InsertionSortRange(IteratorType begin, IteratorType end, CompareType& compare) {
+
+		if (begin == end) {
+			return;
+		}
+
+		for (IteratorType current = begin + 1; current != end; ++current) {
+
+			// Shift the larger elements to the right until we find the spot of the current element
+			auto value = std::move(*current);
+			IteratorType hole = current;
+			for (; hole != begin && compare(value, *(hole - 1)); --hole) {
+				*hole = std::move(*(hole - 1));
 			}
-			// If the compare target is larger than the pivot and we don't have a first largest yet,
-			// track it as our first largest
-			else if (*compareTarget > *pivot && firstLargest == pivot) {
-				firstLargest = compareTarget;
+			*hole = std::move(value);
+		}
+	}
+
+	// Sort a range that is below the quick sort threshold
+	template< typename IteratorType, typename CompareType >
+	void SortBaseCase(IteratorType begin, IteratorType end, CompareType& compare, std::false_type) {
+		InsertionSortRange(begin, end, compare);
+	}
+
+	template< typename IteratorType, typename CompareType >
+	void SortBaseCase(IteratorType begin, IteratorType end, CompareType&, std::true_type) {
+		SortingNetworkRange(begin, end, begin);
+	}
+
+	// Sort the three elements in place
+	template< typename IteratorType, typename CompareType >
+	void SortThree(IteratorType first, IteratorType second, IteratorType third, CompareType& compare) {
+		if (compare(*second, *first)) {
+			std::swap(*second, *first);
+		}
+		if (compare(*third, *second)) {
+			std::swap(*third, *second);
+			if (compare(*second, *first)) {
+				std::swap(*second, *first);
 			}
 		}
+	}
 
-		// Swap our values and set our new pivot position
-		std::swap(*firstLargest, *pivot);
-		pivot = firstLargest;
+	// Select a pivot and move it to the beginning of the range
+	// @Detail: The median of three avoids the O(n^2) behaviour on sorted and reverse sorted ranges,
+	//  the ninther is used for large ranges to get a better approximation of the median.
+	template< typename IteratorType, typename CompareType >
+	void MovePivotToFront(IteratorType begin, IteratorType end, CompareType& compare) {
+
+		size_t size = static_cast<size_t>(std::distance(begin, end));
+		IteratorType middle = begin + size / 2;
+		IteratorType last = end - 1;
+
+		if (size > NINTHER_THRESHOLD) {
+			size_t step = size / 8;
+			SortThree(begin, begin + step, begin + step * 2, compare);
+			SortThree(middle - step, middle, middle + step, compare);
+			SortThree(last - step * 2, last - step, last, compare);
+			SortThree(begin + step, middle, last - step, compare);
+		}
+		else {
+			SortThree(begin, middle, last, compare);
+		}
 
-		// Once the pivots and the ranges have been created, add the new ranges to the queue
-		
-		// if the right range is larger than one, add it to the queue
-		if (std::distance(pivot + 1, currentRange.second) > 1) {
-			sortingRanges.push(std::make_pair(pivot + 1, currentRange.second));
+		std::swap(*begin, *middle);
+	}
+
+	// Partition the range around the pivot at the beginning of the range.
+	// returns the final position of the pivot, every element before it is not greater
+	// and every element after it is not lesser.
+	// @Detail: Elements equal to the pivot stop both scans and get swapped, this keeps the
+	//  partitions balanced when the range has a lot of duplicates.
+	template< typename IteratorType, typename CompareType >
+	IteratorType PartitionAroundFront(IteratorType begin, IteratorType end, CompareType& compare) {
+
+		IteratorType left = begin + 1;
+		IteratorType right = end - 1;
+
+		while (true) {
+			while (left <= right && compare(*left, *begin)) {
+				++left;
+			}
+			while (left <= right && compare(*begin, *right)) {
+				--right;
+			}
+
+			if (left >= right) {
+				break;
+			}
+
+			std::swap(*left, *right);
+			++left;
+			--right;
+		}
+
+		std::swap(*begin, *right);
+		return right;
+	}
+
+	// Select a pivot and partition the range around it, returns the final position of the pivot
+	// This is shared by the quick sort and the selection algorithms
+	template< typename IteratorType, typename CompareType >
+	IteratorType Partition(IteratorType begin, IteratorType end, CompareType& compare) {
+
+		MovePivotToFront(begin, end, compare);
+		return PartitionAroundFront(begin, end, compare);
+	}
+
+	// Restore the heap property of the subtree at index, the heap is a max heap for the comparison
+	template< typename IteratorType, typename CompareType >
+	void SiftDown(IteratorType begin, size_t index, size_t size, CompareType& compare) {
+
+		auto value = std::move(*(begin + index));
+		while (true) {
+			size_t child = index * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+
+			// Pick the largest child
+			if (child + 1 < size && compare(*(begin + child), *(begin + child + 1))) {
+				++child;
+			}
+
+			if (compare(value, *(begin + child)) == false) {
+				break;
+			}
+
+			*(begin + index) = std::move(*(begin + child));
+			index = child;
+		}
+		*(begin + index) = std::move(value);
+	}
+
+	// In place heap sort, this is the fallback of the quick sort when the partitions are degenerate
+	template< typename IteratorType, typename CompareType >
+	void HeapSortRange(IteratorType begin, IteratorType end, CompareType& compare) {
+
+		size_t size = static_cast<size_t>(std::distance(begin, end));
+		if (size < 2) {
+			return;
 		}
 
-		// If the left range is larger than one, add it to the queue
-		if (std::distance(currentRange.first, pivot) > 1) {
-			sortingRanges.push(std::make_pair(currentRange.first, pivot));
+		// Build the heap from the last parent to the root
+		for (size_t i = size / 2; i > 0; --i) {
+			SiftDown(begin, i - 1, size, compare);
+		}
+
+		// Move the largest element to the back and restore the heap on the rest
+		for (size_t i = size - 1; i > 0; --i) {
+			std::swap(*begin, *(begin + i));
+			SiftDown(begin, 0, i, compare);
+		}
+	}
+}
+
+// The main implementation of quick sort is an in place introspective sort. The implementation takes a
+// begin and end iterator in order to sort the items in place.
+// @Detail: The pivot is the median of three elements (or the ninther for large ranges), small ranges are
+//  insertion sorted and ranges that recurse deeper than 2 * log(n) are heap sorted to guarantee O(n log n).
+//  The pending ranges are kept in a fixed size stack, the sort doesn't allocate.
+template< typename IteratorType, typename CompareType = std::less<typename std::iterator_traits<IteratorType>::value_type> >
+void QuickSort(IteratorType begin, IteratorType end, CompareType compare = CompareType()) {
+
+	// Implementation:
+	// push a start and end range for the sort into a stack
+	// Pick the most recent range of the stack
+	// if the range is small, insertion sort it
+	// if the range went past the depth limit, heap sort it
+	// otherwise partition the range around the pivot
+	// push the larger range into the stack and keep working on the smaller one
+
+	struct SortingRange {
+		IteratorType m_Begin;
+		IteratorType m_End;
+		size_t m_DepthLimit;
+	};
+
+	size_t size = static_cast<size_t>(std::distance(begin, end));
+	if (size < 2) {
+		return;
+	}
+
+	// Small ranges of int32_t and float are handed to the sorting networks, they can sort larger ranges than the insertion sort
+	using UseSortingNetwork = Detail::HasSortingNetwork<typename std::iterator_traits<IteratorType>::value_type, CompareType>;
+	constexpr size_t BASE_CASE_THRESHOLD = UseSortingNetwork::value ? Detail::MAX_SORTING_NETWORK_SIZE : Detail::INSERTION_SORT_THRESHOLD;
+
+	// Since we always continue with the smaller range, the stack never holds more than log2(n) ranges
+	SortingRange sortingRanges[sizeof(size_t) * 8];
+	size_t rangeCount = 0;
+
+	SortingRange currentRange = { begin, end, Detail::Log2(size) * 2 };
+	while (true) {
+
+		size_t rangeSize = static_cast<size_t>(std::distance(currentRange.m_Begin, currentRange.m_End));
+
+		bool isRangeDone = false;
+		if (rangeSize <= BASE_CASE_THRESHOLD) {
+			Detail::SortBaseCase(currentRange.m_Begin, currentRange.m_End, compare, UseSortingNetwork());
+			isRangeDone = true;
+		}
+		// The partitions have been degenerate, fall back to heap sort
+		else if (currentRange.m_DepthLimit == 0) {
+			Detail::HeapSortRange(currentRange.m_Begin, currentRange.m_End, compare);
+			isRangeDone = true;
+		}
+
+		if (isRangeDone) {
+			if (rangeCount == 0) {
+				break;
+			}
+
+			currentRange = sortingRanges[--rangeCount];
+			continue;
+		}
+
+		IteratorType pivot = Detail::Partition(currentRange.m_Begin, currentRange.m_End, compare);
+		size_t depthLimit = currentRange.m_DepthLimit - 1;
+
+		SortingRange leftRange = { currentRange.m_Begin, pivot, depthLimit };
+		SortingRange rightRange = { pivot + 1, currentRange.m_End, depthLimit };
+
+		// Keep working on the smaller range in order to bound the size of the stack
+		MIST_ASSERT(rangeCount < sizeof(sortingRanges) / sizeof(SortingRange));
+		if (std::distance(leftRange.m_Begin, leftRange.m_End) < std::distance(rightRange.m_Begin, rightRange.m_End)) {
+			sortingRanges[rangeCount++] = rightRange;
+			currentRange = leftRange;
+		}
+		else {
+			sortingRanges[rangeCount++] = leftRange;
+			currentRange = rightRange;
 		}
 	}
 }
@@ -271,6 +673,170 @@ void QuickSort(CollectionType* collection) {
 	QuickSort(collection->begin(), collection->end());
 }
 
+// -Heap Sort-
+
+// In place heap sort, the sort is O(n log n) in the worst case and doesn't use any extra memory.
+// This is the same heap sort the QuickSort falls back to, it's slower on average but never degenerates.
+template< typename IteratorType, typename CompareType = std::less<typename std::iterator_traits<IteratorType>::value_type> >
+void HeapSort(IteratorType begin, IteratorType end, CompareType compare = CompareType()) {
+	Detail::HeapSortRange(begin, end, compare);
+}
+
+template< typename CollectionType >
+void HeapSort(CollectionType* collection) {
+	HeapSort(collection->begin(), collection->end());
+}
+
+// -Permutation Sort-
+
+// Write the permutation that sorts the range into permutation, which must have room for (end - begin) indices.
+// After the call, permutation[i] is the index of the value that belongs at i in the sorted range, the range isn't modified.
+// This is used to sort several parallel arrays by the keys of one of them, the permutation is then applied to every array.
+// @Detail: The indices are quick sorted and ties are broken by index, elements that compare equal keep their relative order.
+// @Example: Sorting the names by the scores would look like:
+//
+//		SortPermutation(scores, scores + count, permutation);
+//		for (size_t i = 0; i < count; ++i) {
+//			sortedNames[i] = names[permutation[i]];
+//		}
+template< typename IteratorType, typename IndexType, typename CompareType = std::less<typename std::iterator_traits<IteratorType>::value_type> >
+void SortPermutation(IteratorType begin, IteratorType end, IndexType* permutation, CompareType compare = CompareType()) {
+
+	size_t size = static_cast<size_t>(std::distance(begin, end));
+	for (size_t i = 0; i < size; ++i) {
+		permutation[i] = static_cast<IndexType>(i);
+	}
+
+	QuickSort(permutation, permutation + size, [begin, &compare](IndexType left, IndexType right) {
+		const auto& leftValue = *(begin + left);
+		const auto& rightValue = *(begin + right);
+		if (compare(leftValue, rightValue)) {
+			return true;
+		}
+		return compare(rightValue, leftValue) == false && left < right;
+	});
+}
+
+
+
+// -Selection-
+
+namespace Detail {
+
+	// Move the value at index up the heap until it's parent is not lesser, the heap is a max heap for the comparison
+	template< typename IteratorType, typename CompareType >
+	void SiftUp(IteratorType begin, size_t index, CompareType& compare) {
+
+		auto value = std::move(*(begin + index));
+		while (index > 0) {
+			size_t parent = (index - 1) / 2;
+			if (compare(*(begin + parent), value) == false) {
+				break;
+			}
+
+			*(begin + index) = std::move(*(begin + parent));
+			index = parent;
+		}
+		*(begin + index) = std::move(value);
+	}
+}
+
+// Introselect, places the element that would be at nth in a sorted range at nth.
+// Every element before nth is not greater and every element after it is not lesser, both sides are left unsorted.
+// This runs in O(n) on average, the partitions are the same as the quick sort.
+// @Detail: Like the quick sort, the selection falls back to the heap sort when the partitions have been degenerate
+//  in order to keep the worst case to O(n log n).
+template< typename IteratorType, typename CompareType = std::less<typename std::iterator_traits<IteratorType>::value_type> >
+void NthElement(IteratorType begin, IteratorType nth, IteratorType end, CompareType compare = CompareType()) {
+
+	if (nth == end) {
+		return;
+	}
+
+	size_t depthLimit = Detail::Log2(static_cast<size_t>(std::distance(begin, end))) * 2;
+	while (static_cast<size_t>(std::distance(begin, end)) > Detail::INSERTION_SORT_THRESHOLD) {
+
+		if (depthLimit == 0) {
+			Detail::HeapSortRange(begin, end, compare);
+			return;
+		}
+		--depthLimit;
+
+		IteratorType pivot = Detail::Partition(begin, end, compare);
+		if (pivot == nth) {
+			return;
+		}
+
+		// Only keep working on the side that holds nth
+		if (nth < pivot) {
+			end = pivot;
+		}
+		else {
+			begin = pivot + 1;
+		}
+	}
+
+	Detail::InsertionSortRange(begin, end, compare);
+}
+
+// Sort the smallest (middle - begin) elements of the range into [begin, middle), the rest of the range is left unsorted.
+// This runs in O(n + k log k) where k is (middle - begin), the elements are selected with NthElement and then sorted.
+// @Example: Sorting the 16 nearest candidates would look like:
+//
+//		PartialSort(candidates.begin(), candidates.begin() + 16, candidates.end());
+template< typename IteratorType, typename CompareType = std::less<typename std::iterator_traits<IteratorType>::value_type> >
+void PartialSort(IteratorType begin, IteratorType middle, IteratorType end, CompareType compare = CompareType()) {
+
+	if (begin == middle) {
+		return;
+	}
+
+	NthElement(begin, middle - 1, end, compare);
+	QuickSort(begin, middle, compare);
+}
+
+// Streaming selection of the k smallest elements of a range, the range is only read once and isn't modified.
+// The selected elements are written sorted into the output, which must have room for k elements.
+// returns the amount of elements written, which is less than k if the range is smaller than k.
+// This runs in O(n log k) and only keeps the k elements of the output, it's meant for ranges that can't be modified
+// or that are produced on the fly, use PartialSort when the range can be reordered.
+// @Detail: The output is used as a bounded max heap, the root is the largest of the selected elements
+//  and gets replaced whenever a smaller element comes in.
+// @Example: Determining the 16 nearest candidates would look like:
+//
+//		float nearest[16];
+//		size_t nearestCount = TopK(distances.begin(), distances.end(), nearest, 16);
+template< typename InputIteratorType, typename OutputIteratorType,
+	typename CompareType = std::less<typename std::iterator_traits<InputIteratorType>::value_type> >
+size_t TopK(InputIteratorType begin, InputIteratorType end, OutputIteratorType output, size_t k, CompareType compare = CompareType()) {
+
+	if (k == 0) {
+		return 0;
+	}
+
+	size_t count = 0;
+	for (; begin != end; ++begin) {
+
+		if (count < k) {
+			*(output + count) = *begin;
+			Detail::SiftUp(output, count, compare);
+			++count;
+		}
+		// Replace the largest selected element
+		else if (compare(*begin, *output)) {
+			*output = *begin;
+			Detail::SiftDown(output, 0, count, compare);
+		}
+	}
+
+	// The output is already a heap, finish the heap sort
+	for (size_t i = count; i > 1; --i) {
+		std::swap(*output, *(output + i - 1));
+		Detail::SiftDown(output, 0, i - 1, compare);
+	}
+	return count;
+}
+
 
 
 // -Insertion Sort-
@@ -347,6 +913,74 @@ void InsertionSort(SourceCollectionType&& source, DestinationCollectionType* des
 	}
 }
 
+namespace Detail {
+
+	// Resize either a standard collection or a Mist collection
+	// @Detail: The standard collections use resize while the Mist collections use Resize,
+	//  the unused int/long argument prefers the standard version when both are available.
+	template< typename CollectionType >
+	auto ResizeCollection(CollectionType* collection, size_t size, int) -> decltype(collection->resize(size), void()) {
+		collection->resize(size);
+	}
+
+	template< typename CollectionType >
+	auto ResizeCollection(CollectionType* collection, size_t size, long) -> decltype(collection->Resize(size), void()) {
+		collection->Resize(size);
+	}
+}
+
+// Bulk version of insertion sort, this inserts a whole batch of values into a sorted destination at once.
+// The batch is sorted first and then merged into the destination from the back in a single pass,
+// this runs in O(n + m log m) where n is the destination size and m the batch size, instead of the O(n * m)
+// element moves of inserting the values one by one.
+// @Detail: The destination is resized once, it's values are moved towards the back while the batch is merged in.
+//  The destination can be anything with random access iterators and resize/Resize, such as a DynamicArray.
+//  Values from the batch are placed after the equal values already in the destination.
+// @Example: Adding this frame's new entities to the sorted list would look like:
+//
+//		DynamicArray<EntityId> sortedEntities;
+//		...
+//		BulkInsertionSort(newEntities, &sortedEntities);
+template< typename SourceCollectionType, typename DestinationCollectionType,
+	typename CompareType = std::less<typename std::decay<decltype(*std::begin(std::declval<DestinationCollectionType&>()))>::type>,
+	// @Template Condition: the destination collection must have a random access operator in order to
+	//  merge from the back
+	typename ValueType = decltype(std::declval<DestinationCollectionType>()[0]) >
+void BulkInsertionSort(SourceCollectionType&& source, DestinationCollectionType* destination, CompareType compare = CompareType()) {
+
+	using DestinationValueType = typename std::decay<decltype(*std::begin(*destination))>::type;
+
+	// The destination collection must be sorted before inserting into it, unlike InsertionSort it can be empty
+	MIST_ASSERT(std::begin(*destination) == std::end(*destination) || IsSorted(std::begin(*destination), std::end(*destination)));
+
+	// Sort the batch on it's own, the source is left untouched
+	std::vector<DestinationValueType> batch(std::begin(source), std::end(source));
+	if (batch.empty()) {
+		return;
+	}
+	QuickSort(batch.begin(), batch.end(), compare);
+
+	size_t destinationCount = static_cast<size_t>(std::distance(std::begin(*destination), std::end(*destination)));
+	Detail::ResizeCollection(destination, destinationCount + batch.size(), 0);
+
+	// Merge from the back, the write position is always past the destination values that are left to read
+	auto values = std::begin(*destination);
+	size_t writeIndex = destinationCount + batch.size();
+	size_t destinationIndex = destinationCount;
+	size_t batchIndex = batch.size();
+	while (batchIndex > 0) {
+
+		if (destinationIndex > 0 && compare(batch[batchIndex - 1], values[destinationIndex - 1])) {
+			values[--writeIndex] = std::move(values[--destinationIndex]);
+		}
+		else {
+			values[--writeIndex] = std::move(batch[--batchIndex]);
+		}
+	}
+	// @Detail: Once the batch is exhausted, the remaining destination values are already in place
+	MIST_ASSERT(writeIndex == destinationIndex);
+}
+
 // -BucketSort-
 
 // Bucket sort is simply a counting algorithm that counts the amount of a recuring value
@@ -356,9 +990,8 @@ void BucketSort(IteratorType begin, IteratorType end, const ValueType min, const
 
 	MIST_ASSERT(max > min);
 
-	// Create the vector for the counting of the values
-	std::vector<CountType> counts(max - min);
-	counts.resize(max - min);
+	// Create the vector for the counting of the values, max is inclusive
+	std::vector<CountType> counts(max - min + 1);
 
 	for (IteratorType current = begin; current != end; ++current) {
 		
@@ -377,7 +1010,8 @@ void BucketSort(IteratorType begin, IteratorType end, const ValueType min, const
 			++currentIndex;
 		}
 
-		(*current) = currentIndex;
+		// The counts are offset by the minimum value
+		(*current) = static_cast<ValueType>(currentIndex + min);
 		--counts[currentIndex];
 	}
 }
@@ -390,4 +1024,133 @@ void BucketSort(CollectionType* collection, const ValueType min, const ValueType
 }
 
 
+// -Radix Sort-
+
+namespace Detail {
+
+	// The radix sort uses 8 bit digits, one histogram of 256 buckets per byte of the key
+	constexpr size_t RADIX_DIGIT_BITS = 8;
+	constexpr size_t RADIX_BUCKET_COUNT = 1 << RADIX_DIGIT_BITS;
+
+	// The default key extractor sorts the values by themselves
+	struct IdentityKey {
+		template< typename ValueType >
+		const ValueType& operator()(const ValueType& value) const {
+			return value;
+		}
+	};
+
+	// Converts the keys to unsigned integers that sort in the same order as the keys
+	template< typename KeyType, typename Enable = void >
+	struct RadixKeyTraits;
+
+	template< typename KeyType >
+	struct RadixKeyTraits<KeyType, typename std::enable_if<std::is_integral<KeyType>::value && std::is_unsigned<KeyType>::value>::type> {
+		using UnsignedType = KeyType;
+		static UnsignedType ToUnsigned(KeyType key) { return key; }
+	};
+
+	// Signed integers flip the sign bit in order for the negative values to come first
+	template< typename KeyType >
+	struct RadixKeyTraits<KeyType, typename std::enable_if<std::is_integral<KeyType>::value && std::is_signed<KeyType>::value>::type> {
+		using UnsignedType = typename std::make_unsigned<KeyType>::type;
+		static UnsignedType ToUnsigned(KeyType key) {
+			return static_cast<UnsignedType>(key) ^ (UnsignedType(1) << (sizeof(KeyType) * 8 - 1));
+		}
+	};
+
+	// Floats flip the sign bit of positive values and every bit of negative values,
+	// this reverses the order of the negative values that are stored as sign and magnitude
+	template< typename KeyType >
+	struct RadixKeyTraits<KeyType, typename std::enable_if<std::is_floating_point<KeyType>::value>::type> {
+		static_assert(sizeof(KeyType) == 4 || sizeof(KeyType) == 8, "Only 32 and 64 bit floating point keys are supported.");
+
+		using UnsignedType = typename std::conditional<sizeof(KeyType) == 4, uint32_t, uint64_t>::type;
+		static UnsignedType ToUnsigned(KeyType key) {
+			UnsignedType bits;
+			memcpy(&bits, &key, sizeof(bits));
+
+			const UnsignedType signBit = UnsignedType(1) << (sizeof(KeyType) * 8 - 1);
+			return (bits & signBit) != 0 ? ~bits : bits | signBit;
+		}
+	};
+}
+
+// Least significant digit radix sort, the values are sorted by the key returned by the key extractor.
+// The keys can be any integer or floating point type, the sort is stable and runs in O(n * sizeof(key)).
+// This version uses the caller's scratch buffer of at least (end - begin) elements, it doesn't allocate.
+// @Detail: The histograms of all the digits are built in a single pass over the values,
+//  digits where all the values land in the same bucket are skipped entirely (Such as the upper bytes of small keys).
+// @Example: Sorting structures by a key would look like:
+//
+//		RadixSort(begin, end, scratch, [](const DrawCall& drawCall) { return drawCall.m_SortKey; });
+template< typename ValueType, typename KeyExtractorType >
+void RadixSort(ValueType* begin, ValueType* end, ValueType* scratch, KeyExtractorType keyExtractor) {
+
+	using KeyType = typename std::decay<decltype(keyExtractor(*begin))>::type;
+	using KeyTraits = Detail::RadixKeyTraits<KeyType>;
+	using UnsignedKey = typename KeyTraits::UnsignedType;
+	constexpr size_t DIGIT_COUNT = sizeof(UnsignedKey) * 8 / Detail::RADIX_DIGIT_BITS;
+
+	const size_t collectionSize = static_cast<size_t>(end - begin);
+	if (collectionSize < 2) {
+		return;
+	}
+
+	MIST_ASSERT(scratch != nullptr);
+
+	// Build the histogram of every digit in one pass
+	size_t counts[DIGIT_COUNT][Detail::RADIX_BUCKET_COUNT] = {};
+	for (ValueType* current = begin; current != end; ++current) {
+		UnsignedKey key = KeyTraits::ToUnsigned(keyExtractor(*current));
+		for (size_t digit = 0; digit < DIGIT_COUNT; ++digit) {
+			++counts[digit][(key >> (digit * Detail::RADIX_DIGIT_BITS)) & (Detail::RADIX_BUCKET_COUNT - 1)];
+		}
+	}
+
+	ValueType* readTarget = begin;
+	ValueType* writeTarget = scratch;
+
+	const UnsignedKey firstKey = KeyTraits::ToUnsigned(keyExtractor(*begin));
+	for (size_t digit = 0; digit < DIGIT_COUNT; ++digit) {
+
+		const size_t shift = digit * Detail::RADIX_DIGIT_BITS;
+
+		// If every value has the same digit, this pass wouldn't change the order
+		if (counts[digit][(firstKey >> shift) & (Detail::RADIX_BUCKET_COUNT - 1)] == collectionSize) {
+			continue;
+		}
+
+		// Transform the counts into the write offset of every bucket
+		size_t offsets[Detail::RADIX_BUCKET_COUNT];
+		size_t offset = 0;
+		for (size_t bucket = 0; bucket < Detail::RADIX_BUCKET_COUNT; ++bucket) {
+			offsets[bucket] = offset;
+			offset += counts[digit][bucket];
+		}
+
+		for (size_t i = 0; i < collectionSize; ++i) {
+			UnsignedKey key = KeyTraits::ToUnsigned(keyExtractor(readTarget[i]));
+			writeTarget[offsets[(key >> shift) & (Detail::RADIX_BUCKET_COUNT - 1)]++] = std::move(readTarget[i]);
+		}
+
+		// swap our read and write bodies
+		std::swap(readTarget, writeTarget);
+	}
+
+	// If the last pass landed in the scratch buffer, write it back to the passed in pointer
+	if (readTarget != begin) {
+		std::move(readTarget, readTarget + collectionSize, begin);
+	}
+}
+
+// This version of radix sort allocates it's own scratch buffer
+template< typename ValueType, typename KeyExtractorType = Detail::IdentityKey >
+void RadixSort(ValueType* begin, ValueType* end, KeyExtractorType keyExtractor = KeyExtractorType()) {
+
+	// Create our working area, use a vector for the resource management and it's cleaner than std::unique_ptr<ValueType[]>
+	std::vector<ValueType> workingArea(static_cast<size_t>(end - begin));
+	RadixSort(begin, end, workingArea.data(), keyExtractor);
+}
+
 MIST_NAMESPACE_END
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+
+// Select the instruction set of the sorting networks at compile time.
+// Define MIST_SORTING_NETWORK_SCALAR to force the scalar version.
+#if !defined(MIST_SORTING_NETWORK_SCALAR)
+#if defined(__AVX2__)
+#define MIST_SORTING_NETWORK_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIST_SORTING_NETWORK_SSE 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MIST_SORTING_NETWORK_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+// This file implements bitonic sorting networks for small arrays of 8, 16, 32 and 64 elements.
+// The networks have no data dependent branches, this makes them a lot faster than the general sorts
+// when sorting tiny arrays such as per tile light lists or k nearest candidates.
+// int32_t and float are sorted with SSE2, AVX2 or NEON when available, any other type uses the scalar version.
+MIST_NAMESPACE
+
+namespace Detail {
+
+	// The lanes of the vector registers used to sort the values
+	// @Detail: The scalar version is a register of a single value, only the compare exchange between
+	//  registers is ever used.
+	template< typename ValueType >
+	struct NetworkLanes {
+
+		using Register = ValueType;
+		using Mask = bool;
+		static constexpr size_t WIDTH = 1;
+
+		static Register Load(const ValueType* values) { return *values; }
+		static void Store(ValueType* values, Register value) { *values = value; }
+
+		// Place the lesser values in low and the greater values in high
+		static void CompareExchange(Register& low, Register& high) {
+			bool isSwapped = high < low;
+			Register lesser = isSwapped ? high : low;
+			high = isSwapped ? low : high;
+			low = lesser;
+		}
+
+		static Register SwapLanes(Register value, size_t) { return value; }
+		static Mask LoadMask(const int32_t* lanes) { return lanes[0] != 0; }
+		static Register Select(Mask mask, Register selected, Register other) { return mask ? selected : other; }
+	};
+
+#if MIST_SORTING_NETWORK_AVX2
+
+	template<>
+	struct NetworkLanes<int32_t> {
+
+		using Register = __m256i;
+		using Mask = __m256i;
+		static constexpr size_t WIDTH = 8;
+
+		static Register Load(const int32_t* values) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values)); }
+		static void Store(int32_t* values, Register value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), value); }
+
+		static void CompareExchange(Register& low, Register& high) {
+			Register lesser = _mm256_min_epi32(low, high);
+			high = _mm256_max_epi32(low, high);
+			low = lesser;
+		}
+
+		// Every lane i receives the value of the lane i ^ distance
+		static Register SwapLanes(Register value, size_t distance) {
+			switch (distance) {
+			case 1: return _mm256_shuffle_epi32(value, _MM_SHUFFLE(2, 3, 0, 1));
+			case 2: return _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+			default: return _mm256_permute2x128_si256(value, value, 1);
+			}
+		}
+
+		static Mask LoadMask(const int32_t* lanes) { return Load(lanes); }
+		static Register Select(Mask mask, Register selected, Register other) { return _mm256_blendv_epi8(other, selected, mask); }
+	};
+
+	template<>
+	struct NetworkLanes<float> {
+
+		using Register = __m256;
+		using Mask = __m256;
+		static constexpr size_t WIDTH = 8;
+
+		static Register Load(const float* values) { return _mm256_loadu_ps(values); }
+		static void Store(float* values, Register value) { _mm256_storeu_ps(values, value); }
+
+		// @Detail: min and max are not used for floats, they don't keep the sign of equal zeros
+		static void CompareExchange(Register& low, Register& high) {
+			Mask isSwapped = _mm256_cmp_ps(high, low, _CMP_LT_OQ);
+			Register lesser = _mm256_blendv_ps(low, high, isSwapped);
+			high = _mm256_blendv_ps(high, low, isSwapped);
+			low = lesser;
+		}
+
+		static Register SwapLanes(Register value, size_t distance) {
+			switch (distance) {
+			case 1: return _mm256_permute_ps(value, _MM_SHUFFLE(2, 3, 0, 1));
+			case 2: return _mm256_permute_ps(value, _MM_SHUFFLE(1, 0, 3, 2));
+			default: return _mm256_permute2f128_ps(value, value, 1);
+			}
+		}
+
+		static Mask LoadMask(const int32_t* lanes) { return _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes))); }
+		static Register Select(Mask mask, Register selected, Register other) { return _mm256_blendv_ps(other, selected, mask); }
+	};
+
+#elif MIST_SORTING_NETWORK_SSE
+
+	// @Detail: Only SSE2 is used in order to be available on every x86-64 target,
+	//  the blends and the integer min/max are done with masks.
+	template<>
+	struct NetworkLanes<int32_t> {
+
+		using Register = __m128i;
+		using Mask = __m128i;
+		static constexpr size_t WIDTH = 4;
+
+		static Register Load(const int32_t* values) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values)); }
+		static void Store(int32_t* values, Register value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(values), value); }
+
+		static void CompareExchange(Register& low, Register& high) {
+			Mask isSwapped = _mm_cmplt_epi32(high, low);
+			Register lesser = Select(isSwapped, high, low);
+			high = Select(isSwapped, low, high);
+			low = lesser;
+		}
+
+		// Every lane i receives the value of the lane i ^ distance
+		static Register SwapLanes(Register value, size_t distance) {
+			if (distance == 1) {
+				return _mm_shuffle_epi32(value, _MM_SHUFFLE(2, 3, 0, 1));
+			}
+			return _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+		}
+
+		static Mask LoadMask(const int32_t* lanes) { return Load(lanes); }
+		static Register Select(Mask mask, Register selected, Register other) {
+			return _mm_or_si128(_mm_and_si128(mask, selected), _mm_andnot_si128(mask, other));
+		}
+	};
+
+	template<>
+	struct NetworkLanes<float> {
+
+		using Register = __m128;
+		using Mask = __m128;
+		static constexpr size_t WIDTH = 4;
+
+		static Register Load(const float* values) { return _mm_loadu_ps(values); }
+		static void Store(float* values, Register value) { _mm_storeu_ps(values, value); }
+
+		// @Detail: min and max are not used for floats, they don't keep the sign of equal zeros
+		static void CompareExchange(Register& low, Register& high) {
+			Mask isSwapped = _mm_cmplt_ps(high, low);
+			Register lesser = Select(isSwapped, high, low);
+			high = Select(isSwapped, low, high);
+			low = lesser;
+		}
+
+		static Register SwapLanes(Register value, size_t distance) {
+			if (distance == 1) {
+				return _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+			}
+			return _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2));
+		}
+
+		static Mask LoadMask(const int32_t* lanes) { return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes))); }
+		static Register Select(Mask mask, Register selected, Register other) {
+			return _mm_or_ps(_mm_and_ps(mask, selected), _mm_andnot_ps(mask, other));
+		}
+	};
+
+#elif MIST_SORTING_NETWORK_NEON
+
+	template<>
+	struct NetworkLanes<int32_t> {
+
+		using Register = int32x4_t;
+		using Mask = uint32x4_t;
+		static constexpr size_t WIDTH = 4;
+
+		static Register Load(const int32_t* values) { return vld1q_s32(values); }
+		static void Store(int32_t* values, Register value) { vst1q_s32(values, value); }
+
+		static void CompareExchange(Register& low, Register& high) {
+			Register lesser = vminq_s32(low, high);
+			high = vmaxq_s32(low, high);
+			low = lesser;
+		}
+
+		// Every lane i receives the value of the lane i ^ distance
+		static Register SwapLanes(Register value, size_t distance) {
+			if (distance == 1) {
+				return vrev64q_s32(value);
+			}
+			return vextq_s32(value, value, 2);
+		}
+
+		static Mask LoadMask(const int32_t* lanes) { return vreinterpretq_u32_s32(vld1q_s32(lanes)); }
+		static Register Select(Mask mask, Register selected, Register other) { return vbslq_s32(mask, selected, other); }
+	};
+
+	template<>
+	struct NetworkLanes<float> {
+
+		using Register = float32x4_t;
+		using Mask = uint32x4_t;
+		static constexpr size_t WIDTH = 4;
+
+		static Register Load(const float* values) { return vld1q_f32(values); }
+		static void Store(float* values, Register value) { vst1q_f32(values, value); }
+
+		// @Detail: min and max are not used for floats, they don't keep the sign of equal zeros
+		static void CompareExchange(Register& low, Register& high) {
+			Mask isSwapped = vcltq_f32(high, low);
+			Register lesser = vbslq_f32(isSwapped, high, low);
+			high = vbslq_f32(isSwapped, low, high);
+			low = lesser;
+		}
+
+		static Register SwapLanes(Register value, size_t distance) {
+			if (distance == 1) {
+				return vrev64q_f32(value);
+			}
+			return vextq_f32(value, value, 2);
+		}
+
+		static Mask LoadMask(const int32_t* lanes) { return vreinterpretq_u32_s32(vld1q_s32(lanes)); }
+		static Register Select(Mask mask, Register selected, Register other) { return vbslq_f32(mask, selected, other); }
+	};
+
+#endif
+
+	// The element counts that have a sorting network
+	constexpr size_t MIN_SORTING_NETWORK_SIZE = 8;
+	constexpr size_t MAX_SORTING_NETWORK_SIZE = 64;
+
+	// Determine if the sorting network can be used in place of the compare, only the natural order
+	// of int32_t and float is supported.
+	template< typename ValueType, typename CompareType >
+	struct HasSortingNetwork : std::integral_constant<bool,
+		(std::is_same<ValueType, int32_t>::value || std::is_same<ValueType, float>::value) &&
+		std::is_same<CompareType, std::less<ValueType>>::value> {};
+
+	// Sort an array of tCount values with a bitonic sorting network
+	// @Detail: Every step compares the values i and i ^ distance, the direction alternates every blockSize values.
+	//  When the distance is at least the register width, whole registers are compared against each other.
+	//  Otherwise the register is compared against it's own lanes swapped and the lanes pick the lesser or greater value.
+	template< size_t tCount, typename ValueType >
+	void BitonicSort(ValueType* values) {
+
+		using Lanes = NetworkLanes<ValueType>;
+		constexpr size_t WIDTH = Lanes::WIDTH;
+		static_assert(tCount % WIDTH == 0, "The sorting network must be a multiple of the register width.");
+
+		for (size_t blockSize = 2; blockSize <= tCount; blockSize += blockSize) {
+			for (size_t distance = blockSize / 2; distance > 0; distance /= 2) {
+
+				if (distance >= WIDTH) {
+					for (size_t i = 0; i < tCount; i += WIDTH) {
+						if ((i & distance) != 0) {
+							continue;
+						}
+
+						typename Lanes::Register low = Lanes::Load(values + i);
+						typename Lanes::Register high = Lanes::Load(values + i + distance);
+						Lanes::CompareExchange(low, high);
+
+						bool isAscending = (i & blockSize) == 0;
+						Lanes::Store(values + i, isAscending ? low : high);
+						Lanes::Store(values + i + distance, isAscending ? high : low);
+					}
+				}
+				else {
+					// A lane keeps the lesser value when it's the lower lane of the pair of an ascending block
+					// @Detail: When the block is larger than the register, every lane of a register has the same direction
+					int32_t ascendingLanes[WIDTH];
+					int32_t descendingLanes[WIDTH];
+					for (size_t lane = 0; lane < WIDTH; ++lane) {
+						bool isLowerLane = (lane & distance) == 0;
+						bool isAscending = blockSize >= WIDTH || (lane & blockSize) == 0;
+						ascendingLanes[lane] = isLowerLane == isAscending ? -1 : 0;
+						descendingLanes[lane] = isLowerLane == isAscending ? 0 : -1;
+					}
+					typename Lanes::Mask ascendingMask = Lanes::LoadMask(ascendingLanes);
+					typename Lanes::Mask descendingMask = Lanes::LoadMask(descendingLanes);
+
+					for (size_t i = 0; i < tCount; i += WIDTH) {
+
+						typename Lanes::Register low = Lanes::Load(values + i);
+						typename Lanes::Register high = Lanes::SwapLanes(low, distance);
+						Lanes::CompareExchange(low, high);
+
+						bool isAscending = blockSize < WIDTH || (i & blockSize) == 0;
+						Lanes::Store(values + i, Lanes::Select(isAscending ? ascendingMask : descendingMask, low, high));
+					}
+				}
+			}
+		}
+	}
+
+	// The value used to fill the unused part of a network, it must sort after every other value
+	template< typename ValueType >
+	constexpr ValueType SortingNetworkPadding() {
+		return std::numeric_limits<ValueType>::has_infinity ? std::numeric_limits<ValueType>::infinity() : std::numeric_limits<ValueType>::max();
+	}
+
+	// Sort a range of up to MAX_SORTING_NETWORK_SIZE values with the smallest network that fits it.
+	// @Detail: The values are copied into a padded buffer, this allows any iterator type and any size to be sorted.
+	//  The sorted values can be written to a different range than the one they were read from.
+	template< typename ReadIteratorType, typename WriteIteratorType >
+	void SortingNetworkRange(ReadIteratorType begin, ReadIteratorType end, WriteIteratorType destination) {
+
+		using ValueType = typename std::iterator_traits<ReadIteratorType>::value_type;
+
+		size_t size = static_cast<size_t>(std::distance(begin, end));
+		MIST_ASSERT(size <= MAX_SORTING_NETWORK_SIZE);
+
+		ValueType buffer[MAX_SORTING_NETWORK_SIZE];
+		size_t networkSize = MIN_SORTING_NETWORK_SIZE;
+		while (networkSize < size) {
+			networkSize += networkSize;
+		}
+
+		size_t index = 0;
+		for (ReadIteratorType current = begin; current != end; ++current) {
+			buffer[index++] = *current;
+		}
+		for (; index < networkSize; ++index) {
+			buffer[index] = SortingNetworkPadding<ValueType>();
+		}
+
+		switch (networkSize) {
+		case 8: BitonicSort<8>(buffer); break;
+		case 16: BitonicSort<16>(buffer); break;
+		case 32: BitonicSort<32>(buffer); break;
+		default: BitonicSort<64>(buffer); break;
+		}
+
+		for (index = 0; index < size; ++index, ++destination) {
+			*destination = buffer[index];
+		}
+	}
+}
+
+// Sort exactly tCount values with a sorting network, tCount must be 8, 16, 32 or 64.
+// int32_t and float use the SIMD version when it's available, other types use the scalar network.
+// @Detail: The sort is not stable and doesn't support NaNs.
+// @Example: Sorting the candidates of a k nearest search would look like:
+//
+//		float distances[32];
+//		...
+//		SortingNetwork<32>(distances);
+template< size_t tCount, typename ValueType >
+void SortingNetwork(ValueType* values) {
+
+	static_assert(tCount == 8 || tCount == 16 || tCount == 32 || tCount == 64, "Sorting networks are only available for 8, 16, 32 and 64 values.");
+	MIST_ASSERT(values != nullptr);
+	Detail::BitonicSort<tCount>(values);
+}
+
+MIST_NAMESPACE_END
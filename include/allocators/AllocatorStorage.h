@@ -0,0 +1,227 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+// Containers keep an instance of their allocator, this allows stateful allocators (Such as an arena per job)
+// to be used the same way as the static allocators. Static allocators like the CppAllocator are simply
+// called through their instance.
+
+namespace Detail {
+
+	// Holds the allocator of a container.
+	// @Detail: Stateless allocators are stored as a base class in order to take advantage of the
+	//  empty base optimization, a container using the CppAllocator doesn't grow in size.
+	template< typename Allocator, bool tIsEmpty = std::is_empty<Allocator>::value >
+	class AllocatorStorage {
+
+	public:
+
+		Allocator& GetAllocator() { return m_Allocator; }
+		const Allocator& GetAllocator() const { return m_Allocator; }
+
+		AllocatorStorage() = default;
+		AllocatorStorage(const Allocator& allocator) : m_Allocator(allocator) {}
+
+	private:
+
+		Allocator m_Allocator = Allocator();
+	};
+
+	template< typename Allocator >
+	class AllocatorStorage<Allocator, true> : private Allocator {
+
+	public:
+
+		Allocator& GetAllocator() { return *this; }
+		const Allocator& GetAllocator() const { return *this; }
+
+		AllocatorStorage() = default;
+		AllocatorStorage(const Allocator& allocator) : Allocator(allocator) {}
+	};
+
+	// Aligned allocations go through the allocator's aligned API when it has one.
+	// @Detail: Allocators without the aligned API (Such as the LinearArena) only support the fundamental alignment,
+	//  their blocks already respect alignof(std::max_align_t).
+	template< typename Allocator >
+	auto AllocateAligned(Allocator& allocator, size_t size, size_t alignment, int) -> decltype(allocator.Alloc(size, alignment)) {
+		return allocator.Alloc(size, alignment);
+	}
+
+	template< typename Allocator >
+	void* AllocateAligned(Allocator& allocator, size_t size, size_t alignment, long) {
+		MIST_ASSERT(alignment <= alignof(std::max_align_t));
+		(void)alignment;
+		return allocator.Alloc(size);
+	}
+
+	template< typename Allocator >
+	auto FreeAligned(Allocator& allocator, void* block, size_t alignment, int) -> decltype(allocator.Free(block, alignment)) {
+		allocator.Free(block, alignment);
+	}
+
+	template< typename Allocator >
+	void FreeAligned(Allocator& allocator, void* block, size_t alignment, long) {
+		MIST_ASSERT(alignment <= alignof(std::max_align_t));
+		(void)alignment;
+		allocator.Free(block);
+	}
+
+	template< typename Allocator >
+	auto ReallocateAligned(Allocator& allocator, void* block, size_t newSize, size_t alignment, int) -> decltype(allocator.Realloc(block, newSize, alignment)) {
+		return allocator.Realloc(block, newSize, alignment);
+	}
+
+	template< typename Allocator >
+	void* ReallocateAligned(Allocator& allocator, void* block, size_t newSize, size_t alignment, long) {
+		MIST_ASSERT(alignment <= alignof(std::max_align_t));
+		(void)alignment;
+		return allocator.Realloc(block, newSize);
+	}
+
+	// Allocate a block with the alignment, the alignment must be a power of two
+	template< typename Allocator >
+	void* AllocateAligned(Allocator& allocator, size_t size, size_t alignment) {
+		return AllocateAligned(allocator, size, alignment, 0);
+	}
+
+	// Free a block allocated with AllocateAligned
+	template< typename Allocator >
+	void FreeAligned(Allocator& allocator, void* block, size_t alignment) {
+		FreeAligned(allocator, block, alignment, 0);
+	}
+
+	// Reallocate a block allocated with AllocateAligned, the new block has the same alignment
+	template< typename Allocator >
+	void* ReallocateAligned(Allocator& allocator, void* block, size_t newSize, size_t alignment) {
+		return ReallocateAligned(allocator, block, newSize, alignment, 0);
+	}
+}
+
+
+// A stateful allocator that forwards every call to an allocator instance owned elsewhere.
+// This is used to share a single arena or pool between multiple containers.
+// @Example: Giving a container it's own scratch arena would look like:
+//
+//		LinearArena scratchArena;
+//		scratchArena.Initialize(64 * 1024);
+//		AllocatorReference<LinearArena> scratchAllocator(&scratchArena);
+//		DynamicArray<int, AllocatorReference<LinearArena>> scratch(scratchAllocator);
+template< typename AllocatorType >
+class AllocatorReference {
+
+public:
+
+	// -Allocator API-
+
+	template< typename Type, typename... Arguments >
+	Type* Alloc(Arguments&&... args);
+
+	void* Alloc(size_t size);
+
+	template< typename Type,
+		// @Template condition, assure that you don't delete a void pointer,
+		// only allow the void pointer version of free to be used
+		typename TemplateCondition = typename std::enable_if<!std::is_same<void, Type>::value>::type >
+	void Free(Type* object);
+
+	void Free(void* block);
+
+	void* Realloc(void* block, size_t newSize);
+
+	// -Aligned API-
+
+	// The aligned allocations are forwarded to the target's aligned API when it has one
+	void* Alloc(size_t size, size_t alignment);
+
+	void Free(void* block, size_t alignment);
+
+	void* Realloc(void* block, size_t newSize, size_t alignment);
+
+	AllocatorType* GetTarget() const;
+
+	// -Structors-
+
+	AllocatorReference() = default;
+	AllocatorReference(AllocatorType* target);
+
+private:
+
+	AllocatorType* m_Target = nullptr;
+};
+
+
+// -Implementation-
+
+template< typename AllocatorType >
+template< typename Type, typename... Arguments >
+Type* AllocatorReference<AllocatorType>::Alloc(Arguments&&... args) {
+
+	MIST_ASSERT(m_Target != nullptr);
+	return m_Target->template Alloc<Type>(std::forward<Arguments>(args)...);
+}
+
+template< typename AllocatorType >
+void* AllocatorReference<AllocatorType>::Alloc(size_t size) {
+
+	MIST_ASSERT(m_Target != nullptr);
+	return m_Target->Alloc(size);
+}
+
+template< typename AllocatorType >
+template< typename Type, typename TemplateCondition >
+void AllocatorReference<AllocatorType>::Free(Type* object) {
+
+	MIST_ASSERT(m_Target != nullptr);
+	m_Target->Free(object);
+}
+
+template< typename AllocatorType >
+void AllocatorReference<AllocatorType>::Free(void* block) {
+
+	MIST_ASSERT(m_Target != nullptr);
+	m_Target->Free(block);
+}
+
+template< typename AllocatorType >
+void* AllocatorReference<AllocatorType>::Realloc(void* block, size_t newSize) {
+
+	MIST_ASSERT(m_Target != nullptr);
+	return m_Target->Realloc(block, newSize);
+}
+
+template< typename AllocatorType >
+void* AllocatorReference<AllocatorType>::Alloc(size_t size, size_t alignment) {
+
+	MIST_ASSERT(m_Target != nullptr);
+	return Detail::AllocateAligned(*m_Target, size, alignment);
+}
+
+template< typename AllocatorType >
+void AllocatorReference<AllocatorType>::Free(void* block, size_t alignment) {
+
+	MIST_ASSERT(m_Target != nullptr);
+	Detail::FreeAligned(*m_Target, block, alignment);
+}
+
+template< typename AllocatorType >
+void* AllocatorReference<AllocatorType>::Realloc(void* block, size_t newSize, size_t alignment) {
+
+	MIST_ASSERT(m_Target != nullptr);
+	return Detail::ReallocateAligned(*m_Target, block, newSize, alignment);
+}
+
+template< typename AllocatorType >
+AllocatorType* AllocatorReference<AllocatorType>::GetTarget() const {
+
+	return m_Target;
+}
+
+template< typename AllocatorType >
+AllocatorReference<AllocatorType>::AllocatorReference(AllocatorType* target) : m_Target(target) {}
+
+MIST_NAMESPACE_END
@@ -1,170 +1,309 @@
-#pragma once
-
-#include <Mist_Common/include/UtilityMacros.h>
-#include <utility>
-#include <type_traits>
-
-#if MIST_DEBUG
-
-// This define forces the cpp allocator to move the block of memory for realloc
-// This is in case someone uses realloc and assumes it stays in place, this call forces it not to stay in place
-#define MIST_USE_FORCED_MOVE_REALLOC 1
-
-#endif
-
-MIST_NAMESPACE
-
-// The default allocator simply uses new and delete to implement it's functionality
-class CppAllocator {
-	
-public:
-	template< typename Type, typename... Arguments >
-	static Type* Alloc(Arguments&&... args);
-
-	static inline void* Alloc(size_t size);
-
-	template< typename Type,
-		// @Template condition, assure that you don't delete a void pointer,
-		// only allow the void pointer version of free to be used
-		typename TemplateCondition = typename std::enable_if<!std::is_same<void, Type>::value>::type >
-	static void Free(Type* object);
-
-	static inline void Free(void* block);
-
-	// Reallocate a block of memory, this block might be at the same position or it might be at a different position
-	// it's arbitrary to the OS, don't assume that thee block will stay at the same position.
-	// newSize cannot be 0
-	static inline void* Realloc(void* block, size_t newSize);
-};
-
-
-// -Implementation-
-
-template< typename Type, typename... Arguments >
-Type* CppAllocator::Alloc(Arguments&&... args) {
-
-	Type* object = new Type(std::forward<Arguments>(args)...);
-	MIST_ASSERT(object != nullptr);
-	return object;
-}
-
-inline void* CppAllocator::Alloc(size_t size) {
-
-	void* block = nullptr;
-
-	MIST_ASSERT(size > 0);
-
-	// Add the size of the block to the front of the allocation for extra information
-#if MIST_DEBUG
-
-	size_t* memBlock = (size_t*)malloc(sizeof(size_t) + size);
-	MIST_ASSERT(memBlock != nullptr);
-	// Log the information of the memblock at the beginning
-	*memBlock = size;
-	// Advance the pointer by one size_t
-	block = (void*)(memBlock + 1);
-
-#else
-
-	block = malloc(size);
-
-#endif
-
-	return block;
-}
-
-template< typename Type, typename TemplateCondition>
-void CppAllocator::Free(Type* object) {
-
-	MIST_ASSERT(object != nullptr);
-	delete object;
-}
-
-inline void CppAllocator::Free(void* object) {
-
-	MIST_ASSERT(object != nullptr);
-
-#if MIST_DEBUG
-
-	size_t* sizePtr = (size_t*)object;
-	// Return to the start of the original pointer, this is where we stored our size
-	sizePtr = sizePtr - 1;
-	// Return to the object pointer
-	object = (void*)sizePtr;
-
-#endif
-
-	free(object);
-}
-
-inline void* CppAllocator::Realloc(void* oldBlock, size_t newSize) {
-
-	MIST_ASSERT(newSize > 0);
-
-	// If the old block has never existed, 
-	if (oldBlock == nullptr) {
-		return Alloc(newSize);
-	}
-
-	// Assure that the memory moves in order to avoid issues with assumptions that it won't move
-#if MIST_USE_FORCED_MOVE_REALLOC && MIST_DEBUG
-
-	// Allocate a new block of new size, assuring that the other block hasnt been freed yet
-	void* newBlock = Alloc(newSize);
-
-	size_t* oldBlockSizePtr = (size_t*)oldBlock;
-	// Return to the original position of the size value
-	oldBlockSizePtr = oldBlockSizePtr - 1;
-	
-	size_t oldSize = *oldBlockSizePtr;
-
-	// Get the minimum size between the old size and the new size,
-	// this assures that we don't copy too much information into the block
-	size_t minSize = oldSize < newSize ? oldSize : newSize;
-
-	// Copy the contents to a new block
-	memcpy(newBlock, oldBlock, minSize);
-	
-	// set the old blocks memory to garbage
-	memset(oldBlockSizePtr, 0xDB, sizeof(size_t) + oldSize);
-
-	// Free the old block
-	free(oldBlockSizePtr);
-
-	return newBlock;
-
-	// If we're not moving the block but still in debug, assure that the size is still set on this new pointer
-#elif MIST_DEBUG
-
-	// retrieve the original pointer
-	size_t* oldBlockSizePtr = (size_t*)oldBlock;
-	// Return to the original position of the size value
-	oldBlockSizePtr = oldBlockSizePtr - 1;
-
-	void* newBlock = realloc(oldBlockSizePtr, sizeof(size_t) + newSize);
-
-	// If realloc fails, it doesn't free the old block of memory
-	if (newBlock == nullptr) {
-		free(oldBlockSizePtr);
-		MIST_ASSERT(false);
-	}
-
-	// Set the size in the block
-	size_t* newBlockSize = (size_t*)newBlock;
-	*newBlockSize = newSize;
-
-	// Advance the pointer to go passed the size
-	newBlockSize = newBlockSize + 1;
-
-	return (void*)newBlockSize;
-
-#else
-
-	// WARNING: If realloc fails, oldblock still exists!!
-	return realloc(oldBlock, newSize);
-
-#endif
-}
-
-
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../utility/CacheLine.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#if MIST_DEBUG
+
+// This define forces the cpp allocator to move the block of memory for realloc
+// This is in case someone uses realloc and assumes it stays in place, this call forces it not to stay in place
+#define MIST_USE_FORCED_MOVE_REALLOC 1
+
+#endif
+
+MIST_NAMESPACE
+
+// Alignments commonly requested from the aligned allocations
+constexpr size_t AVX_ALIGNMENT = 32;
+constexpr size_t CACHE_LINE_ALIGNMENT = CACHE_LINE_SIZE;
+
+namespace Detail {
+
+	// The header placed in front of the over aligned blocks, it records the offset from the original block in order to free it
+	struct AlignedBlockHeader {
+		size_t m_Offset;
+		size_t m_Size;
+	};
+
+	inline bool IsValidAlignment(size_t alignment) {
+		return alignment != 0 && (alignment & (alignment - 1)) == 0;
+	}
+
+	inline void* AlignPointer(void* pointer, size_t alignment) {
+		return reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(pointer) + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1));
+	}
+}
+
+// The default allocator simply uses new and delete to implement it's functionality
+class CppAllocator {
+	
+public:
+	template< typename Type, typename... Arguments >
+	static Type* Alloc(Arguments&&... args);
+
+	static inline void* Alloc(size_t size);
+
+	template< typename Type,
+		// @Template condition, assure that you don't delete a void pointer,
+		// only allow the void pointer version of free to be used
+		typename TemplateCondition = typename std::enable_if<!std::is_same<void, Type>::value>::type >
+	static void Free(Type* object);
+
+	static inline void Free(void* block);
+
+	// Reallocate a block of memory, this block might be at the same position or it might be at a different position
+	// it's arbitrary to the OS, don't assume that thee block will stay at the same position.
+	// newSize cannot be 0
+	static inline void* Realloc(void* block, size_t newSize);
+
+	// -Aligned API-
+
+	// Allocate a block aligned to the alignment, the alignment must be a power of two.
+	// @Detail: Alignments up to alignof(std::max_align_t) are simply forwarded to Alloc, the bigger alignments
+	//  store a header in front of the block. The aligned blocks must be freed and reallocated with the same alignment.
+	static inline void* Alloc(size_t size, size_t alignment);
+
+	static inline void Free(void* block, size_t alignment);
+
+	// Reallocate a block allocated with the alignment, the new block has the same alignment
+	// newSize cannot be 0
+	static inline void* Realloc(void* block, size_t newSize, size_t alignment);
+
+private:
+
+	// Every block is aligned to the largest fundamental alignment
+	static constexpr size_t FUNDAMENTAL_ALIGNMENT = alignof(std::max_align_t);
+	// Debug blocks store their size in front of the block, the header keeps them aligned
+	static constexpr size_t DEBUG_HEADER_SIZE = FUNDAMENTAL_ALIGNMENT;
+
+	// The amount of bytes to allocate in order to place an aligned block of size bytes
+	static inline size_t AlignedBlockSize(size_t size, size_t alignment);
+	static inline Detail::AlignedBlockHeader* GetAlignedHeader(void* block);
+};
+
+
+// -Implementation-
+
+template< typename Type, typename... Arguments >
+Type* CppAllocator::Alloc(Arguments&&... args) {
+
+	Type* object = new Type(std::forward<Arguments>(args)...);
+	MIST_ASSERT(object != nullptr);
+	return object;
+}
+
+inline void* CppAllocator::Alloc(size_t size) {
+
+	void* block = nullptr;
+
+	MIST_ASSERT(size > 0);
+
+	// Add the size of the block to the front of the allocation for extra information
+#if MIST_DEBUG
+
+	uint8_t* memBlock = (uint8_t*)malloc(DEBUG_HEADER_SIZE + size);
+	MIST_ASSERT(memBlock != nullptr);
+	// Advance the pointer past the header, this keeps the block aligned
+	block = (void*)(memBlock + DEBUG_HEADER_SIZE);
+	// Log the information of the memblock right before the block
+	*((size_t*)block - 1) = size;
+
+#else
+
+	block = malloc(size);
+
+#endif
+
+	return block;
+}
+
+template< typename Type, typename TemplateCondition>
+void CppAllocator::Free(Type* object) {
+
+	MIST_ASSERT(object != nullptr);
+	delete object;
+}
+
+inline void CppAllocator::Free(void* object) {
+
+	MIST_ASSERT(object != nullptr);
+
+#if MIST_DEBUG
+
+	// Return to the start of the original pointer, the size is stored in the header
+	object = (void*)((uint8_t*)object - DEBUG_HEADER_SIZE);
+
+#endif
+
+	free(object);
+}
+
+inline void* CppAllocator::Realloc(void* oldBlock, size_t newSize) {
+
+	MIST_ASSERT(newSize > 0);
+
+	// If the old block has never existed, 
+	if (oldBlock == nullptr) {
+		return Alloc(newSize);
+	}
+
+	// Assure that the memory moves in order to avoid issues with assumptions that it won't move
+#if MIST_USE_FORCED_MOVE_REALLOC && MIST_DEBUG
+
+	// Allocate a new block of new size, assuring that the other block hasnt been freed yet
+	void* newBlock = Alloc(newSize);
+
+	// The size is stored right before the block
+	size_t oldSize = *((size_t*)oldBlock - 1);
+	uint8_t* oldHeader = (uint8_t*)oldBlock - DEBUG_HEADER_SIZE;
+
+	// Get the minimum size between the old size and the new size,
+	// this assures that we don't copy too much information into the block
+	size_t minSize = oldSize < newSize ? oldSize : newSize;
+
+	// Copy the contents to a new block
+	memcpy(newBlock, oldBlock, minSize);
+	
+	// set the old blocks memory to garbage
+	memset(oldHeader, 0xDB, DEBUG_HEADER_SIZE + oldSize);
+
+	// Free the old block
+	free(oldHeader);
+
+	return newBlock;
+
+	// If we're not moving the block but still in debug, assure that the size is still set on this new pointer
+#elif MIST_DEBUG
+
+	// retrieve the original pointer
+	uint8_t* oldHeader = (uint8_t*)oldBlock - DEBUG_HEADER_SIZE;
+
+	uint8_t* newHeader = (uint8_t*)realloc(oldHeader, DEBUG_HEADER_SIZE + newSize);
+
+	// If realloc fails, it doesn't free the old block of memory
+	if (newHeader == nullptr) {
+		free(oldHeader);
+		MIST_ASSERT(false);
+	}
+
+	// Advance the pointer to go passed the header and set the size in the block
+	void* newBlock = (void*)(newHeader + DEBUG_HEADER_SIZE);
+	*((size_t*)newBlock - 1) = newSize;
+
+	return newBlock;
+
+#else
+
+	// WARNING: If realloc fails, oldblock still exists!!
+	return realloc(oldBlock, newSize);
+
+#endif
+}
+
+inline void* CppAllocator::Alloc(size_t size, size_t alignment) {
+
+	MIST_ASSERT(size > 0);
+	MIST_ASSERT(Detail::IsValidAlignment(alignment));
+
+	if (alignment <= FUNDAMENTAL_ALIGNMENT) {
+		return Alloc(size);
+	}
+
+	// Place the block at the first aligned address after the header
+	void* originalBlock = malloc(AlignedBlockSize(size, alignment));
+	MIST_ASSERT(originalBlock != nullptr);
+	void* block = Detail::AlignPointer((uint8_t*)originalBlock + sizeof(Detail::AlignedBlockHeader), alignment);
+
+	Detail::AlignedBlockHeader* header = GetAlignedHeader(block);
+	header->m_Offset = (size_t)((uint8_t*)block - (uint8_t*)originalBlock);
+	header->m_Size = size;
+	return block;
+}
+
+inline void CppAllocator::Free(void* block, size_t alignment) {
+
+	MIST_ASSERT(block != nullptr);
+	MIST_ASSERT(Detail::IsValidAlignment(alignment));
+
+	if (alignment <= FUNDAMENTAL_ALIGNMENT) {
+		Free(block);
+		return;
+	}
+
+	free((uint8_t*)block - GetAlignedHeader(block)->m_Offset);
+}
+
+inline void* CppAllocator::Realloc(void* oldBlock, size_t newSize, size_t alignment) {
+
+	MIST_ASSERT(newSize > 0);
+	MIST_ASSERT(Detail::IsValidAlignment(alignment));
+
+	if (alignment <= FUNDAMENTAL_ALIGNMENT) {
+		return Realloc(oldBlock, newSize);
+	}
+
+	if (oldBlock == nullptr) {
+		return Alloc(newSize, alignment);
+	}
+
+	Detail::AlignedBlockHeader* oldHeader = GetAlignedHeader(oldBlock);
+	size_t oldSize = oldHeader->m_Size;
+	size_t minSize = oldSize < newSize ? oldSize : newSize;
+
+#if MIST_USE_FORCED_MOVE_REALLOC && MIST_DEBUG
+
+	// Assure that the memory moves, the same way as the unaligned realloc
+	void* newBlock = Alloc(newSize, alignment);
+	memcpy(newBlock, oldBlock, minSize);
+	memset(oldBlock, 0xDB, oldSize);
+	free((uint8_t*)oldBlock - oldHeader->m_Offset);
+	return newBlock;
+
+#else
+
+	// Let realloc grow the block in place when it can, the block then only moves if realloc
+	// returns a block with a different alignment
+	// @Detail: The old offset is read from the header before realloc, only the returned block is used after it
+	size_t oldOffset = oldHeader->m_Offset;
+	void* oldOriginalBlock = (uint8_t*)oldBlock - oldOffset;
+
+	uint8_t* newOriginalBlock = (uint8_t*)realloc(oldOriginalBlock, AlignedBlockSize(newSize, alignment));
+	// If realloc fails, it doesn't free the old block of memory
+	if (newOriginalBlock == nullptr) {
+		free(oldOriginalBlock);
+		MIST_ASSERT(false);
+		return nullptr;
+	}
+
+	void* newBlock = Detail::AlignPointer(newOriginalBlock + sizeof(Detail::AlignedBlockHeader), alignment);
+	size_t newOffset = (size_t)((uint8_t*)newBlock - newOriginalBlock);
+	if (newOffset != oldOffset) {
+		memmove(newBlock, newOriginalBlock + oldOffset, minSize);
+	}
+
+	Detail::AlignedBlockHeader* newHeader = GetAlignedHeader(newBlock);
+	newHeader->m_Offset = newOffset;
+	newHeader->m_Size = newSize;
+	return newBlock;
+
+#endif
+}
+
+inline size_t CppAllocator::AlignedBlockSize(size_t size, size_t alignment) {
+
+	return size + sizeof(Detail::AlignedBlockHeader) + alignment - 1;
+}
+
+inline Detail::AlignedBlockHeader* CppAllocator::GetAlignedHeader(void* block) {
+
+	return (Detail::AlignedBlockHeader*)block - 1;
+}
+
+
 MIST_NAMESPACE_END
\ No newline at end of file
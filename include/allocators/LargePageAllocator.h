@@ -0,0 +1,335 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "CppAllocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#if defined(_WIN32)
+#define MIST_LARGE_PAGES_WINDOWS 1
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define MIST_LARGE_PAGES_MMAP 1
+#include <sys/mman.h>
+#endif
+
+MIST_NAMESPACE
+
+// The size of a large page on x86-64 and most ARM platforms
+constexpr size_t LARGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+namespace Detail {
+
+	// Map size bytes of zeroed pages straight from the OS, returns nullptr if the pages can't be mapped
+	// @Detail: Linux maps regular pages aligned to a large page and asks for transparent huge pages, Windows tries large pages first
+	//  (which requires the lock pages in memory privilege) and falls back to regular pages.
+	inline void* MapLargePages(size_t size) {
+
+#if MIST_LARGE_PAGES_WINDOWS
+
+		size_t largePageMinimum = GetLargePageMinimum();
+		if (largePageMinimum != 0 && size % largePageMinimum == 0) {
+			void* pages = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			if (pages != nullptr) {
+				return pages;
+			}
+		}
+		return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+#elif MIST_LARGE_PAGES_MMAP
+
+		// The mapping is only aligned to a regular page, a huge page can only back a range aligned to a large page.
+		// Map an extra large page and trim the unaligned ends so that every large page of the block can be a huge page.
+		size_t mappedSize = size + LARGE_PAGE_SIZE;
+		uint8_t* mapping = static_cast<uint8_t*>(mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+		if (mapping == MAP_FAILED) {
+			return nullptr;
+		}
+
+		size_t head = (LARGE_PAGE_SIZE - reinterpret_cast<uintptr_t>(mapping) % LARGE_PAGE_SIZE) % LARGE_PAGE_SIZE;
+		size_t tail = mappedSize - head - size;
+		uint8_t* pages = mapping + head;
+		if (head > 0) {
+			munmap(mapping, head);
+		}
+		if (tail > 0) {
+			munmap(pages + size, tail);
+		}
+#if defined(MADV_HUGEPAGE)
+		madvise(pages, size, MADV_HUGEPAGE);
+#endif
+		return pages;
+
+#else
+
+		(void)size;
+		return nullptr;
+
+#endif
+	}
+
+	inline void UnmapLargePages(void* pages, size_t size) {
+
+#if MIST_LARGE_PAGES_WINDOWS
+		(void)size;
+		VirtualFree(pages, 0, MEM_RELEASE);
+#elif MIST_LARGE_PAGES_MMAP
+		munmap(pages, size);
+#else
+		(void)pages;
+		(void)size;
+		MIST_ASSERT(false);
+#endif
+	}
+
+	// Grow or shrink the mapping without copying it, returns nullptr if the platform can't remap pages
+	// @Detail: A mapping moved by mremap isn't guaranteed to stay aligned to a large page, it's first large page may then be regular pages.
+	inline void* RemapLargePages(void* pages, size_t oldSize, size_t newSize) {
+
+#if MIST_LARGE_PAGES_MMAP && defined(__linux__) && defined(MREMAP_MAYMOVE)
+		void* newPages = mremap(pages, oldSize, newSize, MREMAP_MAYMOVE);
+		if (newPages == MAP_FAILED) {
+			return nullptr;
+		}
+#if defined(MADV_HUGEPAGE)
+		madvise(newPages, newSize, MADV_HUGEPAGE);
+#endif
+		return newPages;
+#else
+		(void)pages;
+		(void)oldSize;
+		(void)newSize;
+		return nullptr;
+#endif
+	}
+}
+
+// An allocator for very large arrays, the blocks of at least tMappingThreshold bytes are mapped straight from the OS
+// in large pages, this cuts the TLB misses of arrays spanning gigabytes.
+// Smaller blocks and the typed allocations are forwarded to the CppAllocator.
+// @Detail: The mapped blocks grow in place with mremap on Linux instead of being copied. Every block is at least
+//  aligned to the cache line, the alignment can't be bigger than a regular page.
+// @Example: A large array of particles would look like:
+//
+//		DynamicArray<Particle, LargePageAllocator<>> particles;
+//		particles.ReserveAdditional(100 * 1000 * 1000);
+template< size_t tMappingThreshold = LARGE_PAGE_SIZE >
+class LargePageAllocator {
+
+public:
+
+	// -Large Page API-
+
+	// Determine if the block was mapped from the OS or forwarded to the CppAllocator
+	static inline bool IsMapped(void* block);
+
+	// -Allocator API-
+
+	template< typename Type, typename... Arguments >
+	static Type* Alloc(Arguments&&... args) { return CppAllocator::Alloc<Type>(std::forward<Arguments>(args)...); }
+
+	static inline void* Alloc(size_t size);
+
+	template< typename Type,
+		// @Template condition, assure that you don't delete a void pointer,
+		// only allow the void pointer version of free to be used
+		typename TemplateCondition = typename std::enable_if<!std::is_same<void, Type>::value>::type >
+	static void Free(Type* object) { CppAllocator::Free(object); }
+
+	static inline void Free(void* block);
+
+	// newSize cannot be 0
+	static inline void* Realloc(void* block, size_t newSize);
+
+	// -Aligned API-
+
+	static inline void* Alloc(size_t size, size_t alignment);
+
+	static inline void Free(void* block, size_t alignment);
+
+	static inline void* Realloc(void* block, size_t newSize, size_t alignment);
+
+private:
+
+	// Stored right before every block
+	struct BlockHeader {
+		// The start of the mapping or of the CppAllocator block
+		void* m_Base;
+		// The size of the mapping, 0 if the block comes from the CppAllocator
+		size_t m_MappedSize;
+		size_t m_Size;
+		size_t m_Alignment;
+	};
+
+	// The smallest page size of the supported platforms, the mappings are always aligned to it
+	static constexpr size_t REGULAR_PAGE_SIZE = 4096;
+
+	static inline BlockHeader* GetHeader(void* block);
+	// The offset from the base to the block, the header fits in front of the block while keeping it aligned
+	static inline size_t BlockOffset(size_t alignment);
+	static inline size_t MappedSize(size_t blockSize);
+	static inline void* Allocate(size_t size, size_t alignment);
+};
+
+
+// -Implementation-
+
+template< size_t tMappingThreshold >
+bool LargePageAllocator<tMappingThreshold>::IsMapped(void* block) {
+
+	MIST_ASSERT(block != nullptr);
+	return GetHeader(block)->m_MappedSize != 0;
+}
+
+template< size_t tMappingThreshold >
+void* LargePageAllocator<tMappingThreshold>::Alloc(size_t size) {
+
+	return Allocate(size, CACHE_LINE_ALIGNMENT);
+}
+
+template< size_t tMappingThreshold >
+void LargePageAllocator<tMappingThreshold>::Free(void* block) {
+
+	MIST_ASSERT(block != nullptr);
+
+	BlockHeader* header = GetHeader(block);
+	if (header->m_MappedSize != 0) {
+		Detail::UnmapLargePages(header->m_Base, header->m_MappedSize);
+	}
+	else {
+		CppAllocator::Free(header->m_Base, header->m_Alignment);
+	}
+}
+
+template< size_t tMappingThreshold >
+void* LargePageAllocator<tMappingThreshold>::Realloc(void* block, size_t newSize) {
+
+	return Realloc(block, newSize, CACHE_LINE_ALIGNMENT);
+}
+
+template< size_t tMappingThreshold >
+void* LargePageAllocator<tMappingThreshold>::Alloc(size_t size, size_t alignment) {
+
+	return Allocate(size, alignment);
+}
+
+template< size_t tMappingThreshold >
+void LargePageAllocator<tMappingThreshold>::Free(void* block, size_t alignment) {
+
+	MIST_ASSERT(block == nullptr || GetHeader(block)->m_Alignment >= alignment);
+	(void)alignment;
+	Free(block);
+}
+
+template< size_t tMappingThreshold >
+void* LargePageAllocator<tMappingThreshold>::Realloc(void* block, size_t newSize, size_t alignment) {
+
+	MIST_ASSERT(newSize > 0);
+
+	if (block == nullptr) {
+		return Allocate(newSize, alignment);
+	}
+
+	BlockHeader* header = GetHeader(block);
+	MIST_ASSERT(header->m_Alignment >= alignment);
+	alignment = header->m_Alignment;
+	size_t offset = BlockOffset(alignment);
+	bool shouldMap = offset + newSize >= tMappingThreshold;
+
+	// Small blocks stay in the CppAllocator, the offset is the same for the same alignment
+	if (header->m_MappedSize == 0 && shouldMap == false) {
+
+		uint8_t* base = static_cast<uint8_t*>(CppAllocator::Realloc(header->m_Base, offset + newSize, alignment));
+		BlockHeader* newHeader = GetHeader(base + offset);
+		newHeader->m_Base = base;
+		newHeader->m_Size = newSize;
+		return base + offset;
+	}
+
+	// Mapped blocks are remapped without copying when the platform allows it
+	if (header->m_MappedSize != 0 && shouldMap) {
+
+		size_t mappedSize = MappedSize(offset + newSize);
+		if (mappedSize == header->m_MappedSize) {
+			header->m_Size = newSize;
+			return block;
+		}
+
+		uint8_t* base = static_cast<uint8_t*>(Detail::RemapLargePages(header->m_Base, header->m_MappedSize, mappedSize));
+		if (base != nullptr) {
+			BlockHeader* newHeader = GetHeader(base + offset);
+			newHeader->m_Base = base;
+			newHeader->m_MappedSize = mappedSize;
+			newHeader->m_Size = newSize;
+			return base + offset;
+		}
+	}
+
+	// Moving between the CppAllocator and the mappings requires a copy
+	void* newBlock = Allocate(newSize, alignment);
+	memcpy(newBlock, block, header->m_Size < newSize ? header->m_Size : newSize);
+	Free(block);
+	return newBlock;
+}
+
+template< size_t tMappingThreshold >
+typename LargePageAllocator<tMappingThreshold>::BlockHeader* LargePageAllocator<tMappingThreshold>::GetHeader(void* block) {
+
+	return static_cast<BlockHeader*>(block) - 1;
+}
+
+template< size_t tMappingThreshold >
+size_t LargePageAllocator<tMappingThreshold>::BlockOffset(size_t alignment) {
+
+	return (sizeof(BlockHeader) + alignment - 1) & ~(alignment - 1);
+}
+
+template< size_t tMappingThreshold >
+size_t LargePageAllocator<tMappingThreshold>::MappedSize(size_t blockSize) {
+
+	// Whole large pages are mapped, a partial large page would fall back to regular pages
+	return (blockSize + LARGE_PAGE_SIZE - 1) & ~(LARGE_PAGE_SIZE - 1);
+}
+
+template< size_t tMappingThreshold >
+void* LargePageAllocator<tMappingThreshold>::Allocate(size_t size, size_t alignment) {
+
+	MIST_ASSERT(size > 0);
+	MIST_ASSERT(Detail::IsValidAlignment(alignment));
+	MIST_ASSERT(alignment <= REGULAR_PAGE_SIZE);
+
+	alignment = alignment > CACHE_LINE_ALIGNMENT ? alignment : CACHE_LINE_ALIGNMENT;
+	size_t offset = BlockOffset(alignment);
+
+	if (offset + size >= tMappingThreshold) {
+
+		size_t mappedSize = MappedSize(offset + size);
+		uint8_t* base = static_cast<uint8_t*>(Detail::MapLargePages(mappedSize));
+		if (base != nullptr) {
+
+			BlockHeader* header = GetHeader(base + offset);
+			header->m_Base = base;
+			header->m_MappedSize = mappedSize;
+			header->m_Size = size;
+			header->m_Alignment = alignment;
+			return base + offset;
+		}
+	}
+
+	// Small blocks, or platforms that can't map pages, use the CppAllocator
+	uint8_t* base = static_cast<uint8_t*>(CppAllocator::Alloc(offset + size, alignment));
+	BlockHeader* header = GetHeader(base + offset);
+	header->m_Base = base;
+	header->m_MappedSize = 0;
+	header->m_Size = size;
+	header->m_Alignment = alignment;
+	return base + offset;
+}
+
+MIST_NAMESPACE_END
@@ -0,0 +1,387 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+// The linear arena is a bump pointer allocator that hands out memory from one large block.
+// It implements the allocator interface as member functions, use it through an AllocatorReference
+// to give containers their own arena, or through the LinearAllocator for a static arena.
+// @Detail: Individual frees don't release memory unless the block is the last one allocated,
+//  the memory is released in bulk by calling Reset or by rewinding to a marker.
+//  The arena is not thread safe, use a different arena per thread or per job.
+class LinearArena {
+
+public:
+
+	// -Types-
+
+	// A marker is a position in the arena that can be rewound to
+	using Marker = size_t;
+
+	// Records the current position of the arena and rewinds back to it when it goes out of scope
+	class ScopedMarker {
+
+	public:
+
+		inline ScopedMarker(LinearArena* arena);
+		inline ~ScopedMarker();
+
+		ScopedMarker(const ScopedMarker&) = delete;
+		ScopedMarker& operator=(const ScopedMarker&) = delete;
+
+	private:
+
+		LinearArena* m_Arena;
+		Marker m_Marker;
+	};
+
+
+	// -Arena API-
+
+	// Allocate the block of memory that all the allocations will come from
+	inline void Initialize(size_t capacity);
+
+	// Use a block of memory provided by the user, the arena does not take ownership of the block
+	inline void Initialize(void* buffer, size_t capacity);
+
+	// Release the block of memory if it was allocated by the arena
+	inline void Shutdown();
+
+	// Release every allocation in the arena at once
+	// @Detail: Destructors are not called, any container still using the arena is left with dangling memory
+	inline void Reset();
+
+	inline Marker GetMarker() const;
+
+	// Release every allocation made since the marker was retrieved
+	inline void RewindToMarker(Marker marker);
+
+	inline size_t UsedSize() const;
+
+	inline size_t Capacity() const;
+
+
+	// -Allocator API-
+
+	template< typename Type, typename... Arguments >
+	Type* Alloc(Arguments&&... args);
+
+	inline void* Alloc(size_t size);
+
+	// Free only calls the destructor of the object, the memory is reclaimed on Reset
+	template< typename Type,
+		// @Template condition, assure that you don't delete a void pointer,
+		// only allow the void pointer version of free to be used
+		typename TemplateCondition = typename std::enable_if<!std::is_same<void, Type>::value>::type >
+	void Free(Type* object);
+
+	// @Detail: If the block was the last allocation, the memory is given back to the arena
+	inline void Free(void* block);
+
+	// Reallocate a block of memory, if the block was the last allocation it will grow in place
+	// newSize cannot be 0
+	inline void* Realloc(void* block, size_t newSize);
+
+
+	// -Structors-
+
+	LinearArena() = default;
+	inline ~LinearArena();
+
+	// The arena owns it's memory, containers refer to it's address
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+private:
+
+	// Every block is aligned to the largest fundamental alignment
+	static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+	// The size of every block is stored at the front of the block, this is needed for realloc
+	static constexpr size_t HEADER_SIZE = (sizeof(size_t) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+	static inline size_t AlignUp(size_t size);
+	static inline size_t& BlockSize(void* block);
+
+	uint8_t* m_Memory = nullptr;
+	size_t m_Capacity = 0;
+	size_t m_Offset = 0;
+	// Keep track of the last block in order to free and grow it in place
+	void* m_LastBlock = nullptr;
+	bool m_OwnsMemory = false;
+};
+
+
+// The linear allocator exposes a LinearArena through the static interface of the CppAllocator
+// in order to be used as the allocator of any container without holding a reference to the arena.
+// @Detail: The ArenaTag parameter allows multiple independent arenas, each tag has it's own arena.
+// @Example: A per frame arena would look like:
+//
+//		struct FrameArena {};
+//		using FrameAllocator = LinearAllocator<FrameArena>;
+//
+//		FrameAllocator::Initialize(1024 * 1024);
+//		while (running) {
+//			DynamicArray<int, FrameAllocator> visibleObjects;
+//			...
+//			FrameAllocator::Reset();
+//		}
+//		FrameAllocator::Shutdown();
+template< typename ArenaTag = void >
+class LinearAllocator {
+
+public:
+
+	// -Types-
+
+	using Marker = LinearArena::Marker;
+
+	// Records the current position of the arena and rewinds back to it when it goes out of scope
+	class ScopedMarker : public LinearArena::ScopedMarker {
+
+	public:
+
+		ScopedMarker() : LinearArena::ScopedMarker(&GetArena()) {}
+	};
+
+
+	// -Arena API-
+
+	static void Initialize(size_t capacity) { GetArena().Initialize(capacity); }
+	static void Initialize(void* buffer, size_t capacity) { GetArena().Initialize(buffer, capacity); }
+	static void Shutdown() { GetArena().Shutdown(); }
+	static void Reset() { GetArena().Reset(); }
+	static Marker GetMarker() { return GetArena().GetMarker(); }
+	static void RewindToMarker(Marker marker) { GetArena().RewindToMarker(marker); }
+	static size_t UsedSize() { return GetArena().UsedSize(); }
+	static size_t Capacity() { return GetArena().Capacity(); }
+
+	// Retrieve the arena behind this allocator
+	static LinearArena& GetArena();
+
+
+	// -Allocator API-
+
+	template< typename Type, typename... Arguments >
+	static Type* Alloc(Arguments&&... args) { return GetArena().template Alloc<Type>(std::forward<Arguments>(args)...); }
+
+	static void* Alloc(size_t size) { return GetArena().Alloc(size); }
+
+	template< typename Type,
+		// @Template condition, assure that you don't delete a void pointer,
+		// only allow the void pointer version of free to be used
+		typename TemplateCondition = typename std::enable_if<!std::is_same<void, Type>::value>::type >
+	static void Free(Type* object) { GetArena().Free(object); }
+
+	static void Free(void* block) { GetArena().Free(block); }
+
+	static void* Realloc(void* block, size_t newSize) { return GetArena().Realloc(block, newSize); }
+};
+
+
+// -Implementation-
+
+// -LinearArena-
+
+void LinearArena::Initialize(size_t capacity) {
+
+	MIST_ASSERT(m_Memory == nullptr);
+	MIST_ASSERT(capacity > 0);
+
+	// malloc guarantees the fundamental alignment that we need
+	m_Memory = reinterpret_cast<uint8_t*>(malloc(capacity));
+	MIST_ASSERT(m_Memory != nullptr);
+	m_Capacity = capacity;
+	m_Offset = 0;
+	m_LastBlock = nullptr;
+	m_OwnsMemory = true;
+}
+
+void LinearArena::Initialize(void* buffer, size_t capacity) {
+
+	MIST_ASSERT(m_Memory == nullptr);
+	MIST_ASSERT(buffer != nullptr);
+	// The buffer must be aligned in order to guarantee the alignment of the blocks
+	MIST_ASSERT(((size_t)buffer & (ALIGNMENT - 1)) == 0);
+
+	m_Memory = reinterpret_cast<uint8_t*>(buffer);
+	m_Capacity = capacity;
+	m_Offset = 0;
+	m_LastBlock = nullptr;
+	m_OwnsMemory = false;
+}
+
+void LinearArena::Shutdown() {
+
+	if (m_OwnsMemory) {
+		free(m_Memory);
+	}
+
+	m_Memory = nullptr;
+	m_Capacity = 0;
+	m_Offset = 0;
+	m_LastBlock = nullptr;
+	m_OwnsMemory = false;
+}
+
+void LinearArena::Reset() {
+
+	RewindToMarker(0);
+}
+
+LinearArena::Marker LinearArena::GetMarker() const {
+
+	return m_Offset;
+}
+
+void LinearArena::RewindToMarker(Marker marker) {
+
+	MIST_ASSERT(marker <= m_Offset);
+
+#if MIST_DEBUG
+	// Scramble the released memory to assure that it isn't reused
+	if (m_Memory != nullptr) {
+		memset(m_Memory + marker, 0xDB, m_Offset - marker);
+	}
+#endif
+
+	m_Offset = marker;
+	// We don't know if the last block is still around, don't allow it to be grown in place
+	m_LastBlock = nullptr;
+}
+
+size_t LinearArena::UsedSize() const {
+
+	return m_Offset;
+}
+
+size_t LinearArena::Capacity() const {
+
+	return m_Capacity;
+}
+
+template< typename Type, typename... Arguments >
+Type* LinearArena::Alloc(Arguments&&... args) {
+
+	static_assert(alignof(Type) <= ALIGNMENT, "The linear arena does not support over aligned types.");
+
+	void* block = Alloc(sizeof(Type));
+	Type* object = new (block) Type(std::forward<Arguments>(args)...);
+	MIST_ASSERT(object != nullptr);
+	return object;
+}
+
+void* LinearArena::Alloc(size_t size) {
+
+	MIST_ASSERT(size > 0);
+	// The arena has to be initialized before allocating from it
+	MIST_ASSERT(m_Memory != nullptr);
+
+	size_t blockOffset = m_Offset + HEADER_SIZE;
+	size_t newOffset = blockOffset + AlignUp(size);
+
+	// The arena ran out of memory, it should be initialized with a larger capacity
+	if (newOffset > m_Capacity) {
+		MIST_ASSERT(false);
+		return nullptr;
+	}
+
+	void* block = m_Memory + blockOffset;
+	BlockSize(block) = size;
+
+	m_Offset = newOffset;
+	m_LastBlock = block;
+	return block;
+}
+
+template< typename Type, typename TemplateCondition >
+void LinearArena::Free(Type* object) {
+
+	MIST_ASSERT(object != nullptr);
+	object->Type::~Type();
+	Free(reinterpret_cast<void*>(object));
+}
+
+void LinearArena::Free(void* block) {
+
+	MIST_ASSERT(block != nullptr);
+
+	// Only the last block can be given back, every other block is released when the arena is reset
+	if (block == m_LastBlock) {
+		RewindToMarker(static_cast<size_t>(reinterpret_cast<uint8_t*>(block) - m_Memory) - HEADER_SIZE);
+	}
+}
+
+void* LinearArena::Realloc(void* oldBlock, size_t newSize) {
+
+	MIST_ASSERT(newSize > 0);
+
+	// If the old block has never existed,
+	if (oldBlock == nullptr) {
+		return Alloc(newSize);
+	}
+
+	// If the block is the last allocation, simply move the bump pointer
+	if (oldBlock == m_LastBlock) {
+
+		size_t blockOffset = static_cast<size_t>(reinterpret_cast<uint8_t*>(oldBlock) - m_Memory);
+		size_t newOffset = blockOffset + AlignUp(newSize);
+		if (newOffset > m_Capacity) {
+			MIST_ASSERT(false);
+			return nullptr;
+		}
+
+		BlockSize(oldBlock) = newSize;
+		m_Offset = newOffset;
+		return oldBlock;
+	}
+
+	size_t oldSize = BlockSize(oldBlock);
+	void* newBlock = Alloc(newSize);
+	if (newBlock == nullptr) {
+		return nullptr;
+	}
+
+	// Get the minimum size between the old size and the new size,
+	// this assures that we don't copy too much information into the block
+	memcpy(newBlock, oldBlock, oldSize < newSize ? oldSize : newSize);
+	return newBlock;
+}
+
+LinearArena::~LinearArena() {
+
+	Shutdown();
+}
+
+size_t LinearArena::AlignUp(size_t size) {
+
+	return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+size_t& LinearArena::BlockSize(void* block) {
+
+	return *(reinterpret_cast<size_t*>(block) - 1);
+}
+
+LinearArena::ScopedMarker::ScopedMarker(LinearArena* arena) : m_Arena(arena), m_Marker(arena->GetMarker()) {}
+
+LinearArena::ScopedMarker::~ScopedMarker() {
+
+	m_Arena->RewindToMarker(m_Marker);
+}
+
+// -LinearAllocator-
+
+template< typename ArenaTag >
+LinearArena& LinearAllocator<ArenaTag>::GetArena() {
+
+	static LinearArena arena;
+	return arena;
+}
+
+MIST_NAMESPACE_END
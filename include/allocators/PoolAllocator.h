@@ -0,0 +1,266 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "CppAllocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+// The pool allocator hands out fixed size slots from large chunks of memory.
+// It matches the static interface of the CppAllocator in order to be used as the allocator of node based containers.
+// @Detail: Every type allocated through Alloc<Type> has it's own pool with slots of sizeof(Type),
+//  for the SingleList this means a pool sized to the list's node. Slots are handed out contiguously
+//  from the current chunk and freed slots are recycled in O(1) through a free list.
+//  Untyped allocations (Alloc(size), Realloc) are not pooled and are forwarded to the CppAllocator,
+//  this allows the allocator to still be used with the DynamicArray.
+//  The PoolTag parameter allows multiple independent pools for the same type.
+//  The pool is not thread safe, use a different tag per thread.
+// @Example: Releasing a whole list in one go would look like:
+//
+//		struct EventPool {};
+//		using EventAllocator = PoolAllocator<EventPool>;
+//		using EventList = SingleList<Event, EventAllocator>;
+//
+//		EventList events;
+//		...
+//		// Forget the nodes and release all the chunks at once instead of walking the list
+//		events.Abandon();
+//		EventAllocator::ReleaseAll<EventList::Node>();
+template< typename PoolTag = void, size_t tSlotsPerChunk = 256 >
+class PoolAllocator {
+	static_assert(tSlotsPerChunk > 0, "A chunk must be able to hold at least one slot.");
+
+public:
+
+	// -Pool API-
+
+	// Release every chunk of the Type's pool at once
+	// @Detail: Destructors are not called, it is assumed that the objects were trivially destructible
+	//  or have been abandoned by their container.
+	template< typename Type >
+	static void ReleaseAll();
+
+	// Determine how many objects of Type are currently allocated from the pool
+	template< typename Type >
+	static size_t LiveCount();
+
+	// Determine how many chunks the Type's pool has allocated
+	template< typename Type >
+	static size_t ChunkCount();
+
+
+	// -Allocator API-
+
+	template< typename Type, typename... Arguments >
+	static Type* Alloc(Arguments&&... args);
+
+	static inline void* Alloc(size_t size);
+
+	template< typename Type,
+		// @Template condition, assure that you don't delete a void pointer,
+		// only allow the void pointer version of free to be used
+		typename TemplateCondition = typename std::enable_if<!std::is_same<void, Type>::value>::type >
+	static void Free(Type* object);
+
+	static inline void Free(void* block);
+
+	// Untyped blocks are not pooled, this simply forwards to the CppAllocator
+	// newSize cannot be 0
+	static inline void* Realloc(void* block, size_t newSize);
+
+	// -Aligned API-
+
+	// The aligned blocks are not pooled either, they're forwarded to the CppAllocator
+	static inline void* Alloc(size_t size, size_t alignment);
+
+	static inline void Free(void* block, size_t alignment);
+
+	static inline void* Realloc(void* block, size_t newSize, size_t alignment);
+
+private:
+
+	// Chunks are linked together in order to be released in one go
+	struct Chunk {
+		Chunk* m_Previous;
+	};
+
+	// A free slot stores the next free slot in place of the object
+	struct FreeSlot {
+		FreeSlot* m_Next;
+	};
+
+	struct Pool {
+		FreeSlot* m_FreeList = nullptr;
+		// The unused region of the most recent chunk, slots are handed out from here before allocating a new chunk
+		uint8_t* m_Cursor = nullptr;
+		uint8_t* m_End = nullptr;
+		Chunk* m_Chunks = nullptr;
+		size_t m_LiveCount = 0;
+		size_t m_ChunkCount = 0;
+	};
+
+	static constexpr size_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+	// A freed slot holds the free list pointer, the slots must be aligned for it as well as for the Type
+	template< typename Type >
+	static constexpr size_t SlotAlignment() {
+		return alignof(Type) > alignof(FreeSlot) ? alignof(Type) : alignof(FreeSlot);
+	}
+
+	// Every slot must be able to hold the free list pointer and keep the alignment of the following slot
+	template< typename Type >
+	static constexpr size_t SlotSize() {
+		return ((sizeof(Type) > sizeof(FreeSlot) ? sizeof(Type) : sizeof(FreeSlot)) + SlotAlignment<Type>() - 1) & ~(SlotAlignment<Type>() - 1);
+	}
+
+	// Every type has it's own pool
+	template< typename Type >
+	static Pool& GetPool();
+};
+
+
+// -Implementation-
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+template< typename Type >
+typename PoolAllocator<PoolTag, tSlotsPerChunk>::Pool& PoolAllocator<PoolTag, tSlotsPerChunk>::GetPool() {
+
+	static Pool pool;
+	return pool;
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+template< typename Type >
+void PoolAllocator<PoolTag, tSlotsPerChunk>::ReleaseAll() {
+
+	Pool& pool = GetPool<Type>();
+
+	Chunk* chunk = pool.m_Chunks;
+	while (chunk != nullptr) {
+
+		Chunk* previousChunk = chunk->m_Previous;
+		free(chunk);
+		chunk = previousChunk;
+	}
+
+	pool = Pool();
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+template< typename Type >
+size_t PoolAllocator<PoolTag, tSlotsPerChunk>::LiveCount() {
+
+	return GetPool<Type>().m_LiveCount;
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+template< typename Type >
+size_t PoolAllocator<PoolTag, tSlotsPerChunk>::ChunkCount() {
+
+	return GetPool<Type>().m_ChunkCount;
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+template< typename Type, typename... Arguments >
+Type* PoolAllocator<PoolTag, tSlotsPerChunk>::Alloc(Arguments&&... args) {
+
+	static_assert(alignof(Type) <= alignof(std::max_align_t), "The pool allocator does not support over aligned types.");
+
+	Pool& pool = GetPool<Type>();
+	void* slot = nullptr;
+
+	// Recycle the most recently freed slot first, it's the most likely to still be in the cache
+	if (pool.m_FreeList != nullptr) {
+
+		slot = pool.m_FreeList;
+		pool.m_FreeList = pool.m_FreeList->m_Next;
+	}
+	else {
+
+		// The current chunk is full, allocate a new one
+		if (pool.m_Cursor == pool.m_End) {
+
+			Chunk* chunk = reinterpret_cast<Chunk*>(malloc(CHUNK_HEADER_SIZE + SlotSize<Type>() * tSlotsPerChunk));
+			MIST_ASSERT(chunk != nullptr);
+			chunk->m_Previous = pool.m_Chunks;
+			pool.m_Chunks = chunk;
+			++pool.m_ChunkCount;
+
+			pool.m_Cursor = reinterpret_cast<uint8_t*>(chunk) + CHUNK_HEADER_SIZE;
+			pool.m_End = pool.m_Cursor + SlotSize<Type>() * tSlotsPerChunk;
+		}
+
+		slot = pool.m_Cursor;
+		pool.m_Cursor += SlotSize<Type>();
+	}
+
+	++pool.m_LiveCount;
+
+	Type* object = new (slot) Type(std::forward<Arguments>(args)...);
+	MIST_ASSERT(object != nullptr);
+	return object;
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+void* PoolAllocator<PoolTag, tSlotsPerChunk>::Alloc(size_t size) {
+
+	return CppAllocator::Alloc(size);
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+template< typename Type, typename TemplateCondition >
+void PoolAllocator<PoolTag, tSlotsPerChunk>::Free(Type* object) {
+
+	MIST_ASSERT(object != nullptr);
+
+	Pool& pool = GetPool<Type>();
+	MIST_ASSERT(pool.m_LiveCount > 0);
+
+	object->Type::~Type();
+
+#if MIST_DEBUG
+	// Scramble the object to assure that it isn't reused
+	memset(static_cast<void*>(object), 0xDB, sizeof(Type));
+#endif
+
+	FreeSlot* slot = reinterpret_cast<FreeSlot*>(object);
+	slot->m_Next = pool.m_FreeList;
+	pool.m_FreeList = slot;
+	--pool.m_LiveCount;
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+void PoolAllocator<PoolTag, tSlotsPerChunk>::Free(void* block) {
+
+	CppAllocator::Free(block);
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+void* PoolAllocator<PoolTag, tSlotsPerChunk>::Realloc(void* block, size_t newSize) {
+
+	return CppAllocator::Realloc(block, newSize);
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+void* PoolAllocator<PoolTag, tSlotsPerChunk>::Alloc(size_t size, size_t alignment) {
+
+	return CppAllocator::Alloc(size, alignment);
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+void PoolAllocator<PoolTag, tSlotsPerChunk>::Free(void* block, size_t alignment) {
+
+	CppAllocator::Free(block, alignment);
+}
+
+template< typename PoolTag, size_t tSlotsPerChunk >
+void* PoolAllocator<PoolTag, tSlotsPerChunk>::Realloc(void* block, size_t newSize, size_t alignment) {
+
+	return CppAllocator::Realloc(block, newSize, alignment);
+}
+
+MIST_NAMESPACE_END
@@ -0,0 +1,566 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "CppAllocator.h"
+#include "AllocatorStorage.h"
+#include "../utility/BitManipulations.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Allocation tracking is enabled by default in every build, define MIST_TRACK_ALLOCATIONS to 0 in order to
+// compile it out. The TrackingAllocator then simply forwards to it's base allocator without any overhead.
+#if !defined(MIST_TRACK_ALLOCATIONS)
+#define MIST_TRACK_ALLOCATIONS 1
+#endif
+
+#define MIST_ALLOCATION_TAG_STRINGIFY_IMPL(value) #value
+#define MIST_ALLOCATION_TAG_STRINGIFY(value) MIST_ALLOCATION_TAG_STRINGIFY_IMPL(value)
+
+// Declare a tag for the TrackingAllocator, the tag records the name and the place it was declared.
+// @Example: Tracking the allocations of the render queues would look like:
+//
+//		MIST_ALLOCATION_TAG(RenderQueueTag);
+//		DynamicArray<DrawCall, TrackingAllocator<RenderQueueTag>> drawCalls;
+#define MIST_ALLOCATION_TAG(tagName) \
+	struct tagName { \
+		static const char* Name() { return #tagName; } \
+		static const char* Location() { return __FILE__ ":" MIST_ALLOCATION_TAG_STRINGIFY(__LINE__); } \
+	}
+
+MIST_NAMESPACE
+
+// The allocations are grouped by power of two sizes, bucket i holds sizes in (2^(i-1), 2^i].
+// The last bucket holds everything bigger.
+constexpr size_t ALLOCATION_HISTOGRAM_BUCKET_COUNT = 32;
+
+// The merged statistics of all the allocations made through a tag
+struct AllocationStatistics {
+
+	const char* m_Name = nullptr;
+	const char* m_Location = nullptr;
+	// Bytes that are currently allocated and the highest it has ever been
+	int64_t m_LiveBytes = 0;
+	int64_t m_PeakBytes = 0;
+	uint64_t m_AllocationCount = 0;
+	uint64_t m_ReallocationCount = 0;
+	uint64_t m_FreeCount = 0;
+	// Every byte that was ever requested, this measures the churn
+	uint64_t m_AllocatedBytes = 0;
+	uint64_t m_Histogram[ALLOCATION_HISTOGRAM_BUCKET_COUNT] = {};
+};
+
+namespace Detail {
+
+	// Determine the histogram bucket of an allocation size
+	inline size_t AllocationHistogramBucket(size_t size) {
+
+		size_t bucket = size <= 1 ? 0 : 64 - CountLeadingZeros64(static_cast<uint64_t>(size - 1));
+		return bucket < ALLOCATION_HISTOGRAM_BUCKET_COUNT ? bucket : ALLOCATION_HISTOGRAM_BUCKET_COUNT - 1;
+	}
+
+	// The counters written by a single thread.
+	// @Detail: Only the owning thread writes to the counters, the increments are a relaxed load and store
+	//  instead of a locked read modify write. Other threads only read them when the statistics are merged.
+	//  The counters are trivially destructible, a thread_local instance stays usable until the thread's storage is released.
+	struct ThreadAllocationCounters {
+
+		void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		// Add the counters to the statistics
+		void MergeInto(AllocationStatistics* statistics) const {
+
+			statistics->m_AllocationCount += m_AllocationCount.load(std::memory_order_relaxed);
+			statistics->m_ReallocationCount += m_ReallocationCount.load(std::memory_order_relaxed);
+			statistics->m_FreeCount += m_FreeCount.load(std::memory_order_relaxed);
+			statistics->m_AllocatedBytes += m_AllocatedBytes.load(std::memory_order_relaxed);
+			for (size_t i = 0; i < ALLOCATION_HISTOGRAM_BUCKET_COUNT; i++) {
+				statistics->m_Histogram[i] += m_Histogram[i].load(std::memory_order_relaxed);
+			}
+		}
+
+		std::atomic<uint64_t> m_AllocationCount{ 0 };
+		std::atomic<uint64_t> m_ReallocationCount{ 0 };
+		std::atomic<uint64_t> m_FreeCount{ 0 };
+		std::atomic<uint64_t> m_AllocatedBytes{ 0 };
+		std::atomic<uint64_t> m_Histogram[ALLOCATION_HISTOGRAM_BUCKET_COUNT] = {};
+	};
+
+	// The record of a tag holds the counters of every thread that allocated through the tag.
+	// @Detail: The live and peak bytes are shared between the threads, a block freed on another thread
+	//  has to lower the same live count for the peak to be exact. Everything else is counted per thread.
+	class AllocationTagRecord {
+
+	public:
+
+		// The counters are nullptr once the thread has unregistered, the counts then go straight to the retired statistics
+		void RecordAllocation(ThreadAllocationCounters* counters, size_t size) {
+
+			if (counters != nullptr) {
+				counters->Add(counters->m_AllocationCount, 1);
+				counters->Add(counters->m_AllocatedBytes, size);
+				counters->Add(counters->m_Histogram[AllocationHistogramBucket(size)], 1);
+			}
+			else {
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_RetiredStatistics.m_AllocationCount++;
+				m_RetiredStatistics.m_AllocatedBytes += size;
+				m_RetiredStatistics.m_Histogram[AllocationHistogramBucket(size)]++;
+			}
+			AddLiveBytes(static_cast<int64_t>(size));
+		}
+
+		void RecordReallocation(ThreadAllocationCounters* counters, size_t oldSize, size_t newSize) {
+
+			if (counters != nullptr) {
+				counters->Add(counters->m_ReallocationCount, 1);
+				counters->Add(counters->m_AllocatedBytes, newSize);
+				counters->Add(counters->m_Histogram[AllocationHistogramBucket(newSize)], 1);
+			}
+			else {
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_RetiredStatistics.m_ReallocationCount++;
+				m_RetiredStatistics.m_AllocatedBytes += newSize;
+				m_RetiredStatistics.m_Histogram[AllocationHistogramBucket(newSize)]++;
+			}
+			AddLiveBytes(static_cast<int64_t>(newSize) - static_cast<int64_t>(oldSize));
+		}
+
+		void RecordFree(ThreadAllocationCounters* counters, size_t size) {
+
+			if (counters != nullptr) {
+				counters->Add(counters->m_FreeCount, 1);
+			}
+			else {
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_RetiredStatistics.m_FreeCount++;
+			}
+			AddLiveBytes(-static_cast<int64_t>(size));
+		}
+
+		void RegisterThread(ThreadAllocationCounters* counters) {
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_ThreadCounters.push_back(counters);
+		}
+
+		// Keep the counts of a thread that is exiting
+		void UnregisterThread(ThreadAllocationCounters* counters) {
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			counters->MergeInto(&m_RetiredStatistics);
+			for (size_t i = 0; i < m_ThreadCounters.size(); i++) {
+				if (m_ThreadCounters[i] == counters) {
+					m_ThreadCounters[i] = m_ThreadCounters.back();
+					m_ThreadCounters.pop_back();
+					break;
+				}
+			}
+		}
+
+		// Merge the counters of every thread
+		AllocationStatistics GetStatistics() {
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			AllocationStatistics statistics = m_RetiredStatistics;
+			for (ThreadAllocationCounters* counters : m_ThreadCounters) {
+				counters->MergeInto(&statistics);
+			}
+
+			statistics.m_Name = m_Name;
+			statistics.m_Location = m_Location;
+			statistics.m_LiveBytes = m_LiveBytes.load(std::memory_order_relaxed);
+			statistics.m_PeakBytes = m_PeakBytes.load(std::memory_order_relaxed);
+			return statistics;
+		}
+
+		AllocationTagRecord(const char* name, const char* location);
+
+	private:
+
+		void AddLiveBytes(int64_t bytes) {
+
+			int64_t liveBytes = m_LiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+			// The peak rarely changes once the program is warmed up, avoid writing to it unless it does
+			int64_t peakBytes = m_PeakBytes.load(std::memory_order_relaxed);
+			while (liveBytes > peakBytes && m_PeakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed) == false) {}
+		}
+
+		const char* m_Name;
+		const char* m_Location;
+		std::atomic<int64_t> m_LiveBytes{ 0 };
+		std::atomic<int64_t> m_PeakBytes{ 0 };
+
+		std::mutex m_Mutex;
+		std::vector<ThreadAllocationCounters*> m_ThreadCounters;
+		AllocationStatistics m_RetiredStatistics;
+	};
+
+	// Every tag that has been used, in order to report all of them at once
+	class AllocationTagRegistry {
+
+	public:
+
+		static AllocationTagRegistry& Get() {
+			static AllocationTagRegistry registry;
+			return registry;
+		}
+
+		void Register(AllocationTagRecord* record) {
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Records.push_back(record);
+		}
+
+		std::vector<AllocationTagRecord*> GetRecords() {
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			return m_Records;
+		}
+
+	private:
+
+		std::mutex m_Mutex;
+		std::vector<AllocationTagRecord*> m_Records;
+	};
+
+	inline AllocationTagRecord::AllocationTagRecord(const char* name, const char* location) : m_Name(name), m_Location(location) {
+
+		AllocationTagRegistry::Get().Register(this);
+	}
+
+	// Tags declared with MIST_ALLOCATION_TAG have a name and location, other tags are simply reported as untagged
+	template< typename TagType, typename = void >
+	struct AllocationTagInfo {
+		static const char* Name() { return "Untagged"; }
+		static const char* Location() { return ""; }
+	};
+
+	template< typename TagType >
+	struct AllocationTagInfo<TagType, decltype((void)TagType::Name(), (void)TagType::Location())> {
+		static const char* Name() { return TagType::Name(); }
+		static const char* Location() { return TagType::Location(); }
+	};
+
+	enum class ThreadCountersState : uint8_t {
+		Unregistered,
+		Registered,
+		// The handle was destroyed, the thread is exiting or the main thread is running the static destructors
+		Retired
+	};
+
+	// Registers the thread's counters with the tag's record until the thread's thread_local objects are destroyed
+	class ThreadAllocationCountersHandle {
+
+	public:
+
+		ThreadAllocationCountersHandle(AllocationTagRecord* record, ThreadAllocationCounters* counters, ThreadCountersState* state)
+			: m_Record(record)
+			, m_Counters(counters)
+			, m_State(state) {
+			m_Record->RegisterThread(m_Counters);
+			*m_State = ThreadCountersState::Registered;
+		}
+
+		~ThreadAllocationCountersHandle() {
+			m_Record->UnregisterThread(m_Counters);
+			*m_State = ThreadCountersState::Retired;
+		}
+
+	private:
+
+		AllocationTagRecord* m_Record;
+		ThreadAllocationCounters* m_Counters;
+		ThreadCountersState* m_State;
+	};
+
+	// Retrieve the record of the tag, it's shared by every allocator using the tag
+	template< typename TagType >
+	AllocationTagRecord& GetAllocationTagRecord() {
+
+		// The record is never destroyed, blocks may still be freed during static destruction
+		static AllocationTagRecord* record = new AllocationTagRecord(AllocationTagInfo<TagType>::Name(), AllocationTagInfo<TagType>::Location());
+		return *record;
+	}
+
+	// Retrieve the calling thread's counters for the tag, returns nullptr once the thread's handle is destroyed.
+	// @Detail: On the main thread the thread_local objects are destroyed before the static objects, the blocks freed by the
+	//  static destructors come after the handle. The counters and the state are trivially destructible, they stay valid past the handle.
+	template< typename TagType >
+	ThreadAllocationCounters* GetThreadAllocationCounters() {
+
+		static thread_local ThreadAllocationCounters counters;
+		static thread_local ThreadCountersState state = ThreadCountersState::Unregistered;
+
+		if (state != ThreadCountersState::Registered) {
+			if (state == ThreadCountersState::Retired) {
+				return nullptr;
+			}
+			static thread_local ThreadAllocationCountersHandle handle(&GetAllocationTagRecord<TagType>(), &counters, &state);
+		}
+		return &counters;
+	}
+
+	// The header placed in front of every tracked block.
+	// @Detail: The header is padded to 16 bytes, the block then keeps the alignment of the base allocator's block.
+	struct TrackedBlockHeader {
+		size_t m_Size;
+		size_t m_Padding;
+	};
+	static_assert(sizeof(TrackedBlockHeader) == 16, "The tracked block header must keep 16 byte alignments.");
+}
+
+// Retrieve the statistics of every tag that has been used by a TrackingAllocator
+inline std::vector<AllocationStatistics> GetAllocationStatistics() {
+
+	std::vector<AllocationStatistics> statistics;
+	for (Detail::AllocationTagRecord* record : Detail::AllocationTagRegistry::Get().GetRecords()) {
+		statistics.push_back(record->GetStatistics());
+	}
+	return statistics;
+}
+
+// An allocator that records the allocations made through it before forwarding them to the base allocator.
+// The statistics are kept per tag, every TrackingAllocator with the same tag shares them.
+// This is used to find which containers churn through allocations before moving them to arenas or pools.
+// @Detail: Every block is prefixed by a header holding it's size, this allows Free to be tracked without
+//  the size. The typed allocations go through the base allocator's untyped Alloc in order to be tracked as well.
+//  The counters are per thread and only merged when the statistics are retrieved, only the live bytes
+//  are shared between the threads in order to compute the peak.
+// @Example: Tracking the allocations of a list would look like:
+//
+//		MIST_ALLOCATION_TAG(EventTag);
+//		using EventAllocator = TrackingAllocator<EventTag>;
+//		SingleList<Event, EventAllocator> events;
+//		...
+//		AllocationStatistics statistics = EventAllocator::GetStatistics();
+template< typename TrackingTag = void, typename BaseAllocator = CppAllocator >
+class TrackingAllocator : private Detail::AllocatorStorage<BaseAllocator> {
+
+public:
+
+	// -Tracking API-
+
+	// Merge the counters of every thread that allocated with the tag
+	static AllocationStatistics GetStatistics();
+
+	// Retrieve the base allocator instance that the allocations are forwarded to
+	using Detail::AllocatorStorage<BaseAllocator>::GetAllocator;
+
+	// -Allocator API-
+
+	template< typename Type, typename... Arguments >
+	Type* Alloc(Arguments&&... args);
+
+	void* Alloc(size_t size);
+
+	template< typename Type,
+		// @Template condition, assure that you don't delete a void pointer,
+		// only allow the void pointer version of free to be used
+		typename TemplateCondition = typename std::enable_if<!std::is_same<void, Type>::value>::type >
+	void Free(Type* object);
+
+	void Free(void* block);
+
+	// newSize cannot be 0
+	void* Realloc(void* block, size_t newSize);
+
+	// -Aligned API-
+
+	// The aligned blocks are forwarded to the base allocator's aligned API, the header is padded to the alignment
+	void* Alloc(size_t size, size_t alignment);
+
+	void Free(void* block, size_t alignment);
+
+	void* Realloc(void* block, size_t newSize, size_t alignment);
+
+	// -Structors-
+
+	TrackingAllocator() = default;
+	TrackingAllocator(const BaseAllocator& baseAllocator);
+
+private:
+
+	// The header takes a whole alignment in front of the aligned blocks
+	static size_t AlignedHeaderSize(size_t alignment);
+};
+
+
+// -Implementation-
+
+template< typename TrackingTag, typename BaseAllocator >
+AllocationStatistics TrackingAllocator<TrackingTag, BaseAllocator>::GetStatistics() {
+
+	return Detail::GetAllocationTagRecord<TrackingTag>().GetStatistics();
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+template< typename Type, typename... Arguments >
+Type* TrackingAllocator<TrackingTag, BaseAllocator>::Alloc(Arguments&&... args) {
+
+	static_assert(alignof(Type) <= alignof(std::max_align_t), "The tracked blocks are only aligned to max_align_t.");
+
+	void* block = Alloc(sizeof(Type));
+	return new (block) Type(std::forward<Arguments>(args)...);
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+void* TrackingAllocator<TrackingTag, BaseAllocator>::Alloc(size_t size) {
+
+	MIST_ASSERT(size > 0);
+
+#if MIST_TRACK_ALLOCATIONS
+
+	Detail::TrackedBlockHeader* header = static_cast<Detail::TrackedBlockHeader*>(GetAllocator().Alloc(sizeof(Detail::TrackedBlockHeader) + size));
+	MIST_ASSERT(header != nullptr);
+	header->m_Size = size;
+	Detail::GetAllocationTagRecord<TrackingTag>().RecordAllocation(Detail::GetThreadAllocationCounters<TrackingTag>(), size);
+	return header + 1;
+
+#else
+
+	return GetAllocator().Alloc(size);
+
+#endif
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+template< typename Type, typename TemplateCondition >
+void TrackingAllocator<TrackingTag, BaseAllocator>::Free(Type* object) {
+
+	MIST_ASSERT(object != nullptr);
+	object->~Type();
+	Free(static_cast<void*>(object));
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+void TrackingAllocator<TrackingTag, BaseAllocator>::Free(void* block) {
+
+	MIST_ASSERT(block != nullptr);
+
+#if MIST_TRACK_ALLOCATIONS
+
+	Detail::TrackedBlockHeader* header = static_cast<Detail::TrackedBlockHeader*>(block) - 1;
+	Detail::GetAllocationTagRecord<TrackingTag>().RecordFree(Detail::GetThreadAllocationCounters<TrackingTag>(), header->m_Size);
+	GetAllocator().Free(static_cast<void*>(header));
+
+#else
+
+	GetAllocator().Free(block);
+
+#endif
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+void* TrackingAllocator<TrackingTag, BaseAllocator>::Realloc(void* block, size_t newSize) {
+
+	MIST_ASSERT(newSize > 0);
+
+#if MIST_TRACK_ALLOCATIONS
+
+	if (block == nullptr) {
+		return Alloc(newSize);
+	}
+
+	Detail::TrackedBlockHeader* header = static_cast<Detail::TrackedBlockHeader*>(block) - 1;
+	size_t oldSize = header->m_Size;
+	header = static_cast<Detail::TrackedBlockHeader*>(GetAllocator().Realloc(header, sizeof(Detail::TrackedBlockHeader) + newSize));
+	MIST_ASSERT(header != nullptr);
+	header->m_Size = newSize;
+	Detail::GetAllocationTagRecord<TrackingTag>().RecordReallocation(Detail::GetThreadAllocationCounters<TrackingTag>(), oldSize, newSize);
+	return header + 1;
+
+#else
+
+	return GetAllocator().Realloc(block, newSize);
+
+#endif
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+void* TrackingAllocator<TrackingTag, BaseAllocator>::Alloc(size_t size, size_t alignment) {
+
+	MIST_ASSERT(size > 0);
+
+#if MIST_TRACK_ALLOCATIONS
+
+	size_t headerSize = AlignedHeaderSize(alignment);
+	uint8_t* baseBlock = static_cast<uint8_t*>(Detail::AllocateAligned(GetAllocator(), headerSize + size, alignment));
+	MIST_ASSERT(baseBlock != nullptr);
+
+	Detail::TrackedBlockHeader* header = reinterpret_cast<Detail::TrackedBlockHeader*>(baseBlock + headerSize) - 1;
+	header->m_Size = size;
+	Detail::GetAllocationTagRecord<TrackingTag>().RecordAllocation(Detail::GetThreadAllocationCounters<TrackingTag>(), size);
+	return baseBlock + headerSize;
+
+#else
+
+	return Detail::AllocateAligned(GetAllocator(), size, alignment);
+
+#endif
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+void TrackingAllocator<TrackingTag, BaseAllocator>::Free(void* block, size_t alignment) {
+
+	MIST_ASSERT(block != nullptr);
+
+#if MIST_TRACK_ALLOCATIONS
+
+	Detail::TrackedBlockHeader* header = static_cast<Detail::TrackedBlockHeader*>(block) - 1;
+	Detail::GetAllocationTagRecord<TrackingTag>().RecordFree(Detail::GetThreadAllocationCounters<TrackingTag>(), header->m_Size);
+	Detail::FreeAligned(GetAllocator(), static_cast<uint8_t*>(block) - AlignedHeaderSize(alignment), alignment);
+
+#else
+
+	Detail::FreeAligned(GetAllocator(), block, alignment);
+
+#endif
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+void* TrackingAllocator<TrackingTag, BaseAllocator>::Realloc(void* block, size_t newSize, size_t alignment) {
+
+	MIST_ASSERT(newSize > 0);
+
+#if MIST_TRACK_ALLOCATIONS
+
+	if (block == nullptr) {
+		return Alloc(newSize, alignment);
+	}
+
+	size_t headerSize = AlignedHeaderSize(alignment);
+	size_t oldSize = (static_cast<Detail::TrackedBlockHeader*>(block) - 1)->m_Size;
+	uint8_t* baseBlock = static_cast<uint8_t*>(Detail::ReallocateAligned(GetAllocator(), static_cast<uint8_t*>(block) - headerSize, headerSize + newSize, alignment));
+	MIST_ASSERT(baseBlock != nullptr);
+
+	Detail::TrackedBlockHeader* header = reinterpret_cast<Detail::TrackedBlockHeader*>(baseBlock + headerSize) - 1;
+	header->m_Size = newSize;
+	Detail::GetAllocationTagRecord<TrackingTag>().RecordReallocation(Detail::GetThreadAllocationCounters<TrackingTag>(), oldSize, newSize);
+	return baseBlock + headerSize;
+
+#else
+
+	return Detail::ReallocateAligned(GetAllocator(), block, newSize, alignment);
+
+#endif
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+size_t TrackingAllocator<TrackingTag, BaseAllocator>::AlignedHeaderSize(size_t alignment) {
+
+	return alignment > sizeof(Detail::TrackedBlockHeader) ? alignment : sizeof(Detail::TrackedBlockHeader);
+}
+
+template< typename TrackingTag, typename BaseAllocator >
+TrackingAllocator<TrackingTag, BaseAllocator>::TrackingAllocator(const BaseAllocator& baseAllocator) : Detail::AllocatorStorage<BaseAllocator>(baseAllocator) {}
+
+MIST_NAMESPACE_END
@@ -0,0 +1,629 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "DynamicArray.h"
+#include "../allocators/CppAllocator.h"
+#include "../utility/BitManipulations.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define MIST_BITSET_AVX2 1
+#include <immintrin.h>
+#endif
+
+MIST_NAMESPACE
+
+// Bit sets are stored as an array of 64 bit words, the bit i is the bit (i % 64) of the word (i / 64).
+using BitSetWord = uint64_t;
+constexpr size_t BITS_PER_BITSET_WORD = sizeof(BitSetWord) * 8;
+
+namespace Detail {
+
+	constexpr size_t BitSetWordCount(size_t bitCount) {
+		return (bitCount + BITS_PER_BITSET_WORD - 1) / BITS_PER_BITSET_WORD;
+	}
+
+	// The bulk operations work on whole words, 4 words at a time when AVX2 is available.
+	// The target is modified in place, the target and the source must have wordCount words.
+
+	inline void BitWordsAnd(BitSetWord* target, const BitSetWord* source, size_t wordCount) {
+		size_t i = 0;
+#if MIST_BITSET_AVX2
+		for (; i + 4 <= wordCount; i += 4) {
+			__m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+			__m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_and_si256(left, right));
+		}
+#endif
+		for (; i < wordCount; ++i) {
+			target[i] &= source[i];
+		}
+	}
+
+	inline void BitWordsOr(BitSetWord* target, const BitSetWord* source, size_t wordCount) {
+		size_t i = 0;
+#if MIST_BITSET_AVX2
+		for (; i + 4 <= wordCount; i += 4) {
+			__m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+			__m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_or_si256(left, right));
+		}
+#endif
+		for (; i < wordCount; ++i) {
+			target[i] |= source[i];
+		}
+	}
+
+	inline void BitWordsXor(BitSetWord* target, const BitSetWord* source, size_t wordCount) {
+		size_t i = 0;
+#if MIST_BITSET_AVX2
+		for (; i + 4 <= wordCount; i += 4) {
+			__m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+			__m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_xor_si256(left, right));
+		}
+#endif
+		for (; i < wordCount; ++i) {
+			target[i] ^= source[i];
+		}
+	}
+
+	// Remove the bits of the source from the target
+	inline void BitWordsAndNot(BitSetWord* target, const BitSetWord* source, size_t wordCount) {
+		size_t i = 0;
+#if MIST_BITSET_AVX2
+		for (; i + 4 <= wordCount; i += 4) {
+			__m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i));
+			__m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+			// @Detail: andnot negates it's first operand
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_andnot_si256(right, left));
+		}
+#endif
+		for (; i < wordCount; ++i) {
+			target[i] &= ~source[i];
+		}
+	}
+
+	// Determine if every bit of the flags is set in the words
+	inline bool BitWordsContains(const BitSetWord* words, const BitSetWord* flags, size_t wordCount) {
+		size_t i = 0;
+#if MIST_BITSET_AVX2
+		for (; i + 4 <= wordCount; i += 4) {
+			__m256i wordBits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+			__m256i flagBits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + i));
+			// testc is set when (~words & flags) == 0
+			if (_mm256_testc_si256(wordBits, flagBits) == 0) {
+				return false;
+			}
+		}
+#endif
+		for (; i < wordCount; ++i) {
+			if ((words[i] & flags[i]) != flags[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	inline size_t BitWordsCountBitsSet(const BitSetWord* words, size_t wordCount) {
+		size_t count = 0;
+		size_t i = 0;
+#if MIST_BITSET_AVX2
+		// Count the nibbles with a lookup table in every byte, then sum the bytes of every word
+		// @Detail: From Wojciech Mula's "Faster population counts using AVX2 instructions"
+		const __m256i nibbleCounts = _mm256_setr_epi8(
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i lowNibbles = _mm256_set1_epi8(0x0F);
+		__m256i wordCounts = _mm256_setzero_si256();
+		for (; i + 4 <= wordCount; i += 4) {
+			__m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+			__m256i lowCounts = _mm256_shuffle_epi8(nibbleCounts, _mm256_and_si256(bits, lowNibbles));
+			__m256i highCounts = _mm256_shuffle_epi8(nibbleCounts, _mm256_and_si256(_mm256_srli_epi16(bits, 4), lowNibbles));
+			wordCounts = _mm256_add_epi64(wordCounts, _mm256_sad_epu8(_mm256_add_epi8(lowCounts, highCounts), _mm256_setzero_si256()));
+		}
+
+		BitSetWord laneCounts[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(laneCounts), wordCounts);
+		count = static_cast<size_t>(laneCounts[0] + laneCounts[1] + laneCounts[2] + laneCounts[3]);
+#endif
+		for (; i < wordCount; ++i) {
+			count += CountBitsSet64(words[i]);
+		}
+		return count;
+	}
+
+	inline bool BitWordsIsEmpty(const BitSetWord* words, size_t wordCount) {
+		for (size_t i = 0; i < wordCount; ++i) {
+			if (words[i] != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Set the bits from begin to end (exclusive)
+	inline void BitWordsSetRange(BitSetWord* words, size_t begin, size_t end) {
+		for (; begin < end && begin % BITS_PER_BITSET_WORD != 0; ++begin) {
+			words[begin / BITS_PER_BITSET_WORD] |= BitSetWord(1) << (begin % BITS_PER_BITSET_WORD);
+		}
+		// Fill the whole words in one go
+		for (; begin + BITS_PER_BITSET_WORD <= end; begin += BITS_PER_BITSET_WORD) {
+			words[begin / BITS_PER_BITSET_WORD] = ~BitSetWord(0);
+		}
+		for (; begin < end; ++begin) {
+			words[begin / BITS_PER_BITSET_WORD] |= BitSetWord(1) << (begin % BITS_PER_BITSET_WORD);
+		}
+	}
+
+	// Call the function with the index of every bit set in the words, empty words are skipped
+	template< typename FunctionType >
+	void BitWordsForEachSetBit(const BitSetWord* words, size_t wordCount, FunctionType& function) {
+		for (size_t i = 0; i < wordCount; ++i) {
+			size_t wordOffset = i * BITS_PER_BITSET_WORD;
+			for (size_t bit : IterateSetBits(words[i])) {
+				function(wordOffset + bit);
+			}
+		}
+	}
+
+	// Get all of the indices of the bits set in the words
+	inline void BitWordsGetIndices(const BitSetWord* words, size_t wordCount, size_t* bitIndices, size_t* indexCount) {
+		MIST_ASSERT(bitIndices != nullptr);
+		MIST_ASSERT(indexCount != nullptr);
+
+		(*indexCount) = 0;
+		auto writeIndex = [bitIndices, indexCount](size_t index) { bitIndices[(*indexCount)++] = index; };
+		BitWordsForEachSetBit(words, wordCount, writeIndex);
+	}
+}
+
+// A fixed size set of tBitCount bits, this is the wide version of the BitField for component masks and visibility sets.
+// The operations match the BitManipulations functions, the bulk operations work a word at a time
+// and use AVX2 when available.
+// @Detail: The bits past tBitCount in the last word are always kept off.
+// @Example: Matching an archetype against a query would look like:
+//
+//		BitSet<256> queryComponents;
+//		queryComponents.SetBit(PositionComponent);
+//		queryComponents.SetBit(VelocityComponent);
+//		if (archetypeComponents.IsFlagSet(queryComponents)) {
+//			...
+//		}
+template< size_t tBitCount >
+class BitSet {
+	static_assert(tBitCount > 0, "A BitSet cannot be of size 0. Is it a typo?");
+
+public:
+
+	// -Public API-
+
+	// Determine if a bit is set
+	bool IsBitSet(size_t index) const;
+
+	// Set a bit to on
+	void SetBit(size_t index);
+
+	// Toggle a bit from on to off or off to on
+	void ToggleBit(size_t index);
+
+	// Set a bit to off
+	void UnsetBit(size_t index);
+
+	// Set all the bits from the range begin to end (exclusive)
+	void SetBitRange(size_t begin, size_t end);
+
+	// Set every bit to off
+	void Clear();
+
+	// Determine if every bit set in the flags is also set in this set
+	bool IsFlagSet(const BitSet& flags) const;
+
+	// Determine if no bit is set
+	bool IsEmpty() const;
+
+	// Determine how many bits are set
+	size_t CountBitsSet() const;
+
+	// Get all of the indices of the bits set
+	// bitIndices must have room for CountBitsSet() indices
+	void GetIndividualBitIndices(size_t* bitIndices, size_t* indexCount) const;
+
+	// Call the function with the index of every bit set, without writing the indices anywhere
+	template< typename FunctionType >
+	void ForEachSetBit(FunctionType&& function) const;
+
+	// Remove the bits of the other set from this set
+	BitSet& AndNot(const BitSet& other);
+
+	BitSet& operator&=(const BitSet& other);
+	BitSet& operator|=(const BitSet& other);
+	BitSet& operator^=(const BitSet& other);
+
+	bool operator==(const BitSet& other) const;
+	bool operator!=(const BitSet& other) const;
+
+	BitSetWord* Words();
+	const BitSetWord* Words() const;
+
+	static constexpr size_t WordCount() { return WORD_COUNT; }
+	static constexpr size_t Size() { return tBitCount; }
+
+private:
+
+	static constexpr size_t WORD_COUNT = Detail::BitSetWordCount(tBitCount);
+
+	BitSetWord m_Words[WORD_COUNT] = {};
+};
+
+template< size_t tBitCount >
+BitSet<tBitCount> operator&(BitSet<tBitCount> left, const BitSet<tBitCount>& right);
+
+template< size_t tBitCount >
+BitSet<tBitCount> operator|(BitSet<tBitCount> left, const BitSet<tBitCount>& right);
+
+template< size_t tBitCount >
+BitSet<tBitCount> operator^(BitSet<tBitCount> left, const BitSet<tBitCount>& right);
+
+// Write the indices of every bit set that has all of the flags set, this is the archetype matching of a query.
+// returns the amount of indices written, matchingIndices must have room for bitSetCount indices
+template< size_t tBitCount >
+size_t FindBitSetsWithFlags(const BitSet<tBitCount>* bitSets, size_t bitSetCount, const BitSet<tBitCount>& flags, size_t* matchingIndices);
+
+
+// A bit set that can be resized at runtime, the words are stored in a DynamicArray.
+// The operations are the same as the BitSet, operations between two sets require both sets to have the same size.
+template< typename Allocator = CppAllocator >
+class DynamicBitSet {
+
+public:
+
+	// -Public API-
+
+	bool IsBitSet(size_t index) const;
+
+	void SetBit(size_t index);
+
+	void ToggleBit(size_t index);
+
+	void UnsetBit(size_t index);
+
+	void SetBitRange(size_t begin, size_t end);
+
+	// Set every bit to off, the size is kept
+	void Clear();
+
+	// Change the amount of bits of the set, the new bits are off
+	void Resize(size_t bitCount);
+
+	bool IsFlagSet(const DynamicBitSet& flags) const;
+
+	bool IsEmpty() const;
+
+	size_t CountBitsSet() const;
+
+	void GetIndividualBitIndices(size_t* bitIndices, size_t* indexCount) const;
+
+	template< typename FunctionType >
+	void ForEachSetBit(FunctionType&& function) const;
+
+	DynamicBitSet& AndNot(const DynamicBitSet& other);
+
+	DynamicBitSet& operator&=(const DynamicBitSet& other);
+	DynamicBitSet& operator|=(const DynamicBitSet& other);
+	DynamicBitSet& operator^=(const DynamicBitSet& other);
+
+	bool operator==(const DynamicBitSet& other) const;
+	bool operator!=(const DynamicBitSet& other) const;
+
+	BitSetWord* Words();
+	const BitSetWord* Words() const;
+
+	size_t WordCount() const;
+	size_t Size() const;
+
+	// -Structors-
+
+	DynamicBitSet() = default;
+	explicit DynamicBitSet(size_t bitCount, const Allocator& allocator = Allocator());
+
+private:
+
+	DynamicArray<BitSetWord, Allocator> m_Words;
+	size_t m_BitCount = 0;
+};
+
+
+// -Implementation-
+
+template< size_t tBitCount >
+bool BitSet<tBitCount>::IsBitSet(size_t index) const {
+	MIST_ASSERT(index < tBitCount);
+	return ((m_Words[index / BITS_PER_BITSET_WORD] >> (index % BITS_PER_BITSET_WORD)) & 1) != 0;
+}
+
+template< size_t tBitCount >
+void BitSet<tBitCount>::SetBit(size_t index) {
+	MIST_ASSERT(index < tBitCount);
+	m_Words[index / BITS_PER_BITSET_WORD] |= BitSetWord(1) << (index % BITS_PER_BITSET_WORD);
+}
+
+template< size_t tBitCount >
+void BitSet<tBitCount>::ToggleBit(size_t index) {
+	MIST_ASSERT(index < tBitCount);
+	m_Words[index / BITS_PER_BITSET_WORD] ^= BitSetWord(1) << (index % BITS_PER_BITSET_WORD);
+}
+
+template< size_t tBitCount >
+void BitSet<tBitCount>::UnsetBit(size_t index) {
+	MIST_ASSERT(index < tBitCount);
+	m_Words[index / BITS_PER_BITSET_WORD] &= ~(BitSetWord(1) << (index % BITS_PER_BITSET_WORD));
+}
+
+template< size_t tBitCount >
+void BitSet<tBitCount>::SetBitRange(size_t begin, size_t end) {
+	MIST_ASSERT(end <= tBitCount);
+	MIST_ASSERT(begin < end);
+	Detail::BitWordsSetRange(m_Words, begin, end);
+}
+
+template< size_t tBitCount >
+void BitSet<tBitCount>::Clear() {
+	memset(m_Words, 0, sizeof(m_Words));
+}
+
+template< size_t tBitCount >
+bool BitSet<tBitCount>::IsFlagSet(const BitSet& flags) const {
+	return Detail::BitWordsContains(m_Words, flags.m_Words, WORD_COUNT);
+}
+
+template< size_t tBitCount >
+bool BitSet<tBitCount>::IsEmpty() const {
+	return Detail::BitWordsIsEmpty(m_Words, WORD_COUNT);
+}
+
+template< size_t tBitCount >
+size_t BitSet<tBitCount>::CountBitsSet() const {
+	return Detail::BitWordsCountBitsSet(m_Words, WORD_COUNT);
+}
+
+template< size_t tBitCount >
+void BitSet<tBitCount>::GetIndividualBitIndices(size_t* bitIndices, size_t* indexCount) const {
+	Detail::BitWordsGetIndices(m_Words, WORD_COUNT, bitIndices, indexCount);
+}
+
+template< size_t tBitCount >
+template< typename FunctionType >
+void BitSet<tBitCount>::ForEachSetBit(FunctionType&& function) const {
+	Detail::BitWordsForEachSetBit(m_Words, WORD_COUNT, function);
+}
+
+template< size_t tBitCount >
+BitSet<tBitCount>& BitSet<tBitCount>::AndNot(const BitSet& other) {
+	Detail::BitWordsAndNot(m_Words, other.m_Words, WORD_COUNT);
+	return *this;
+}
+
+template< size_t tBitCount >
+BitSet<tBitCount>& BitSet<tBitCount>::operator&=(const BitSet& other) {
+	Detail::BitWordsAnd(m_Words, other.m_Words, WORD_COUNT);
+	return *this;
+}
+
+template< size_t tBitCount >
+BitSet<tBitCount>& BitSet<tBitCount>::operator|=(const BitSet& other) {
+	Detail::BitWordsOr(m_Words, other.m_Words, WORD_COUNT);
+	return *this;
+}
+
+template< size_t tBitCount >
+BitSet<tBitCount>& BitSet<tBitCount>::operator^=(const BitSet& other) {
+	Detail::BitWordsXor(m_Words, other.m_Words, WORD_COUNT);
+	return *this;
+}
+
+template< size_t tBitCount >
+bool BitSet<tBitCount>::operator==(const BitSet& other) const {
+	return memcmp(m_Words, other.m_Words, sizeof(m_Words)) == 0;
+}
+
+template< size_t tBitCount >
+bool BitSet<tBitCount>::operator!=(const BitSet& other) const {
+	return (*this == other) == false;
+}
+
+template< size_t tBitCount >
+BitSetWord* BitSet<tBitCount>::Words() {
+	return m_Words;
+}
+
+template< size_t tBitCount >
+const BitSetWord* BitSet<tBitCount>::Words() const {
+	return m_Words;
+}
+
+template< size_t tBitCount >
+BitSet<tBitCount> operator&(BitSet<tBitCount> left, const BitSet<tBitCount>& right) {
+	return left &= right;
+}
+
+template< size_t tBitCount >
+BitSet<tBitCount> operator|(BitSet<tBitCount> left, const BitSet<tBitCount>& right) {
+	return left |= right;
+}
+
+template< size_t tBitCount >
+BitSet<tBitCount> operator^(BitSet<tBitCount> left, const BitSet<tBitCount>& right) {
+	return left ^= right;
+}
+
+template< size_t tBitCount >
+size_t FindBitSetsWithFlags(const BitSet<tBitCount>* bitSets, size_t bitSetCount, const BitSet<tBitCount>& flags, size_t* matchingIndices) {
+	MIST_ASSERT(bitSets != nullptr || bitSetCount == 0);
+	MIST_ASSERT(matchingIndices != nullptr);
+
+	size_t matchingCount = 0;
+	for (size_t i = 0; i < bitSetCount; ++i) {
+		// @Detail: Write the index unconditionally and only advance on a match, this avoids a hard to predict branch
+		matchingIndices[matchingCount] = i;
+		matchingCount += bitSets[i].IsFlagSet(flags) ? 1 : 0;
+	}
+	return matchingCount;
+}
+
+
+template< typename Allocator >
+bool DynamicBitSet<Allocator>::IsBitSet(size_t index) const {
+	MIST_ASSERT(index < m_BitCount);
+	return ((m_Words.AsRawArray()[index / BITS_PER_BITSET_WORD] >> (index % BITS_PER_BITSET_WORD)) & 1) != 0;
+}
+
+template< typename Allocator >
+void DynamicBitSet<Allocator>::SetBit(size_t index) {
+	MIST_ASSERT(index < m_BitCount);
+	m_Words[index / BITS_PER_BITSET_WORD] |= BitSetWord(1) << (index % BITS_PER_BITSET_WORD);
+}
+
+template< typename Allocator >
+void DynamicBitSet<Allocator>::ToggleBit(size_t index) {
+	MIST_ASSERT(index < m_BitCount);
+	m_Words[index / BITS_PER_BITSET_WORD] ^= BitSetWord(1) << (index % BITS_PER_BITSET_WORD);
+}
+
+template< typename Allocator >
+void DynamicBitSet<Allocator>::UnsetBit(size_t index) {
+	MIST_ASSERT(index < m_BitCount);
+	m_Words[index / BITS_PER_BITSET_WORD] &= ~(BitSetWord(1) << (index % BITS_PER_BITSET_WORD));
+}
+
+template< typename Allocator >
+void DynamicBitSet<Allocator>::SetBitRange(size_t begin, size_t end) {
+	MIST_ASSERT(end <= m_BitCount);
+	MIST_ASSERT(begin < end);
+	Detail::BitWordsSetRange(m_Words.AsRawArray(), begin, end);
+}
+
+template< typename Allocator >
+void DynamicBitSet<Allocator>::Clear() {
+	if (m_Words.Size() > 0) {
+		memset(m_Words.AsRawArray(), 0, m_Words.Size() * sizeof(BitSetWord));
+	}
+}
+
+template< typename Allocator >
+void DynamicBitSet<Allocator>::Resize(size_t bitCount) {
+
+	size_t wordCount = Detail::BitSetWordCount(bitCount);
+	if (wordCount == 0) {
+		m_Words.Clear();
+	}
+	else {
+		m_Words.Resize(wordCount, BitSetWord(0));
+
+		// Turn off the bits that were removed from the last word
+		size_t lastWordBits = bitCount % BITS_PER_BITSET_WORD;
+		if (lastWordBits != 0) {
+			m_Words[wordCount - 1] &= (BitSetWord(1) << lastWordBits) - 1;
+		}
+	}
+	m_BitCount = bitCount;
+}
+
+template< typename Allocator >
+bool DynamicBitSet<Allocator>::IsFlagSet(const DynamicBitSet& flags) const {
+	MIST_ASSERT(flags.m_BitCount == m_BitCount);
+	return Detail::BitWordsContains(m_Words.AsRawArray(), flags.m_Words.AsRawArray(), m_Words.Size());
+}
+
+template< typename Allocator >
+bool DynamicBitSet<Allocator>::IsEmpty() const {
+	return Detail::BitWordsIsEmpty(m_Words.AsRawArray(), m_Words.Size());
+}
+
+template< typename Allocator >
+size_t DynamicBitSet<Allocator>::CountBitsSet() const {
+	return Detail::BitWordsCountBitsSet(m_Words.AsRawArray(), m_Words.Size());
+}
+
+template< typename Allocator >
+void DynamicBitSet<Allocator>::GetIndividualBitIndices(size_t* bitIndices, size_t* indexCount) const {
+	Detail::BitWordsGetIndices(m_Words.AsRawArray(), m_Words.Size(), bitIndices, indexCount);
+}
+
+template< typename Allocator >
+template< typename FunctionType >
+void DynamicBitSet<Allocator>::ForEachSetBit(FunctionType&& function) const {
+	Detail::BitWordsForEachSetBit(m_Words.AsRawArray(), m_Words.Size(), function);
+}
+
+template< typename Allocator >
+DynamicBitSet<Allocator>& DynamicBitSet<Allocator>::AndNot(const DynamicBitSet& other) {
+	MIST_ASSERT(other.m_BitCount == m_BitCount);
+	Detail::BitWordsAndNot(m_Words.AsRawArray(), other.m_Words.AsRawArray(), m_Words.Size());
+	return *this;
+}
+
+template< typename Allocator >
+DynamicBitSet<Allocator>& DynamicBitSet<Allocator>::operator&=(const DynamicBitSet& other) {
+	MIST_ASSERT(other.m_BitCount == m_BitCount);
+	Detail::BitWordsAnd(m_Words.AsRawArray(), other.m_Words.AsRawArray(), m_Words.Size());
+	return *this;
+}
+
+template< typename Allocator >
+DynamicBitSet<Allocator>& DynamicBitSet<Allocator>::operator|=(const DynamicBitSet& other) {
+	MIST_ASSERT(other.m_BitCount == m_BitCount);
+	Detail::BitWordsOr(m_Words.AsRawArray(), other.m_Words.AsRawArray(), m_Words.Size());
+	return *this;
+}
+
+template< typename Allocator >
+DynamicBitSet<Allocator>& DynamicBitSet<Allocator>::operator^=(const DynamicBitSet& other) {
+	MIST_ASSERT(other.m_BitCount == m_BitCount);
+	Detail::BitWordsXor(m_Words.AsRawArray(), other.m_Words.AsRawArray(), m_Words.Size());
+	return *this;
+}
+
+template< typename Allocator >
+bool DynamicBitSet<Allocator>::operator==(const DynamicBitSet& other) const {
+	if (other.m_BitCount != m_BitCount) {
+		return false;
+	}
+	return m_BitCount == 0 || memcmp(m_Words.AsRawArray(), other.m_Words.AsRawArray(), m_Words.Size() * sizeof(BitSetWord)) == 0;
+}
+
+template< typename Allocator >
+bool DynamicBitSet<Allocator>::operator!=(const DynamicBitSet& other) const {
+	return (*this == other) == false;
+}
+
+template< typename Allocator >
+BitSetWord* DynamicBitSet<Allocator>::Words() {
+	return m_Words.AsRawArray();
+}
+
+template< typename Allocator >
+const BitSetWord* DynamicBitSet<Allocator>::Words() const {
+	return m_Words.AsRawArray();
+}
+
+template< typename Allocator >
+size_t DynamicBitSet<Allocator>::WordCount() const {
+	return m_Words.Size();
+}
+
+template< typename Allocator >
+size_t DynamicBitSet<Allocator>::Size() const {
+	return m_BitCount;
+}
+
+template< typename Allocator >
+DynamicBitSet<Allocator>::DynamicBitSet(size_t bitCount, const Allocator& allocator)
+	: m_Words(allocator) {
+
+	Resize(bitCount);
+}
+
+MIST_NAMESPACE_END
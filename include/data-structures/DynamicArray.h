@@ -2,22 +2,78 @@
 
 #include <Mist_Common/include/UtilityMacros.h>
 #include "../allocators/CppAllocator.h"
+#include "../allocators/AllocatorStorage.h"
+#include "GrowthPolicy.h"
+#include "../utility/TypeTraits.h"
 #include <cstdint>
+#include <iterator>
+#include <memory>
+#include <cstring>
 #include <type_traits>
 
 MIST_NAMESPACE
 
-template< typename ValueType, typename Allocator = CppAllocator >
-class DynamicArray {
+namespace Detail {
+	// Construct count values in place with the same arguments
+	// @Detail: The arguments are not forwarded as they're used for every value, moving them would
+	//  leave all but the first value with moved from arguments
+	template< typename ValueType, typename... WriteValues >
+	void ConstructValues(ValueType* values, size_t count, std::false_type /*isTriviallyCopyable*/, WriteValues&... writeValues) {
+		for (size_t i = 0; i < count; ++i) {
+			new (values + i) ValueType(writeValues...);
+		}
+	}
+
+	// Trivially copyable types are constructed once and copied into the rest of the range
+	template< typename ValueType, typename... WriteValues >
+	void ConstructValues(ValueType* values, size_t count, std::true_type /*isTriviallyCopyable*/, WriteValues&... writeValues) {
+		// Value initializing a trivial type is simply zeroing it out, do it all in one go
+		if (sizeof...(WriteValues) == 0 && std::is_trivial<ValueType>::value) {
+			memset(static_cast<void*>(values), 0, count * sizeof(ValueType));
+		}
+		else {
+			const ValueType value(writeValues...);
+			std::uninitialized_fill_n(values, count, value);
+		}
+	}
+}
+
+// The growth policy determines how much memory is reserved when the array runs out of space.
+// See GrowthPolicy.h for the available policies.
+// The allocator instance is kept by the array, stateless allocators don't take any space.
+// The values are aligned to tAlignment, or to the alignment of the value type if it's bigger.
+// @Detail: Over aligned arrays use the allocator's aligned API, see AlignedDynamicArray.
+template< typename ValueType, typename Allocator = CppAllocator, typename GrowthPolicy = DefaultGrowth, size_t tAlignment = alignof(ValueType) >
+class DynamicArray : private Detail::AllocatorStorage<Allocator> {
 
 public:
 
+	// The alignment of the first value of the array
+	static constexpr size_t ALIGNMENT = tAlignment > alignof(ValueType) ? tAlignment : alignof(ValueType);
+	static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "The alignment of a dynamic array must be a power of two.");
+
 	// -Public API-
 
 	// Write a value into the array at the back
 	template< typename... WriteType >
 	void InsertAsLast(WriteType&&... writeValue);
 
+	// Copy a range of values into the back of the array
+	// @Detail: The memory is only reserved once for the whole range, this is prefered over
+	//  calling InsertAsLast in a loop when the amount of items is known.
+	template< typename IteratorType >
+	void InsertRange(IteratorType begin, IteratorType end);
+
+	// Construct count values in place at the back of the array using the passed in arguments
+	// @Detail: The memory is only reserved once for all the values.
+	template< typename... WriteValues >
+	void AppendN(size_t count, WriteValues&&... writeValues);
+
+	// Grow the array by count values without constructing them, returns the first of the new values.
+	// @Detail: Only trivially copyable values can be left uninitialized, they must be written before they're read.
+	//  This is used to copy values straight into the array, such as when loading them from a file.
+	ValueType* AppendUninitialized(size_t count);
+
 	// Remove the last element of the array.
 	// @Detail: the array will not shrink
 	void RemoveLast();
@@ -51,11 +107,15 @@ public:
 	ValueType* LastValue();
 
 	ValueType* AsRawArray();
+	const ValueType* AsRawArray() const;
 
 	size_t Size() const;
 
 	size_t ReservedSize() const;
 
+	// Retrieve the allocator instance used by the array
+	using Detail::AllocatorStorage<Allocator>::GetAllocator;
+
 	// Remove the contents of the array, this completely removes
 	// everything in the array and references to those items will be lost
 	void Clear();
@@ -64,6 +124,8 @@ public:
 
 	ValueType* begin();
 	ValueType* end();
+	const ValueType* begin() const;
+	const ValueType* end() const;
 
 	// -Structors-
 
@@ -71,7 +133,10 @@ public:
 	// Create a dynamic array with the desired reserved space, you cannot invoke
 	// operator[] as no elements were pushed into the array
 	// @Detail: Internally, this just invokes ReserveAdditional.
-	DynamicArray(size_t desiredReservedSpace);
+	DynamicArray(size_t desiredReservedSpace, const Allocator& allocator = Allocator());
+
+	// Create an empty dynamic array that uses the allocator instance for all of it's memory
+	explicit DynamicArray(const Allocator& allocator);
 
 	~DynamicArray();
 
@@ -86,19 +151,37 @@ public:
 
 private:
 
-	static constexpr size_t GROWTH_BLOCK_SIZE = 5;
+	// Assure that we have enough reserved space for the required amount of items,
+	// this grows the memory using the growth policy
+	void GrowToFit(size_t requiredCount);
+
+	// Move the items to a block of newMemorySize bytes.
+	// @Detail: Trivially relocatable types are simply reallocated, other types are move constructed
+	//  into the new block and destroyed in the old block as a realloc would bitwise move them.
+	void Reallocate(size_t newMemorySize);
+
+	// Destroy the items from index to the end of the array, this doesn't release any memory
+	void DestroyFrom(size_t index);
 
 	void* m_Memory = nullptr;
 	size_t m_ItemCount = 0;
 	size_t m_MemorySize = 0;
 };
 
+// A dynamic array aligned for SIMD loads and stores over AsRawArray, such as the AVX_ALIGNMENT or CACHE_LINE_ALIGNMENT
+// @Example: An array of floats that can be loaded with aligned AVX loads would look like:
+//
+//		AlignedDynamicArray<float, AVX_ALIGNMENT> weights;
+//		__m256 first = _mm256_load_ps(weights.AsRawArray());
+template< typename ValueType, size_t tAlignment = CACHE_LINE_ALIGNMENT, typename Allocator = CppAllocator, typename GrowthPolicy = DefaultGrowth >
+using AlignedDynamicArray = DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>;
+
 // -Implementation-
 
 
-template< typename ValueType, typename Allocator >
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
 template< typename... WriteType >
-void DynamicArray<ValueType, Allocator>::InsertAsLast(WriteType&&... writeValue) {
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::InsertAsLast(WriteType&&... writeValue) {
 
 #if MIST_DEBUG
 	size_t previousMemorySize = m_MemorySize;
@@ -106,8 +189,8 @@ void DynamicArray<ValueType, Allocator>::InsertAsLast(WriteType&&... writeValue)
 
 	// Assure that we have enough space
 	if (m_MemorySize < (m_ItemCount + 1) * sizeof(ValueType)) {
-		ReserveAdditional(GROWTH_BLOCK_SIZE);
-		
+		GrowToFit(m_ItemCount + 1);
+
 #if MIST_DEBUG
 		/// Assure that the memory size actually grew after calling ReserveAdditional
 		MIST_ASSERT(m_MemorySize > previousMemorySize);
@@ -130,8 +213,58 @@ void DynamicArray<ValueType, Allocator>::InsertAsLast(WriteType&&... writeValue)
 	m_ItemCount++;
 }
 
-template< typename ValueType, typename Allocator >
-void DynamicArray<ValueType, Allocator>::RemoveLast() {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+template< typename IteratorType >
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::InsertRange(IteratorType begin, IteratorType end) {
+
+	size_t rangeSize = static_cast<size_t>(std::distance(begin, end));
+	if (rangeSize == 0) {
+		return;
+	}
+
+	GrowToFit(m_ItemCount + rangeSize);
+
+	// Copy construct the values in place, we already have the space so we can skip InsertAsLast's checks
+	ValueType* values = reinterpret_cast<ValueType*>(m_Memory) + m_ItemCount;
+	for (; begin != end; ++begin, ++values) {
+		new (values) ValueType(*begin);
+	}
+
+	m_ItemCount += rangeSize;
+}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+template< typename... WriteValues >
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::AppendN(size_t count, WriteValues&&... writeValues) {
+
+	if (count == 0) {
+		return;
+	}
+
+	GrowToFit(m_ItemCount + count);
+
+	ValueType* values = reinterpret_cast<ValueType*>(m_Memory) + m_ItemCount;
+	Detail::ConstructValues(values, count, std::integral_constant<bool, std::is_trivially_copyable<ValueType>::value>(), writeValues...);
+
+	m_ItemCount += count;
+}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::AppendUninitialized(size_t count) {
+
+	static_assert(std::is_trivially_copyable<ValueType>::value, "Only trivially copyable values can be appended uninitialized.");
+
+	if (count > 0) {
+		GrowToFit(m_ItemCount + count);
+	}
+
+	ValueType* values = reinterpret_cast<ValueType*>(m_Memory) + m_ItemCount;
+	m_ItemCount += count;
+	return values;
+}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::RemoveLast() {
 
 	// Decrement our item count and call the destructor on the last item
 	ValueType* lastItem = LastValue();
@@ -141,25 +274,24 @@ void DynamicArray<ValueType, Allocator>::RemoveLast() {
 
 #if MIST_DEBUG
 	// Scramble the item to assure that it isn't reused and assure that we crash the program
-	memset(lastItem, 0xDB, sizeof(ValueType));
+	memset(static_cast<void*>(lastItem), 0xDB, sizeof(ValueType));
 #endif
 }
 
-template< typename ValueType, typename Allocator >
-void DynamicArray<ValueType, Allocator>::ShrinkToSize() {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::ShrinkToSize() {
 
 	// If we're already the right size, don't do anything, this is to avoid doing extra work
 	if (m_MemorySize == m_ItemCount * sizeof(ValueType)) {
 		return;
 	}
 
-	m_Memory = Allocator::template Realloc(m_Memory, m_ItemCount * sizeof(ValueType));
-	m_MemorySize = m_ItemCount * sizeof(ValueType);
+	Reallocate(m_ItemCount * sizeof(ValueType));
 }
 
-template< typename ValueType, typename Allocator >
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
 template< typename... WriteValues >
-void DynamicArray<ValueType, Allocator>::Resize(size_t desiredSize, WriteValues&&... defaultValues) {
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::Resize(size_t desiredSize, WriteValues&&... defaultValues) {
 
 	// Call Clear if you want to empty out the array
 	MIST_ASSERT(desiredSize > 0);
@@ -170,39 +302,93 @@ void DynamicArray<ValueType, Allocator>::Resize(size_t desiredSize, WriteValues&
 	}
 	// If the new size is larger than the current size, add elements until we've reached that size
 	else if (desiredSize > m_ItemCount) {
-		size_t newItemCount = desiredSize - m_ItemCount;
-		for (size_t i = 0; i < newItemCount; ++i) {
-			InsertAsLast(std::forward<WriteValues>(defaultValues)...);
-		}
+		AppendN(desiredSize - m_ItemCount, std::forward<WriteValues>(defaultValues)...);
 	}
 	// If the new size is smaller than the current size, remove elements until we've reache that size
 	// if (desiredSize < m_ItemCount)
 	else {
-		size_t removedItemCount = m_ItemCount - desiredSize;
-		for (size_t i = 0; i < removedItemCount; ++i) {
-			RemoveLast();
-		}
+		DestroyFrom(desiredSize);
 	}
 
 	MIST_ASSERT(m_ItemCount == desiredSize);
 }
 
-template< typename ValueType, typename Allocator >
-void DynamicArray<ValueType, Allocator>::ReserveAdditional(size_t size) {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::ReserveAdditional(size_t size) {
 
 	// Assure that we reserve the byte memory, not just the count of items
-	m_Memory = Allocator:: template Realloc(m_Memory, m_MemorySize + size * sizeof(ValueType));
-	m_MemorySize += size * sizeof(ValueType);
+	Reallocate(m_MemorySize + size * sizeof(ValueType));
 }
 
-template< typename ValueType, typename Allocator >
-ValueType& DynamicArray<ValueType, Allocator>::operator[](size_t index) {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::GrowToFit(size_t requiredCount) {
+
+	size_t reservedCount = ReservedSize();
+	if (reservedCount >= requiredCount) {
+		return;
+	}
+
+	size_t newCapacity = GrowthPolicy::NextCapacity(reservedCount, requiredCount);
+	MIST_ASSERT(newCapacity >= requiredCount);
+	ReserveAdditional(newCapacity - reservedCount);
+}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::Reallocate(size_t newMemorySize) {
+
+	MIST_ASSERT(newMemorySize >= m_ItemCount * sizeof(ValueType));
+
+	// If there are no items to move or they can be moved bitwise, let the allocator move the block for us
+	if (IsTriviallyRelocatable<ValueType>::value || m_ItemCount == 0) {
+		m_Memory = Detail::ReallocateAligned(GetAllocator(), m_Memory, newMemorySize, ALIGNMENT);
+		m_MemorySize = newMemorySize;
+		return;
+	}
+
+	// Move every item into the new block and destroy the old ones before releasing the old block
+	ValueType* newValues = reinterpret_cast<ValueType*>(Detail::AllocateAligned(GetAllocator(), newMemorySize, ALIGNMENT));
+	ValueType* oldValues = reinterpret_cast<ValueType*>(m_Memory);
+	for (size_t i = 0; i < m_ItemCount; ++i) {
+		new (newValues + i) ValueType(std::move(oldValues[i]));
+		oldValues[i].ValueType::~ValueType();
+	}
+
+	Detail::FreeAligned(GetAllocator(), m_Memory, ALIGNMENT);
+	m_Memory = newValues;
+	m_MemorySize = newMemorySize;
+}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::DestroyFrom(size_t index) {
+
+	MIST_ASSERT(index <= m_ItemCount);
+
+	ValueType* values = reinterpret_cast<ValueType*>(m_Memory);
+	// Trivially destructible types don't need to go through every item
+	if (std::is_trivially_destructible<ValueType>::value == false) {
+		for (size_t i = index; i < m_ItemCount; ++i) {
+			values[i].ValueType::~ValueType();
+		}
+	}
+
+#if MIST_DEBUG
+	// Scramble the items to assure that they aren't reused and assure that we crash the program
+	if (index < m_ItemCount) {
+		memset(static_cast<void*>(values + index), 0xDB, (m_ItemCount - index) * sizeof(ValueType));
+	}
+#endif
+
+	m_ItemCount = index;
+}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+ValueType& DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::operator[](size_t index) {
 
 	return *GetValue(index);
 }
 
-template< typename ValueType, typename Allocator >
-ValueType* DynamicArray<ValueType, Allocator>::GetValue(size_t index) {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::GetValue(size_t index) {
 
 	MIST_ASSERT(index < m_ItemCount);
 
@@ -210,94 +396,118 @@ ValueType* DynamicArray<ValueType, Allocator>::GetValue(size_t index) {
 	return values + index;
 }
 
-template< typename ValueType, typename Allocator >
-ValueType* DynamicArray<ValueType, Allocator>::FirstValue() {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::FirstValue() {
 
 	return GetValue(0);
 }
 
-template< typename ValueType, typename Allocator >
-ValueType* DynamicArray<ValueType, Allocator>::LastValue() {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::LastValue() {
 
 	return GetValue(m_ItemCount - 1);
 }
 
-template< typename ValueType, typename Allocator >
-ValueType* DynamicArray<ValueType, Allocator>::AsRawArray() {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::AsRawArray() {
 
 	return reinterpret_cast<ValueType*>(m_Memory);
 }
 
-template< typename ValueType, typename Allocator >
-size_t DynamicArray<ValueType, Allocator>::Size() const {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+const ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::AsRawArray() const {
+
+	return reinterpret_cast<const ValueType*>(m_Memory);
+}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+size_t DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::Size() const {
 
 	return m_ItemCount;
 }
 
-template< typename ValueType, typename Allocator >
-size_t DynamicArray<ValueType, Allocator>::ReservedSize() const {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+size_t DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::ReservedSize() const {
 
 	return m_MemorySize / sizeof(ValueType);
 }
 
-template< typename ValueType, typename Allocator >
-void DynamicArray<ValueType, Allocator>::Clear() {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+void DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::Clear() {
 
-	if (m_ItemCount == 0) {
+	// @Detail: Test the memory instead of the item count, an empty array might still have reserved memory
+	if (m_Memory == nullptr) {
 		return;
 	}
 
-	// loop through and remove all the elements
-	size_t arraySize = Size();
-	for (size_t i = 0; i < arraySize; ++i) {
-		RemoveLast();
-	}
+	DestroyFrom(0);
 
-	Allocator:: template Free(m_Memory);
+	Detail::FreeAligned(GetAllocator(), m_Memory, ALIGNMENT);
 	m_Memory = nullptr;
 	m_MemorySize = 0;
 
 	MIST_ASSERT(m_ItemCount == 0);
 }
 
-template< typename ValueType, typename Allocator >
-ValueType* DynamicArray<ValueType, Allocator>::begin() {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::begin() {
 
 	return reinterpret_cast<ValueType*>(m_Memory);
 }
 
-template< typename ValueType, typename Allocator >
-ValueType* DynamicArray<ValueType, Allocator>::end() {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::end() {
 
 	return reinterpret_cast<ValueType*>(m_Memory) + m_ItemCount;
 }
 
-template< typename ValueType, typename Allocator >
-DynamicArray<ValueType, Allocator>::DynamicArray(size_t desiredReservedSpace) {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+const ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::begin() const {
+
+	return reinterpret_cast<const ValueType*>(m_Memory);
+}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+const ValueType* DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::end() const {
+
+	return reinterpret_cast<const ValueType*>(m_Memory) + m_ItemCount;
+}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::DynamicArray(size_t desiredReservedSpace, const Allocator& allocator)
+	: Detail::AllocatorStorage<Allocator>(allocator) {
 
 	ReserveAdditional(desiredReservedSpace);
 }
 
-template< typename ValueType, typename Allocator >
-DynamicArray<ValueType, Allocator>::DynamicArray(DynamicArray&& rhs) {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::DynamicArray(const Allocator& allocator)
+	: Detail::AllocatorStorage<Allocator>(allocator) {}
+
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::DynamicArray(DynamicArray&& rhs) {
 
 	std::swap(m_Memory, rhs.m_Memory);
 	std::swap(m_MemorySize, rhs.m_MemorySize);
 	std::swap(m_ItemCount, rhs.m_ItemCount);
+	// The memory belongs to the allocator, it has to follow the memory
+	std::swap(GetAllocator(), rhs.GetAllocator());
 }
 
-template< typename ValueType, typename Allocator >
-DynamicArray<ValueType, Allocator>& DynamicArray<ValueType, Allocator>::operator=(DynamicArray&& rhs) {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>& DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::operator=(DynamicArray&& rhs) {
 
 	std::swap(m_Memory, rhs.m_Memory);
 	std::swap(m_MemorySize, rhs.m_MemorySize);
 	std::swap(m_ItemCount, rhs.m_ItemCount);
+	// The memory belongs to the allocator, it has to follow the memory
+	std::swap(GetAllocator(), rhs.GetAllocator());
 
 	return *this;
 }
 
-template< typename ValueType, typename Allocator >
-DynamicArray<ValueType, Allocator>::~DynamicArray() {
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>::~DynamicArray() {
 
 	Clear();
 }
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include <cstdint>
+
+MIST_NAMESPACE
+
+// Growth policies determine how much a dynamically sized container grows by
+// when it runs out of reserved space.
+// A growth policy only has to provide a static NextCapacity method that takes the current capacity
+// and the minimum required capacity (both in elements) and returns the new capacity.
+// The returned capacity must always be greater or equal to the required capacity.
+
+// Grow the capacity by tNumerator / tDenominator every time we run out of space.
+// @Detail: This gives us amortized O(1) insertions, 3/2 is the default as it allows the allocator
+//  to reuse previously freed blocks more often than a factor of 2.
+template< size_t tNumerator = 3, size_t tDenominator = 2, size_t tMinimumCapacity = 4 >
+struct GeometricGrowth {
+	static_assert(tNumerator > tDenominator, "The growth factor must be larger than 1 or the container will never grow.");
+	static_assert(tDenominator > 0, "The growth factor cannot have a denominator of 0.");
+
+	static size_t NextCapacity(size_t currentCapacity, size_t requiredCapacity);
+};
+
+// Doubles the capacity every time we run out of space
+using DoublingGrowth = GeometricGrowth<2, 1>;
+
+// Grow the capacity by a fixed amount of elements every time we run out of space.
+// @Detail: This was the original behaviour of the dynamic array, pushing n elements
+//  results in O(n / tBlockSize) reallocations. Prefer the geometric growth unless memory is very tight.
+template< size_t tBlockSize = 5 >
+struct FixedGrowth {
+	static_assert(tBlockSize > 0, "A fixed growth of 0 would never grow the container.");
+
+	static size_t NextCapacity(size_t currentCapacity, size_t requiredCapacity);
+};
+
+using DefaultGrowth = GeometricGrowth<>;
+
+
+// -Implementation-
+
+template< size_t tNumerator, size_t tDenominator, size_t tMinimumCapacity >
+size_t GeometricGrowth<tNumerator, tDenominator, tMinimumCapacity>::NextCapacity(size_t currentCapacity, size_t requiredCapacity) {
+
+	size_t newCapacity = currentCapacity * tNumerator / tDenominator;
+	// Small capacities might not grow at all with the integer division, assure that we always grow
+	if (newCapacity < tMinimumCapacity) {
+		newCapacity = tMinimumCapacity;
+	}
+
+	// If we still don't have enough room, simply grow to the required size
+	return newCapacity < requiredCapacity ? requiredCapacity : newCapacity;
+}
+
+template< size_t tBlockSize >
+size_t FixedGrowth<tBlockSize>::NextCapacity(size_t currentCapacity, size_t requiredCapacity) {
+
+	size_t newCapacity = currentCapacity + tBlockSize;
+	return newCapacity < requiredCapacity ? requiredCapacity : newCapacity;
+}
+
+MIST_NAMESPACE_END
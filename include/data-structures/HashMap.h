@@ -0,0 +1,803 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../allocators/CppAllocator.h"
+#include "../allocators/AllocatorStorage.h"
+#include "../utility/BitManipulations.h"
+#include "../utility/Hash.h"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIST_HASH_MAP_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MIST_HASH_MAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+MIST_NAMESPACE
+
+namespace Detail {
+
+	// Every slot of the hash map has a control byte, a full slot stores the 7 lowest bits of the key's hash
+	// and the empty and deleted slots have their sign bit set.
+	constexpr int8_t HASH_CONTROL_EMPTY = -128;
+	constexpr int8_t HASH_CONTROL_DELETED = -2;
+
+	// The amount of control bytes compared at once, a group is also the unit of probing
+	constexpr size_t HASH_GROUP_WIDTH = 16;
+
+	// A group of control bytes matched with a single SSE2 or NEON comparison,
+	// the matches are returned as a mask with one bit per slot of the group.
+	class HashControlGroup {
+
+	public:
+
+		// The controls must be aligned to HASH_GROUP_WIDTH
+		explicit HashControlGroup(const int8_t* controls);
+
+		// The full slots with the same 7 bits of hash
+		uint32_t Match(int8_t hashBits) const;
+
+		uint32_t MatchEmpty() const;
+
+		uint32_t MatchEmptyOrDeleted() const;
+
+	private:
+
+#if MIST_HASH_MAP_SSE2
+		__m128i m_Controls;
+#elif MIST_HASH_MAP_NEON
+		static uint32_t ToMask(uint8x16_t matches);
+
+		int8x16_t m_Controls;
+#else
+		int8_t m_Controls[HASH_GROUP_WIDTH];
+#endif
+	};
+
+	// Hint the processor to load the cache line of the address, lookups use this to overlap their cache misses
+	inline void PrefetchRead(const void* address) {
+
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address, 0, 3);
+#elif MIST_HASH_MAP_SSE2
+		_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+		(void)address;
+#endif
+	}
+
+	// Determine if a functor is transparent and accepts other types than the key type
+	template< typename FunctorType, typename Enable = void >
+	struct IsTransparentFunctor : std::false_type {};
+
+	template< typename FunctorType >
+	struct IsTransparentFunctor<FunctorType, typename std::conditional<true, void, typename FunctorType::is_transparent>::type> : std::true_type {};
+}
+
+template< typename KeyType, typename ValueType >
+struct HashMapEntry {
+	KeyType m_Key;
+	ValueType m_Value;
+};
+
+// A flat open addressing hash map, the entries are stored in a single array next to an array of control bytes.
+// A lookup hashes the key once, loads a group of 16 control bytes and compares all of them to 7 bits of the hash
+// with a single SSE2 or NEON instruction. Only the entries with matching bits are compared to the key,
+// this makes most lookups cost a single cache miss in the control bytes and a single cache miss in the entries.
+// @Detail: The capacity is a power of two of at least a group, the map grows once it's 7/8th full.
+//  Removed entries leave a tombstone in groups that are full, the tombstones are reused by the insertions.
+//  Inserting entries might rehash the map, which invalidates the pointers to the values and the iterators.
+//  The hasher and the key comparison are default constructed for every use, they're expected to be stateless.
+//  When both are transparent (Such as Hash<std::string> and std::equal_to<>) the map can be searched with
+//  other types than the key type, a string map can be searched with a string literal without creating a string.
+// @Example: A map of entity names would look like:
+//
+//		HashMap<uint32_t, std::string> names;
+//		names.Reserve(entityCount);
+//		names.Insert(entity, "Player");
+//		if (std::string* name = names.Find(entity)) { ... }
+template< typename KeyType, typename ValueType, typename Hasher = Hash<KeyType>, typename KeyEqual = std::equal_to<>, typename Allocator = CppAllocator >
+class HashMap : private Detail::AllocatorStorage<Allocator> {
+
+	// @Template Condition: Heterogeneous lookups require both the hasher and the key comparison to be transparent
+	template< typename LookupType >
+	using EnableLookup = typename std::enable_if<std::is_same<LookupType, KeyType>::value == false
+		&& Detail::IsTransparentFunctor<Hasher>::value && Detail::IsTransparentFunctor<KeyEqual>::value>::type;
+
+public:
+
+	using Entry = HashMapEntry<KeyType, ValueType>;
+
+	class Iterator;
+
+	// -Public API-
+
+	// Insert a value constructed from the arguments if the key isn't in the map yet.
+	// Returns the value of the key, if the key was already in the map the existing value is returned untouched.
+	template< typename... WriteTypes >
+	ValueType* Insert(const KeyType& key, WriteTypes&&... writeValues);
+
+	template< typename... WriteTypes >
+	ValueType* Insert(KeyType&& key, WriteTypes&&... writeValues);
+
+	// Retrieve the value of the key, a value initialized value is inserted if the key isn't in the map
+	ValueType& operator[](const KeyType& key);
+
+	// Returns nullptr if the key isn't in the map
+	ValueType* Find(const KeyType& key);
+	const ValueType* Find(const KeyType& key) const;
+
+	template< typename LookupType, typename TemplateCondition = EnableLookup<LookupType> >
+	ValueType* Find(const LookupType& key);
+
+	template< typename LookupType, typename TemplateCondition = EnableLookup<LookupType> >
+	const ValueType* Find(const LookupType& key) const;
+
+	// Find the values of count keys at once, the value of keys[i] is written in values[i] or nullptr if it isn't in the map.
+	// Returns the amount of keys found.
+	// @Detail: The keys are hashed and their groups prefetched in batches before they're probed,
+	//  the cache misses of the batch overlap instead of being paid one after the other.
+	template< typename LookupType >
+	size_t FindBatch(const LookupType* keys, size_t count, ValueType** values);
+
+	bool Contains(const KeyType& key) const;
+
+	template< typename LookupType, typename TemplateCondition = EnableLookup<LookupType> >
+	bool Contains(const LookupType& key) const;
+
+	// Remove the entry of the key, returns false if the key isn't in the map
+	bool Remove(const KeyType& key);
+
+	template< typename LookupType, typename TemplateCondition = EnableLookup<LookupType> >
+	bool Remove(const LookupType& key);
+
+	// Reserve enough space for count entries, the map won't grow until it holds more than count entries
+	void Reserve(size_t count);
+
+	size_t Size() const;
+
+	// The amount of slots of the map, only 7/8th of the slots can be used before the map grows
+	size_t ReservedSize() const;
+
+	// Retrieve the allocator instance used by the map
+	using Detail::AllocatorStorage<Allocator>::GetAllocator;
+
+	// Remove every entry of the map and release it's memory
+	void Clear();
+
+	// -Iterators-
+
+	// The entries are visited in the order of their slots, the keys must not be modified
+	Iterator begin();
+	Iterator end();
+
+	// -Types-
+
+	class Iterator {
+
+	public:
+
+		Iterator operator++();
+
+		bool operator!=(const Iterator& rhs) const;
+		bool operator==(const Iterator& rhs) const;
+
+		Entry& operator*();
+		Entry* operator->();
+
+	private:
+
+		friend class HashMap;
+
+		Iterator(const int8_t* controls, Entry* entries, size_t index, size_t capacity);
+
+		void SkipFreeSlots();
+
+		const int8_t* m_Controls;
+		Entry* m_Entries;
+		size_t m_Index;
+		size_t m_Capacity;
+	};
+
+	// -Structors-
+
+	HashMap() = default;
+	// Create a hash map with enough space for count entries
+	// @Detail: Internally, this just invokes Reserve.
+	HashMap(size_t count, const Allocator& allocator = Allocator());
+
+	// Create an empty hash map that uses the allocator instance for all of it's memory
+	explicit HashMap(const Allocator& allocator);
+
+	~HashMap();
+
+	// Copying is disallowed to avoid accidental copying, same as the DynamicArray
+	HashMap(const HashMap&) = delete;
+	HashMap& operator=(const HashMap&) = delete;
+
+	HashMap(HashMap&&);
+	HashMap& operator=(HashMap&&);
+
+private:
+
+	static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+	static constexpr size_t ALIGNMENT = alignof(Entry) > Detail::HASH_GROUP_WIDTH ? alignof(Entry) : Detail::HASH_GROUP_WIDTH;
+	// The amount of keys hashed and prefetched at once by FindBatch
+	static constexpr size_t BATCH_SIZE = 16;
+
+	// The top bits select the group and the 7 lowest bits are stored in the control byte
+	static size_t GroupBits(uint64_t hash);
+	static int8_t ControlBits(uint64_t hash);
+
+	// The amount of entries of the capacity before the map has to grow
+	static size_t MaxLoad(size_t capacity);
+	// The offset of the entries from the control bytes
+	static size_t EntriesOffset(size_t capacity);
+
+	// Return the index of the key's slot or NOT_FOUND
+	template< typename LookupType >
+	size_t FindIndex(const LookupType& key, uint64_t hash) const;
+
+	// Return the index of the first empty or deleted slot of the hash's probe sequence
+	size_t FindFreeIndex(uint64_t hash) const;
+
+	template< typename WrittenKeyType, typename... WriteTypes >
+	ValueType* InsertKey(WrittenKeyType&& key, WriteTypes&&... writeValues);
+
+	void RemoveAt(size_t index);
+
+	// Make room for at least one more entry, either by growing or by purging the tombstones
+	void Grow();
+
+	// Move every entry into a block of newCapacity slots
+	void Rehash(size_t newCapacity);
+
+	int8_t* m_Controls = nullptr;
+	Entry* m_Entries = nullptr;
+	size_t m_ItemCount = 0;
+	size_t m_Capacity = 0;
+	// The amount of empty slots that can be filled before the map has to grow
+	size_t m_GrowthLeft = 0;
+};
+
+// -Implementation-
+
+namespace Detail {
+
+#if MIST_HASH_MAP_SSE2
+
+	inline HashControlGroup::HashControlGroup(const int8_t* controls)
+		: m_Controls(_mm_load_si128(reinterpret_cast<const __m128i*>(controls))) {}
+
+	inline uint32_t HashControlGroup::Match(int8_t hashBits) const {
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_Controls, _mm_set1_epi8(hashBits))));
+	}
+
+	inline uint32_t HashControlGroup::MatchEmpty() const {
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_Controls, _mm_set1_epi8(HASH_CONTROL_EMPTY))));
+	}
+
+	inline uint32_t HashControlGroup::MatchEmptyOrDeleted() const {
+		// The empty and deleted controls are the only ones with their sign bit set
+		return static_cast<uint32_t>(_mm_movemask_epi8(m_Controls));
+	}
+
+#elif MIST_HASH_MAP_NEON
+
+	inline HashControlGroup::HashControlGroup(const int8_t* controls)
+		: m_Controls(vld1q_s8(controls)) {}
+
+	inline uint32_t HashControlGroup::ToMask(uint8x16_t matches) {
+		// NEON has no movemask, weight every lane by it's bit and add up each half of the group
+		static const uint8_t laneBits[HASH_GROUP_WIDTH] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		uint8x16_t weighted = vandq_u8(matches, vld1q_u8(laneBits));
+		return static_cast<uint32_t>(vaddv_u8(vget_low_u8(weighted))) | (static_cast<uint32_t>(vaddv_u8(vget_high_u8(weighted))) << 8);
+	}
+
+	inline uint32_t HashControlGroup::Match(int8_t hashBits) const {
+		return ToMask(vceqq_s8(m_Controls, vdupq_n_s8(hashBits)));
+	}
+
+	inline uint32_t HashControlGroup::MatchEmpty() const {
+		return ToMask(vceqq_s8(m_Controls, vdupq_n_s8(HASH_CONTROL_EMPTY)));
+	}
+
+	inline uint32_t HashControlGroup::MatchEmptyOrDeleted() const {
+		return ToMask(vcltq_s8(m_Controls, vdupq_n_s8(0)));
+	}
+
+#else
+
+	inline HashControlGroup::HashControlGroup(const int8_t* controls) {
+		memcpy(m_Controls, controls, HASH_GROUP_WIDTH);
+	}
+
+	inline uint32_t HashControlGroup::Match(int8_t hashBits) const {
+		uint32_t mask = 0;
+		for (size_t i = 0; i < HASH_GROUP_WIDTH; ++i) {
+			mask |= static_cast<uint32_t>(m_Controls[i] == hashBits) << i;
+		}
+		return mask;
+	}
+
+	inline uint32_t HashControlGroup::MatchEmpty() const {
+		return Match(HASH_CONTROL_EMPTY);
+	}
+
+	inline uint32_t HashControlGroup::MatchEmptyOrDeleted() const {
+		uint32_t mask = 0;
+		for (size_t i = 0; i < HASH_GROUP_WIDTH; ++i) {
+			mask |= static_cast<uint32_t>(m_Controls[i] < 0) << i;
+		}
+		return mask;
+	}
+
+#endif
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+template< typename... WriteTypes >
+ValueType* HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Insert(const KeyType& key, WriteTypes&&... writeValues) {
+
+	return InsertKey(key, std::forward<WriteTypes>(writeValues)...);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+template< typename... WriteTypes >
+ValueType* HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Insert(KeyType&& key, WriteTypes&&... writeValues) {
+
+	return InsertKey(std::move(key), std::forward<WriteTypes>(writeValues)...);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+ValueType& HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::operator[](const KeyType& key) {
+
+	return *InsertKey(key);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+ValueType* HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Find(const KeyType& key) {
+
+	size_t index = FindIndex(key, Hasher()(key));
+	return index != NOT_FOUND ? &m_Entries[index].m_Value : nullptr;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+const ValueType* HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Find(const KeyType& key) const {
+
+	size_t index = FindIndex(key, Hasher()(key));
+	return index != NOT_FOUND ? &m_Entries[index].m_Value : nullptr;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+template< typename LookupType, typename TemplateCondition >
+ValueType* HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Find(const LookupType& key) {
+
+	size_t index = FindIndex(key, Hasher()(key));
+	return index != NOT_FOUND ? &m_Entries[index].m_Value : nullptr;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+template< typename LookupType, typename TemplateCondition >
+const ValueType* HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Find(const LookupType& key) const {
+
+	size_t index = FindIndex(key, Hasher()(key));
+	return index != NOT_FOUND ? &m_Entries[index].m_Value : nullptr;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+template< typename LookupType >
+size_t HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::FindBatch(const LookupType* keys, size_t count, ValueType** values) {
+
+	static_assert(std::is_same<LookupType, KeyType>::value || (Detail::IsTransparentFunctor<Hasher>::value && Detail::IsTransparentFunctor<KeyEqual>::value),
+		"Heterogeneous lookups require both the hasher and the key comparison to be transparent.");
+
+	size_t foundCount = 0;
+	if (m_Capacity == 0) {
+		for (size_t i = 0; i < count; ++i) {
+			values[i] = nullptr;
+		}
+		return foundCount;
+	}
+
+	size_t groupMask = m_Capacity / Detail::HASH_GROUP_WIDTH - 1;
+	uint64_t hashes[BATCH_SIZE];
+	for (size_t batchStart = 0; batchStart < count; batchStart += BATCH_SIZE) {
+
+		size_t batchSize = count - batchStart < BATCH_SIZE ? count - batchStart : BATCH_SIZE;
+
+		// Start loading the first group of every key of the batch before probing any of them
+		for (size_t i = 0; i < batchSize; ++i) {
+			hashes[i] = Hasher()(keys[batchStart + i]);
+			size_t groupStart = (GroupBits(hashes[i]) & groupMask) * Detail::HASH_GROUP_WIDTH;
+			Detail::PrefetchRead(m_Controls + groupStart);
+			Detail::PrefetchRead(m_Entries + groupStart);
+		}
+
+		for (size_t i = 0; i < batchSize; ++i) {
+			size_t index = FindIndex(keys[batchStart + i], hashes[i]);
+			values[batchStart + i] = index != NOT_FOUND ? &m_Entries[index].m_Value : nullptr;
+			foundCount += index != NOT_FOUND;
+		}
+	}
+
+	return foundCount;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+bool HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Contains(const KeyType& key) const {
+
+	return FindIndex(key, Hasher()(key)) != NOT_FOUND;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+template< typename LookupType, typename TemplateCondition >
+bool HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Contains(const LookupType& key) const {
+
+	return FindIndex(key, Hasher()(key)) != NOT_FOUND;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+bool HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Remove(const KeyType& key) {
+
+	size_t index = FindIndex(key, Hasher()(key));
+	if (index == NOT_FOUND) {
+		return false;
+	}
+
+	RemoveAt(index);
+	return true;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+template< typename LookupType, typename TemplateCondition >
+bool HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Remove(const LookupType& key) {
+
+	size_t index = FindIndex(key, Hasher()(key));
+	if (index == NOT_FOUND) {
+		return false;
+	}
+
+	RemoveAt(index);
+	return true;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+void HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Reserve(size_t count) {
+
+	if (count <= m_ItemCount + m_GrowthLeft) {
+		return;
+	}
+
+	size_t newCapacity = Detail::HASH_GROUP_WIDTH;
+	while (MaxLoad(newCapacity) < count) {
+		newCapacity *= 2;
+	}
+
+	Rehash(newCapacity);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+size_t HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Size() const {
+
+	return m_ItemCount;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+size_t HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::ReservedSize() const {
+
+	return m_Capacity;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+void HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Clear() {
+
+	if (m_Controls == nullptr) {
+		return;
+	}
+
+	for (size_t i = 0; i < m_Capacity; ++i) {
+		if (m_Controls[i] >= 0) {
+			m_Entries[i].Entry::~Entry();
+		}
+	}
+
+	Detail::FreeAligned(GetAllocator(), m_Controls, ALIGNMENT);
+	m_Controls = nullptr;
+	m_Entries = nullptr;
+	m_ItemCount = 0;
+	m_Capacity = 0;
+	m_GrowthLeft = 0;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+typename HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::begin() {
+
+	return Iterator(m_Controls, m_Entries, 0, m_Capacity);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+typename HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::end() {
+
+	return Iterator(m_Controls, m_Entries, m_Capacity, m_Capacity);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+size_t HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::GroupBits(uint64_t hash) {
+
+	return static_cast<size_t>(hash >> 7);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+int8_t HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::ControlBits(uint64_t hash) {
+
+	return static_cast<int8_t>(hash & 0x7F);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+size_t HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::MaxLoad(size_t capacity) {
+
+	return capacity - capacity / 8;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+size_t HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::EntriesOffset(size_t capacity) {
+
+	return (capacity + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+template< typename LookupType >
+size_t HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::FindIndex(const LookupType& key, uint64_t hash) const {
+
+	if (m_Capacity == 0) {
+		return NOT_FOUND;
+	}
+
+	int8_t controlBits = ControlBits(hash);
+	size_t groupMask = m_Capacity / Detail::HASH_GROUP_WIDTH - 1;
+	size_t group = GroupBits(hash) & groupMask;
+
+	// Triangular probing visits every group once when the amount of groups is a power of two
+	for (size_t probe = 1; ; ++probe) {
+
+		size_t groupStart = group * Detail::HASH_GROUP_WIDTH;
+		Detail::HashControlGroup controls(m_Controls + groupStart);
+		for (uint32_t matches = controls.Match(controlBits); matches != 0; matches &= matches - 1) {
+			size_t index = groupStart + CountTrailingZeros(matches);
+			if (KeyEqual()(m_Entries[index].m_Key, key)) {
+				return index;
+			}
+		}
+
+		// The key would have been inserted in this group if it had an empty slot
+		if (controls.MatchEmpty() != 0) {
+			return NOT_FOUND;
+		}
+
+		MIST_ASSERT(probe <= groupMask + 1);
+		group = (group + probe) & groupMask;
+	}
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+size_t HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::FindFreeIndex(uint64_t hash) const {
+
+	size_t groupMask = m_Capacity / Detail::HASH_GROUP_WIDTH - 1;
+	size_t group = GroupBits(hash) & groupMask;
+
+	for (size_t probe = 1; ; ++probe) {
+
+		size_t groupStart = group * Detail::HASH_GROUP_WIDTH;
+		uint32_t freeSlots = Detail::HashControlGroup(m_Controls + groupStart).MatchEmptyOrDeleted();
+		if (freeSlots != 0) {
+			return groupStart + CountTrailingZeros(freeSlots);
+		}
+
+		MIST_ASSERT(probe <= groupMask + 1);
+		group = (group + probe) & groupMask;
+	}
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+template< typename WrittenKeyType, typename... WriteTypes >
+ValueType* HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::InsertKey(WrittenKeyType&& key, WriteTypes&&... writeValues) {
+
+	uint64_t hash = Hasher()(key);
+	size_t index = FindIndex(key, hash);
+	if (index != NOT_FOUND) {
+		return &m_Entries[index].m_Value;
+	}
+
+	if (m_GrowthLeft == 0) {
+		Grow();
+	}
+
+	index = FindFreeIndex(hash);
+	// Reusing a tombstone doesn't bring the map closer to growing
+	if (m_Controls[index] == Detail::HASH_CONTROL_EMPTY) {
+		m_GrowthLeft--;
+	}
+
+	m_Controls[index] = ControlBits(hash);
+	Entry* entry = new (m_Entries + index) Entry{ KeyType(std::forward<WrittenKeyType>(key)), ValueType(std::forward<WriteTypes>(writeValues)...) };
+	m_ItemCount++;
+
+	return &entry->m_Value;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+void HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::RemoveAt(size_t index) {
+
+	m_Entries[index].Entry::~Entry();
+	m_ItemCount--;
+
+	// A group with an empty slot ends every probe sequence going through it,
+	// no key was pushed past it and the slot can be emptied. Otherwise a tombstone keeps the probes going.
+	size_t groupStart = index & ~(Detail::HASH_GROUP_WIDTH - 1);
+	if (Detail::HashControlGroup(m_Controls + groupStart).MatchEmpty() != 0) {
+		m_Controls[index] = Detail::HASH_CONTROL_EMPTY;
+		m_GrowthLeft++;
+	}
+	else {
+		m_Controls[index] = Detail::HASH_CONTROL_DELETED;
+	}
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+void HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Grow() {
+
+	if (m_Capacity == 0) {
+		Rehash(Detail::HASH_GROUP_WIDTH);
+	}
+	// The slots are mostly tombstones, rehashing at the same capacity is enough
+	else if (m_ItemCount * 2 <= MaxLoad(m_Capacity)) {
+		Rehash(m_Capacity);
+	}
+	else {
+		Rehash(m_Capacity * 2);
+	}
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+void HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Rehash(size_t newCapacity) {
+
+	MIST_ASSERT((newCapacity & (newCapacity - 1)) == 0 && newCapacity >= Detail::HASH_GROUP_WIDTH);
+	MIST_ASSERT(MaxLoad(newCapacity) >= m_ItemCount);
+
+	int8_t* oldControls = m_Controls;
+	Entry* oldEntries = m_Entries;
+	size_t oldCapacity = m_Capacity;
+
+	// The control bytes and the entries share a single block
+	size_t entriesOffset = EntriesOffset(newCapacity);
+	uint8_t* memory = static_cast<uint8_t*>(Detail::AllocateAligned(GetAllocator(), entriesOffset + newCapacity * sizeof(Entry), ALIGNMENT));
+	m_Controls = reinterpret_cast<int8_t*>(memory);
+	m_Entries = reinterpret_cast<Entry*>(memory + entriesOffset);
+	m_Capacity = newCapacity;
+	m_GrowthLeft = MaxLoad(newCapacity) - m_ItemCount;
+	memset(m_Controls, static_cast<uint8_t>(Detail::HASH_CONTROL_EMPTY), newCapacity);
+
+	if (oldControls == nullptr) {
+		return;
+	}
+
+	for (size_t i = 0; i < oldCapacity; ++i) {
+		if (oldControls[i] < 0) {
+			continue;
+		}
+
+		uint64_t hash = Hasher()(oldEntries[i].m_Key);
+		size_t index = FindFreeIndex(hash);
+		m_Controls[index] = ControlBits(hash);
+		new (m_Entries + index) Entry(std::move(oldEntries[i]));
+		oldEntries[i].Entry::~Entry();
+	}
+
+	Detail::FreeAligned(GetAllocator(), oldControls, ALIGNMENT);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::HashMap(size_t count, const Allocator& allocator)
+	: Detail::AllocatorStorage<Allocator>(allocator) {
+
+	Reserve(count);
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::HashMap(const Allocator& allocator)
+	: Detail::AllocatorStorage<Allocator>(allocator) {}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::HashMap(HashMap&& rhs) {
+
+	std::swap(m_Controls, rhs.m_Controls);
+	std::swap(m_Entries, rhs.m_Entries);
+	std::swap(m_ItemCount, rhs.m_ItemCount);
+	std::swap(m_Capacity, rhs.m_Capacity);
+	std::swap(m_GrowthLeft, rhs.m_GrowthLeft);
+	// The memory belongs to the allocator, it has to follow the memory
+	std::swap(GetAllocator(), rhs.GetAllocator());
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>& HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::operator=(HashMap&& rhs) {
+
+	std::swap(m_Controls, rhs.m_Controls);
+	std::swap(m_Entries, rhs.m_Entries);
+	std::swap(m_ItemCount, rhs.m_ItemCount);
+	std::swap(m_Capacity, rhs.m_Capacity);
+	std::swap(m_GrowthLeft, rhs.m_GrowthLeft);
+	// The memory belongs to the allocator, it has to follow the memory
+	std::swap(GetAllocator(), rhs.GetAllocator());
+
+	return *this;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::~HashMap() {
+
+	Clear();
+}
+
+// -Iterator-
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+typename HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator::operator++() {
+
+	m_Index++;
+	SkipFreeSlots();
+	return *this;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+bool HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator::operator!=(const Iterator& rhs) const {
+
+	return m_Index != rhs.m_Index || m_Entries != rhs.m_Entries;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+bool HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator::operator==(const Iterator& rhs) const {
+
+	return (*this != rhs) == false;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+typename HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Entry& HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator::operator*() {
+
+	MIST_ASSERT(m_Index < m_Capacity);
+	return m_Entries[m_Index];
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+typename HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Entry* HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator::operator->() {
+
+	MIST_ASSERT(m_Index < m_Capacity);
+	return m_Entries + m_Index;
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator::Iterator(const int8_t* controls, Entry* entries, size_t index, size_t capacity)
+	: m_Controls(controls)
+	, m_Entries(entries)
+	, m_Index(index)
+	, m_Capacity(capacity) {
+
+	SkipFreeSlots();
+}
+
+template< typename KeyType, typename ValueType, typename Hasher, typename KeyEqual, typename Allocator >
+void HashMap<KeyType, ValueType, Hasher, KeyEqual, Allocator>::Iterator::SkipFreeSlots() {
+
+	while (m_Index < m_Capacity && m_Controls[m_Index] < 0) {
+		m_Index++;
+	}
+}
+
+MIST_NAMESPACE_END
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../utility/CacheLine.h"
+#include <atomic>
+#include <utility>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+// A bounded lock free queue for any number of producer and consumer threads.
+// The API matches the RingBuffer, it can be swapped in without changing the callers.
+// @Details: The implementation is based on Dmitry Vyukov's bounded MPMC queue:
+//  http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//  Every slot holds a sequence number that tells the producers and consumers whose turn it is to use the slot,
+//  threads claim a position with a compare and swap on the shared head and then only touch their slot.
+//  Unlike the RingBuffer, all tSize slots can be written in one go.
+//  A power of two tSize allows the position to slot conversion to be a simple mask.
+// @Example: Pushing tasks to worker threads would look like:
+//
+//		MpmcRingBuffer<TaskHandle, 1024> tasks;
+//		// Any thread
+//		while (tasks.TryWrite(task) == false) {}
+//		// Any worker
+//		TaskHandle task;
+//		if (tasks.TryRead(&task)) {
+//			Run(task);
+//		}
+template< typename ValueType, size_t tSize >
+class MpmcRingBuffer {
+	static_assert(tSize > 1, "A Ring Buffer Cannot be of size 0. Is it a typo?");
+
+public:
+
+	// -Public API-
+
+	// Attempts to read from the buffer, also consumes the read.
+	// returns false if no value is available to read
+	bool TryRead(ValueType* outValue);
+
+	// Attempts to read from the buffer, does not consume the read.
+	// returns false if no value is available to read, or if the value was consumed while it was being peeked
+	// @Detail: The value might be overwritten while it's being copied, peeking is only allowed for trivially copyable types
+	bool TryPeek(ValueType* outValue) const;
+
+	// Determine if there is any valid data for the user to read from the buffer
+	// @Detail: This is only a snapshot, another consumer might read the value before this thread does
+	bool CanRead() const;
+
+	// Write a value into the buffer.
+	// If the method returns false, that means the buffer is full and nothing is written
+	template< typename WriteType = ValueType,
+		// @Template condition: the Writing type must be convertible to value type
+		typename TemplateCondition = typename std::enable_if<std::is_convertible<WriteType, ValueType>::value>::type >
+	bool TryWrite(WriteType&& writeValue);
+
+	// Determine if there is space to write to in the buffer
+	// @Detail: This is only a snapshot, another producer might fill the space before this thread does
+	bool CanWrite() const;
+
+	size_t Size() const;
+
+
+	// -Types-
+	using Type = ValueType;
+
+
+	// -Structors-
+	MpmcRingBuffer();
+
+	MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+	MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+private:
+
+	struct Slot {
+		// When the sequence equals the position, the slot can be written
+		// When the sequence equals the position + 1, the slot can be read
+		std::atomic<size_t> m_Sequence;
+		ValueType m_Value;
+	};
+
+	// The position that the next write will claim
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_WritePosition{ 0 };
+	// The position that the next read will claim
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_ReadPosition{ 0 };
+
+	alignas(CACHE_LINE_SIZE) Slot m_Slots[tSize];
+};
+
+
+// -Implementation-
+
+template< typename ValueType, size_t tSize >
+MpmcRingBuffer<ValueType, tSize>::MpmcRingBuffer() : m_Slots() {
+
+	// Every slot starts as writable for the first lap of positions
+	for (size_t i = 0; i < tSize; ++i) {
+		m_Slots[i].m_Sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+template< typename ValueType, size_t tSize >
+bool MpmcRingBuffer<ValueType, tSize>::TryRead(ValueType* outValue) {
+
+	size_t position = m_ReadPosition.load(std::memory_order_relaxed);
+	Slot* slot;
+	while (true) {
+
+		slot = &m_Slots[position % tSize];
+		size_t sequence = slot->m_Sequence.load(std::memory_order_acquire);
+		intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+		// The slot has been written, attempt to claim it
+		if (difference == 0) {
+			if (m_ReadPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+			// @Detail: A failed compare exchange reloads the position, simply try again
+		}
+		// The slot hasn't been written yet, the buffer is empty
+		else if (difference < 0) {
+			return false;
+		}
+		// Another consumer claimed this position, catch up
+		else {
+			position = m_ReadPosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	*outValue = std::move(slot->m_Value);
+	// Give the slot back to the producers for the next lap
+	slot->m_Sequence.store(position + tSize, std::memory_order_release);
+	return true;
+}
+
+template< typename ValueType, size_t tSize >
+bool MpmcRingBuffer<ValueType, tSize>::TryPeek(ValueType* outValue) const {
+
+	static_assert(std::is_trivially_copyable<ValueType>::value, "Peeking into a MPMC buffer is only allowed for trivially copyable types.");
+
+	size_t position = m_ReadPosition.load(std::memory_order_relaxed);
+	const Slot& slot = m_Slots[position % tSize];
+
+	if (slot.m_Sequence.load(std::memory_order_acquire) != position + 1) {
+		return false;
+	}
+
+	*outValue = slot.m_Value;
+
+	// If the value was consumed while we were copying it, the copy might be garbage
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return m_ReadPosition.load(std::memory_order_relaxed) == position;
+}
+
+template< typename ValueType, size_t tSize >
+bool MpmcRingBuffer<ValueType, tSize>::CanRead() const {
+
+	size_t position = m_ReadPosition.load(std::memory_order_relaxed);
+	return m_Slots[position % tSize].m_Sequence.load(std::memory_order_acquire) == position + 1;
+}
+
+template< typename ValueType, size_t tSize >
+template< typename WriteType,
+	// @Template Condition: links to condition in class definition
+	typename TemplateCondition >
+bool MpmcRingBuffer<ValueType, tSize>::TryWrite(WriteType&& writeValue) {
+
+	size_t position = m_WritePosition.load(std::memory_order_relaxed);
+	Slot* slot;
+	while (true) {
+
+		slot = &m_Slots[position % tSize];
+		size_t sequence = slot->m_Sequence.load(std::memory_order_acquire);
+		intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+		// The slot is free, attempt to claim it
+		if (difference == 0) {
+			if (m_WritePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		// The slot from the previous lap hasn't been read yet, the buffer is full
+		else if (difference < 0) {
+			return false;
+		}
+		// Another producer claimed this position, catch up
+		else {
+			position = m_WritePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->m_Value = std::forward<WriteType&&>(writeValue);
+	// Publish the value to the consumers
+	slot->m_Sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+template< typename ValueType, size_t tSize >
+bool MpmcRingBuffer<ValueType, tSize>::CanWrite() const {
+
+	size_t position = m_WritePosition.load(std::memory_order_relaxed);
+	return m_Slots[position % tSize].m_Sequence.load(std::memory_order_acquire) == position;
+}
+
+template< typename ValueType, size_t tSize >
+size_t MpmcRingBuffer<ValueType, tSize>::Size() const {
+	return tSize;
+}
+
+MIST_NAMESPACE_END
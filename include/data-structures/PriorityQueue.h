@@ -0,0 +1,561 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../allocators/CppAllocator.h"
+#include "DynamicArray.h"
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+MIST_NAMESPACE
+
+// Priority queues stored as d-ary heaps in a DynamicArray.
+// - PriorityQueue, the values come out in the order of the comparison
+// - IndexedPriorityQueue, every value gets a handle that can be used to move it up the queue (DecreaseKey) or remove it
+// The top of the queue is the value that comes first in the comparison, a queue using std::less pops the smallest value first.
+// This is the reverse of std::priority_queue, a queue pops it's values in the same order as a sort with the same comparison.
+
+namespace Detail {
+
+	// The heap functions work with a hole, the value being moved is kept aside and the values
+	// on it's path are shifted into the hole until the value can be placed.
+	// The placement is told every index where an entry was written, the indexed queue tracks the positions of it's handles.
+	struct NoHeapPlacement {
+		template< typename EntryType >
+		void operator()(EntryType*, size_t) const {}
+	};
+
+	// Move the hole at index up the heap until the value can be placed in it
+	template< size_t tArity, typename EntryType, typename CompareType, typename PlacementType >
+	void HeapSiftUp(EntryType* entries, size_t index, EntryType&& value, CompareType& compare, PlacementType& placement) {
+
+		while (index > 0) {
+			size_t parent = (index - 1) / tArity;
+			if (compare(value, entries[parent]) == false) {
+				break;
+			}
+
+			entries[index] = std::move(entries[parent]);
+			placement(entries, index);
+			index = parent;
+		}
+		entries[index] = std::move(value);
+		placement(entries, index);
+	}
+
+	// Move the hole at index down the heap until the value can be placed in it
+	// @Detail: The children of a node are contiguous, with 4 children of 16 bytes or less they share a cache line.
+	//  The wider nodes make the heap shallower, there are more comparisons per level but a lot less cache misses.
+	template< size_t tArity, typename EntryType, typename CompareType, typename PlacementType >
+	void HeapSiftDown(EntryType* entries, size_t index, size_t size, EntryType&& value, CompareType& compare, PlacementType& placement) {
+
+		while (true) {
+			size_t firstChild = index * tArity + 1;
+			if (firstChild >= size) {
+				break;
+			}
+
+			// Pick the child that comes first
+			size_t lastChild = size - firstChild < tArity ? size : firstChild + tArity;
+			size_t bestChild = firstChild;
+			for (size_t child = firstChild + 1; child < lastChild; ++child) {
+				if (compare(entries[child], entries[bestChild])) {
+					bestChild = child;
+				}
+			}
+
+			if (compare(entries[bestChild], value) == false) {
+				break;
+			}
+
+			entries[index] = std::move(entries[bestChild]);
+			placement(entries, index);
+			index = bestChild;
+		}
+		entries[index] = std::move(value);
+		placement(entries, index);
+	}
+
+	// Move the hole at index down to a leaf and sift the value up from there, this is the sift of the pops.
+	// @Detail: The value filling the hole of a pop is the last value of the heap, it almost always belongs near the leaves.
+	//  Going straight to the leaves saves the comparison of every level against the value.
+	template< size_t tArity, typename EntryType, typename CompareType, typename PlacementType >
+	void HeapSiftDownToLeaf(EntryType* entries, size_t index, size_t size, EntryType&& value, CompareType& compare, PlacementType& placement) {
+
+		while (true) {
+			size_t firstChild = index * tArity + 1;
+			if (firstChild >= size) {
+				break;
+			}
+
+			size_t lastChild = size - firstChild < tArity ? size : firstChild + tArity;
+			size_t bestChild = firstChild;
+			for (size_t child = firstChild + 1; child < lastChild; ++child) {
+				bestChild = compare(entries[child], entries[bestChild]) ? child : bestChild;
+			}
+
+			entries[index] = std::move(entries[bestChild]);
+			placement(entries, index);
+			index = bestChild;
+		}
+		HeapSiftUp<tArity>(entries, index, std::move(value), compare, placement);
+	}
+
+	// Build the heap in O(n) by sifting down every parent, from the last one to the root
+	template< size_t tArity, typename EntryType, typename CompareType, typename PlacementType >
+	void HeapBuild(EntryType* entries, size_t size, CompareType& compare, PlacementType& placement) {
+
+		if (size < 2) {
+			return;
+		}
+
+		for (size_t parent = (size - 2) / tArity + 1; parent > 0; --parent) {
+			EntryType value = std::move(entries[parent - 1]);
+			HeapSiftDown<tArity>(entries, parent - 1, size, std::move(value), compare, placement);
+		}
+	}
+}
+
+// -PriorityQueue-
+
+// A priority queue stored as a d-ary heap, the default of 4 children per node is faster than a binary heap
+// for most value types, the heap is half as deep and the children of a node are read together.
+// @Detail: Pushing a range larger than the queue rebuilds the whole heap in O(n) instead of sifting up every value.
+// @Example: Scheduling events by time would look like:
+//
+//		PriorityQueue<Event, EarlierEvent> events;
+//		events.Push(Event{ 2.0f, SpawnWave });
+//		while (events.Size() > 0 && events.Top().m_Time <= currentTime) {
+//			Event event;
+//			events.Pop(&event);
+//			event.m_Callback();
+//		}
+template< typename ValueType, typename CompareType = std::less<ValueType>, size_t tArity = 4, typename Allocator = CppAllocator >
+class PriorityQueue {
+	static_assert(tArity >= 2, "A heap needs at least two children per node.");
+
+public:
+
+	// -Public API-
+
+	// Construct a value in place and move it to it's position in the queue
+	template< typename... WriteType >
+	void Push(WriteType&&... writeValue);
+
+	// Copy a range of values into the queue
+	// @Detail: The memory is only reserved once, a range larger than the queue rebuilds the heap in O(n)
+	template< typename IteratorType >
+	void PushRange(IteratorType begin, IteratorType end);
+
+	// Replace the contents of the queue with the range, the heap is built in O(n)
+	template< typename IteratorType >
+	void Heapify(IteratorType begin, IteratorType end);
+
+	// The value that comes first in the comparison, the queue cannot be empty
+	const ValueType& Top() const;
+
+	// Remove the top value, the second version moves it into outValue
+	void Pop();
+	void Pop(ValueType* outValue);
+
+	size_t Size() const;
+
+	// Reserve room for size more values
+	void ReserveAdditional(size_t size);
+
+	void Clear();
+
+	// -Structors-
+
+	PriorityQueue() = default;
+	explicit PriorityQueue(CompareType compare, const Allocator& allocator = Allocator());
+
+	PriorityQueue(PriorityQueue&&) = default;
+	PriorityQueue& operator=(PriorityQueue&&) = default;
+
+private:
+
+	DynamicArray<ValueType, Allocator> m_Values;
+	CompareType m_Compare = CompareType();
+};
+
+// -IndexedPriorityQueue-
+
+// A priority queue where every value has a handle, the handle finds the value in the queue in O(1)
+// in order to move it up the queue when it gets a better priority or to remove it.
+// This is the queue of pathfinding, the cost of a node is decreased when a shorter path to it is found.
+// @Detail: The handle of a value is only valid until the value leaves the queue, the handle is then reused by later pushes.
+//  Every move in the heap also updates the position of the handle, prefer the PriorityQueue when the handles aren't needed.
+// @Example: The open set of an A* search would look like:
+//
+//		IndexedPriorityQueue<OpenNode, LowerCost> open;
+//		handles[start] = open.Push(OpenNode{ start, 0.0f });
+//		...
+//		if (open.Contains(handles[neighbour]) && cost < open.GetValue(handles[neighbour])->m_Cost) {
+//			open.DecreaseKey(handles[neighbour], OpenNode{ neighbour, cost });
+//		}
+template< typename ValueType, typename CompareType = std::less<ValueType>, size_t tArity = 4, typename Allocator = CppAllocator >
+class IndexedPriorityQueue {
+	static_assert(tArity >= 2, "A heap needs at least two children per node.");
+
+public:
+
+	using Handle = uint32_t;
+
+	// -Public API-
+
+	// Construct a value in place and move it to it's position in the queue, returns the handle of the value
+	template< typename... WriteType >
+	Handle Push(WriteType&&... writeValue);
+
+	// Copy a range of values into the queue, the handles of the values are written to outHandles if it isn't null
+	// @Detail: The memory is only reserved once, a range larger than the queue rebuilds the heap in O(n)
+	template< typename IteratorType >
+	void PushRange(IteratorType begin, IteratorType end, Handle* outHandles = nullptr);
+
+	// Replace the value of the handle with a value that doesn't come after it, the value moves up the queue
+	template< typename WriteType >
+	void DecreaseKey(Handle handle, WriteType&& value);
+
+	// Remove the value of the handle from the queue
+	void Remove(Handle handle);
+
+	// Determine if the value of the handle is still in the queue
+	bool Contains(Handle handle) const;
+
+	// The value of a handle that is in the queue
+	const ValueType* GetValue(Handle handle) const;
+
+	// The value that comes first in the comparison and it's handle, the queue cannot be empty
+	const ValueType& Top() const;
+	Handle TopHandle() const;
+
+	// Remove the top value, the second version moves it into outValue
+	void Pop();
+	void Pop(ValueType* outValue);
+
+	size_t Size() const;
+
+	// Reserve room for size more values
+	void ReserveAdditional(size_t size);
+
+	// Remove every value, every handle becomes invalid
+	void Clear();
+
+	// -Structors-
+
+	IndexedPriorityQueue() = default;
+	explicit IndexedPriorityQueue(CompareType compare, const Allocator& allocator = Allocator());
+
+	IndexedPriorityQueue(IndexedPriorityQueue&&) = default;
+	IndexedPriorityQueue& operator=(IndexedPriorityQueue&&) = default;
+
+private:
+
+	// The position of the handles that aren't in the queue
+	static constexpr size_t INVALID_POSITION = ~static_cast<size_t>(0);
+
+	struct Entry {
+		ValueType m_Value;
+		Handle m_Handle;
+	};
+
+	// Compares the values of the entries
+	struct EntryCompare {
+		bool operator()(const Entry& left, const Entry& right) { return m_Compare(left.m_Value, right.m_Value); }
+		CompareType m_Compare;
+	};
+
+	// Records the position of the entries written into the heap
+	struct EntryPlacement {
+		void operator()(Entry* entries, size_t index) { (*m_Positions)[entries[index].m_Handle] = index; }
+		DynamicArray<size_t, Allocator>* m_Positions;
+	};
+
+	// Take a free handle, or a new one, for a value placed at index
+	Handle AcquireHandle(size_t index);
+
+	// Remove the entry at index, the last entry fills it's place
+	void RemoveAt(size_t index, ValueType* outValue);
+
+	DynamicArray<Entry, Allocator> m_Entries;
+	// The position of every handle in the heap
+	DynamicArray<size_t, Allocator> m_Positions;
+	DynamicArray<Handle, Allocator> m_FreeHandles;
+	EntryCompare m_Compare = { CompareType() };
+};
+
+
+// -PriorityQueue Implementation-
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+PriorityQueue<ValueType, CompareType, tArity, Allocator>::PriorityQueue(CompareType compare, const Allocator& allocator)
+	: m_Values(allocator)
+	, m_Compare(compare) {}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+template< typename... WriteType >
+void PriorityQueue<ValueType, CompareType, tArity, Allocator>::Push(WriteType&&... writeValue) {
+
+	m_Values.InsertAsLast(std::forward<WriteType>(writeValue)...);
+
+	size_t index = m_Values.Size() - 1;
+	ValueType value = std::move(m_Values[index]);
+	Detail::NoHeapPlacement placement;
+	Detail::HeapSiftUp<tArity>(m_Values.AsRawArray(), index, std::move(value), m_Compare, placement);
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+template< typename IteratorType >
+void PriorityQueue<ValueType, CompareType, tArity, Allocator>::PushRange(IteratorType begin, IteratorType end) {
+
+	size_t previousSize = m_Values.Size();
+	m_Values.InsertRange(begin, end);
+
+	Detail::NoHeapPlacement placement;
+	size_t size = m_Values.Size();
+	if (size - previousSize > previousSize) {
+		Detail::HeapBuild<tArity>(m_Values.AsRawArray(), size, m_Compare, placement);
+		return;
+	}
+
+	for (size_t i = previousSize; i < size; i++) {
+		ValueType value = std::move(m_Values[i]);
+		Detail::HeapSiftUp<tArity>(m_Values.AsRawArray(), i, std::move(value), m_Compare, placement);
+	}
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+template< typename IteratorType >
+void PriorityQueue<ValueType, CompareType, tArity, Allocator>::Heapify(IteratorType begin, IteratorType end) {
+
+	m_Values.Clear();
+	m_Values.InsertRange(begin, end);
+
+	Detail::NoHeapPlacement placement;
+	Detail::HeapBuild<tArity>(m_Values.AsRawArray(), m_Values.Size(), m_Compare, placement);
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+const ValueType& PriorityQueue<ValueType, CompareType, tArity, Allocator>::Top() const {
+
+	MIST_ASSERT(m_Values.Size() > 0);
+	return m_Values.AsRawArray()[0];
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void PriorityQueue<ValueType, CompareType, tArity, Allocator>::Pop() {
+
+	MIST_ASSERT(m_Values.Size() > 0);
+
+	// The last value fills the hole left by the top
+	size_t size = m_Values.Size() - 1;
+	if (size > 0) {
+		ValueType value = std::move(m_Values[size]);
+		Detail::NoHeapPlacement placement;
+		Detail::HeapSiftDownToLeaf<tArity>(m_Values.AsRawArray(), 0, size, std::move(value), m_Compare, placement);
+	}
+	m_Values.RemoveLast();
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void PriorityQueue<ValueType, CompareType, tArity, Allocator>::Pop(ValueType* outValue) {
+
+	MIST_ASSERT(m_Values.Size() > 0);
+	*outValue = std::move(m_Values[0]);
+	Pop();
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+size_t PriorityQueue<ValueType, CompareType, tArity, Allocator>::Size() const {
+
+	return m_Values.Size();
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void PriorityQueue<ValueType, CompareType, tArity, Allocator>::ReserveAdditional(size_t size) {
+
+	m_Values.ReserveAdditional(size);
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void PriorityQueue<ValueType, CompareType, tArity, Allocator>::Clear() {
+
+	m_Values.Clear();
+}
+
+// -IndexedPriorityQueue Implementation-
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::IndexedPriorityQueue(CompareType compare, const Allocator& allocator)
+	: m_Entries(allocator)
+	, m_Positions(allocator)
+	, m_FreeHandles(allocator)
+	, m_Compare{ compare } {}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+template< typename... WriteType >
+typename IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Handle IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Push(WriteType&&... writeValue) {
+
+	size_t index = m_Entries.Size();
+	Handle handle = AcquireHandle(index);
+	m_Entries.InsertAsLast(Entry{ ValueType(std::forward<WriteType>(writeValue)...), handle });
+
+	Entry entry = std::move(m_Entries[index]);
+	EntryPlacement placement = { &m_Positions };
+	Detail::HeapSiftUp<tArity>(m_Entries.AsRawArray(), index, std::move(entry), m_Compare, placement);
+	return handle;
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+template< typename IteratorType >
+void IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::PushRange(IteratorType begin, IteratorType end, Handle* outHandles) {
+
+	size_t previousSize = m_Entries.Size();
+	size_t count = static_cast<size_t>(std::distance(begin, end));
+	if (count == 0) {
+		return;
+	}
+
+	m_Entries.ReserveAdditional(count);
+	for (; begin != end; ++begin) {
+		Handle handle = AcquireHandle(m_Entries.Size());
+		m_Entries.InsertAsLast(Entry{ *begin, handle });
+		if (outHandles != nullptr) {
+			*outHandles++ = handle;
+		}
+	}
+
+	EntryPlacement placement = { &m_Positions };
+	size_t size = m_Entries.Size();
+	if (count > previousSize) {
+		Detail::HeapBuild<tArity>(m_Entries.AsRawArray(), size, m_Compare, placement);
+		return;
+	}
+
+	for (size_t i = previousSize; i < size; i++) {
+		Entry entry = std::move(m_Entries[i]);
+		Detail::HeapSiftUp<tArity>(m_Entries.AsRawArray(), i, std::move(entry), m_Compare, placement);
+	}
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+template< typename WriteType >
+void IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::DecreaseKey(Handle handle, WriteType&& value) {
+
+	MIST_ASSERT(Contains(handle));
+	size_t index = m_Positions[handle];
+
+	Entry entry = { std::forward<WriteType>(value), handle };
+	// The new value can't come after the old value, otherwise it would have to move down the queue
+	MIST_ASSERT(m_Compare(m_Entries[index], entry) == false);
+
+	EntryPlacement placement = { &m_Positions };
+	Detail::HeapSiftUp<tArity>(m_Entries.AsRawArray(), index, std::move(entry), m_Compare, placement);
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Remove(Handle handle) {
+
+	MIST_ASSERT(Contains(handle));
+	RemoveAt(m_Positions[handle], nullptr);
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+bool IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Contains(Handle handle) const {
+
+	return handle < m_Positions.Size() && m_Positions.AsRawArray()[handle] != INVALID_POSITION;
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+const ValueType* IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::GetValue(Handle handle) const {
+
+	MIST_ASSERT(Contains(handle));
+	return &m_Entries.AsRawArray()[m_Positions.AsRawArray()[handle]].m_Value;
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+const ValueType& IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Top() const {
+
+	MIST_ASSERT(m_Entries.Size() > 0);
+	return m_Entries.AsRawArray()[0].m_Value;
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+typename IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Handle IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::TopHandle() const {
+
+	MIST_ASSERT(m_Entries.Size() > 0);
+	return m_Entries.AsRawArray()[0].m_Handle;
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Pop() {
+
+	MIST_ASSERT(m_Entries.Size() > 0);
+	RemoveAt(0, nullptr);
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Pop(ValueType* outValue) {
+
+	MIST_ASSERT(m_Entries.Size() > 0);
+	RemoveAt(0, outValue);
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+size_t IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Size() const {
+
+	return m_Entries.Size();
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::ReserveAdditional(size_t size) {
+
+	m_Entries.ReserveAdditional(size);
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Clear() {
+
+	m_Entries.Clear();
+	m_Positions.Clear();
+	m_FreeHandles.Clear();
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+typename IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::Handle IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::AcquireHandle(size_t index) {
+
+	if (m_FreeHandles.Size() > 0) {
+		Handle handle = *m_FreeHandles.LastValue();
+		m_FreeHandles.RemoveLast();
+		m_Positions[handle] = index;
+		return handle;
+	}
+
+	MIST_ASSERT(m_Positions.Size() < static_cast<size_t>(~static_cast<Handle>(0)));
+	m_Positions.InsertAsLast(index);
+	return static_cast<Handle>(m_Positions.Size() - 1);
+}
+
+template< typename ValueType, typename CompareType, size_t tArity, typename Allocator >
+void IndexedPriorityQueue<ValueType, CompareType, tArity, Allocator>::RemoveAt(size_t index, ValueType* outValue) {
+
+	Handle handle = m_Entries[index].m_Handle;
+	if (outValue != nullptr) {
+		*outValue = std::move(m_Entries[index].m_Value);
+	}
+	m_Positions[handle] = INVALID_POSITION;
+	m_FreeHandles.InsertAsLast(handle);
+
+	// The last entry fills the hole, the sift up from the leaf also moves it above the hole when it belongs there
+	size_t size = m_Entries.Size() - 1;
+	if (index < size) {
+		Entry entry = std::move(m_Entries[size]);
+		EntryPlacement placement = { &m_Positions };
+		Detail::HeapSiftDownToLeaf<tArity>(m_Entries.AsRawArray(), index, size, std::move(entry), m_Compare, placement);
+	}
+	m_Entries.RemoveLast();
+}
+
+MIST_NAMESPACE_END
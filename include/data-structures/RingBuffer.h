@@ -1,6 +1,8 @@
 #pragma once
 
 #include <utility>
+#include <algorithm>
+#include <type_traits>
 #include <Mist_Common/include/UtilityMacros.h>
 
 MIST_NAMESPACE
@@ -19,6 +21,17 @@ MIST_NAMESPACE
 //		if(buffer.TryRead(&result) == false) {
 //			std::cout << "Nothing left to read" << std::endl;
 //		}
+//
+//  Filling the buffer in place would look like:
+//
+//		int* span = nullptr;
+//		size_t spanSize = buffer.AcquireWriteSpan(&span);
+//		for (size_t i = 0; i < spanSize; i++) {
+//			span[i] = i;
+//		}
+//		buffer.CommitWrite(spanSize);
+//
+//  A power of two tSize is prefered, the heads are then wrapped with a mask.
 template< typename ValueType, size_t tSize >
 class RingBuffer {
 	static_assert(tSize > 1, "A Ring Buffer Cannot be of size 0. Is it a typo?");
@@ -48,6 +61,39 @@ public:
 	// Determine if there is space to write to in the buffer
 	bool CanWrite() const;
 
+	// Write up to count values into the buffer, the values are copied in at most two contiguous segments.
+	// returns the amount of values written, this might be less than count if the buffer fills up
+	size_t TryWriteN(const ValueType* values, size_t count);
+
+	// Read up to count values from the buffer, the values are copied in at most two contiguous segments.
+	// returns the amount of values read
+	size_t TryReadN(ValueType* outValues, size_t count);
+
+	// Retrieve the contiguous region of the buffer that can be written to in place.
+	// returns the amount of values that can be written to the span, 0 if the buffer is full
+	// @Detail: The region stops at the end of the storage, once committed another span might be available at the start
+	size_t AcquireWriteSpan(ValueType** outSpan);
+
+	// Publish the first count values written to the span retrieved with AcquireWriteSpan
+	void CommitWrite(size_t count);
+
+	// Retrieve the contiguous region of the buffer that can be read in place.
+	// returns the amount of values that can be read from the span, 0 if the buffer is empty
+	size_t AcquireReadSpan(const ValueType** outSpan) const;
+
+	// Consume the first count values of the span retrieved with AcquireReadSpan
+	void CommitRead(size_t count);
+
+	// Retrieve every readable value without consuming them, the values wrap around the storage in at most two spans.
+	// returns the amount of readable values, the second span holds the values that didn't fit in the first span
+	size_t PeekReadSpans(const ValueType** outFirstSpan, size_t* outFirstCount, const ValueType** outSecondSpan) const;
+
+	// Determine how many values can currently be read
+	size_t ReadableCount() const;
+
+	// Determine how many values can currently be written
+	size_t WritableCount() const;
+
 	size_t Size() const;
 
 
@@ -59,6 +105,13 @@ public:
 	RingBuffer() : m_Values() {}
 
 private:
+
+	static constexpr bool IS_POWER_OF_TWO = (tSize & (tSize - 1)) == 0;
+
+	// Wrap an index that is less than 2 * tSize back into the buffer
+	// @Detail: Power of two sizes are masked, other sizes use a comparison instead of an integer division
+	static size_t Wrap(size_t index);
+
 	// Determines the previous region read in the buffer, it's always one step behind the next read
 	size_t m_ReadHead = 0;
 	// Determines the location that the next write will occure
@@ -76,7 +129,7 @@ bool RingBuffer<ValueType, tSize>::TryRead(ValueType* outValue) {
 		return false;
 	}
 
-	m_ReadHead = (m_ReadHead + 1) % tSize;
+	m_ReadHead = Wrap(m_ReadHead + 1);
 	*outValue = m_Values[m_ReadHead];
 	return true;
 }
@@ -87,7 +140,7 @@ bool RingBuffer<ValueType, tSize>::TryPeek(ValueType* outValue) const {
 		return false;
 	}
 
-	size_t readPosition = (m_ReadHead + 1) % tSize;
+	size_t readPosition = Wrap(m_ReadHead + 1);
 	*outValue = m_Values[readPosition];
 	return true;
 }
@@ -95,7 +148,7 @@ bool RingBuffer<ValueType, tSize>::TryPeek(ValueType* outValue) const {
 template< typename ValueType, size_t tSize >
 bool RingBuffer<ValueType, tSize>::CanRead() const {
 	// You can't read where hasn't been written yet
-	size_t readLocation = (m_ReadHead + 1) % tSize;
+	size_t readLocation = Wrap(m_ReadHead + 1);
 	return readLocation != m_WriteHead;
 }
 
@@ -111,7 +164,7 @@ bool RingBuffer<ValueType, tSize>::TryWrite(WriteType&& writeValue) {
 	m_Values[m_WriteHead] = std::forward<WriteType&&>(writeValue);
 
 	// Advance the write head
-	m_WriteHead = (m_WriteHead + 1) % tSize;
+	m_WriteHead = Wrap(m_WriteHead + 1);
 	return true;
 }
 
@@ -121,9 +174,101 @@ bool RingBuffer<ValueType, tSize>::CanWrite() const {
 	return (m_ReadHead == m_WriteHead) == false;
 }
 
+template< typename ValueType, size_t tSize >
+size_t RingBuffer<ValueType, tSize>::TryWriteN(const ValueType* values, size_t count) {
+
+	size_t writeCount = std::min(count, WritableCount());
+
+	// Copy up to the end of the storage and then wrap around to the start
+	size_t firstSegment = std::min(writeCount, tSize - m_WriteHead);
+	std::copy(values, values + firstSegment, m_Values + m_WriteHead);
+	std::copy(values + firstSegment, values + writeCount, m_Values);
+
+	m_WriteHead = Wrap(m_WriteHead + writeCount);
+	return writeCount;
+}
+
+template< typename ValueType, size_t tSize >
+size_t RingBuffer<ValueType, tSize>::TryReadN(ValueType* outValues, size_t count) {
+
+	size_t readCount = std::min(count, ReadableCount());
+	size_t readPosition = Wrap(m_ReadHead + 1);
+
+	// Copy up to the end of the storage and then wrap around to the start
+	size_t firstSegment = std::min(readCount, tSize - readPosition);
+	std::copy(m_Values + readPosition, m_Values + readPosition + firstSegment, outValues);
+	std::copy(m_Values, m_Values + (readCount - firstSegment), outValues + firstSegment);
+
+	m_ReadHead = Wrap(m_ReadHead + readCount);
+	return readCount;
+}
+
+template< typename ValueType, size_t tSize >
+size_t RingBuffer<ValueType, tSize>::AcquireWriteSpan(ValueType** outSpan) {
+
+	*outSpan = m_Values + m_WriteHead;
+	return std::min(WritableCount(), tSize - m_WriteHead);
+}
+
+template< typename ValueType, size_t tSize >
+void RingBuffer<ValueType, tSize>::CommitWrite(size_t count) {
+
+	// You can't commit more than the acquired span
+	MIST_ASSERT(count <= std::min(WritableCount(), tSize - m_WriteHead));
+	m_WriteHead = Wrap(m_WriteHead + count);
+}
+
+template< typename ValueType, size_t tSize >
+size_t RingBuffer<ValueType, tSize>::AcquireReadSpan(const ValueType** outSpan) const {
+
+	size_t readPosition = Wrap(m_ReadHead + 1);
+	*outSpan = m_Values + readPosition;
+	return std::min(ReadableCount(), tSize - readPosition);
+}
+
+template< typename ValueType, size_t tSize >
+void RingBuffer<ValueType, tSize>::CommitRead(size_t count) {
+
+	// You can't commit more than the acquired span
+	MIST_ASSERT(count <= std::min(ReadableCount(), tSize - Wrap(m_ReadHead + 1)));
+	m_ReadHead = Wrap(m_ReadHead + count);
+}
+
+template< typename ValueType, size_t tSize >
+size_t RingBuffer<ValueType, tSize>::PeekReadSpans(const ValueType** outFirstSpan, size_t* outFirstCount, const ValueType** outSecondSpan) const {
+
+	*outFirstCount = AcquireReadSpan(outFirstSpan);
+	*outSecondSpan = m_Values;
+	return ReadableCount();
+}
+
+template< typename ValueType, size_t tSize >
+size_t RingBuffer<ValueType, tSize>::ReadableCount() const {
+	// Everything between the previous read and the next write
+	return Wrap(m_WriteHead + tSize - m_ReadHead - 1);
+}
+
+template< typename ValueType, size_t tSize >
+size_t RingBuffer<ValueType, tSize>::WritableCount() const {
+	// Everything between the next write and the previous read
+	return Wrap(m_ReadHead + tSize - m_WriteHead);
+}
+
 template< typename ValueType, size_t tSize >
 size_t RingBuffer<ValueType, tSize>::Size() const {
 	return tSize;
 }
 
+template< typename ValueType, size_t tSize >
+size_t RingBuffer<ValueType, tSize>::Wrap(size_t index) {
+
+	MIST_ASSERT(index < tSize * 2);
+	if (IS_POWER_OF_TWO) {
+		return index & (tSize - 1);
+	}
+	else {
+		return index >= tSize ? index - tSize : index;
+	}
+}
+
 MIST_NAMESPACE_END
@@ -2,13 +2,15 @@
 
 #include <Mist_Common/include/UtilityMacros.h>
 #include "../allocators/CppAllocator.h"
+#include "../allocators/AllocatorStorage.h"
 #include <type_traits>
 
 MIST_NAMESPACE
 
 // SingleList is a simple singly linked list
+// The allocator instance is kept by the list, stateless allocators don't take any space.
 template< typename ValueType, typename Allocator = CppAllocator >
-class SingleList {
+class SingleList : private Detail::AllocatorStorage<Allocator> {
 
 public:
 
@@ -35,9 +37,25 @@ public:
 		typename Condition = typename std::enable_if<std::is_convertible<WriteType, ValueType>::value>::type >
 	void InsertAsLast(WriteType&& writeValue);
 
+	// Remove the node, this operation runs at O(n) time unless the node is the head
+	// @Detail: The previous node has to be found by walking from the head, prefer RemoveAfter or EraseIf
+	//  when removing many nodes.
 	void Remove(Node* node);
 
+	// Remove the node following the node, this operation runs at O(1) time
+	void RemoveAfter(Node* node);
 
+	// Remove every value that satisfies the predicate in a single pass, returns how many values were removed
+	// @Example: Purging the expired entries of a queue would look like:
+	//
+	//		queue.EraseIf([currentFrame](const Entry& entry) { return entry.m_Frame < currentFrame; });
+	template< typename PredicateType >
+	size_t EraseIf(PredicateType predicate);
+
+	// Move all the nodes of the other list to the back of this list, this operation runs at O(1) time
+	// @Detail: The nodes aren't reallocated, both lists must be able to free each other's nodes
+	//  (Such as a stateless allocator or a reference to the same arena or pool).
+	void Splice(SingleList& other);
 
 	// Retrieve the value stored at index, this operation runs at O(n) time
 	ValueType* RetrieveValueAt(size_t index);
@@ -50,6 +68,7 @@ public:
 	ValueType* LastValue();
 
 	Node* FirstNode();
+	const Node* FirstNode() const;
 
 	Node* LastNode();
 
@@ -57,6 +76,14 @@ public:
 
 	void Clear();
 
+	// Empty the list without freeing the nodes.
+	// @Detail: Use this when the allocator releases the nodes' memory in bulk (Such as the PoolAllocator's ReleaseAll
+	//  or the LinearAllocator's Reset), this avoids walking the whole list. Destructors are not called.
+	void Abandon();
+
+	// Retrieve the allocator instance used by the list
+	using Detail::AllocatorStorage<Allocator>::GetAllocator;
+
 	// -Iterators-
 
 	Iterator begin();
@@ -65,6 +92,8 @@ public:
 	// -Structors-
 
 	SingleList() = default;
+	// Create an empty list that uses the allocator instance for all of it's nodes
+	explicit SingleList(const Allocator& allocator);
 	~SingleList();
 
 	// Copying is currently disalllowed in the singlelist this is to avoid accidental copying, if it is desired,
@@ -84,13 +113,15 @@ public:
 
 		// Retrieve the value of the node
 		ValueType* GetValue();
+		const ValueType* GetValue() const;
 
 		// Retrieve the next node
 		Node* NextNode();
+		const Node* NextNode() const;
 
 		Node* operator++();
 
-		friend SingleList<ValueType>;
+		friend SingleList<ValueType, Allocator>;
 
 		// Create a node with the designated value type
 		template< typename WriteType,
@@ -130,6 +161,7 @@ private:
 
 	Node* m_Head = nullptr;
 	Node* m_Tail = nullptr;
+	size_t m_Count = 0;
 };
 
 
@@ -149,9 +181,10 @@ void SingleList<ValueType, Allocator>::InsertAfter(Node* node, WriteType&& write
 	}
 
 	MIST_ASSERT(node != nullptr);
-	Node* newNode = Allocator::template Alloc<Node>(std::forward<WriteType>(writeValue));
+	Node* newNode = GetAllocator().template Alloc<Node>(std::forward<WriteType>(writeValue));
 	newNode->m_Next = node->NextNode();
 	node->m_Next = newNode;
+	++m_Count;
 }
 
 template< typename ValueType, typename Allocator >
@@ -164,15 +197,16 @@ void SingleList<ValueType, Allocator>::InsertAsFirst(WriteType&& writeValue) {
 	if (m_Head == nullptr) {
 
 		MIST_ASSERT(m_Tail == nullptr);
-		m_Head = Allocator::template Alloc<Node>(std::forward<WriteType>(writeValue));
+		m_Head = GetAllocator().template Alloc<Node>(std::forward<WriteType>(writeValue));
 		m_Tail = m_Head;
 	}
 	else {
 
-		Node* newNode = Allocator:: template Alloc<Node>(std::forward<WriteType>(writeValue));
+		Node* newNode = GetAllocator().template Alloc<Node>(std::forward<WriteType>(writeValue));
 		newNode->m_Next = m_Head;
 		m_Head = newNode;
 	}
+	++m_Count;
 }
 
 template< typename ValueType, typename Allocator >
@@ -185,15 +219,16 @@ void SingleList<ValueType, Allocator>::InsertAsLast(WriteType&& writeValue) {
 	if (m_Tail == nullptr) {
 		
 		MIST_ASSERT(m_Head == nullptr);
-		m_Tail = Allocator:: template Alloc<Node>(std::forward<WriteType>(writeValue));
+		m_Tail = GetAllocator().template Alloc<Node>(std::forward<WriteType>(writeValue));
 		m_Head = m_Tail;
 	}
 	else {
 
 		MIST_ASSERT(m_Tail->m_Next == nullptr);
-		m_Tail->m_Next = Allocator:: template Alloc<Node>(std::forward<WriteType>(writeValue));
+		m_Tail->m_Next = GetAllocator().template Alloc<Node>(std::forward<WriteType>(writeValue));
 		m_Tail = m_Tail->NextNode();
 	}
+	++m_Count;
 }
 
 template< typename ValueType, typename Allocator >
@@ -202,9 +237,6 @@ void SingleList<ValueType, Allocator>::Remove(Node* node) {
 
 	MIST_ASSERT(node != nullptr);
 
-	Node* previousNode = nullptr;
-	Node* currentNode = m_Head;
-
 	if (node == m_Head) {
 
 		if (m_Head == m_Tail) {
@@ -212,37 +244,95 @@ void SingleList<ValueType, Allocator>::Remove(Node* node) {
 		}
 
 		m_Head = node->NextNode();
-		Allocator::Free(node);
+		GetAllocator().Free(node);
+		--m_Count;
 		return;
 	}
-	else if (node == m_Tail) {
 
-		if (m_Head == m_Tail) {
-			m_Tail = nullptr;
-		}
-		else {
-			m_Tail = RetrieveNodeAt(Size() - 2);
-		}
+	// Find the previous node in order to unlink the node
+	Node* previousNode = m_Head;
+	while (previousNode != nullptr && previousNode->NextNode() != node) {
+		previousNode = previousNode->NextNode();
+	}
 
-		m_Tail->m_Next = nullptr;
-		Allocator::Free(node);
-		return;
+	MIST_ASSERT(previousNode != nullptr);
+	RemoveAfter(previousNode);
+}
+
+template< typename ValueType, typename Allocator >
+void SingleList<ValueType, Allocator>::RemoveAfter(Node* node) {
+
+	MIST_ASSERT(node != nullptr);
+	MIST_ASSERT(node->NextNode() != nullptr);
+
+	Node* removedNode = node->NextNode();
+	node->m_Next = removedNode->NextNode();
+	if (removedNode == m_Tail) {
+		m_Tail = node;
 	}
 
+	GetAllocator().Free(removedNode);
+	--m_Count;
+}
+
+template< typename ValueType, typename Allocator >
+template< typename PredicateType >
+size_t SingleList<ValueType, Allocator>::EraseIf(PredicateType predicate) {
+
+	size_t removedCount = 0;
+	Node* previousNode = nullptr;
+	Node* currentNode = m_Head;
+
+	// Unlink the matching nodes as we go, the previous node is the last node that was kept
 	while (currentNode != nullptr) {
 
-		if (currentNode == node) {
-			
-			Allocator::Free(currentNode);
-			previousNode->m_Next = nullptr;
-			break;
+		Node* nextNode = currentNode->NextNode();
+		if (predicate(*currentNode->GetValue())) {
+
+			if (previousNode == nullptr) {
+				m_Head = nextNode;
+			}
+			else {
+				previousNode->m_Next = nextNode;
+			}
+
+			GetAllocator().Free(currentNode);
+			removedCount++;
+		}
+		else {
+			previousNode = currentNode;
 		}
 
-		previousNode = currentNode;
-		currentNode = previousNode->NextNode();
+		currentNode = nextNode;
 	}
+
+	m_Tail = previousNode;
+	m_Count -= removedCount;
+	return removedCount;
 }
 
+template< typename ValueType, typename Allocator >
+void SingleList<ValueType, Allocator>::Splice(SingleList& other) {
+
+	MIST_ASSERT(&other != this);
+
+	if (other.m_Head == nullptr) {
+		return;
+	}
+
+	if (m_Tail == nullptr) {
+		m_Head = other.m_Head;
+	}
+	else {
+		m_Tail->m_Next = other.m_Head;
+	}
+	m_Tail = other.m_Tail;
+	m_Count += other.m_Count;
+
+	other.m_Head = nullptr;
+	other.m_Tail = nullptr;
+	other.m_Count = 0;
+}
 
 template< typename ValueType, typename Allocator >
 // Retrieve the value stored at index, this operation runs at O(n) time
@@ -290,6 +380,13 @@ typename SingleList<ValueType, Allocator>::Node* SingleList<ValueType, Allocator
 	return m_Head;
 }
 
+template< typename ValueType, typename Allocator >
+const typename SingleList<ValueType, Allocator>::Node* SingleList<ValueType, Allocator>::FirstNode() const {
+
+	MIST_ASSERT(m_Head != nullptr);
+	return m_Head;
+}
+
 
 template< typename ValueType, typename Allocator >
 typename SingleList<ValueType, Allocator>::Node* SingleList<ValueType, Allocator>::LastNode() {
@@ -299,23 +396,10 @@ typename SingleList<ValueType, Allocator>::Node* SingleList<ValueType, Allocator
 }
 
 template< typename ValueType, typename Allocator >
-// Get the back node of the list
+// Get the number of nodes in the list
 size_t SingleList<ValueType, Allocator>::Size() const {
 
-	// If we have nothing, return 0
-	if (m_Head == nullptr) {
-		return 0;
-	}
-
-	size_t count = 0;
-	Node* next = m_Head;
-	while (next != nullptr) {
-
-		count++;
-		next = next->NextNode();
-	}
-
-	return count;
+	return m_Count;
 }
 
 template< typename ValueType, typename Allocator >
@@ -327,18 +411,27 @@ void SingleList<ValueType, Allocator>::Clear() {
 	while (currentNode != nullptr) {
 		
 		Node* nextNode = currentNode->NextNode();
-		Allocator::Free(currentNode);
+		GetAllocator().Free(currentNode);
 		currentNode = nextNode;
 	}
 
 	m_Head = nullptr;
 	m_Tail = nullptr;
+	m_Count = 0;
+}
+
+template< typename ValueType, typename Allocator >
+void SingleList<ValueType, Allocator>::Abandon() {
+
+	m_Head = nullptr;
+	m_Tail = nullptr;
+	m_Count = 0;
 }
 
 template< typename ValueType, typename Allocator >
 typename SingleList<ValueType, Allocator>::Iterator SingleList<ValueType, Allocator>::begin() {
 
-	return Iterator(FirstNode());
+	return Iterator(m_Head);
 }
 
 template< typename ValueType, typename Allocator >
@@ -347,11 +440,17 @@ typename SingleList<ValueType, Allocator>::Iterator SingleList<ValueType, Alloca
 	return Iterator(nullptr);
 }
 
+template< typename ValueType, typename Allocator >
+SingleList<ValueType, Allocator>::SingleList(const Allocator& allocator) : Detail::AllocatorStorage<Allocator>(allocator) {}
+
 template< typename ValueType, typename Allocator >
 SingleList<ValueType, Allocator>::SingleList(SingleList&& rhs) {
 
 	std::swap(m_Head, rhs.m_Head);
 	std::swap(m_Tail, rhs.m_Tail);
+	std::swap(m_Count, rhs.m_Count);
+	// The nodes belong to the allocator, it has to follow the nodes
+	std::swap(GetAllocator(), rhs.GetAllocator());
 }
 
 template< typename ValueType, typename Allocator >
@@ -359,6 +458,9 @@ SingleList<ValueType, Allocator>& SingleList<ValueType, Allocator>::operator=(Si
 
 	std::swap(m_Head, rhs.m_Head);
 	std::swap(m_Tail, rhs.m_Tail);
+	std::swap(m_Count, rhs.m_Count);
+	// The nodes belong to the allocator, it has to follow the nodes
+	std::swap(GetAllocator(), rhs.GetAllocator());
 
 	return *this;
 }
@@ -383,6 +485,12 @@ ValueType* SingleList<ValueType, Allocator>::Node::GetValue() {
 	return &m_Value;
 }
 
+template< typename ValueType, typename Allocator >
+const ValueType* SingleList<ValueType, Allocator>::Node::GetValue() const {
+
+	return &m_Value;
+}
+
 // Retrieve the next node
 template< typename ValueType, typename Allocator >
 typename SingleList<ValueType, Allocator>::Node* SingleList<ValueType, Allocator>::Node::NextNode() {
@@ -390,6 +498,12 @@ typename SingleList<ValueType, Allocator>::Node* SingleList<ValueType, Allocator
 	return m_Next;
 }
 
+template< typename ValueType, typename Allocator >
+const typename SingleList<ValueType, Allocator>::Node* SingleList<ValueType, Allocator>::Node::NextNode() const {
+
+	return m_Next;
+}
+
 template< typename ValueType, typename Allocator >
 typename SingleList<ValueType, Allocator>::Node* SingleList<ValueType, Allocator>::Node::operator++() {
 	
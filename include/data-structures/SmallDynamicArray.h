@@ -0,0 +1,485 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../allocators/CppAllocator.h"
+#include "../allocators/AllocatorStorage.h"
+#include "GrowthPolicy.h"
+#include "DynamicArray.h"
+#include "../utility/TypeTraits.h"
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+// SmallDynamicArray is a DynamicArray that stores it's first tInlineCapacity values inline, the values only spill
+// to the allocator once the array grows past the inline capacity.
+// Arrays that are usually small (Such as the children of an entity) then don't allocate at all and keep
+// their values in the cache lines of the object that owns them.
+// @Detail: The API matches the DynamicArray. Unlike the DynamicArray, moving a small array that is still inline
+//  moves every value, the pointers to the values of the moved array are no longer valid.
+// @Example: A list of contacts that rarely holds more than 4 contacts would look like:
+//
+//		struct Body {
+//			SmallDynamicArray<ContactId, 4> m_Contacts;
+//		};
+template< typename ValueType, size_t tInlineCapacity, typename Allocator = CppAllocator, typename GrowthPolicy = DefaultGrowth >
+class SmallDynamicArray : private Detail::AllocatorStorage<Allocator> {
+	static_assert(tInlineCapacity > 0, "A small dynamic array without inline capacity is a DynamicArray.");
+
+public:
+
+	// -Public API-
+
+	// Write a value into the array at the back
+	template< typename... WriteType >
+	void InsertAsLast(WriteType&&... writeValue);
+
+	// Copy a range of values into the back of the array
+	// @Detail: The memory is only reserved once for the whole range
+	template< typename IteratorType >
+	void InsertRange(IteratorType begin, IteratorType end);
+
+	// Construct count values in place at the back of the array using the passed in arguments
+	template< typename... WriteValues >
+	void AppendN(size_t count, WriteValues&&... writeValues);
+
+	// Remove the last element of the array.
+	// @Detail: the array will not shrink
+	void RemoveLast();
+
+	// Shrink the array to the desired size
+	// @Detail: The values move back inline if they fit in the inline capacity
+	void ShrinkToSize();
+
+	// Resize the array to fit the desired size
+	// @Detail: This might remove some elements from the array
+	//  a size of zero is disallowed, call clear instead if you intend to empty the array
+	template< typename... WriteValues >
+	void Resize(size_t desiredSize, WriteValues&&... defaultValue);
+
+	// Reserve space for size additional values
+	void ReserveAdditional(size_t size);
+
+	ValueType& operator[](size_t index);
+
+	ValueType* GetValue(size_t index);
+
+	ValueType* FirstValue();
+
+	ValueType* LastValue();
+
+	ValueType* AsRawArray();
+	const ValueType* AsRawArray() const;
+
+	size_t Size() const;
+
+	size_t ReservedSize() const;
+
+	// Determine if the values are stored inline, an inline array hasn't allocated any memory
+	bool IsInline() const;
+
+	// Retrieve the allocator instance used by the array
+	using Detail::AllocatorStorage<Allocator>::GetAllocator;
+
+	// Remove the contents of the array, the allocated memory is released and the array goes back to it's inline storage
+	void Clear();
+
+	// -Types-
+	static constexpr size_t INLINE_CAPACITY = tInlineCapacity;
+
+	// -Iterators-
+
+	ValueType* begin();
+	ValueType* end();
+	const ValueType* begin() const;
+	const ValueType* end() const;
+
+	// -Structors-
+
+	SmallDynamicArray() = default;
+	// Create a small dynamic array with the desired reserved space, the values are only allocated
+	// if the reserved space is bigger than the inline capacity
+	SmallDynamicArray(size_t desiredReservedSpace, const Allocator& allocator = Allocator());
+
+	// Create an empty small dynamic array that uses the allocator instance once it spills
+	explicit SmallDynamicArray(const Allocator& allocator);
+
+	~SmallDynamicArray();
+
+	// Copying is currently disalllowed in the small dynamic array, this is to avoid accidental copying, same as the DynamicArray
+	SmallDynamicArray(const SmallDynamicArray&) = delete;
+	SmallDynamicArray& operator=(const SmallDynamicArray&) = delete;
+
+	SmallDynamicArray(SmallDynamicArray&&);
+	SmallDynamicArray& operator=(SmallDynamicArray&&);
+
+private:
+
+	ValueType* InlineValues();
+
+	// Assure that we have enough reserved space for the required amount of items,
+	// this grows the memory using the growth policy
+	void GrowToFit(size_t requiredCount);
+
+	// Move the items to a block holding newCapacity items, or to the inline storage if they fit
+	void Reallocate(size_t newCapacity);
+
+	// Move count values to the destination and destroy them in the source
+	static void RelocateValues(ValueType* source, ValueType* destination, size_t count);
+
+	// Destroy the items from index to the end of the array, this doesn't release any memory
+	void DestroyFrom(size_t index);
+
+	// Steal the allocated memory of the array, or move it's inline values
+	void TakeValues(SmallDynamicArray& rhs);
+
+	// Points to the inline storage until the array spills to the allocator
+	ValueType* m_Values = InlineValues();
+	size_t m_ItemCount = 0;
+	size_t m_Capacity = tInlineCapacity;
+	typename std::aligned_storage<sizeof(ValueType), alignof(ValueType)>::type m_InlineStorage[tInlineCapacity];
+};
+
+// -Implementation-
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+template< typename... WriteType >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::InsertAsLast(WriteType&&... writeValue) {
+
+	if (m_ItemCount == m_Capacity) {
+		GrowToFit(m_ItemCount + 1);
+	}
+
+	new (m_Values + m_ItemCount) ValueType(std::forward<WriteType>(writeValue)...);
+	m_ItemCount++;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+template< typename IteratorType >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::InsertRange(IteratorType begin, IteratorType end) {
+
+	size_t rangeSize = static_cast<size_t>(std::distance(begin, end));
+	if (rangeSize == 0) {
+		return;
+	}
+
+	GrowToFit(m_ItemCount + rangeSize);
+
+	ValueType* values = m_Values + m_ItemCount;
+	for (; begin != end; ++begin, ++values) {
+		new (values) ValueType(*begin);
+	}
+
+	m_ItemCount += rangeSize;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+template< typename... WriteValues >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::AppendN(size_t count, WriteValues&&... writeValues) {
+
+	if (count == 0) {
+		return;
+	}
+
+	GrowToFit(m_ItemCount + count);
+
+	Detail::ConstructValues(m_Values + m_ItemCount, count, std::integral_constant<bool, std::is_trivially_copyable<ValueType>::value>(), writeValues...);
+	m_ItemCount += count;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::RemoveLast() {
+
+	ValueType* lastItem = LastValue();
+	lastItem->ValueType::~ValueType();
+
+	m_ItemCount--;
+
+#if MIST_DEBUG
+	// Scramble the item to assure that it isn't reused and assure that we crash the program
+	memset(static_cast<void*>(lastItem), 0xDB, sizeof(ValueType));
+#endif
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::ShrinkToSize() {
+
+	if (IsInline() || m_Capacity == m_ItemCount) {
+		return;
+	}
+
+	Reallocate(m_ItemCount);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+template< typename... WriteValues >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::Resize(size_t desiredSize, WriteValues&&... defaultValues) {
+
+	// Call Clear if you want to empty out the array
+	MIST_ASSERT(desiredSize > 0);
+
+	if (m_ItemCount == desiredSize) {
+		return;
+	}
+	else if (desiredSize > m_ItemCount) {
+		AppendN(desiredSize - m_ItemCount, std::forward<WriteValues>(defaultValues)...);
+	}
+	else {
+		DestroyFrom(desiredSize);
+	}
+
+	MIST_ASSERT(m_ItemCount == desiredSize);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::ReserveAdditional(size_t size) {
+
+	if (m_ItemCount + size > m_Capacity) {
+		Reallocate(m_ItemCount + size);
+	}
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+ValueType& SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::operator[](size_t index) {
+
+	return *GetValue(index);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::GetValue(size_t index) {
+
+	MIST_ASSERT(index < m_ItemCount);
+	return m_Values + index;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::FirstValue() {
+
+	return GetValue(0);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::LastValue() {
+
+	return GetValue(m_ItemCount - 1);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::AsRawArray() {
+
+	return m_Values;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+const ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::AsRawArray() const {
+
+	return m_Values;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+size_t SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::Size() const {
+
+	return m_ItemCount;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+size_t SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::ReservedSize() const {
+
+	return m_Capacity;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+bool SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::IsInline() const {
+
+	return m_Values == reinterpret_cast<const ValueType*>(m_InlineStorage);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::Clear() {
+
+	DestroyFrom(0);
+
+	if (IsInline() == false) {
+		Detail::FreeAligned(GetAllocator(), m_Values, alignof(ValueType));
+		m_Values = InlineValues();
+		m_Capacity = tInlineCapacity;
+	}
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::begin() {
+
+	return m_Values;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::end() {
+
+	return m_Values + m_ItemCount;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+const ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::begin() const {
+
+	return m_Values;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+const ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::end() const {
+
+	return m_Values + m_ItemCount;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+ValueType* SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::InlineValues() {
+
+	return reinterpret_cast<ValueType*>(m_InlineStorage);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::GrowToFit(size_t requiredCount) {
+
+	if (m_Capacity >= requiredCount) {
+		return;
+	}
+
+	size_t newCapacity = GrowthPolicy::NextCapacity(m_Capacity, requiredCount);
+	MIST_ASSERT(newCapacity >= requiredCount);
+	Reallocate(newCapacity);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::Reallocate(size_t newCapacity) {
+
+	MIST_ASSERT(newCapacity >= m_ItemCount);
+
+	// Move back into the inline storage once the values fit
+	if (newCapacity <= tInlineCapacity) {
+
+		if (IsInline() == false) {
+			ValueType* heapValues = m_Values;
+			RelocateValues(heapValues, InlineValues(), m_ItemCount);
+			Detail::FreeAligned(GetAllocator(), heapValues, alignof(ValueType));
+			m_Values = InlineValues();
+			m_Capacity = tInlineCapacity;
+		}
+		return;
+	}
+
+	// Let the allocator move the block for us if the values can be moved bitwise
+	if (IsInline() == false && IsTriviallyRelocatable<ValueType>::value) {
+		m_Values = reinterpret_cast<ValueType*>(Detail::ReallocateAligned(GetAllocator(), m_Values, newCapacity * sizeof(ValueType), alignof(ValueType)));
+		m_Capacity = newCapacity;
+		return;
+	}
+
+	ValueType* newValues = reinterpret_cast<ValueType*>(Detail::AllocateAligned(GetAllocator(), newCapacity * sizeof(ValueType), alignof(ValueType)));
+	RelocateValues(m_Values, newValues, m_ItemCount);
+	if (IsInline() == false) {
+		Detail::FreeAligned(GetAllocator(), m_Values, alignof(ValueType));
+	}
+
+	m_Values = newValues;
+	m_Capacity = newCapacity;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::RelocateValues(ValueType* source, ValueType* destination, size_t count) {
+
+	if (IsTriviallyRelocatable<ValueType>::value) {
+		if (count > 0) {
+			memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(ValueType));
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		new (destination + i) ValueType(std::move(source[i]));
+		source[i].ValueType::~ValueType();
+	}
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::DestroyFrom(size_t index) {
+
+	MIST_ASSERT(index <= m_ItemCount);
+
+	// Trivially destructible types don't need to go through every item
+	if (std::is_trivially_destructible<ValueType>::value == false) {
+		for (size_t i = index; i < m_ItemCount; ++i) {
+			m_Values[i].ValueType::~ValueType();
+		}
+	}
+
+#if MIST_DEBUG
+	// Scramble the items to assure that they aren't reused and assure that we crash the program
+	if (index < m_ItemCount) {
+		memset(static_cast<void*>(m_Values + index), 0xDB, (m_ItemCount - index) * sizeof(ValueType));
+	}
+#endif
+
+	m_ItemCount = index;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+void SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::TakeValues(SmallDynamicArray& rhs) {
+
+	MIST_ASSERT(m_ItemCount == 0 && IsInline());
+
+	// The allocator follows the values even when they're inline, the heap memory belongs to it
+	// and the inline values will grow into it
+	std::swap(GetAllocator(), rhs.GetAllocator());
+
+	if (rhs.IsInline()) {
+		RelocateValues(rhs.m_Values, InlineValues(), rhs.m_ItemCount);
+		m_ItemCount = rhs.m_ItemCount;
+		rhs.m_ItemCount = 0;
+		return;
+	}
+
+	m_Values = rhs.m_Values;
+	m_ItemCount = rhs.m_ItemCount;
+	m_Capacity = rhs.m_Capacity;
+
+	rhs.m_Values = rhs.InlineValues();
+	rhs.m_ItemCount = 0;
+	rhs.m_Capacity = tInlineCapacity;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::SmallDynamicArray(size_t desiredReservedSpace, const Allocator& allocator)
+	: Detail::AllocatorStorage<Allocator>(allocator) {
+
+	ReserveAdditional(desiredReservedSpace);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::SmallDynamicArray(const Allocator& allocator)
+	: Detail::AllocatorStorage<Allocator>(allocator) {}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::SmallDynamicArray(SmallDynamicArray&& rhs) {
+
+	TakeValues(rhs);
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>& SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::operator=(SmallDynamicArray&& rhs) {
+
+	if (&rhs != this) {
+		Clear();
+		TakeValues(rhs);
+	}
+	return *this;
+}
+
+template< typename ValueType, size_t tInlineCapacity, typename Allocator, typename GrowthPolicy >
+SmallDynamicArray<ValueType, tInlineCapacity, Allocator, GrowthPolicy>::~SmallDynamicArray() {
+
+	Clear();
+}
+
+MIST_NAMESPACE_END
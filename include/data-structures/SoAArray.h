@@ -0,0 +1,607 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../allocators/CppAllocator.h"
+#include "../allocators/AllocatorStorage.h"
+#include "../algorithms/Sorting.h"
+#include "GrowthPolicy.h"
+#include "../utility/TypeTraits.h"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+MIST_NAMESPACE
+
+namespace Detail {
+
+	// The largest alignment of the value types
+	template< typename... ValueTypes >
+	struct MaxAlignmentOf : std::integral_constant<size_t, 1> {};
+
+	template< typename ValueType, typename... ValueTypes >
+	struct MaxAlignmentOf<ValueType, ValueTypes...> : std::integral_constant<size_t,
+		(alignof(ValueType) > MaxAlignmentOf<ValueTypes...>::value) ? alignof(ValueType) : MaxAlignmentOf<ValueTypes...>::value> {};
+}
+
+// A view over a single column of the structure of arrays, the view is invalidated when the array reallocates.
+template< typename ValueType >
+class SoAColumn {
+
+public:
+
+	// -Public API-
+
+	ValueType& operator[](size_t index) const;
+
+	ValueType* AsRawArray() const;
+
+	size_t Size() const;
+
+	// -Iterators-
+
+	ValueType* begin() const;
+	ValueType* end() const;
+
+	// -Structors-
+
+	SoAColumn(ValueType* values, size_t size);
+
+private:
+
+	ValueType* m_Values;
+	size_t m_Size;
+};
+
+// A structure of arrays, every value type is stored in it's own contiguous column instead of being stored
+// together in a struct. Loops that only touch a few of the fields then only fetch the cache lines of those fields.
+// All the columns are stored in a single allocation, the columns share the same size and reserved size.
+// @Detail: Every column starts on a COLUMN_ALIGNMENT boundary and is padded to a multiple of it,
+//  SIMD kernels can use aligned loads over the raw columns and process whole vectors up to the reserved size.
+//  Use the SoAArray alias unless a different allocator or growth policy is required.
+// @Example: A set of particles would look like:
+//
+//		SoAArray<float, float, uint32_t> particles;
+//		particles.InsertAsLast(positionX, velocityX, color);
+//
+//		SoAColumn<float> positions = particles.Column<0>();
+//		SoAColumn<float> velocities = particles.Column<1>();
+//		for (size_t i = 0; i < particles.Size(); ++i) {
+//			positions[i] += velocities[i] * deltaTime;
+//		}
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+class BasicSoAArray : private Detail::AllocatorStorage<Allocator> {
+	static_assert(sizeof...(ValueTypes) > 0, "A structure of arrays requires at least one column.");
+
+public:
+
+	// -Types-
+
+	static constexpr size_t COLUMN_COUNT = sizeof...(ValueTypes);
+
+	// The alignment of the first value of every column
+	static constexpr size_t COLUMN_ALIGNMENT = Detail::MaxAlignmentOf<ValueTypes...>::value > CACHE_LINE_ALIGNMENT
+		? Detail::MaxAlignmentOf<ValueTypes...>::value : CACHE_LINE_ALIGNMENT;
+
+	template< size_t tColumn >
+	using ColumnType = typename std::tuple_element<tColumn, std::tuple<ValueTypes...>>::type;
+
+	// -Public API-
+
+	// Write a value into the back of every column, one value per column
+	template< typename... WriteTypes >
+	void InsertAsLast(WriteTypes&&... writeValues);
+
+	// Remove the last element of every column.
+	// @Detail: the array will not shrink
+	void RemoveLast();
+
+	// Remove the element at index by moving the last element in it's place, this doesn't keep the order of the elements.
+	void SwapRemove(size_t index);
+
+	// Resize the array to fit the desired size, the new elements are value initialized
+	// @Detail: This might remove some elements from the array
+	//  a size of zero is disallowed, call clear instead if you intend to empty the array
+	void Resize(size_t desiredSize);
+
+	// Resize the array to fit the desired size, the new elements are copies of the default values, one per column
+	void Resize(size_t desiredSize, const ValueTypes&... defaultValues);
+
+	// Reserve space for size additional elements in every column
+	void ReserveAdditional(size_t size);
+
+	// Shrink the allocated memory to fit Size() elements in every column
+	void ShrinkToSize();
+
+	// Sort the elements of every column by the values of tColumn
+	// @Detail: The permutation that sorts the key column is computed with SortPermutation and then applied to every column.
+	//  Elements with equal keys keep their relative order. The permutation is allocated from the array's allocator.
+	template< size_t tColumn, typename CompareType = std::less<ColumnType<tColumn>> >
+	void SortBy(CompareType compare = CompareType());
+
+	template< size_t tColumn >
+	ColumnType<tColumn>* GetValue(size_t index);
+
+	// Retrieve a view over a whole column
+	template< size_t tColumn >
+	SoAColumn<ColumnType<tColumn>> Column();
+
+	template< size_t tColumn >
+	SoAColumn<const ColumnType<tColumn>> Column() const;
+
+	size_t Size() const;
+
+	size_t ReservedSize() const;
+
+	// Retrieve the allocator instance used by the array
+	using Detail::AllocatorStorage<Allocator>::GetAllocator;
+
+	// Remove the contents of every column and release the memory
+	void Clear();
+
+	// -Structors-
+
+	BasicSoAArray() = default;
+	// Create a structure of arrays with the desired reserved space in every column
+	// @Detail: Internally, this just invokes ReserveAdditional.
+	BasicSoAArray(size_t desiredReservedSpace, const Allocator& allocator = Allocator());
+
+	// Create an empty structure of arrays that uses the allocator instance for all of it's memory
+	explicit BasicSoAArray(const Allocator& allocator);
+
+	~BasicSoAArray();
+
+	// Copying is disallowed to avoid accidental copying, same as the DynamicArray
+	BasicSoAArray(const BasicSoAArray&) = delete;
+	BasicSoAArray& operator=(const BasicSoAArray&) = delete;
+
+	BasicSoAArray(BasicSoAArray&&);
+	BasicSoAArray& operator=(BasicSoAArray&&);
+
+private:
+
+	using ColumnIndices = std::index_sequence_for<ValueTypes...>;
+
+	template< size_t tColumn >
+	ColumnType<tColumn>* ColumnValues() const;
+
+	// The bytes used by a column of capacity values, padded to the column alignment
+	static size_t ColumnMemorySize(size_t capacity, size_t valueSize);
+
+	// The bytes used by every column of capacity values
+	static size_t MemorySize(size_t capacity);
+
+	// Assure that we have enough reserved space for the required amount of elements,
+	// this grows the memory using the growth policy
+	void GrowToFit(size_t requiredCount);
+
+	// Move the elements to a block holding newCapacity elements per column
+	void Reallocate(size_t newCapacity);
+
+	template< size_t... tColumns >
+	void RelocateColumns(void** newColumns, std::index_sequence<tColumns...>);
+
+	template< typename ValueType >
+	static void RelocateColumn(ValueType* source, ValueType* destination, size_t count);
+
+	template< size_t... tColumns, typename... WriteTypes >
+	void ConstructAt(size_t index, std::index_sequence<tColumns...>, WriteTypes&&... writeValues);
+
+	template< size_t... tColumns >
+	void MoveElement(size_t source, size_t destination, std::index_sequence<tColumns...>);
+
+	template< size_t... tColumns >
+	void ApplyPermutation(size_t* permutation, std::index_sequence<tColumns...>);
+
+	// Destroy the elements from index to the end of every column, this doesn't release any memory
+	void DestroyFrom(size_t index);
+
+	template< size_t... tColumns >
+	void DestroyColumnsFrom(size_t index, std::index_sequence<tColumns...>);
+
+	template< typename ValueType >
+	static void DestroyColumn(ValueType* values, size_t begin, size_t end);
+
+	// The first column is the start of the memory block
+	void* m_Columns[COLUMN_COUNT] = {};
+	size_t m_ItemCount = 0;
+	size_t m_Capacity = 0;
+};
+
+// A structure of arrays using the default allocator and growth policy
+template< typename... ValueTypes >
+using SoAArray = BasicSoAArray<CppAllocator, DefaultGrowth, ValueTypes...>;
+
+// -Implementation-
+
+template< typename ValueType >
+ValueType& SoAColumn<ValueType>::operator[](size_t index) const {
+
+	MIST_ASSERT(index < m_Size);
+	return m_Values[index];
+}
+
+template< typename ValueType >
+ValueType* SoAColumn<ValueType>::AsRawArray() const {
+
+	return m_Values;
+}
+
+template< typename ValueType >
+size_t SoAColumn<ValueType>::Size() const {
+
+	return m_Size;
+}
+
+template< typename ValueType >
+ValueType* SoAColumn<ValueType>::begin() const {
+
+	return m_Values;
+}
+
+template< typename ValueType >
+ValueType* SoAColumn<ValueType>::end() const {
+
+	return m_Values + m_Size;
+}
+
+template< typename ValueType >
+SoAColumn<ValueType>::SoAColumn(ValueType* values, size_t size)
+	: m_Values(values)
+	, m_Size(size) {}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< typename... WriteTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::InsertAsLast(WriteTypes&&... writeValues) {
+
+	static_assert(sizeof...(WriteTypes) == COLUMN_COUNT, "InsertAsLast requires one value per column.");
+
+	GrowToFit(m_ItemCount + 1);
+	ConstructAt(m_ItemCount, ColumnIndices(), std::forward<WriteTypes>(writeValues)...);
+	m_ItemCount++;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::RemoveLast() {
+
+	MIST_ASSERT(m_ItemCount > 0);
+	DestroyFrom(m_ItemCount - 1);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::SwapRemove(size_t index) {
+
+	MIST_ASSERT(index < m_ItemCount);
+
+	size_t lastIndex = m_ItemCount - 1;
+	if (index != lastIndex) {
+		MoveElement(lastIndex, index, ColumnIndices());
+	}
+	DestroyFrom(lastIndex);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::Resize(size_t desiredSize) {
+
+	// Call Clear if you want to empty out the array
+	MIST_ASSERT(desiredSize > 0);
+
+	if (desiredSize < m_ItemCount) {
+		DestroyFrom(desiredSize);
+		return;
+	}
+
+	GrowToFit(desiredSize);
+	for (size_t i = m_ItemCount; i < desiredSize; ++i) {
+		ConstructAt(i, ColumnIndices(), ValueTypes()...);
+	}
+	m_ItemCount = desiredSize;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::Resize(size_t desiredSize, const ValueTypes&... defaultValues) {
+
+	// Call Clear if you want to empty out the array
+	MIST_ASSERT(desiredSize > 0);
+
+	if (desiredSize < m_ItemCount) {
+		DestroyFrom(desiredSize);
+		return;
+	}
+
+	GrowToFit(desiredSize);
+	for (size_t i = m_ItemCount; i < desiredSize; ++i) {
+		ConstructAt(i, ColumnIndices(), defaultValues...);
+	}
+	m_ItemCount = desiredSize;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::ReserveAdditional(size_t size) {
+
+	Reallocate(m_Capacity + size);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::ShrinkToSize() {
+
+	if (m_Capacity != m_ItemCount) {
+		Reallocate(m_ItemCount);
+	}
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t tColumn, typename CompareType >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::SortBy(CompareType compare) {
+
+	if (m_ItemCount < 2) {
+		return;
+	}
+
+	size_t* permutation = static_cast<size_t*>(Detail::AllocateAligned(GetAllocator(), m_ItemCount * sizeof(size_t), alignof(size_t)));
+
+	ColumnType<tColumn>* keys = ColumnValues<tColumn>();
+	SortPermutation(keys, keys + m_ItemCount, permutation, compare);
+	ApplyPermutation(permutation, ColumnIndices());
+
+	Detail::FreeAligned(GetAllocator(), permutation, alignof(size_t));
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t tColumn >
+typename BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::template ColumnType<tColumn>* BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::GetValue(size_t index) {
+
+	MIST_ASSERT(index < m_ItemCount);
+	return ColumnValues<tColumn>() + index;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t tColumn >
+SoAColumn<typename BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::template ColumnType<tColumn>> BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::Column() {
+
+	return SoAColumn<ColumnType<tColumn>>(ColumnValues<tColumn>(), m_ItemCount);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t tColumn >
+SoAColumn<const typename BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::template ColumnType<tColumn>> BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::Column() const {
+
+	return SoAColumn<const ColumnType<tColumn>>(ColumnValues<tColumn>(), m_ItemCount);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+size_t BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::Size() const {
+
+	return m_ItemCount;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+size_t BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::ReservedSize() const {
+
+	return m_Capacity;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::Clear() {
+
+	if (m_Columns[0] == nullptr) {
+		return;
+	}
+
+	DestroyFrom(0);
+	Reallocate(0);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t tColumn >
+typename BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::template ColumnType<tColumn>* BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::ColumnValues() const {
+
+	return static_cast<ColumnType<tColumn>*>(m_Columns[tColumn]);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+size_t BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::ColumnMemorySize(size_t capacity, size_t valueSize) {
+
+	return (capacity * valueSize + COLUMN_ALIGNMENT - 1) & ~(COLUMN_ALIGNMENT - 1);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+size_t BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::MemorySize(size_t capacity) {
+
+	const size_t valueSizes[COLUMN_COUNT] = { sizeof(ValueTypes)... };
+
+	size_t memorySize = 0;
+	for (size_t i = 0; i < COLUMN_COUNT; ++i) {
+		memorySize += ColumnMemorySize(capacity, valueSizes[i]);
+	}
+	return memorySize;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::GrowToFit(size_t requiredCount) {
+
+	if (m_Capacity >= requiredCount) {
+		return;
+	}
+
+	size_t newCapacity = GrowthPolicy::NextCapacity(m_Capacity, requiredCount);
+	MIST_ASSERT(newCapacity >= requiredCount);
+	Reallocate(newCapacity);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::Reallocate(size_t newCapacity) {
+
+	MIST_ASSERT(newCapacity >= m_ItemCount);
+
+	void* newColumns[COLUMN_COUNT] = {};
+	if (newCapacity > 0) {
+
+		// The columns are laid out one after the other in the block, every column starts aligned
+		const size_t valueSizes[COLUMN_COUNT] = { sizeof(ValueTypes)... };
+		uint8_t* column = static_cast<uint8_t*>(Detail::AllocateAligned(GetAllocator(), MemorySize(newCapacity), COLUMN_ALIGNMENT));
+		for (size_t i = 0; i < COLUMN_COUNT; ++i) {
+			newColumns[i] = column;
+			column += ColumnMemorySize(newCapacity, valueSizes[i]);
+		}
+	}
+
+	// The offsets of the columns change with the capacity, every column is moved even when it could be reallocated
+	RelocateColumns(newColumns, ColumnIndices());
+
+	if (m_Columns[0] != nullptr) {
+		Detail::FreeAligned(GetAllocator(), m_Columns[0], COLUMN_ALIGNMENT);
+	}
+
+	for (size_t i = 0; i < COLUMN_COUNT; ++i) {
+		m_Columns[i] = newColumns[i];
+	}
+	m_Capacity = newCapacity;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t... tColumns >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::RelocateColumns(void** newColumns, std::index_sequence<tColumns...>) {
+
+	(void)std::initializer_list<int>{ (RelocateColumn(ColumnValues<tColumns>(), static_cast<ColumnType<tColumns>*>(newColumns[tColumns]), m_ItemCount), 0)... };
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< typename ValueType >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::RelocateColumn(ValueType* source, ValueType* destination, size_t count) {
+
+	if (count == 0) {
+		return;
+	}
+
+	if (IsTriviallyRelocatable<ValueType>::value) {
+		memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(ValueType));
+		return;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		new (destination + i) ValueType(std::move(source[i]));
+		source[i].ValueType::~ValueType();
+	}
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t... tColumns, typename... WriteTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::ConstructAt(size_t index, std::index_sequence<tColumns...>, WriteTypes&&... writeValues) {
+
+	MIST_ASSERT(index < m_Capacity);
+	(void)std::initializer_list<int>{ ((void)new (ColumnValues<tColumns>() + index) ColumnType<tColumns>(std::forward<WriteTypes>(writeValues)), 0)... };
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t... tColumns >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::MoveElement(size_t source, size_t destination, std::index_sequence<tColumns...>) {
+
+	(void)std::initializer_list<int>{ ((void)(ColumnValues<tColumns>()[destination] = std::move(ColumnValues<tColumns>()[source])), 0)... };
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t... tColumns >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::ApplyPermutation(size_t* permutation, std::index_sequence<tColumns...>) {
+
+	// Follow every cycle of the permutation once and rotate the elements of every column along it,
+	// the visited indices are marked by pointing them to themselves
+	for (size_t i = 0; i < m_ItemCount; ++i) {
+
+		if (permutation[i] == i) {
+			continue;
+		}
+
+		std::tuple<ValueTypes...> heldElement(std::move(ColumnValues<tColumns>()[i])...);
+
+		size_t current = i;
+		while (permutation[current] != i) {
+			size_t next = permutation[current];
+			MoveElement(next, current, ColumnIndices());
+			permutation[current] = current;
+			current = next;
+		}
+
+		(void)std::initializer_list<int>{ ((void)(ColumnValues<tColumns>()[current] = std::move(std::get<tColumns>(heldElement))), 0)... };
+		permutation[current] = current;
+	}
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::DestroyFrom(size_t index) {
+
+	MIST_ASSERT(index <= m_ItemCount);
+
+	DestroyColumnsFrom(index, ColumnIndices());
+	m_ItemCount = index;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< size_t... tColumns >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::DestroyColumnsFrom(size_t index, std::index_sequence<tColumns...>) {
+
+	(void)std::initializer_list<int>{ (DestroyColumn(ColumnValues<tColumns>(), index, m_ItemCount), 0)... };
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+template< typename ValueType >
+void BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::DestroyColumn(ValueType* values, size_t begin, size_t end) {
+
+	// Trivially destructible types don't need to go through every item
+	if (std::is_trivially_destructible<ValueType>::value == false) {
+		for (size_t i = begin; i < end; ++i) {
+			values[i].ValueType::~ValueType();
+		}
+	}
+
+#if MIST_DEBUG
+	// Scramble the items to assure that they aren't reused and assure that we crash the program
+	if (begin < end) {
+		memset(static_cast<void*>(values + begin), 0xDB, (end - begin) * sizeof(ValueType));
+	}
+#endif
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::BasicSoAArray(size_t desiredReservedSpace, const Allocator& allocator)
+	: Detail::AllocatorStorage<Allocator>(allocator) {
+
+	ReserveAdditional(desiredReservedSpace);
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::BasicSoAArray(const Allocator& allocator)
+	: Detail::AllocatorStorage<Allocator>(allocator) {}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::BasicSoAArray(BasicSoAArray&& rhs) {
+
+	std::swap(m_Columns, rhs.m_Columns);
+	std::swap(m_ItemCount, rhs.m_ItemCount);
+	std::swap(m_Capacity, rhs.m_Capacity);
+	// The memory belongs to the allocator, it has to follow the memory
+	std::swap(GetAllocator(), rhs.GetAllocator());
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>& BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::operator=(BasicSoAArray&& rhs) {
+
+	std::swap(m_Columns, rhs.m_Columns);
+	std::swap(m_ItemCount, rhs.m_ItemCount);
+	std::swap(m_Capacity, rhs.m_Capacity);
+	// The memory belongs to the allocator, it has to follow the memory
+	std::swap(GetAllocator(), rhs.GetAllocator());
+
+	return *this;
+}
+
+template< typename Allocator, typename GrowthPolicy, typename... ValueTypes >
+BasicSoAArray<Allocator, GrowthPolicy, ValueTypes...>::~BasicSoAArray() {
+
+	Clear();
+}
+
+MIST_NAMESPACE_END
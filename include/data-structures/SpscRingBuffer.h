@@ -0,0 +1,171 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../utility/CacheLine.h"
+#include <atomic>
+#include <utility>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+// A lock free ring buffer for a single producer thread and a single consumer thread.
+// The API matches the RingBuffer, it can be swapped in when the buffer is shared between two threads.
+// @Details: Only one thread may call the write methods (TryWrite, CanWrite) and only one thread may
+//  call the read methods (TryRead, TryPeek, CanRead). As with the RingBuffer, the amount you can write
+//  in one go is tSize - 1.
+//  The heads are published with release stores and observed with acquire loads, each side keeps a cached copy
+//  of the other side's head and only reloads it when the buffer looks full or empty. This keeps the
+//  cache line of the other thread's head from bouncing between cores on every call.
+// @Example: Passing packets from an IO thread to the simulation thread would look like:
+//
+//		SpscRingBuffer<Packet, 256> packets;
+//		// IO thread
+//		while (packets.TryWrite(packet) == false) {}
+//		// Simulation thread
+//		Packet packet;
+//		while (packets.TryRead(&packet)) {
+//			Process(packet);
+//		}
+template< typename ValueType, size_t tSize >
+class SpscRingBuffer {
+	static_assert(tSize > 1, "A Ring Buffer Cannot be of size 0. Is it a typo?");
+
+public:
+
+	// -Public API-
+
+	// Attempts to read from the buffer, also consumes the read.
+	// returns false if no value is available to read
+	// @Detail: Consumer thread only
+	bool TryRead(ValueType* outValue);
+
+	// Attempts to read from the buffer, does not consume the read.
+	// returns false if no value is available to read
+	// @Detail: Consumer thread only
+	bool TryPeek(ValueType* outValue) const;
+
+	// Determine if there is any valid data for the user to read from the buffer
+	// @Detail: Consumer thread only
+	bool CanRead() const;
+
+	// Write a value into the buffer, moving the write head forward.
+	// If the method returns false, that means the next spot hasn't been read yet and nothing is written
+	// @Detail: Producer thread only
+	template< typename WriteType = ValueType,
+		// @Template condition: the Writing type must be convertible to value type
+		typename TemplateCondition = typename std::enable_if<std::is_convertible<WriteType, ValueType>::value>::type >
+	bool TryWrite(WriteType&& writeValue);
+
+	// Determine if there is space to write to in the buffer
+	// @Detail: Producer thread only
+	bool CanWrite() const;
+
+	size_t Size() const;
+
+
+	// -Types-
+	using Type = ValueType;
+
+
+	// -Structors-
+	SpscRingBuffer() : m_Values() {}
+
+	SpscRingBuffer(const SpscRingBuffer&) = delete;
+	SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+private:
+
+	// -Producer cache line-
+	// Determines the location that the next write will occure
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_WriteHead{ 0 };
+	// The producer's last known position of the read head
+	mutable size_t m_CachedReadHead = 0;
+
+	// -Consumer cache line-
+	// Determines the location that the next read will occure
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_ReadHead{ 0 };
+	// The consumer's last known position of the write head
+	mutable size_t m_CachedWriteHead = 0;
+
+	alignas(CACHE_LINE_SIZE) ValueType m_Values[tSize];
+};
+
+
+// -Implementation-
+
+template< typename ValueType, size_t tSize >
+bool SpscRingBuffer<ValueType, tSize>::TryRead(ValueType* outValue) {
+	if (CanRead() == false) {
+		return false;
+	}
+
+	// Only the consumer writes the read head, a relaxed load is enough
+	size_t readHead = m_ReadHead.load(std::memory_order_relaxed);
+	*outValue = std::move(m_Values[readHead]);
+
+	// Release the slot back to the producer once the value has been moved out
+	m_ReadHead.store((readHead + 1) % tSize, std::memory_order_release);
+	return true;
+}
+
+template< typename ValueType, size_t tSize >
+bool SpscRingBuffer<ValueType, tSize>::TryPeek(ValueType* outValue) const {
+	if (CanRead() == false) {
+		return false;
+	}
+
+	*outValue = m_Values[m_ReadHead.load(std::memory_order_relaxed)];
+	return true;
+}
+
+template< typename ValueType, size_t tSize >
+bool SpscRingBuffer<ValueType, tSize>::CanRead() const {
+	size_t readHead = m_ReadHead.load(std::memory_order_relaxed);
+	if (readHead != m_CachedWriteHead) {
+		return true;
+	}
+
+	// The buffer looks empty, refresh our view of the producer
+	// @Detail: The acquire pairs with the producer's release, the written value is visible once we see the head
+	m_CachedWriteHead = m_WriteHead.load(std::memory_order_acquire);
+	return readHead != m_CachedWriteHead;
+}
+
+template< typename ValueType, size_t tSize >
+template< typename WriteType,
+	// @Template Condition: links to condition in class definition
+	typename TemplateCondition >
+bool SpscRingBuffer<ValueType, tSize>::TryWrite(WriteType&& writeValue) {
+	if (CanWrite() == false) {
+		return false;
+	}
+
+	// Only the producer writes the write head, a relaxed load is enough
+	size_t writeHead = m_WriteHead.load(std::memory_order_relaxed);
+	m_Values[writeHead] = std::forward<WriteType&&>(writeValue);
+
+	// Publish the value to the consumer
+	m_WriteHead.store((writeHead + 1) % tSize, std::memory_order_release);
+	return true;
+}
+
+template< typename ValueType, size_t tSize >
+bool SpscRingBuffer<ValueType, tSize>::CanWrite() const {
+	// You can't write where hasn't been read yet
+	size_t nextWriteHead = (m_WriteHead.load(std::memory_order_relaxed) + 1) % tSize;
+	if (nextWriteHead != m_CachedReadHead) {
+		return true;
+	}
+
+	// The buffer looks full, refresh our view of the consumer
+	// @Detail: The acquire pairs with the consumer's release, the slot is no longer in use once we see the head
+	m_CachedReadHead = m_ReadHead.load(std::memory_order_acquire);
+	return nextWriteHead != m_CachedReadHead;
+}
+
+template< typename ValueType, size_t tSize >
+size_t SpscRingBuffer<ValueType, tSize>::Size() const {
+	return tSize;
+}
+
+MIST_NAMESPACE_END
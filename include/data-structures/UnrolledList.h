@@ -0,0 +1,576 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../allocators/CppAllocator.h"
+#include "../allocators/AllocatorStorage.h"
+#include "../utility/CacheLine.h"
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+namespace Detail {
+
+	// By default a node holds as many values as fit in two cache lines, with at least 4 values per node
+	template< typename ValueType >
+	constexpr size_t DefaultUnrolledNodeCapacity() {
+		return (CACHE_LINE_SIZE * 2 - sizeof(void*) * 2) / sizeof(ValueType) > 4 ? (CACHE_LINE_SIZE * 2 - sizeof(void*) * 2) / sizeof(ValueType) : 4;
+	}
+}
+
+// UnrolledList is a singly linked list where every node holds up to tNodeCapacity values.
+// The API matches the SingleList, but the positions are iterators instead of nodes as a node holds multiple values.
+// Iterating and appending only chase a pointer every tNodeCapacity values, this cuts the cache misses of
+// the SingleList by roughly the node capacity.
+// @Detail: Appending fills the last node before allocating a new one. Inserting in the middle of a full node
+//  splits it in two, removing from a node merges it with the next node once they both fit into half a node.
+//  InsertAsFirst splits a full head the same way, the head node itself never changes.
+//  Inserting or removing invalidates the iterators to the node that was modified (and its next node when merging).
+//  An iterator caches the node before its own, so a split, a merge or freeing a node that became empty
+//  also invalidates the iterators to the node that now follows the modified node.
+// @Example: An event list that is appended to and then iterated every frame would look like:
+//
+//		UnrolledList<Event> events;
+//		events.InsertAsLast(event);
+//		...
+//		for (Event& event : events) {
+//			Process(event);
+//		}
+template< typename ValueType, size_t tNodeCapacity = Detail::DefaultUnrolledNodeCapacity<ValueType>(), typename Allocator = CppAllocator >
+class UnrolledList : private Detail::AllocatorStorage<Allocator> {
+	static_assert(tNodeCapacity > 1, "A node of the unrolled list must be able to hold more than one value, use the SingleList instead.");
+
+public:
+
+	class Node;
+	class Iterator;
+
+	// -Public API-
+
+	// Write a value into the list after the value at the position
+	// returns the position of the new value
+	template< typename WriteType,
+		// @Template Condition: the write type must be convertible to value type
+		typename Condition = typename std::enable_if<std::is_convertible<WriteType, ValueType>::value>::type >
+	Iterator InsertAfter(Iterator position, WriteType&& writeValue);
+
+	// Write a value into the list at the front
+	template< typename WriteType,
+		// @Template Condition: the write type must be convertible to value type
+		typename Condition = typename std::enable_if<std::is_convertible<WriteType, ValueType>::value>::type >
+	void InsertAsFirst(WriteType&& writeValue);
+
+	// Write a value into the list at the back
+	template< typename WriteType,
+		// @Template Condition: the write type must be convertible to value type
+		typename Condition = typename std::enable_if<std::is_convertible<WriteType, ValueType>::value>::type >
+	void InsertAsLast(WriteType&& writeValue);
+
+	// Remove the value at the position
+	// returns the position of the value that followed the removed value
+	Iterator Remove(Iterator position);
+
+	// Retrieve the value stored at index, this operation runs at O(n / tNodeCapacity) time
+	ValueType* RetrieveValueAt(size_t index);
+
+	ValueType* FirstValue();
+
+	ValueType* LastValue();
+
+	size_t Size() const;
+
+	// Determine how many nodes are allocated
+	size_t NodeCount() const;
+
+	void Clear();
+
+	// Empty the list without freeing the nodes.
+	// @Detail: Use this when the allocator releases the nodes' memory in bulk (Such as the PoolAllocator's ReleaseAll
+	//  or the LinearAllocator's Reset), this avoids walking the whole list. Destructors are not called.
+	void Abandon();
+
+	// Retrieve the allocator instance used by the list
+	using Detail::AllocatorStorage<Allocator>::GetAllocator;
+
+	// -Types-
+	using Type = ValueType;
+	static constexpr size_t NODE_CAPACITY = tNodeCapacity;
+
+	// -Iterators-
+
+	Iterator begin();
+	Iterator end();
+
+	// -Structors-
+
+	UnrolledList() = default;
+	// Create an empty list that uses the allocator instance for all of it's nodes
+	explicit UnrolledList(const Allocator& allocator);
+	~UnrolledList();
+
+	// Copying is currently disalllowed in the unrolled list this is to avoid accidental copying, if it is desired,
+	// an explicit copy method would be prefered, preferably outside this class in order to avoid
+	// cluttering the api
+	UnrolledList(const UnrolledList&) = delete;
+	UnrolledList& operator=(const UnrolledList&) = delete;
+
+	UnrolledList(UnrolledList&& rhs);
+	UnrolledList& operator=(UnrolledList&& rhs);
+
+	class Node {
+
+	public:
+
+		// Retrieve the value at index in the node
+		ValueType* GetValue(size_t index);
+
+		// Retrieve the next node
+		Node* NextNode();
+
+		size_t Count() const;
+
+		friend UnrolledList<ValueType, tNodeCapacity, Allocator>;
+
+		Node() = default;
+
+	private:
+
+		ValueType* Values();
+
+		Node* m_Next = nullptr;
+		size_t m_Count = 0;
+		// The values are constructed in place, only the first m_Count values are alive
+		typename std::aligned_storage<sizeof(ValueType), alignof(ValueType)>::type m_Values[tNodeCapacity];
+	};
+
+	class Iterator {
+
+	public:
+
+		// -Public API-
+
+		// Advance the iterator forward
+		Iterator operator++();
+
+		bool operator!=(const Iterator& rhs) const;
+		bool operator==(const Iterator& rhs) const;
+
+		ValueType& operator*();
+		ValueType* operator->();
+
+		ValueType* GetValue();
+
+		// -Structors-
+		Iterator() = default;
+
+		friend UnrolledList<ValueType, tNodeCapacity, Allocator>;
+
+	private:
+
+		Iterator(Node* previousNode, Node* node, size_t index);
+
+		// The previous node is kept in order to unlink the node in O(1) when it's emptied
+		Node* m_PreviousNode = nullptr;
+		Node* m_TargetNode = nullptr;
+		size_t m_Index = 0;
+	};
+
+private:
+
+	// Create an empty node after the node, or as the head if the node is null
+	Node* CreateNodeAfter(Node* node);
+
+	// Unlink the empty node and free it
+	void FreeNode(Node* previousNode, Node* node);
+
+	// Move the values from index to the end of the node one position to the right, the spot at index is left unconstructed
+	static void OpenGap(Node* node, size_t index);
+
+	// Move the values after the index on top of the destroyed value at index
+	static void CloseGap(Node* node, size_t index);
+
+	// Move the values of the source node from index to the end of the destination node
+	static void MoveValues(Node* source, size_t index, Node* destination);
+
+	Node* m_Head = nullptr;
+	Node* m_Tail = nullptr;
+	size_t m_Count = 0;
+};
+
+
+// -Implementation-
+
+// -UnrolledList-
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+template< typename WriteType, typename Condition >
+typename UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator UnrolledList<ValueType, tNodeCapacity, Allocator>::InsertAfter(Iterator position, WriteType&& writeValue) {
+
+	Node* node = position.m_TargetNode;
+	MIST_ASSERT(node != nullptr);
+	MIST_ASSERT(position.m_Index < node->m_Count);
+
+	size_t insertIndex = position.m_Index + 1;
+	Node* previousNode = position.m_PreviousNode;
+
+	// Split the full node in two, the second half moves into a new node
+	if (node->m_Count == tNodeCapacity) {
+
+		Node* splitNode = CreateNodeAfter(node);
+		MoveValues(node, tNodeCapacity / 2, splitNode);
+
+		if (insertIndex > node->m_Count) {
+			insertIndex -= node->m_Count;
+			previousNode = node;
+			node = splitNode;
+		}
+	}
+
+	OpenGap(node, insertIndex);
+	new (node->Values() + insertIndex) ValueType(std::forward<WriteType>(writeValue));
+	++node->m_Count;
+	++m_Count;
+
+	return Iterator(previousNode, node, insertIndex);
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+template< typename WriteType, typename Condition >
+void UnrolledList<ValueType, tNodeCapacity, Allocator>::InsertAsFirst(WriteType&& writeValue) {
+
+	if (m_Head == nullptr) {
+		CreateNodeAfter(nullptr);
+	}
+	// Split the full head in place instead of linking a new head, the head node never changes
+	// and the iterators to the following nodes keep a valid previous node
+	else if (m_Head->m_Count == tNodeCapacity) {
+		Node* splitNode = CreateNodeAfter(m_Head);
+		MoveValues(m_Head, tNodeCapacity / 2, splitNode);
+	}
+
+	OpenGap(m_Head, 0);
+	new (m_Head->Values()) ValueType(std::forward<WriteType>(writeValue));
+	++m_Head->m_Count;
+	++m_Count;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+template< typename WriteType, typename Condition >
+void UnrolledList<ValueType, tNodeCapacity, Allocator>::InsertAsLast(WriteType&& writeValue) {
+
+	// Only allocate once the last node is full
+	if (m_Tail == nullptr || m_Tail->m_Count == tNodeCapacity) {
+		CreateNodeAfter(m_Tail);
+	}
+
+	new (m_Tail->Values() + m_Tail->m_Count) ValueType(std::forward<WriteType>(writeValue));
+	++m_Tail->m_Count;
+	++m_Count;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+typename UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator UnrolledList<ValueType, tNodeCapacity, Allocator>::Remove(Iterator position) {
+
+	Node* node = position.m_TargetNode;
+	MIST_ASSERT(node != nullptr);
+	MIST_ASSERT(position.m_Index < node->m_Count);
+
+	size_t index = position.m_Index;
+	node->Values()[index].~ValueType();
+	CloseGap(node, index);
+	--node->m_Count;
+	--m_Count;
+
+	if (node->m_Count == 0) {
+		Node* nextNode = node->m_Next;
+		FreeNode(position.m_PreviousNode, node);
+		return Iterator(position.m_PreviousNode, nextNode, 0);
+	}
+
+	// Merge the next node into this node once both fit in half a node, this keeps the nodes from becoming sparse
+	// while leaving room to insert without splitting right away
+	Node* nextNode = node->m_Next;
+	if (nextNode != nullptr && node->m_Count + nextNode->m_Count <= tNodeCapacity / 2) {
+		MoveValues(nextNode, 0, node);
+		FreeNode(node, nextNode);
+	}
+
+	if (index < node->m_Count) {
+		return Iterator(position.m_PreviousNode, node, index);
+	}
+	return Iterator(node, node->m_Next, 0);
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+ValueType* UnrolledList<ValueType, tNodeCapacity, Allocator>::RetrieveValueAt(size_t index) {
+
+	MIST_ASSERT(index < m_Count);
+
+	// Skip whole nodes until the one holding the index
+	Node* node = m_Head;
+	while (index >= node->m_Count) {
+		index -= node->m_Count;
+		node = node->m_Next;
+	}
+	return node->GetValue(index);
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+ValueType* UnrolledList<ValueType, tNodeCapacity, Allocator>::FirstValue() {
+
+	MIST_ASSERT(m_Head != nullptr);
+	return m_Head->GetValue(0);
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+ValueType* UnrolledList<ValueType, tNodeCapacity, Allocator>::LastValue() {
+
+	MIST_ASSERT(m_Tail != nullptr);
+	return m_Tail->GetValue(m_Tail->m_Count - 1);
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+size_t UnrolledList<ValueType, tNodeCapacity, Allocator>::Size() const {
+
+	return m_Count;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+size_t UnrolledList<ValueType, tNodeCapacity, Allocator>::NodeCount() const {
+
+	size_t count = 0;
+	for (Node* node = m_Head; node != nullptr; node = node->m_Next) {
+		++count;
+	}
+	return count;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+void UnrolledList<ValueType, tNodeCapacity, Allocator>::Clear() {
+
+	Node* currentNode = m_Head;
+
+	// Loop through all the nodes, destroy their values and delete them
+	while (currentNode != nullptr) {
+
+		Node* nextNode = currentNode->m_Next;
+		if (std::is_trivially_destructible<ValueType>::value == false) {
+			for (size_t i = 0; i < currentNode->m_Count; ++i) {
+				currentNode->Values()[i].~ValueType();
+			}
+		}
+		GetAllocator().Free(currentNode);
+		currentNode = nextNode;
+	}
+
+	m_Head = nullptr;
+	m_Tail = nullptr;
+	m_Count = 0;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+void UnrolledList<ValueType, tNodeCapacity, Allocator>::Abandon() {
+
+	m_Head = nullptr;
+	m_Tail = nullptr;
+	m_Count = 0;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+typename UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator UnrolledList<ValueType, tNodeCapacity, Allocator>::begin() {
+
+	return Iterator(nullptr, m_Head, 0);
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+typename UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator UnrolledList<ValueType, tNodeCapacity, Allocator>::end() {
+
+	return Iterator(m_Tail, nullptr, 0);
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+typename UnrolledList<ValueType, tNodeCapacity, Allocator>::Node* UnrolledList<ValueType, tNodeCapacity, Allocator>::CreateNodeAfter(Node* node) {
+
+	Node* newNode = GetAllocator().template Alloc<Node>();
+	if (node == nullptr) {
+		newNode->m_Next = m_Head;
+		m_Head = newNode;
+	}
+	else {
+		newNode->m_Next = node->m_Next;
+		node->m_Next = newNode;
+	}
+
+	if (newNode->m_Next == nullptr) {
+		m_Tail = newNode;
+	}
+	return newNode;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+void UnrolledList<ValueType, tNodeCapacity, Allocator>::FreeNode(Node* previousNode, Node* node) {
+
+	MIST_ASSERT(node->m_Count == 0);
+	MIST_ASSERT(previousNode == nullptr ? m_Head == node : previousNode->m_Next == node);
+
+	if (previousNode == nullptr) {
+		m_Head = node->m_Next;
+	}
+	else {
+		previousNode->m_Next = node->m_Next;
+	}
+
+	if (m_Tail == node) {
+		m_Tail = previousNode;
+	}
+
+	GetAllocator().Free(node);
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+void UnrolledList<ValueType, tNodeCapacity, Allocator>::OpenGap(Node* node, size_t index) {
+
+	MIST_ASSERT(node->m_Count < tNodeCapacity);
+
+	ValueType* values = node->Values();
+	for (size_t i = node->m_Count; i > index; --i) {
+		new (values + i) ValueType(std::move(values[i - 1]));
+		values[i - 1].~ValueType();
+	}
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+void UnrolledList<ValueType, tNodeCapacity, Allocator>::CloseGap(Node* node, size_t index) {
+
+	ValueType* values = node->Values();
+	for (size_t i = index + 1; i < node->m_Count; ++i) {
+		new (values + i - 1) ValueType(std::move(values[i]));
+		values[i].~ValueType();
+	}
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+void UnrolledList<ValueType, tNodeCapacity, Allocator>::MoveValues(Node* source, size_t index, Node* destination) {
+
+	MIST_ASSERT(destination->m_Count + source->m_Count - index <= tNodeCapacity);
+
+	ValueType* sourceValues = source->Values();
+	ValueType* destinationValues = destination->Values();
+	for (size_t i = index; i < source->m_Count; ++i) {
+		new (destinationValues + destination->m_Count) ValueType(std::move(sourceValues[i]));
+		sourceValues[i].~ValueType();
+		++destination->m_Count;
+	}
+	source->m_Count = index;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+UnrolledList<ValueType, tNodeCapacity, Allocator>::UnrolledList(const Allocator& allocator) : Detail::AllocatorStorage<Allocator>(allocator) {}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+UnrolledList<ValueType, tNodeCapacity, Allocator>::UnrolledList(UnrolledList&& rhs) {
+
+	std::swap(m_Head, rhs.m_Head);
+	std::swap(m_Tail, rhs.m_Tail);
+	std::swap(m_Count, rhs.m_Count);
+	// The nodes belong to the allocator, it has to follow the nodes
+	std::swap(GetAllocator(), rhs.GetAllocator());
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+UnrolledList<ValueType, tNodeCapacity, Allocator>& UnrolledList<ValueType, tNodeCapacity, Allocator>::operator=(UnrolledList&& rhs) {
+
+	std::swap(m_Head, rhs.m_Head);
+	std::swap(m_Tail, rhs.m_Tail);
+	std::swap(m_Count, rhs.m_Count);
+	// The nodes belong to the allocator, it has to follow the nodes
+	std::swap(GetAllocator(), rhs.GetAllocator());
+
+	return *this;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+UnrolledList<ValueType, tNodeCapacity, Allocator>::~UnrolledList() {
+
+	Clear();
+}
+
+// -Node-
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+ValueType* UnrolledList<ValueType, tNodeCapacity, Allocator>::Node::GetValue(size_t index) {
+
+	MIST_ASSERT(index < m_Count);
+	return Values() + index;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+typename UnrolledList<ValueType, tNodeCapacity, Allocator>::Node* UnrolledList<ValueType, tNodeCapacity, Allocator>::Node::NextNode() {
+
+	return m_Next;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+size_t UnrolledList<ValueType, tNodeCapacity, Allocator>::Node::Count() const {
+
+	return m_Count;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+ValueType* UnrolledList<ValueType, tNodeCapacity, Allocator>::Node::Values() {
+
+	return reinterpret_cast<ValueType*>(m_Values);
+}
+
+// -Iterator-
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+typename UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator::operator++() {
+
+	// Only move to the next node once all of the values of the node have been visited
+	if (++m_Index == m_TargetNode->m_Count) {
+		m_PreviousNode = m_TargetNode;
+		m_TargetNode = m_TargetNode->m_Next;
+		m_Index = 0;
+	}
+	return *this;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+bool UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator::operator!=(const Iterator& rhs) const {
+
+	return rhs.m_TargetNode != m_TargetNode || rhs.m_Index != m_Index;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+bool UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator::operator==(const Iterator& rhs) const {
+
+	return (*this != rhs) == false;
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+ValueType& UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator::operator*() {
+
+	return *GetValue();
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+ValueType* UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator::operator->() {
+
+	return GetValue();
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+ValueType* UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator::GetValue() {
+
+	MIST_ASSERT(m_TargetNode != nullptr);
+	return m_TargetNode->GetValue(m_Index);
+}
+
+template< typename ValueType, size_t tNodeCapacity, typename Allocator >
+UnrolledList<ValueType, tNodeCapacity, Allocator>::Iterator::Iterator(Node* previousNode, Node* node, size_t index)
+	: m_PreviousNode(previousNode), m_TargetNode(node), m_Index(index) {}
+
+MIST_NAMESPACE_END
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../utility/CacheLine.h"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+// A bounded lock free Chase-Lev deque, the owner thread pushes and pops at the bottom while any other thread
+// can steal from the top. This is the queue of every worker of the JobScheduler.
+// @Details: The implementation follows "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al. 2013)
+//  without the growable array, a full deque refuses the push and the owner is expected to run the value itself.
+//  The owner works in LIFO order, the most recent value is still in it's cache. The thieves take the oldest values,
+//  which are usually the largest pieces of work when the work is split recursively.
+//  Only trivially copyable values (Such as pointers) can be stored, the slots are read before the steal is confirmed.
+// @Example: A worker loop would look like:
+//
+//		Job* job;
+//		if (ownDeque.TryPop(&job) || otherDeque.TrySteal(&job)) {
+//			Execute(job);
+//		}
+template< typename ValueType, size_t tSize >
+class WorkStealingDeque {
+	static_assert(tSize > 1 && (tSize & (tSize - 1)) == 0, "The size of a work stealing deque must be a power of two.");
+	static_assert(std::is_trivially_copyable<ValueType>::value, "The values of a work stealing deque are copied bitwise.");
+
+public:
+
+	// -Public API-
+
+	// Push a value at the bottom of the deque, returns false if the deque is full
+	// @Detail: Owner thread only
+	bool TryPush(ValueType value);
+
+	// Pop the most recently pushed value, returns false if the deque is empty or the last value was stolen
+	// @Detail: Owner thread only
+	bool TryPop(ValueType* outValue);
+
+	// Steal the oldest value, returns false if the deque is empty or another thread took the value first
+	// @Detail: Any thread
+	bool TrySteal(ValueType* outValue);
+
+	// @Detail: This is only a snapshot when other threads are stealing
+	size_t Size() const;
+
+	// -Structors-
+
+	WorkStealingDeque() = default;
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+private:
+
+	static constexpr int64_t MASK = static_cast<int64_t>(tSize - 1);
+
+	// The thieves take values from the top
+	alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_Top{ 0 };
+	// The owner pushes and pops at the bottom
+	alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_Bottom{ 0 };
+
+	// The slots are always written before the bottom moves past them
+	alignas(CACHE_LINE_SIZE) std::atomic<ValueType> m_Values[tSize];
+};
+
+
+// -Implementation-
+
+template< typename ValueType, size_t tSize >
+bool WorkStealingDeque<ValueType, tSize>::TryPush(ValueType value) {
+
+	int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+	int64_t top = m_Top.load(std::memory_order_acquire);
+	if (bottom - top >= static_cast<int64_t>(tSize)) {
+		return false;
+	}
+
+	m_Values[bottom & MASK].store(value, std::memory_order_relaxed);
+	// Publish the value before the thieves can see the new bottom
+	std::atomic_thread_fence(std::memory_order_release);
+	m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+	return true;
+}
+
+template< typename ValueType, size_t tSize >
+bool WorkStealingDeque<ValueType, tSize>::TryPop(ValueType* outValue) {
+
+	// Reserve the bottom value before looking at the top, a thief that reads the top after us
+	// sees the reservation and the two of us race for the last value with the compare and swap
+	int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+	m_Bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = m_Top.load(std::memory_order_relaxed);
+
+	if (top > bottom) {
+		// The deque was empty, restore the bottom
+		m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	ValueType value = m_Values[bottom & MASK].load(std::memory_order_relaxed);
+	if (top == bottom) {
+		// The last value, the thieves might be trying to take it too
+		bool isWon = m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		if (isWon == false) {
+			return false;
+		}
+	}
+
+	*outValue = value;
+	return true;
+}
+
+template< typename ValueType, size_t tSize >
+bool WorkStealingDeque<ValueType, tSize>::TrySteal(ValueType* outValue) {
+
+	int64_t top = m_Top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+	if (top >= bottom) {
+		return false;
+	}
+
+	// The value is read before claiming it, the owner can't overwrite it until the top moves past it
+	ValueType value = m_Values[top & MASK].load(std::memory_order_relaxed);
+	if (m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed) == false) {
+		return false;
+	}
+
+	*outValue = value;
+	return true;
+}
+
+template< typename ValueType, size_t tSize >
+size_t WorkStealingDeque<ValueType, tSize>::Size() const {
+
+	int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+	int64_t top = m_Top.load(std::memory_order_relaxed);
+	return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+MIST_NAMESPACE_END
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../utility/Hash.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Compile time reflection, the fields of a type are described once with MIST_REFLECT and every query
+// on the description is resolved by the compiler. There is no registry, no virtual call and no runtime type lookup,
+// iterating the fields of a type compiles to the same code as accessing every field by hand.
+// - FieldDescriptor, the name and member pointer of a field
+// - TypeDescriptor, the name and fields of a reflected type
+// - ForEachField and FindFieldIndex, the queries over the fields
+MIST_NAMESPACE
+
+// -Field Descriptors-
+
+// Describes a field of a reflected type, the descriptor can be used in constant expressions
+template< typename ClassType, typename FieldType >
+struct FieldDescriptor {
+
+	using Class = ClassType;
+	using Type = FieldType;
+
+	// Retrieve the field of an object
+	const FieldType& Get(const ClassType& object) const { return object.*m_Member; }
+	FieldType& Get(ClassType& object) const { return object.*m_Member; }
+
+	constexpr FieldDescriptor(const char* name, FieldType ClassType::* member)
+		: m_Name(name)
+		, m_NameHash(djb2::Hash(name))
+		, m_Member(member) {}
+
+	const char* m_Name;
+	// The names are compared by hash before they are compared by characters
+	uint32_t m_NameHash;
+	FieldType ClassType::* m_Member;
+};
+
+template< typename ClassType, typename FieldType >
+constexpr FieldDescriptor<ClassType, FieldType> MakeField(const char* name, FieldType ClassType::* member) {
+	return FieldDescriptor<ClassType, FieldType>(name, member);
+}
+
+// -Type Descriptors-
+
+// The description of a type, MIST_REFLECT specializes it for the reflected types.
+// A reflected type provides Name() and Fields(), a tuple of the descriptors of it's fields.
+template< typename Type >
+struct TypeDescriptor {
+	static constexpr bool IS_REFLECTED = false;
+};
+
+template< typename Type >
+struct IsReflected : std::integral_constant<bool, TypeDescriptor<Type>::IS_REFLECTED> {};
+
+// The index returned by FindFieldIndex when the type has no field with the name
+constexpr size_t FIELD_NOT_FOUND = ~static_cast<size_t>(0);
+
+// The tuple of the field descriptors of a reflected type
+template< typename Type >
+using FieldDescriptors = decltype(TypeDescriptor<Type>::Fields());
+
+// The amount of fields of a reflected type
+template< typename Type >
+constexpr size_t FieldCount() {
+	return std::tuple_size<FieldDescriptors<Type>>::value;
+}
+
+// Call the visitor with the descriptor of every field of the type, in the order they were reflected.
+// visitor(const FieldDescriptor<Type, FieldType>& field)
+template< typename Type, typename VisitorType >
+void ForEachFieldDescriptor(VisitorType&& visitor);
+
+// Call the visitor with the descriptor and the value of every field of the object, in the order they were reflected.
+// visitor(const FieldDescriptor<Type, FieldType>& field, FieldType& value)
+// @Example: Printing every field of a reflected type would look like:
+//
+//		ForEachField(vertex, [](const auto& field, const auto& value) { std::cout << field.m_Name << ": " << value << std::endl; });
+template< typename Type, typename VisitorType >
+void ForEachField(Type& object, VisitorType&& visitor);
+
+// Find the index of the field named name, returns FIELD_NOT_FOUND if the type doesn't have the field.
+// This is a constant expression when the name is, it can be used to check that a field exists at compile time.
+// @Example: static_assert(FindFieldIndex<Vertex>("m_Normal") == 1, "The normal is the second field.");
+template< typename Type >
+constexpr size_t FindFieldIndex(const char* name);
+
+MIST_NAMESPACE_END
+
+// Describe the fields of a type, every field is named with MIST_FIELD.
+// This must be used in the global namespace, the fields must be accessible from the TypeDescriptor.
+// @Example: Reflecting a vertex would look like:
+//
+//		MIST_REFLECT(Vertex, MIST_FIELD(m_Position), MIST_FIELD(m_Normal), MIST_FIELD(m_TexCoord))
+#define MIST_REFLECT(type, ...) \
+	MIST_NAMESPACE \
+	template<> \
+	struct TypeDescriptor<type> { \
+		using ReflectedType = type; \
+		static constexpr bool IS_REFLECTED = true; \
+		static constexpr const char* Name() { return #type; } \
+		static constexpr auto Fields() { return std::make_tuple(__VA_ARGS__); } \
+	}; \
+	MIST_NAMESPACE_END
+
+#define MIST_FIELD(field) MakeField(#field, &ReflectedType::field)
+
+MIST_NAMESPACE
+
+// -Implementation-
+
+namespace Detail {
+
+	template< typename DescriptorsType, typename VisitorType, size_t... tIndices >
+	void VisitFieldDescriptors(const DescriptorsType& fields, VisitorType& visitor, std::index_sequence<tIndices...>) {
+		(void)fields;
+		(void)visitor;
+		(void)std::initializer_list<int>{ (visitor(std::get<tIndices>(fields)), 0)... };
+	}
+
+	template< typename Type, typename DescriptorsType, typename VisitorType, size_t... tIndices >
+	void VisitFields(Type& object, const DescriptorsType& fields, VisitorType& visitor, std::index_sequence<tIndices...>) {
+		(void)object;
+		(void)fields;
+		(void)visitor;
+		(void)std::initializer_list<int>{ (visitor(std::get<tIndices>(fields), std::get<tIndices>(fields).Get(object)), 0)... };
+	}
+
+	constexpr bool IsSameString(const char* left, const char* right) {
+		return *left == *right && (*left == '\0' || IsSameString(left + 1, right + 1));
+	}
+
+	// The search stops once the index is past the last field
+	template< typename DescriptorsType, size_t tIndex >
+	constexpr size_t FindFieldIndex(const DescriptorsType&, const char*, uint32_t, std::integral_constant<size_t, tIndex>, std::false_type /*isInRange*/) {
+		return FIELD_NOT_FOUND;
+	}
+
+	template< typename DescriptorsType, size_t tIndex >
+	constexpr size_t FindFieldIndex(const DescriptorsType& fields, const char* name, uint32_t nameHash, std::integral_constant<size_t, tIndex>, std::true_type /*isInRange*/) {
+		return std::get<tIndex>(fields).m_NameHash == nameHash && IsSameString(std::get<tIndex>(fields).m_Name, name)
+			? tIndex
+			: FindFieldIndex(fields, name, nameHash, std::integral_constant<size_t, tIndex + 1>(),
+				std::integral_constant<bool, (tIndex + 1 < std::tuple_size<DescriptorsType>::value)>());
+	}
+}
+
+template< typename Type, typename VisitorType >
+void ForEachFieldDescriptor(VisitorType&& visitor) {
+
+	static_assert(IsReflected<Type>::value, "The type must be reflected with MIST_REFLECT.");
+	Detail::VisitFieldDescriptors(TypeDescriptor<Type>::Fields(), visitor, std::make_index_sequence<FieldCount<Type>()>());
+}
+
+template< typename Type, typename VisitorType >
+void ForEachField(Type& object, VisitorType&& visitor) {
+
+	using ReflectedType = typename std::remove_const<Type>::type;
+	static_assert(IsReflected<ReflectedType>::value, "The type must be reflected with MIST_REFLECT.");
+	Detail::VisitFields(object, TypeDescriptor<ReflectedType>::Fields(), visitor, std::make_index_sequence<FieldCount<ReflectedType>()>());
+}
+
+template< typename Type >
+constexpr size_t FindFieldIndex(const char* name) {
+	return Detail::FindFieldIndex(TypeDescriptor<Type>::Fields(), name, djb2::Hash(name), std::integral_constant<size_t, 0>(),
+		std::integral_constant<bool, (FieldCount<Type>() > 0)>());
+}
+
+MIST_NAMESPACE_END
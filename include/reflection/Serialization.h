@@ -0,0 +1,498 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "Reflection.h"
+#include "../data-structures/DynamicArray.h"
+#include "../data-structures/SingleList.h"
+#include "../data-structures/RingBuffer.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Binary serialization of values and containers, the layout of every type is known at compile time.
+// - MemoryWriter, MemoryReader, FileWriter and FileReader, the destinations and sources of the data
+// - IsBitwiseSerializable, the types that are saved as a copy of their bytes
+// - BinarySerializer, SaveBinary and LoadBinary, the serialization of a value
+// Containers of bitwise serializable values are saved and loaded with a single copy of all their values,
+// the other values are serialized field by field through their reflection.
+// The data is a copy of the memory with the native endianness and layout, it's meant to be loaded back by the same platform
+// (Such as the caches of a build step or the levels of a platform), the data must come from SaveBinary.
+MIST_NAMESPACE
+
+// -Writers and Readers-
+
+// Any type with bool Write(const void* data, size_t size) is a writer and any type with bool Read(void* data, size_t size)
+// is a reader, the serialization is templated on them and there's no virtual call per field.
+
+// Writes into a block of memory that grows with the data
+class MemoryWriter {
+
+public:
+
+	// -Public API-
+
+	inline bool Write(const void* data, size_t size);
+
+	inline const uint8_t* Data() const;
+
+	inline size_t Size() const;
+
+	inline void Clear();
+
+private:
+
+	DynamicArray<uint8_t> m_Bytes;
+};
+
+// Reads from a block of memory owned by the caller, such as a memory mapped file
+class MemoryReader {
+
+public:
+
+	// -Public API-
+
+	// Returns false if there are less than size bytes left, nothing is read
+	inline bool Read(void* data, size_t size);
+
+	// The amount of bytes that weren't read yet
+	inline size_t RemainingSize() const;
+
+	// -Structors-
+
+	inline MemoryReader(const void* data, size_t size);
+
+private:
+
+	const uint8_t* m_Data;
+	size_t m_Size;
+	size_t m_Position = 0;
+};
+
+// Writes to a file opened by the caller in binary mode
+class FileWriter {
+
+public:
+
+	// -Public API-
+
+	inline bool Write(const void* data, size_t size);
+
+	// -Structors-
+
+	inline explicit FileWriter(FILE* file);
+
+private:
+
+	FILE* m_File;
+};
+
+// Reads from a file opened by the caller in binary mode
+class FileReader {
+
+public:
+
+	// -Public API-
+
+	inline bool Read(void* data, size_t size);
+
+	// -Structors-
+
+	inline explicit FileReader(FILE* file);
+
+private:
+
+	FILE* m_File;
+};
+
+// -Bitwise Serialization-
+
+template< typename Type >
+struct IsBitwiseSerializable;
+
+namespace Detail {
+
+	template< bool... tValues >
+	struct BoolPack {};
+
+	template< bool... tValues >
+	struct AllOf : std::is_same<BoolPack<true, tValues...>, BoolPack<tValues..., true>> {};
+
+	template< typename DescriptorsType >
+	struct HasBitwiseFieldTypes;
+
+	template< typename... FieldDescriptorTypes >
+	struct HasBitwiseFieldTypes<std::tuple<FieldDescriptorTypes...>> : AllOf<IsBitwiseSerializable<typename FieldDescriptorTypes::Type>::value...> {};
+
+	// Types that aren't reflected can't be checked field by field
+	template< typename Type, bool tIsReflected = IsReflected<Type>::value >
+	struct HasBitwiseFields : std::true_type {};
+
+	template< typename Type >
+	struct HasBitwiseFields<Type, true> : HasBitwiseFieldTypes<FieldDescriptors<Type>> {};
+
+	template< typename Type >
+	struct AlwaysFalse : std::false_type {};
+}
+
+// Determine if a type is saved as a copy of it's bytes. Trivially copyable types are bitwise serializable except for
+// pointers, they don't point to the same object once loaded, and reflected types with a field that isn't bitwise serializable.
+// @Detail: Specialize this trait to serialize a trivially copyable type that isn't reflected field by field (Such as a type holding a pointer)
+// @Example:
+//
+//		template<>
+//		struct IsBitwiseSerializable<TextureHandle> : std::false_type {};
+template< typename Type >
+struct IsBitwiseSerializable : std::integral_constant<bool,
+	std::is_trivially_copyable<Type>::value
+	&& std::is_pointer<typename std::remove_all_extents<Type>::type>::value == false
+	&& std::is_member_pointer<typename std::remove_all_extents<Type>::type>::value == false
+	&& Detail::HasBitwiseFields<typename std::remove_all_extents<Type>::type>::value> {};
+
+// A ring buffer of trivially copyable values is trivially copyable too, only it's readable values are saved instead of the whole storage
+template< typename ValueType, size_t tSize >
+struct IsBitwiseSerializable<RingBuffer<ValueType, tSize>> : std::false_type {};
+
+// -Binary Serializer-
+
+// Saves and loads the values of a type, specialize it to serialize your own types.
+// Save(writer, const Type& value) and Load(reader, Type* outValue) return false if the writer or reader failed.
+// Bitwise serializable types, reflected types, std::string, DynamicArray, SingleList and RingBuffer are serialized by the library.
+template< typename Type, typename Enable = void >
+struct BinarySerializer {
+	static_assert(Detail::AlwaysFalse<Type>::value, "The type isn't serializable, reflect it with MIST_REFLECT or specialize the BinarySerializer.");
+};
+
+// Save a value to the writer
+template< typename WriterType, typename Type >
+bool SaveBinary(WriterType& writer, const Type& value);
+
+// Load a value from the reader, the value is overwritten.
+// The containers are emptied before they are loaded, except for the RingBuffer which writes the values after it's current values.
+template< typename ReaderType, typename Type >
+bool LoadBinary(ReaderType& reader, Type* outValue);
+
+// -Implementation-
+
+inline bool MemoryWriter::Write(const void* data, size_t size) {
+
+	if (size > 0) {
+		memcpy(m_Bytes.AppendUninitialized(size), data, size);
+	}
+	return true;
+}
+
+inline const uint8_t* MemoryWriter::Data() const {
+
+	return m_Bytes.AsRawArray();
+}
+
+inline size_t MemoryWriter::Size() const {
+
+	return m_Bytes.Size();
+}
+
+inline void MemoryWriter::Clear() {
+
+	m_Bytes.Clear();
+}
+
+inline MemoryReader::MemoryReader(const void* data, size_t size)
+	: m_Data(static_cast<const uint8_t*>(data))
+	, m_Size(size) {}
+
+inline bool MemoryReader::Read(void* data, size_t size) {
+
+	if (m_Size - m_Position < size) {
+		return false;
+	}
+
+	if (size > 0) {
+		memcpy(data, m_Data + m_Position, size);
+	}
+	m_Position += size;
+	return true;
+}
+
+inline size_t MemoryReader::RemainingSize() const {
+
+	return m_Size - m_Position;
+}
+
+inline FileWriter::FileWriter(FILE* file)
+	: m_File(file) {}
+
+inline bool FileWriter::Write(const void* data, size_t size) {
+
+	return fwrite(data, 1, size, m_File) == size;
+}
+
+inline FileReader::FileReader(FILE* file)
+	: m_File(file) {}
+
+inline bool FileReader::Read(void* data, size_t size) {
+
+	return fread(data, 1, size, m_File) == size;
+}
+
+namespace Detail {
+
+	// Save a range of values, bitwise ranges are written at once
+	template< typename WriterType, typename ValueType >
+	bool SaveValues(WriterType& writer, const ValueType* values, size_t count, std::true_type /*isBitwise*/) {
+		return count == 0 || writer.Write(values, count * sizeof(ValueType));
+	}
+
+	template< typename WriterType, typename ValueType >
+	bool SaveValues(WriterType& writer, const ValueType* values, size_t count, std::false_type /*isBitwise*/) {
+		for (size_t i = 0; i < count; i++) {
+			if (SaveBinary(writer, values[i]) == false) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Load a range of constructed values, bitwise ranges are read at once
+	template< typename ReaderType, typename ValueType >
+	bool LoadValues(ReaderType& reader, ValueType* values, size_t count, std::true_type /*isBitwise*/) {
+		return count == 0 || reader.Read(values, count * sizeof(ValueType));
+	}
+
+	template< typename ReaderType, typename ValueType >
+	bool LoadValues(ReaderType& reader, ValueType* values, size_t count, std::false_type /*isBitwise*/) {
+		for (size_t i = 0; i < count; i++) {
+			if (LoadBinary(reader, values + i) == false) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Grow the array by count values ready to be loaded, bitwise values are left uninitialized
+	template< typename ArrayType >
+	auto AppendLoadedValues(ArrayType* array, size_t count, std::true_type /*isBitwise*/) -> decltype(array->AsRawArray()) {
+		return array->AppendUninitialized(count);
+	}
+
+	template< typename ArrayType >
+	auto AppendLoadedValues(ArrayType* array, size_t count, std::false_type /*isBitwise*/) -> decltype(array->AsRawArray()) {
+		size_t previousSize = array->Size();
+		array->AppendN(count);
+		return array->AsRawArray() + previousSize;
+	}
+
+	// Containers store their amount of values in front of the values
+	template< typename ReaderType >
+	bool LoadCount(ReaderType& reader, size_t valueSize, size_t* outCount) {
+
+		uint64_t count;
+		if (reader.Read(&count, sizeof(count)) == false || count > ~static_cast<size_t>(0) / valueSize) {
+			return false;
+		}
+		*outCount = static_cast<size_t>(count);
+		return true;
+	}
+
+	template< typename WriterType >
+	bool SaveCount(WriterType& writer, size_t count) {
+
+		uint64_t savedCount = count;
+		return writer.Write(&savedCount, sizeof(savedCount));
+	}
+}
+
+template< typename Type >
+struct BinarySerializer<Type, typename std::enable_if<IsBitwiseSerializable<Type>::value>::type> {
+
+	template< typename WriterType >
+	static bool Save(WriterType& writer, const Type& value) {
+		return writer.Write(&value, sizeof(Type));
+	}
+
+	template< typename ReaderType >
+	static bool Load(ReaderType& reader, Type* outValue) {
+		return reader.Read(outValue, sizeof(Type));
+	}
+};
+
+// Reflected types that can't be copied bitwise are serialized field by field, in the order of the reflection
+template< typename Type >
+struct BinarySerializer<Type, typename std::enable_if<IsReflected<Type>::value && IsBitwiseSerializable<Type>::value == false>::type> {
+
+	template< typename WriterType >
+	static bool Save(WriterType& writer, const Type& value) {
+
+		bool isSaved = true;
+		ForEachField(value, [&writer, &isSaved](const auto&, const auto& fieldValue) {
+			isSaved = isSaved && SaveBinary(writer, fieldValue);
+		});
+		return isSaved;
+	}
+
+	template< typename ReaderType >
+	static bool Load(ReaderType& reader, Type* outValue) {
+
+		bool isLoaded = true;
+		ForEachField(*outValue, [&reader, &isLoaded](const auto&, auto& fieldValue) {
+			isLoaded = isLoaded && LoadBinary(reader, &fieldValue);
+		});
+		return isLoaded;
+	}
+};
+
+template<>
+struct BinarySerializer<std::string> {
+
+	template< typename WriterType >
+	static bool Save(WriterType& writer, const std::string& value) {
+		return Detail::SaveCount(writer, value.size()) && (value.empty() || writer.Write(value.data(), value.size()));
+	}
+
+	template< typename ReaderType >
+	static bool Load(ReaderType& reader, std::string* outValue) {
+
+		size_t size;
+		if (Detail::LoadCount(reader, 1, &size) == false) {
+			return false;
+		}
+		outValue->resize(size);
+		return size == 0 || reader.Read(&(*outValue)[0], size);
+	}
+};
+
+// Arrays of bitwise values are saved and loaded with a single copy of the whole array
+template< typename ValueType, typename Allocator, typename GrowthPolicy, size_t tAlignment >
+struct BinarySerializer<DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>> {
+
+	using ArrayType = DynamicArray<ValueType, Allocator, GrowthPolicy, tAlignment>;
+	using IsBitwise = std::integral_constant<bool, IsBitwiseSerializable<ValueType>::value>;
+
+	template< typename WriterType >
+	static bool Save(WriterType& writer, const ArrayType& array) {
+		return Detail::SaveCount(writer, array.Size()) && Detail::SaveValues(writer, array.AsRawArray(), array.Size(), IsBitwise());
+	}
+
+	template< typename ReaderType >
+	static bool Load(ReaderType& reader, ArrayType* outArray) {
+
+		outArray->Clear();
+
+		size_t count;
+		if (Detail::LoadCount(reader, sizeof(ValueType), &count) == false) {
+			return false;
+		}
+
+		ValueType* values = Detail::AppendLoadedValues(outArray, count, IsBitwise());
+		if (Detail::LoadValues(reader, values, count, IsBitwise()) == false) {
+			outArray->Clear();
+			return false;
+		}
+		return true;
+	}
+};
+
+// The values of the list are saved in order and loaded into new nodes
+template< typename ValueType, typename Allocator >
+struct BinarySerializer<SingleList<ValueType, Allocator>> {
+
+	using ListType = SingleList<ValueType, Allocator>;
+	using IsBitwise = std::integral_constant<bool, IsBitwiseSerializable<ValueType>::value>;
+
+	template< typename WriterType >
+	static bool Save(WriterType& writer, const ListType& list) {
+
+		if (Detail::SaveCount(writer, list.Size()) == false) {
+			return false;
+		}
+
+		const typename ListType::Node* node = list.Size() > 0 ? list.FirstNode() : nullptr;
+		for (; node != nullptr; node = node->NextNode()) {
+			if (Detail::SaveValues(writer, node->GetValue(), 1, IsBitwise()) == false) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template< typename ReaderType >
+	static bool Load(ReaderType& reader, ListType* outList) {
+
+		outList->Clear();
+
+		size_t count;
+		if (Detail::LoadCount(reader, sizeof(ValueType), &count) == false) {
+			return false;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			ValueType value = ValueType();
+			if (Detail::LoadValues(reader, &value, 1, IsBitwise()) == false) {
+				outList->Clear();
+				return false;
+			}
+			outList->InsertAsLast(std::move(value));
+		}
+		return true;
+	}
+};
+
+// The readable values of the buffer are saved without being consumed, they are loaded straight into the write spans
+template< typename ValueType, size_t tSize >
+struct BinarySerializer<RingBuffer<ValueType, tSize>> {
+
+	using BufferType = RingBuffer<ValueType, tSize>;
+	using IsBitwise = std::integral_constant<bool, IsBitwiseSerializable<ValueType>::value>;
+
+	template< typename WriterType >
+	static bool Save(WriterType& writer, const BufferType& buffer) {
+
+		const ValueType* firstSpan;
+		const ValueType* secondSpan;
+		size_t firstCount;
+		size_t count = buffer.PeekReadSpans(&firstSpan, &firstCount, &secondSpan);
+
+		return Detail::SaveCount(writer, count)
+			&& Detail::SaveValues(writer, firstSpan, firstCount, IsBitwise())
+			&& Detail::SaveValues(writer, secondSpan, count - firstCount, IsBitwise());
+	}
+
+	// Returns false if the buffer doesn't have room for the values, nothing is written
+	template< typename ReaderType >
+	static bool Load(ReaderType& reader, BufferType* outBuffer) {
+
+		size_t count;
+		if (Detail::LoadCount(reader, sizeof(ValueType), &count) == false || count > outBuffer->WritableCount()) {
+			return false;
+		}
+
+		// The free space wraps around the storage in at most two spans
+		while (count > 0) {
+			ValueType* span;
+			size_t spanCount = outBuffer->AcquireWriteSpan(&span);
+			spanCount = spanCount < count ? spanCount : count;
+			if (Detail::LoadValues(reader, span, spanCount, IsBitwise()) == false) {
+				return false;
+			}
+			outBuffer->CommitWrite(spanCount);
+			count -= spanCount;
+		}
+		return true;
+	}
+};
+
+template< typename WriterType, typename Type >
+bool SaveBinary(WriterType& writer, const Type& value) {
+
+	return BinarySerializer<Type>::Save(writer, value);
+}
+
+template< typename ReaderType, typename Type >
+bool LoadBinary(ReaderType& reader, Type* outValue) {
+
+	return BinarySerializer<Type>::Load(reader, outValue);
+}
+
+MIST_NAMESPACE_END
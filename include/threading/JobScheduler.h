@@ -0,0 +1,527 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include "../allocators/CppAllocator.h"
+#include "../data-structures/WorkStealingDeque.h"
+#include "../data-structures/MpmcRingBuffer.h"
+#include "../utility/CacheLine.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+MIST_NAMESPACE
+
+class JobScheduler;
+
+// The handle of a set of forked jobs, waiting on the group joins every job that was run in it.
+// @Detail: A group must outlive the jobs it tracks, wait on it before it goes out of scope.
+class JobGroup {
+
+public:
+
+	// Determine if every job of the group has finished
+	bool IsDone() const { return m_PendingCount.load(std::memory_order_acquire) == 0; }
+
+	JobGroup() = default;
+
+	JobGroup(const JobGroup&) = delete;
+	JobGroup& operator=(const JobGroup&) = delete;
+
+	~JobGroup() { MIST_ASSERT(IsDone()); }
+
+private:
+
+	friend class JobScheduler;
+
+	std::atomic<size_t> m_PendingCount{ 0 };
+};
+
+// How the worker threads are placed on the cores
+enum class WorkerAffinity {
+	// Let the OS move the workers around
+	None,
+	// Pin worker i to the core (m_FirstCore + i) modulo the amount of cores
+	PinToCores
+};
+
+struct JobSchedulerSettings {
+	// The amount of worker threads, 0 uses one worker per core minus the calling thread
+	size_t m_WorkerCount = 0;
+	WorkerAffinity m_Affinity = WorkerAffinity::None;
+	// The core of the first worker, the main thread usually keeps core 0
+	size_t m_FirstCore = 1;
+};
+
+namespace Detail {
+
+	// The callables that fit in a job are stored inline, the bigger ones are allocated
+	constexpr size_t JOB_STORAGE_SIZE = 48;
+	// The amount of jobs a worker can queue before running the new jobs inline
+	constexpr size_t JOB_DEQUE_SIZE = 4096;
+	// The amount of jobs the threads outside of the scheduler can queue before running the new jobs inline
+	constexpr size_t INJECTED_JOB_QUEUE_SIZE = 4096;
+	// The amount of times an idle worker looks for jobs before going to sleep
+	constexpr size_t WORKER_SPIN_COUNT = 64;
+	// The amount of free jobs kept by every thread
+	constexpr size_t JOB_FREE_LIST_SIZE = 1024;
+
+	// A job fits in a cache line, the jobs run by different workers don't share cache lines
+	struct alignas(CACHE_LINE_SIZE) Job {
+		// Run and destroy the callable stored in the job
+		void(*m_Run)(Job*);
+		JobGroup* m_Group;
+		union {
+			typename std::aligned_storage<JOB_STORAGE_SIZE, alignof(std::max_align_t)>::type m_Storage;
+			Job* m_NextFree;
+		};
+	};
+
+	template< typename FunctionType >
+	using IsInlineJobFunction = std::integral_constant<bool, sizeof(FunctionType) <= JOB_STORAGE_SIZE && alignof(FunctionType) <= alignof(std::max_align_t)>;
+
+	template< typename FunctionType >
+	void RunInlineJobFunction(Job* job) {
+		FunctionType* function = reinterpret_cast<FunctionType*>(&job->m_Storage);
+		(*function)();
+		function->~FunctionType();
+	}
+
+	template< typename FunctionType >
+	void RunAllocatedJobFunction(Job* job) {
+		FunctionType* function = *reinterpret_cast<FunctionType**>(&job->m_Storage);
+		(*function)();
+		CppAllocator::Free(function);
+	}
+
+	template< typename FunctionType >
+	void StoreJobFunction(Job* job, FunctionType&& function, std::true_type /*isInline*/) {
+		using StoredType = typename std::decay<FunctionType>::type;
+		new (&job->m_Storage) StoredType(std::forward<FunctionType>(function));
+		job->m_Run = &RunInlineJobFunction<StoredType>;
+	}
+
+	template< typename FunctionType >
+	void StoreJobFunction(Job* job, FunctionType&& function, std::false_type /*isInline*/) {
+		using StoredType = typename std::decay<FunctionType>::type;
+		*reinterpret_cast<StoredType**>(&job->m_Storage) = CppAllocator::Alloc<StoredType>(std::forward<FunctionType>(function));
+		job->m_Run = &RunAllocatedJobFunction<StoredType>;
+	}
+
+	// Every thread keeps the jobs it ran for the next jobs it creates, this avoids going through the allocator
+	// for every job. The jobs move between the threads, a thread that mostly steals jobs frees the extra ones.
+	class JobFreeList {
+
+	public:
+
+		Job* Allocate() {
+
+			if (m_Head == nullptr) {
+				return static_cast<Job*>(CppAllocator::Alloc(sizeof(Job), alignof(Job)));
+			}
+
+			Job* job = m_Head;
+			m_Head = job->m_NextFree;
+			m_Count--;
+			return job;
+		}
+
+		void Free(Job* job) {
+
+			if (m_Count == JOB_FREE_LIST_SIZE) {
+				CppAllocator::Free(job, alignof(Job));
+				return;
+			}
+
+			job->m_NextFree = m_Head;
+			m_Head = job;
+			m_Count++;
+		}
+
+		~JobFreeList() {
+
+			while (m_Head != nullptr) {
+				Job* next = m_Head->m_NextFree;
+				CppAllocator::Free(m_Head, alignof(Job));
+				m_Head = next;
+			}
+		}
+
+	private:
+
+		Job* m_Head = nullptr;
+		size_t m_Count = 0;
+	};
+
+	inline JobFreeList& GetJobFreeList() {
+
+		thread_local JobFreeList freeList;
+		return freeList;
+	}
+
+	// The scheduler and worker that the current thread belongs to, the threads outside of the scheduler have none
+	struct WorkerContext {
+		JobScheduler* m_Scheduler = nullptr;
+		size_t m_WorkerIndex = 0;
+	};
+
+	inline WorkerContext& GetWorkerContext() {
+
+		thread_local WorkerContext context;
+		return context;
+	}
+
+	// Pin the thread to the core, returns false if the platform doesn't support it
+	inline bool PinThreadToCore(std::thread& thread, size_t core) {
+
+#if defined(_WIN32)
+		return SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << (core % (sizeof(DWORD_PTR) * 8))) != 0;
+#elif defined(__linux__)
+		cpu_set_t cores;
+		CPU_ZERO(&cores);
+		CPU_SET(core % CPU_SETSIZE, &cores);
+		return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cores) == 0;
+#else
+		(void)thread;
+		(void)core;
+		return false;
+#endif
+	}
+}
+
+// A work stealing job scheduler, every worker thread owns a Chase-Lev deque of jobs. A worker runs the jobs of
+// it's own deque first and steals the oldest jobs of the other workers when it runs out of work.
+// The threads outside of the scheduler queue their jobs in a shared queue that every worker reads from.
+// Waiting on a group doesn't block the thread, it runs the queued jobs until the group is done.
+// @Detail: The default scheduler is meant to be the single pool of threads of the whole engine, the parallel
+//  algorithms of Sorting.h run on it. Jobs are callables without arguments, the captures of up to 48 bytes
+//  are stored in the job without allocating. The idle workers spin for a short while and then sleep until
+//  new jobs are queued. A job can run and wait on other jobs, the waiting thread helps until they're done.
+// @Example: Forking two halves of a problem and joining them would look like:
+//
+//		JobScheduler& scheduler = JobScheduler::Default();
+//		JobGroup group;
+//		scheduler.Run(group, [&]() { UpdateParticles(first); });
+//		scheduler.Run(group, [&]() { UpdateParticles(second); });
+//		scheduler.Wait(group);
+class JobScheduler {
+
+public:
+
+	// -Public API-
+
+	// Queue the function as a job of the group, the function might run before this returns if the queue is full
+	template< typename FunctionType >
+	void Run(JobGroup& group, FunctionType&& function);
+
+	// Run the queued jobs until every job of the group is done
+	void Wait(JobGroup& group);
+
+	// Split [begin, end) into ranges of at most grainSize indices and call function(rangeBegin, rangeEnd) on every range
+	// from the workers, returns once every range is done.
+	// @Detail: The range is split in halves recursively, the thieves take the larger halves first.
+	//  The calling thread works on the ranges too.
+	template< typename FunctionType >
+	void ParallelFor(size_t begin, size_t end, size_t grainSize, FunctionType&& function);
+
+	// The amount of threads running the jobs, the worker threads and the thread waiting on the jobs
+	size_t ThreadCount() const;
+
+	// The scheduler shared by the whole engine, it's created with the default settings on first use
+	static JobScheduler& Default();
+
+	// -Structors-
+
+	explicit JobScheduler(const JobSchedulerSettings& settings = JobSchedulerSettings());
+
+	// Every job should be done before the scheduler is destroyed
+	~JobScheduler();
+
+	JobScheduler(const JobScheduler&) = delete;
+	JobScheduler& operator=(const JobScheduler&) = delete;
+
+private:
+
+	struct Worker {
+		WorkStealingDeque<Detail::Job*, Detail::JOB_DEQUE_SIZE> m_Jobs;
+		std::thread m_Thread;
+	};
+
+	// Queue the job in the deque of the current worker or in the shared queue
+	void Push(Detail::Job* job);
+
+	// Look for a job in our own deque, the shared queue and then the other workers
+	bool FindJob(Detail::Job** outJob);
+
+	void Execute(Detail::Job* job);
+
+	void WorkerMain(size_t workerIndex);
+
+	// Wake a worker up if any of them is sleeping
+	void NotifyJobQueued();
+
+	template< typename FunctionType >
+	void SplitRange(JobGroup& group, size_t begin, size_t end, size_t grainSize, FunctionType& function);
+
+	// The workers are allocated with their alignment, new[] doesn't respect the over aligned deques before C++17
+	Worker* m_Workers = nullptr;
+	size_t m_WorkerCount = 0;
+
+	MpmcRingBuffer<Detail::Job*, Detail::INJECTED_JOB_QUEUE_SIZE> m_InjectedJobs;
+
+	// -Sleeping-
+	std::atomic<bool> m_IsRunning{ true };
+	// Incremented every time a job is queued, a worker only goes to sleep if no job was queued while it was looking
+	alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_QueuedEpoch{ 0 };
+	std::atomic<size_t> m_SleepingCount{ 0 };
+	std::mutex m_SleepMutex;
+	std::condition_variable m_WakeCondition;
+};
+
+
+// -Implementation-
+
+template< typename FunctionType >
+void JobScheduler::Run(JobGroup& group, FunctionType&& function) {
+
+	Detail::Job* job = Detail::GetJobFreeList().Allocate();
+	job->m_Group = &group;
+	Detail::StoreJobFunction(job, std::forward<FunctionType>(function), Detail::IsInlineJobFunction<typename std::decay<FunctionType>::type>());
+
+	group.m_PendingCount.fetch_add(1, std::memory_order_relaxed);
+	Push(job);
+}
+
+inline void JobScheduler::Wait(JobGroup& group) {
+
+	while (group.IsDone() == false) {
+
+		Detail::Job* job;
+		if (FindJob(&job)) {
+			Execute(job);
+		}
+		else {
+			// The remaining jobs of the group are running on other threads
+			std::this_thread::yield();
+		}
+	}
+}
+
+template< typename FunctionType >
+void JobScheduler::ParallelFor(size_t begin, size_t end, size_t grainSize, FunctionType&& function) {
+
+	if (begin >= end) {
+		return;
+	}
+
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+
+	// A single range doesn't need to go through the queues
+	if (end - begin <= grainSize) {
+		function(begin, end);
+		return;
+	}
+
+	JobGroup group;
+	SplitRange(group, begin, end, grainSize, function);
+	Wait(group);
+}
+
+inline size_t JobScheduler::ThreadCount() const {
+
+	return m_WorkerCount + 1;
+}
+
+inline JobScheduler& JobScheduler::Default() {
+
+	static JobScheduler scheduler;
+	return scheduler;
+}
+
+inline JobScheduler::JobScheduler(const JobSchedulerSettings& settings) {
+
+	m_WorkerCount = settings.m_WorkerCount;
+	if (m_WorkerCount == 0) {
+		size_t coreCount = std::thread::hardware_concurrency();
+		m_WorkerCount = coreCount > 1 ? coreCount - 1 : 0;
+	}
+
+	// Every worker has to exist before the threads start stealing from each other
+	if (m_WorkerCount > 0) {
+		m_Workers = static_cast<Worker*>(CppAllocator::Alloc(sizeof(Worker) * m_WorkerCount, alignof(Worker)));
+		for (size_t i = 0; i < m_WorkerCount; ++i) {
+			new (m_Workers + i) Worker();
+		}
+	}
+
+	for (size_t i = 0; i < m_WorkerCount; ++i) {
+		m_Workers[i].m_Thread = std::thread(&JobScheduler::WorkerMain, this, i);
+
+		if (settings.m_Affinity == WorkerAffinity::PinToCores) {
+			size_t coreCount = std::thread::hardware_concurrency();
+			Detail::PinThreadToCore(m_Workers[i].m_Thread, (settings.m_FirstCore + i) % (coreCount > 0 ? coreCount : 1));
+		}
+	}
+}
+
+inline JobScheduler::~JobScheduler() {
+
+	{
+		std::lock_guard<std::mutex> lock(m_SleepMutex);
+		m_IsRunning.store(false);
+	}
+	m_WakeCondition.notify_all();
+
+	for (size_t i = 0; i < m_WorkerCount; ++i) {
+		m_Workers[i].m_Thread.join();
+	}
+
+	if (m_Workers != nullptr) {
+		for (size_t i = 0; i < m_WorkerCount; ++i) {
+			m_Workers[i].~Worker();
+		}
+		CppAllocator::Free(m_Workers, alignof(Worker));
+	}
+
+	MIST_ASSERT(m_InjectedJobs.CanRead() == false);
+}
+
+inline void JobScheduler::Push(Detail::Job* job) {
+
+	Detail::WorkerContext& context = Detail::GetWorkerContext();
+
+	bool isQueued;
+	if (context.m_Scheduler == this) {
+		isQueued = m_Workers[context.m_WorkerIndex].m_Jobs.TryPush(job);
+	}
+	else {
+		isQueued = m_InjectedJobs.TryWrite(job);
+	}
+
+	// The queues are full, there's already plenty of work for the other threads
+	if (isQueued == false) {
+		Execute(job);
+		return;
+	}
+
+	NotifyJobQueued();
+}
+
+inline bool JobScheduler::FindJob(Detail::Job** outJob) {
+
+	Detail::WorkerContext& context = Detail::GetWorkerContext();
+	bool isWorker = context.m_Scheduler == this;
+
+	if (isWorker && m_Workers[context.m_WorkerIndex].m_Jobs.TryPop(outJob)) {
+		return true;
+	}
+
+	if (m_InjectedJobs.TryRead(outJob)) {
+		return true;
+	}
+
+	// Start with the next worker, the workers don't all go after the same victim
+	size_t firstVictim = isWorker ? context.m_WorkerIndex + 1 : 0;
+	for (size_t i = 0; i < m_WorkerCount; ++i) {
+		size_t victim = (firstVictim + i) % m_WorkerCount;
+		if (isWorker && victim == context.m_WorkerIndex) {
+			continue;
+		}
+		if (m_Workers[victim].m_Jobs.TrySteal(outJob)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+inline void JobScheduler::Execute(Detail::Job* job) {
+
+	JobGroup* group = job->m_Group;
+	job->m_Run(job);
+	Detail::GetJobFreeList().Free(job);
+
+	// Release the results of the job to the thread waiting on the group
+	group->m_PendingCount.fetch_sub(1, std::memory_order_release);
+}
+
+inline void JobScheduler::WorkerMain(size_t workerIndex) {
+
+	Detail::WorkerContext& context = Detail::GetWorkerContext();
+	context.m_Scheduler = this;
+	context.m_WorkerIndex = workerIndex;
+
+	while (m_IsRunning.load(std::memory_order_relaxed)) {
+
+		uint64_t epoch = m_QueuedEpoch.load(std::memory_order_seq_cst);
+
+		bool isJobFound = false;
+		for (size_t spin = 0; spin < Detail::WORKER_SPIN_COUNT; ++spin) {
+			Detail::Job* job;
+			if (FindJob(&job)) {
+				Execute(job);
+				isJobFound = true;
+				break;
+			}
+			std::this_thread::yield();
+		}
+
+		if (isJobFound) {
+			continue;
+		}
+
+		// Sleep until a job is queued, a job queued since we read the epoch keeps us awake
+		std::unique_lock<std::mutex> lock(m_SleepMutex);
+		m_SleepingCount.fetch_add(1, std::memory_order_seq_cst);
+		m_WakeCondition.wait(lock, [this, epoch]() {
+			return m_QueuedEpoch.load(std::memory_order_seq_cst) != epoch || m_IsRunning.load() == false;
+		});
+		m_SleepingCount.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	context.m_Scheduler = nullptr;
+}
+
+inline void JobScheduler::NotifyJobQueued() {
+
+	m_QueuedEpoch.fetch_add(1, std::memory_order_seq_cst);
+	if (m_SleepingCount.load(std::memory_order_seq_cst) > 0) {
+		// Taking the lock assures that the sleeping worker is either waiting or will see the new epoch
+		std::lock_guard<std::mutex> lock(m_SleepMutex);
+		m_WakeCondition.notify_one();
+	}
+}
+
+template< typename FunctionType >
+void JobScheduler::SplitRange(JobGroup& group, size_t begin, size_t end, size_t grainSize, FunctionType& function) {
+
+	// Queue the upper halves and keep working on the lower half, the oldest jobs that the thieves
+	// take first are the largest ranges
+	while (end - begin > grainSize) {
+		size_t middle = begin + (end - begin) / 2;
+		Run(group, [this, &group, middle, end, grainSize, &function]() {
+			SplitRange(group, middle, end, grainSize, function);
+		});
+		end = middle;
+	}
+
+	function(begin, end);
+}
+
+MIST_NAMESPACE_END
@@ -1,117 +1,374 @@
 #pragma once
 
 #include <Mist_Common\include\UtilityMacros.h>
+#include "Constexpr.h"
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 MIST_NAMESPACE
 
+// Every method is constexpr, masks built from constants are computed at compile time and can be used
+// in static_asserts and template arguments. The intrinsics are only used outside of constant expressions.
+
 // -Public API-
 
 using BitField = uint32_t;
 
 // Determine if a bit is set
-inline bool IsBitSet(const BitField mask, const BitField index);
+constexpr bool IsBitSet(const BitField mask, const BitField index);
 
 // Set a bit to on
 // the index must be less than sizeof(BitField) * 8
-inline BitField SetBit(const BitField mask, const BitField index);
+constexpr BitField SetBit(const BitField mask, const BitField index);
 
 // Toggle a bit from on to off or off to on
-inline BitField ToggleBit(BitField mask, const BitField index);
+constexpr BitField ToggleBit(BitField mask, const BitField index);
 
 // Set a bit to off
-inline BitField UnsetBit(const BitField mask, const BitField index);
+constexpr BitField UnsetBit(const BitField mask, const BitField index);
 
 // Determine if a flag is set inside of the mask
-inline bool IsFlagSet(const BitField mask, const BitField flag);
+constexpr bool IsFlagSet(const BitField mask, const BitField flag);
 
 // Determine how many flags are set in the mask
-inline size_t CountBitsSet(BitField bits);
+constexpr size_t CountBitsSet(BitField bits);
+constexpr size_t CountBitsSet64(uint64_t bits);
+
+// Determine the index of the lowest bit set, returns the amount of bits of the mask if no bit is set
+constexpr size_t CountTrailingZeros(BitField bits);
+constexpr size_t CountTrailingZeros64(uint64_t bits);
+
+// Determine the amount of bits before the highest bit set, returns the amount of bits of the mask if no bit is set
+constexpr size_t CountLeadingZeros(BitField bits);
+constexpr size_t CountLeadingZeros64(uint64_t bits);
+
+// Gather the bits of value selected by the mask into the lowest bits of the result (pext)
+// mask = 0b1010, value = 0b1000 -> 0b10
+constexpr BitField ExtractBits(BitField value, BitField mask);
+
+// Scatter the lowest bits of value into the bits selected by the mask (pdep)
+// mask = 0b1010, value = 0b10 -> 0b1000
+constexpr BitField DepositBits(BitField value, BitField mask);
+
+// Call the function with the index of every bit set in the mask, from the lowest to the highest bit
+// @Example: for each component of a mask:
+//
+//		ForEachSetBit(componentMask, [&](size_t componentIndex) { ... });
+template< typename MaskType, typename FunctionType >
+constexpr void ForEachSetBit(MaskType mask, FunctionType&& function);
 
 // Get all of the set flags in the mask as their own masks
-inline void GetIndividualBitFlags(BitField mask, BitField* bits, size_t* maskCount);
+constexpr void GetIndividualBitFlags(BitField mask, BitField* bits, size_t* maskCount);
 
 // Get all of the indices of the bits set in the mask
-inline void GetIndividualBitIndices(const BitField mask, BitField* bitIndices, size_t* indexCount);
+constexpr void GetIndividualBitIndices(const BitField mask, BitField* bitIndices, size_t* indexCount);
 
 // Get a bit mask of all the bit indices
-inline BitField GetBitMask(const BitField* bitIndices, const size_t indexCount);
+constexpr BitField GetBitMask(const BitField* bitIndices, const size_t indexCount);
 
 // Get a bit mask for the bit passed in
-inline BitField GetBitFlag(const BitField bitIndex);
+constexpr BitField GetBitFlag(const BitField bitIndex);
 
 // Set all the bits from the range begin to end (exclusive)
-inline BitField SetBitRange(const BitField begin, const BitField end);
+constexpr BitField SetBitRange(const BitField begin, const BitField end);
 
-inline BitField GetBitRange(const BitField mask, const BitField begin, const BitField end);
+constexpr BitField GetBitRange(const BitField mask, const BitField begin, const BitField end);
 
 // Set all the bits from 0 -> end (exclusive)
 // end must be less than sizeof(BitField) * 8
-inline BitField SetLowerBitRange(const BitField end);
+constexpr BitField SetLowerBitRange(const BitField end);
 
 // Set all the bits from n -> end (inclusive)
 // end must more than 0
-inline BitField SetUpperBitRange(const BitField end);
+constexpr BitField SetUpperBitRange(const BitField end);
 
 // Determine the differing bits between left and right
-inline BitField GetMaskDifferences(const BitField left, const BitField right);
+constexpr BitField GetMaskDifferences(const BitField left, const BitField right);
+
+// Build a mask from bit indices at compile time, the indices are validated with a static_assert
+// @Example: A query signature that folds into an immediate:
+//
+//		constexpr BitField movementQuery = MakeMask<PositionComponent, VelocityComponent>();
+//		static_assert(IsFlagSet(movementQuery, GetBitFlag(PositionComponent)), "");
+template< BitField... tIndices >
+constexpr BitField MakeMask();
+
+
+// Iterates the indices of the bits set in a mask without allocating, there is no array of indices to fill.
+// Every step finds the lowest bit with a count of the trailing zeros and then clears it.
+// @Example: for each component of a mask:
+//
+//		for (size_t componentIndex : IterateSetBits(componentMask)) {
+//			...
+//		}
+template< typename MaskType >
+class SetBitIterator {
+	static_assert(std::is_unsigned<MaskType>::value, "The mask must be an unsigned integer.");
+
+public:
+
+	constexpr size_t operator*() const;
+	constexpr SetBitIterator& operator++();
+	constexpr bool operator!=(const SetBitIterator& other) const;
+	constexpr bool operator==(const SetBitIterator& other) const;
+
+	constexpr SetBitIterator() = default;
+	constexpr explicit SetBitIterator(MaskType mask) : m_Mask(mask) {}
+
+private:
+
+	// The bits that have yet to be visited
+	MaskType m_Mask = 0;
+};
+
+template< typename MaskType >
+struct SetBitIndexRange {
+	constexpr SetBitIterator<MaskType> begin() const { return SetBitIterator<MaskType>(m_Mask); }
+	constexpr SetBitIterator<MaskType> end() const { return SetBitIterator<MaskType>(); }
+
+	MaskType m_Mask;
+};
+
+template< typename MaskType >
+constexpr SetBitIndexRange<typename std::make_unsigned<MaskType>::type> IterateSetBits(MaskType mask);
 
 
 
 // -Implementation-
 
+namespace Detail {
+
+	// Portable fallbacks of the bit intrinsics
+	constexpr size_t PopCountFallback(uint64_t bits) {
+		// Count the bits in pairs, then nibbles and then sum the bytes with a multiply
+		bits = bits - ((bits >> 1) & 0x5555555555555555ull);
+		bits = (bits & 0x3333333333333333ull) + ((bits >> 2) & 0x3333333333333333ull);
+		bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return static_cast<size_t>((bits * 0x0101010101010101ull) >> 56);
+	}
+
+	constexpr size_t CountTrailingZerosFallback(uint64_t bits, size_t bitCount) {
+		if (bits == 0) {
+			return bitCount;
+		}
+		size_t count = 0;
+		while ((bits & 1) == 0) {
+			bits >>= 1;
+			++count;
+		}
+		return count;
+	}
+
+	constexpr size_t CountLeadingZerosFallback(uint64_t bits, size_t bitCount) {
+		size_t count = bitCount;
+		while (bits != 0) {
+			bits >>= 1;
+			--count;
+		}
+		return count;
+	}
+
+	// Pick the 32 or 64 bit version for the mask type
+	template< typename MaskType >
+	constexpr size_t CountTrailingZerosOf(MaskType bits) {
+		return sizeof(MaskType) <= sizeof(BitField) ? CountTrailingZeros(static_cast<BitField>(bits)) : CountTrailingZeros64(static_cast<uint64_t>(bits));
+	}
+}
+
 // Determine if a bit is set
-inline bool IsBitSet(const BitField mask, const BitField index) {
+constexpr bool IsBitSet(const BitField mask, const BitField index) {
 	// index must be less than sizeof(BitField) * 8
-	MIST_ASSERT(index < sizeof(BitField) * 8);
+	MIST_CONSTEXPR_ASSERT(index < sizeof(BitField) * 8);
 	return (mask >> index) & 1;
 }
 
 // Set a bit to on
 // the index must be less than sizeof(BitField) * 8
-inline BitField SetBit(const BitField mask, const BitField index) {
-	MIST_ASSERT(index < sizeof(BitField) * 8);
-	return mask | (1 << index);
+constexpr BitField SetBit(const BitField mask, const BitField index) {
+	MIST_CONSTEXPR_ASSERT(index < sizeof(BitField) * 8);
+	return mask | (BitField(1) << index);
 }
 
 // Toggle a bit from on to off or off to on
-inline BitField ToggleBit(BitField mask, const BitField index) {
+constexpr BitField ToggleBit(BitField mask, const BitField index) {
 	// index must be less than sizeof(BitField) * 8
-	MIST_ASSERT(index < sizeof(BitField) * 8);
-	return mask ^ (1 << index);
+	MIST_CONSTEXPR_ASSERT(index < sizeof(BitField) * 8);
+	return mask ^ (BitField(1) << index);
 }
 
 // Set a bit to off
-inline BitField UnsetBit(const BitField mask, const BitField index) {
+constexpr BitField UnsetBit(const BitField mask, const BitField index) {
 	// index must be less than sizeof(BitField) * 8
-	MIST_ASSERT(index < sizeof(BitField) * 8);
-	return mask & (~(1 << index));
+	MIST_CONSTEXPR_ASSERT(index < sizeof(BitField) * 8);
+	return mask & (~(BitField(1) << index));
 }
 
 
 // Determine if a flag is set inside of the mask
-inline bool IsFlagSet(const BitField mask, const BitField flag) {
+constexpr bool IsFlagSet(const BitField mask, const BitField flag) {
 	return (mask & flag) == flag;
 }
 
 // Determine how many flags are set in the mask
-// Concept from: https://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetKernighan.
-// Discovered and shared by: https://github.com/xoorath
-inline size_t CountBitsSet(BitField bits) {
-	size_t count = 0;
-	// While we still have bits left
+// @Detail: This uses the popcnt instruction when the compiler can target it, otherwise the bits
+//  are counted in parallel within the word.
+constexpr size_t CountBitsSet(BitField bits) {
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<size_t>(__builtin_popcount(bits));
+#elif defined(_MSC_VER) && defined(__AVX__) && MIST_HAS_CONSTANT_EVALUATED
+	// @Detail: MSVC always emits popcnt, it's only guaranteed to be available with AVX
+	if (MIST_IS_CONSTANT_EVALUATED() == false) {
+		return static_cast<size_t>(__popcnt(bits));
+	}
+	return Detail::PopCountFallback(bits);
+#else
+	return Detail::PopCountFallback(bits);
+#endif
+}
+
+constexpr size_t CountBitsSet64(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<size_t>(__builtin_popcountll(bits));
+#elif defined(_MSC_VER) && defined(__AVX__) && defined(_M_X64) && MIST_HAS_CONSTANT_EVALUATED
+	if (MIST_IS_CONSTANT_EVALUATED() == false) {
+		return static_cast<size_t>(__popcnt64(bits));
+	}
+	return Detail::PopCountFallback(bits);
+#else
+	return Detail::PopCountFallback(bits);
+#endif
+}
+
+constexpr size_t CountTrailingZeros(BitField bits) {
+	if (bits == 0) {
+		return sizeof(BitField) * 8;
+	}
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<size_t>(__builtin_ctz(bits));
+#elif defined(_MSC_VER) && MIST_HAS_CONSTANT_EVALUATED
+	if (MIST_IS_CONSTANT_EVALUATED() == false) {
+		unsigned long index = 0;
+		_BitScanForward(&index, bits);
+		return static_cast<size_t>(index);
+	}
+	return Detail::CountTrailingZerosFallback(bits, sizeof(BitField) * 8);
+#else
+	return Detail::CountTrailingZerosFallback(bits, sizeof(BitField) * 8);
+#endif
+}
+
+constexpr size_t CountTrailingZeros64(uint64_t bits) {
+	if (bits == 0) {
+		return sizeof(uint64_t) * 8;
+	}
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<size_t>(__builtin_ctzll(bits));
+#elif defined(_MSC_VER) && defined(_M_X64) && MIST_HAS_CONSTANT_EVALUATED
+	if (MIST_IS_CONSTANT_EVALUATED() == false) {
+		unsigned long index = 0;
+		_BitScanForward64(&index, bits);
+		return static_cast<size_t>(index);
+	}
+	return Detail::CountTrailingZerosFallback(bits, sizeof(uint64_t) * 8);
+#else
+	return Detail::CountTrailingZerosFallback(bits, sizeof(uint64_t) * 8);
+#endif
+}
+
+constexpr size_t CountLeadingZeros(BitField bits) {
+	if (bits == 0) {
+		return sizeof(BitField) * 8;
+	}
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<size_t>(__builtin_clz(bits));
+#elif defined(_MSC_VER) && MIST_HAS_CONSTANT_EVALUATED
+	if (MIST_IS_CONSTANT_EVALUATED() == false) {
+		unsigned long index = 0;
+		_BitScanReverse(&index, bits);
+		return sizeof(BitField) * 8 - 1 - static_cast<size_t>(index);
+	}
+	return Detail::CountLeadingZerosFallback(bits, sizeof(BitField) * 8);
+#else
+	return Detail::CountLeadingZerosFallback(bits, sizeof(BitField) * 8);
+#endif
+}
+
+constexpr size_t CountLeadingZeros64(uint64_t bits) {
+	if (bits == 0) {
+		return sizeof(uint64_t) * 8;
+	}
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<size_t>(__builtin_clzll(bits));
+#elif defined(_MSC_VER) && defined(_M_X64) && MIST_HAS_CONSTANT_EVALUATED
+	if (MIST_IS_CONSTANT_EVALUATED() == false) {
+		unsigned long index = 0;
+		_BitScanReverse64(&index, bits);
+		return sizeof(uint64_t) * 8 - 1 - static_cast<size_t>(index);
+	}
+	return Detail::CountLeadingZerosFallback(bits, sizeof(uint64_t) * 8);
+#else
+	return Detail::CountLeadingZerosFallback(bits, sizeof(uint64_t) * 8);
+#endif
+}
+
+constexpr BitField ExtractBits(BitField value, BitField mask) {
+#if defined(__BMI2__) && MIST_HAS_CONSTANT_EVALUATED
+	if (MIST_IS_CONSTANT_EVALUATED() == false) {
+		return _pext_u32(value, mask);
+	}
+#endif
+	// Walk the bits of the mask from the lowest, every selected bit goes to the next bit of the result
+	BitField result = 0;
+	for (BitField resultBit = 1; mask != 0; resultBit <<= 1) {
+		BitField lowestBit = mask & (~mask + 1);
+		if ((value & lowestBit) != 0) {
+			result |= resultBit;
+		}
+		mask &= mask - 1;
+	}
+	return result;
+}
+
+constexpr BitField DepositBits(BitField value, BitField mask) {
+#if defined(__BMI2__) && MIST_HAS_CONSTANT_EVALUATED
+	if (MIST_IS_CONSTANT_EVALUATED() == false) {
+		return _pdep_u32(value, mask);
+	}
+#endif
+	BitField result = 0;
+	for (BitField valueBit = 1; mask != 0; valueBit <<= 1) {
+		BitField lowestBit = mask & (~mask + 1);
+		if ((value & valueBit) != 0) {
+			result |= lowestBit;
+		}
+		mask &= mask - 1;
+	}
+	return result;
+}
+
+template< typename MaskType, typename FunctionType >
+constexpr void ForEachSetBit(MaskType mask, FunctionType&& function) {
+	using UnsignedMaskType = typename std::make_unsigned<MaskType>::type;
+	UnsignedMaskType bits = static_cast<UnsignedMaskType>(mask);
 	while (bits != 0) {
-		// Remove the least significant bit
+		function(Detail::CountTrailingZerosOf(bits));
+		// Remove the lowest bit
 		bits &= bits - 1;
-		++count;
 	}
-	return count;
 }
 
 // Get all of the set flags in the mask as their own masks
-inline void GetIndividualBitFlags(BitField mask, BitField* bits, size_t* maskCount) {
-	MIST_ASSERT(bits != nullptr);
-	MIST_ASSERT(maskCount != nullptr);
+constexpr void GetIndividualBitFlags(BitField mask, BitField* bits, size_t* maskCount) {
+	MIST_CONSTEXPR_ASSERT(bits != nullptr);
+	MIST_CONSTEXPR_ASSERT(maskCount != nullptr);
 
 	(*maskCount) = 0;
 	// While we still have bits left
@@ -128,94 +385,148 @@ inline void GetIndividualBitFlags(BitField mask, BitField* bits, size_t* maskCou
 }
 
 // Get all of the indices of the bits set in the mask
-inline void GetIndividualBitIndices(const BitField mask, BitField* bitIndices, size_t* indexCount) {
-	MIST_ASSERT(bitIndices != nullptr);
-	MIST_ASSERT(indexCount != nullptr);
+constexpr void GetIndividualBitIndices(const BitField mask, BitField* bitIndices, size_t* indexCount) {
+	MIST_CONSTEXPR_ASSERT(bitIndices != nullptr);
+	MIST_CONSTEXPR_ASSERT(indexCount != nullptr);
 
 	(*indexCount) = 0;
-	// loop through every bit of the mask and determine if they're on or not
-	for (BitField i = 0; i < sizeof(BitField); ++i) {
-		if (IsBitSet(mask, i)) {
-			// Add the index to the array
-			bitIndices[(*indexCount)] = i;
-			++(*indexCount);
-		}
+	// Only visit the bits that are set, the lowest bit is found and then removed
+	BitField remainingBits = mask;
+	while (remainingBits != 0) {
+		bitIndices[(*indexCount)] = static_cast<BitField>(CountTrailingZeros(remainingBits));
+		++(*indexCount);
+		remainingBits &= remainingBits - 1;
 	}
 }
 
 // Get a bit mask of all the bit indices
-inline BitField GetBitMask(const BitField* bitIndices, const size_t indexCount) {
-	MIST_ASSERT(bitIndices != nullptr);
+constexpr BitField GetBitMask(const BitField* bitIndices, const size_t indexCount) {
+	MIST_CONSTEXPR_ASSERT(bitIndices != nullptr);
 
 	BitField mask = 0;
 	for (size_t i = 0; i < indexCount; ++i) {
 		// index must be less than sizeof(BitField) * 8
-		MIST_ASSERT(bitIndices[i] < sizeof(BitField) * 8);
+		MIST_CONSTEXPR_ASSERT(bitIndices[i] < sizeof(BitField) * 8);
 
-		mask |= 1 << (bitIndices[i]);
+		mask |= BitField(1) << (bitIndices[i]);
 	}
 	return mask;
 }
 
 // Get a bit mask for the bit passed in
-inline BitField GetBitFlag(const BitField bitIndex) {
+constexpr BitField GetBitFlag(const BitField bitIndex) {
 	// index must be less than sizeof(BitField) * 8
-	MIST_ASSERT(bitIndex < sizeof(BitField) * 8);
+	MIST_CONSTEXPR_ASSERT(bitIndex < sizeof(BitField) * 8);
 
-	return 1 << bitIndex;
+	return BitField(1) << bitIndex;
 }
 
 // Set all the bits from the range begin to end (exclusive)
-inline BitField SetBitRange(const BitField begin, const BitField end) {
+constexpr BitField SetBitRange(const BitField begin, const BitField end) {
 	// index must be less than sizeof(BitField) * 8
-	MIST_ASSERT(begin < sizeof(BitField) * 8);
-	MIST_ASSERT(end < sizeof(BitField) * 8);
+	MIST_CONSTEXPR_ASSERT(begin < sizeof(BitField) * 8);
+	MIST_CONSTEXPR_ASSERT(end < sizeof(BitField) * 8);
 	// If begin is equal or greater than end, the result is 0. This probably isn't the intended range to set.
-	MIST_ASSERT(begin < end);
+	MIST_CONSTEXPR_ASSERT(begin < end);
 
 	BitField rangeBitmask = 0;
 	// Set the end bit and transform it into a range of those bits
 	// end = 4 -> 00001111
-	rangeBitmask |= (1 << end) - 1;
+	rangeBitmask |= (BitField(1) << end) - 1;
 	// Remove the bits before the begin index
 	// begin = 2 -> 11111100
 	// 00001111 & 11111100 = 00001100
-	rangeBitmask &= ~((1 << begin) - 1);
+	rangeBitmask &= ~((BitField(1) << begin) - 1);
 	return rangeBitmask;
 }
 
-inline BitField GetBitRange(const BitField mask, const BitField begin, const BitField end) {
+constexpr BitField GetBitRange(const BitField mask, const BitField begin, const BitField end) {
 	// index must be less than sizeof(BitField) * 8
-	MIST_ASSERT(begin < sizeof(BitField) * 8);
-	MIST_ASSERT(end < sizeof(BitField) * 8);
+	MIST_CONSTEXPR_ASSERT(begin < sizeof(BitField) * 8);
+	MIST_CONSTEXPR_ASSERT(end < sizeof(BitField) * 8);
 	// Begin must be less than end or else the mask is 0 and has no effect
-	MIST_ASSERT(begin < end);
+	MIST_CONSTEXPR_ASSERT(begin < end);
 
 	BitField rangeBitmask = 0;
-	rangeBitmask |= (1 << end) - 1;
-	rangeBitmask &= ~((1 << begin) - 1);
+	rangeBitmask |= (BitField(1) << end) - 1;
+	rangeBitmask &= ~((BitField(1) << begin) - 1);
 	return mask & rangeBitmask;
 }
 
 // Set all the bits from 0 -> end (exclusive)
 // end must be less than sizeof(BitField) * 8
-inline BitField SetLowerBitRange(const BitField end) {
-	MIST_ASSERT(end < sizeof(BitField) * 8);
+constexpr BitField SetLowerBitRange(const BitField end) {
+	MIST_CONSTEXPR_ASSERT(end < sizeof(BitField) * 8);
 	// end = 4 -> 00000001 -> 00010000 -> 00001111
-	return (1 << end) - 1;
+	return (BitField(1) << end) - 1;
 }
 
 // Set all the bits from n -> end (inclusive)
 // end must more than 0
-inline BitField SetUpperBitRange(const BitField end) {
-	MIST_ASSERT(end > 0);
+constexpr BitField SetUpperBitRange(const BitField end) {
+	MIST_CONSTEXPR_ASSERT(end > 0);
 	// end = 5 = 8 - 5 = 3 -> 00000001 -> 00001000 -> 00000111 -> 11111000
-	return ~((1 << (sizeof(BitField) * 8 - end)) - 1);
+	return ~((BitField(1) << (sizeof(BitField) * 8 - end)) - 1);
 }
 
 // Determine the differing bits between left and right
-inline BitField GetMaskDifferences(const BitField left, const BitField right) {
+constexpr BitField GetMaskDifferences(const BitField left, const BitField right) {
 	return left ^ right;
 }
 
+namespace Detail {
+
+	constexpr BitField MakeMaskOf() {
+		return 0;
+	}
+
+	template< typename... IndexTypes >
+	constexpr BitField MakeMaskOf(BitField index, IndexTypes... indices) {
+		return GetBitFlag(index) | MakeMaskOf(indices...);
+	}
+
+	constexpr bool AreBitIndicesValid() {
+		return true;
+	}
+
+	template< typename... IndexTypes >
+	constexpr bool AreBitIndicesValid(BitField index, IndexTypes... indices) {
+		return index < sizeof(BitField) * 8 && AreBitIndicesValid(indices...);
+	}
+}
+
+template< BitField... tIndices >
+constexpr BitField MakeMask() {
+	static_assert(Detail::AreBitIndicesValid(tIndices...), "Every index of the mask must be less than sizeof(BitField) * 8.");
+	return Detail::MakeMaskOf(tIndices...);
+}
+
+template< typename MaskType >
+constexpr size_t SetBitIterator<MaskType>::operator*() const {
+	MIST_CONSTEXPR_ASSERT(m_Mask != 0);
+	return Detail::CountTrailingZerosOf(m_Mask);
+}
+
+template< typename MaskType >
+constexpr SetBitIterator<MaskType>& SetBitIterator<MaskType>::operator++() {
+	// Remove the lowest bit
+	m_Mask &= m_Mask - 1;
+	return *this;
+}
+
+template< typename MaskType >
+constexpr bool SetBitIterator<MaskType>::operator!=(const SetBitIterator& other) const {
+	return m_Mask != other.m_Mask;
+}
+
+template< typename MaskType >
+constexpr bool SetBitIterator<MaskType>::operator==(const SetBitIterator& other) const {
+	return m_Mask == other.m_Mask;
+}
+
+template< typename MaskType >
+constexpr SetBitIndexRange<typename std::make_unsigned<MaskType>::type> IterateSetBits(MaskType mask) {
+	return { static_cast<typename std::make_unsigned<MaskType>::type>(mask) };
+}
+
 MIST_NAMESPACE_END
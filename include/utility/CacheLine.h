@@ -0,0 +1,12 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include <cstddef>
+
+MIST_NAMESPACE
+
+// The size of a cache line on the targeted platforms (x86-64 and most ARM cores).
+// Data written by different threads should be kept on different cache lines to avoid false sharing.
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+MIST_NAMESPACE_END
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+namespace Detail {
+
+	// Called when a constexpr assert fails.
+	// @Detail: This method is not constexpr, a failed assert in a constant expression becomes a compilation error
+	//  while a failed assert at runtime goes through the usual MIST_ASSERT.
+	inline void ConstexprAssertFailed() {
+		MIST_ASSERT(false);
+	}
+}
+
+MIST_NAMESPACE_END
+
+// Assert that can be used inside of constexpr methods
+#if MIST_DEBUG
+#define MIST_CONSTEXPR_ASSERT(condition) ((condition) ? (void)0 : ::Mist::Detail::ConstexprAssertFailed())
+#else
+#define MIST_CONSTEXPR_ASSERT(condition) ((void)0)
+#endif
+
+// Determine if the current evaluation is a constant expression, this allows constexpr methods
+// to use intrinsics that aren't constexpr at runtime.
+// MIST_HAS_CONSTANT_EVALUATED is 0 when the compiler can't tell, the intrinsics should then be avoided in constexpr methods.
+#if defined(__cpp_lib_is_constant_evaluated)
+#define MIST_HAS_CONSTANT_EVALUATED 1
+#define MIST_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define MIST_HAS_CONSTANT_EVALUATED 1
+#define MIST_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define MIST_HAS_CONSTANT_EVALUATED 1
+#define MIST_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#if !defined(MIST_HAS_CONSTANT_EVALUATED)
+#define MIST_HAS_CONSTANT_EVALUATED 0
+#define MIST_IS_CONSTANT_EVALUATED() true
+#endif
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+MIST_NAMESPACE
+
+// Non cryptographic hash functions, none of them should be used for anything that can be attacked.
+// - djb2, a tiny constexpr string hash for compile time identifiers
+// - Hash64, a fast hash of any block of bytes in the spirit of wyhash, it reads 16 to 48 bytes per step
+// - Hash<Type>, the hashing functor used by the HashMap
+
+// -djb2-
+
+namespace djb2 {
+
+	// Hash a null terminated string, usable at compile time
+	// @Example: constexpr uint32_t positionId = djb2::Hash("m_Position");
+	constexpr uint32_t Hash(const char* string, uint32_t hash = 5381) {
+		return *string == '\0' ? hash : Hash(string + 1, hash * 33 + static_cast<uint8_t>(*string));
+	}
+}
+
+// -Hash64-
+
+namespace Detail {
+
+	constexpr uint64_t HASH_SECRET[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+	// Multiply two 64 bit values into a 128 bit result, the low bits are written into left and the high bits into right
+	inline void Multiply128(uint64_t* left, uint64_t* right) {
+
+#if defined(__SIZEOF_INT128__)
+		__uint128_t result = static_cast<__uint128_t>(*left) * *right;
+		*left = static_cast<uint64_t>(result);
+		*right = static_cast<uint64_t>(result >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		*left = _umul128(*left, *right, right);
+#else
+		uint64_t leftHigh = *left >> 32, leftLow = static_cast<uint32_t>(*left);
+		uint64_t rightHigh = *right >> 32, rightLow = static_cast<uint32_t>(*right);
+		uint64_t high = leftHigh * rightHigh, middle0 = leftHigh * rightLow, middle1 = leftLow * rightHigh, low = leftLow * rightLow;
+		uint64_t middle = (low >> 32) + static_cast<uint32_t>(middle0) + static_cast<uint32_t>(middle1);
+		*left = (middle << 32) | static_cast<uint32_t>(low);
+		*right = high + (middle0 >> 32) + (middle1 >> 32) + (middle >> 32);
+#endif
+	}
+
+	// Multiply and fold the 128 bit result, this is where every bit of the input is mixed with every other bit
+	inline uint64_t Mix(uint64_t left, uint64_t right) {
+		Multiply128(&left, &right);
+		return left ^ right;
+	}
+
+	// The reads are done through memcpy, they compile to a single unaligned load
+	inline uint64_t Read64(const uint8_t* bytes) {
+		uint64_t value;
+		memcpy(&value, bytes, sizeof(value));
+		return value;
+	}
+
+	inline uint64_t Read32(const uint8_t* bytes) {
+		uint32_t value;
+		memcpy(&value, bytes, sizeof(value));
+		return value;
+	}
+
+	// Read 1 to 3 bytes without branching on the size
+	inline uint64_t ReadSmall(const uint8_t* bytes, size_t size) {
+		return (static_cast<uint64_t>(bytes[0]) << 16) | (static_cast<uint64_t>(bytes[size >> 1]) << 8) | bytes[size - 1];
+	}
+}
+
+// Hash a block of bytes, the seed can be used to get independent hashes of the same data.
+// @Detail: This follows wyhash (final version 4) and it's default secret. Blocks of at most 16 bytes are hashed
+//  with a couple of overlapping reads and no loop, larger blocks are consumed in 3 independent lanes of 16 bytes.
+//  The reads are native endian, the hashes differ between little and big endian platforms.
+inline uint64_t Hash64(const void* data, size_t size, uint64_t seed = 0) {
+
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	seed ^= Detail::Mix(seed ^ Detail::HASH_SECRET[0], Detail::HASH_SECRET[1]);
+
+	uint64_t left;
+	uint64_t right;
+	if (size <= 16) {
+		if (size >= 4) {
+			size_t offset = (size >> 3) << 2;
+			left = (Detail::Read32(bytes) << 32) | Detail::Read32(bytes + offset);
+			right = (Detail::Read32(bytes + size - 4) << 32) | Detail::Read32(bytes + size - 4 - offset);
+		}
+		else if (size > 0) {
+			left = Detail::ReadSmall(bytes, size);
+			right = 0;
+		}
+		else {
+			left = 0;
+			right = 0;
+		}
+	}
+	else {
+		size_t remaining = size;
+		if (remaining > 48) {
+			uint64_t seed1 = seed;
+			uint64_t seed2 = seed;
+			do {
+				seed = Detail::Mix(Detail::Read64(bytes) ^ Detail::HASH_SECRET[1], Detail::Read64(bytes + 8) ^ seed);
+				seed1 = Detail::Mix(Detail::Read64(bytes + 16) ^ Detail::HASH_SECRET[2], Detail::Read64(bytes + 24) ^ seed1);
+				seed2 = Detail::Mix(Detail::Read64(bytes + 32) ^ Detail::HASH_SECRET[3], Detail::Read64(bytes + 40) ^ seed2);
+				bytes += 48;
+				remaining -= 48;
+			} while (remaining > 48);
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (remaining > 16) {
+			seed = Detail::Mix(Detail::Read64(bytes) ^ Detail::HASH_SECRET[1], Detail::Read64(bytes + 8) ^ seed);
+			bytes += 16;
+			remaining -= 16;
+		}
+
+		// The last 16 bytes overlap with the bytes that were already hashed
+		left = Detail::Read64(bytes + remaining - 16);
+		right = Detail::Read64(bytes + remaining - 8);
+	}
+
+	left ^= Detail::HASH_SECRET[1];
+	right ^= seed;
+	Detail::Multiply128(&left, &right);
+	return Detail::Mix(left ^ Detail::HASH_SECRET[0] ^ size, right ^ Detail::HASH_SECRET[1]);
+}
+
+// Hash a single integer, this is a single multiplication and is much cheaper than hashing the bytes of the integer
+inline uint64_t HashInteger(uint64_t value) {
+
+	return Detail::Mix(value ^ Detail::HASH_SECRET[0], Detail::HASH_SECRET[1]);
+}
+
+// -Hash functors-
+
+// The hashing functor used by the hash map, specialize it to hash your own types.
+// Integers, enums and pointers are hashed by value, every bit of the key affects every bit of the hash.
+template< typename Type, typename Enable = void >
+struct Hash;
+
+template< typename Type >
+struct Hash<Type, typename std::enable_if<std::is_integral<Type>::value || std::is_enum<Type>::value>::type> {
+	uint64_t operator()(Type value) const { return HashInteger(static_cast<uint64_t>(value)); }
+};
+
+template< typename Type >
+struct Hash<Type*> {
+	uint64_t operator()(const Type* value) const { return HashInteger(reinterpret_cast<uintptr_t>(value)); }
+};
+
+// Strings are hashed by their characters, the hash is transparent and can hash a string literal without creating a string.
+// The hash of a string and of a null terminated string with the same characters are the same.
+template<>
+struct Hash<std::string> {
+	using is_transparent = void;
+
+	uint64_t operator()(const std::string& value) const { return Hash64(value.data(), value.size()); }
+	uint64_t operator()(const char* value) const { return Hash64(value, strlen(value)); }
+};
+
+MIST_NAMESPACE_END
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include <type_traits>
+
+MIST_NAMESPACE
+
+// Determine if a type can be moved to a new memory location with a simple memcpy
+// and without calling the destructor on the previous location.
+// @Detail: This defaults to trivially copyable types, specialize this trait for types that are safe
+//  to relocate bitwise but aren't trivially copyable (Such as types holding a pointer to heap memory)
+// @Example:
+//
+//		template<>
+//		struct IsTriviallyRelocatable<MyHandle> : std::true_type {};
+template< typename Type >
+struct IsTriviallyRelocatable : std::integral_constant<bool, std::is_trivially_copyable<Type>::value> {};
+
+MIST_NAMESPACE_END
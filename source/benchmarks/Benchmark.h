@@ -0,0 +1,284 @@
+#pragma once
+
+#include <Mist_Common/include/UtilityMacros.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+MIST_NAMESPACE
+
+namespace Benchmark {
+
+	// The benchmarks are timed with a monotonic clock, time never goes backwards.
+	using Clock = std::chrono::steady_clock;
+
+	// -Optimization Barriers-
+
+	// Force the compiler to assume the value is read, the computation of the value can't be removed.
+	// @Example: Timing a sum that is otherwise never used would look like:
+	//
+	//		size_t sum = 0;
+	//		for (size_t value : values) {
+	//			sum += value;
+	//		}
+	//		DoNotOptimize(sum);
+	template< typename ValueType >
+	inline void DoNotOptimize(const ValueType& value) {
+#if defined(_MSC_VER)
+		// MSVC doesn't support inline assembly on x64, read the value through a volatile pointer instead
+		const volatile char* volatile sink = reinterpret_cast<const volatile char*>(&value);
+		(void)sink;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	// Force the compiler to assume every pending write to memory is observed.
+	inline void ClobberMemory() {
+#if defined(_MSC_VER)
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+
+	// -Input Distributions-
+
+	enum class Distribution {
+		Random,
+		Sorted,
+		Reversed,
+		// Only 16 distinct values
+		FewUnique,
+		Count
+	};
+
+	inline const char* DistributionName(Distribution distribution) {
+
+		switch (distribution) {
+		case Distribution::Random: return "random";
+		case Distribution::Sorted: return "sorted";
+		case Distribution::Reversed: return "reversed";
+		case Distribution::FewUnique: return "few-unique";
+		default: return "unknown";
+		}
+	}
+
+	// Generate count values in [0, count) following the distribution, the same seed always creates the same values.
+	template< typename ValueType >
+	std::vector<ValueType> GenerateValues(Distribution distribution, size_t count, uint64_t seed = 0x5EED) {
+
+		std::vector<ValueType> values(count);
+		std::mt19937_64 generator(seed);
+
+		switch (distribution) {
+		case Distribution::Random: {
+			std::uniform_int_distribution<uint64_t> range(0, count > 0 ? count - 1 : 0);
+			for (ValueType& value : values) {
+				value = static_cast<ValueType>(range(generator));
+			}
+			break;
+		}
+		case Distribution::Sorted:
+			for (size_t i = 0; i < count; i++) {
+				values[i] = static_cast<ValueType>(i);
+			}
+			break;
+		case Distribution::Reversed:
+			for (size_t i = 0; i < count; i++) {
+				values[i] = static_cast<ValueType>(count - i - 1);
+			}
+			break;
+		case Distribution::FewUnique: {
+			std::uniform_int_distribution<uint64_t> range(0, 15);
+			for (ValueType& value : values) {
+				value = static_cast<ValueType>(range(generator));
+			}
+			break;
+		}
+		default:
+			MIST_ASSERT(false);
+		}
+		return values;
+	}
+
+	// -Measurements-
+
+	struct Settings {
+
+		// Runs that are executed before measuring, they warm up the caches, the branch predictors and the allocator
+		size_t m_WarmupRuns = 2;
+		size_t m_Repetitions = 15;
+		// Only the benchmarks containing the filter in their name are run
+		std::string m_Filter;
+	};
+
+	// The timings of every repetition of a benchmark, all of the times are in nanoseconds
+	struct Result {
+
+		std::string m_Group;
+		std::string m_Name;
+		std::string m_Distribution;
+		size_t m_Size = 0;
+		size_t m_Repetitions = 0;
+		double m_Median = 0.0;
+		double m_P99 = 0.0;
+		double m_Minimum = 0.0;
+		double m_Mean = 0.0;
+		// The amount of items processed per second at the median time
+		double m_ItemsPerSecond = 0.0;
+	};
+
+	namespace Detail {
+
+		// Nearest rank percentile of sorted samples
+		inline double Percentile(const std::vector<double>& sortedSamples, double percentile) {
+
+			MIST_ASSERT(sortedSamples.empty() == false);
+			size_t rank = static_cast<size_t>(percentile * static_cast<double>(sortedSamples.size()) + 0.999999);
+			rank = std::max<size_t>(rank, 1);
+			return sortedSamples[std::min(rank, sortedSamples.size()) - 1];
+		}
+	}
+
+	// Measure the run, the setup is called before every run and isn't timed (Such as copying the unsorted input).
+	// itemCount is the amount of items a single run processes, it's used to compute the throughput.
+	template< typename SetupType, typename RunType >
+	Result Measure(const Settings& settings, const char* group, const char* name, const char* distribution, size_t itemCount,
+		SetupType setup, RunType run) {
+
+		for (size_t i = 0; i < settings.m_WarmupRuns; i++) {
+			setup();
+			run();
+			ClobberMemory();
+		}
+
+		std::vector<double> samples(settings.m_Repetitions);
+		for (double& sample : samples) {
+
+			setup();
+			ClobberMemory();
+			Clock::time_point start = Clock::now();
+			run();
+			ClobberMemory();
+			Clock::time_point end = Clock::now();
+			sample = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+		}
+		std::sort(samples.begin(), samples.end());
+
+		Result result;
+		result.m_Group = group;
+		result.m_Name = name;
+		result.m_Distribution = distribution;
+		result.m_Size = itemCount;
+		result.m_Repetitions = samples.size();
+		result.m_Median = Detail::Percentile(samples, 0.5);
+		result.m_P99 = Detail::Percentile(samples, 0.99);
+		result.m_Minimum = samples.front();
+		result.m_Mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+		result.m_ItemsPerSecond = result.m_Median > 0.0 ? static_cast<double>(itemCount) * 1e9 / result.m_Median : 0.0;
+		return result;
+	}
+
+	// -Reporting-
+
+	enum class Format {
+		Table,
+		Csv,
+		Json
+	};
+
+	// Write a single result, the table format is written as the benchmarks run to show the progress
+	inline void ReportTableRow(const Result& result, std::ostream& stream) {
+
+		stream << result.m_Group << "/" << result.m_Name << "/" << result.m_Distribution << "/" << result.m_Size
+			<< ": median " << result.m_Median / 1000.0 << "us"
+			<< ", p99 " << result.m_P99 / 1000.0 << "us"
+			<< ", " << result.m_ItemsPerSecond / 1e6 << "M items/s" << std::endl;
+	}
+
+	inline void ReportCsv(const std::vector<Result>& results, std::ostream& stream) {
+
+		stream << "group,name,distribution,size,repetitions,median_ns,p99_ns,min_ns,mean_ns,items_per_second" << std::endl;
+		for (const Result& result : results) {
+			stream << result.m_Group << "," << result.m_Name << "," << result.m_Distribution << "," << result.m_Size << ","
+				<< result.m_Repetitions << "," << result.m_Median << "," << result.m_P99 << "," << result.m_Minimum << ","
+				<< result.m_Mean << "," << result.m_ItemsPerSecond << std::endl;
+		}
+	}
+
+	inline void ReportJson(const std::vector<Result>& results, std::ostream& stream) {
+
+		// The names are generated by the benchmarks, they never need to be escaped
+		stream << "[" << std::endl;
+		for (size_t i = 0; i < results.size(); i++) {
+
+			const Result& result = results[i];
+			stream << "\t{ \"group\": \"" << result.m_Group << "\", \"name\": \"" << result.m_Name
+				<< "\", \"distribution\": \"" << result.m_Distribution << "\", \"size\": " << result.m_Size
+				<< ", \"repetitions\": " << result.m_Repetitions << ", \"median_ns\": " << result.m_Median
+				<< ", \"p99_ns\": " << result.m_P99 << ", \"min_ns\": " << result.m_Minimum
+				<< ", \"mean_ns\": " << result.m_Mean << ", \"items_per_second\": " << result.m_ItemsPerSecond
+				<< (i + 1 < results.size() ? " }," : " }") << std::endl;
+		}
+		stream << "]" << std::endl;
+	}
+
+	// Collects the results of the benchmarks and writes them in the requested format
+	class Runner {
+
+	public:
+
+		// -Public API-
+
+		// Run the benchmark unless it's filtered out
+		template< typename SetupType, typename RunType >
+		void Run(const char* group, const char* name, const char* distribution, size_t itemCount, SetupType setup, RunType run) {
+
+			std::string fullName = std::string(group) + "/" + name;
+			if (m_Settings.m_Filter.empty() == false && fullName.find(m_Settings.m_Filter) == std::string::npos) {
+				return;
+			}
+
+			m_Results.push_back(Measure(m_Settings, group, name, distribution, itemCount, setup, run));
+			if (m_Format == Format::Table) {
+				ReportTableRow(m_Results.back(), std::cout);
+			}
+		}
+
+		// Write the results in the csv or json format, the table is written while running
+		void Report(std::ostream& stream) const {
+
+			if (m_Format == Format::Csv) {
+				ReportCsv(m_Results, stream);
+			}
+			else if (m_Format == Format::Json) {
+				ReportJson(m_Results, stream);
+			}
+		}
+
+		const Settings& GetSettings() const { return m_Settings; }
+
+		// -Structors-
+
+		Runner(const Settings& settings, Format format) : m_Settings(settings), m_Format(format) {}
+
+	private:
+
+		Settings m_Settings;
+		Format m_Format;
+		std::vector<Result> m_Results;
+	};
+}
+
+MIST_NAMESPACE_END
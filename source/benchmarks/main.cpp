@@ -0,0 +1,569 @@
+#include <Mist_Common/include/UtilityMacros.h>
+
+#include "Benchmark.h"
+#include "../../include/algorithms/Sorting.h"
+#include "../../include/data-structures/DynamicArray.h"
+#include "../../include/data-structures/SingleList.h"
+#include "../../include/data-structures/UnrolledList.h"
+#include "../../include/data-structures/RingBuffer.h"
+#include "../../include/data-structures/SpscRingBuffer.h"
+#include "../../include/data-structures/MpmcRingBuffer.h"
+#include "../../include/data-structures/HashMap.h"
+#include "../../include/data-structures/PriorityQueue.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Benchmarks of the containers and algorithms against their standard library counterparts.
+// Usage: benchmarks [--format=table|csv|json] [--output=file] [--filter=substring] [--repetitions=n] [--warmup=n] [--quick]
+//  The filter matches "group/name", such as "sort/QuickSort" or "list/".
+
+using Mist::Benchmark::Distribution;
+using Mist::Benchmark::Runner;
+using Mist::Benchmark::DoNotOptimize;
+
+namespace {
+
+	std::vector<size_t> s_SortSizes = { 1 << 10, 1 << 14, 1 << 17, 1 << 20 };
+	std::vector<size_t> s_ContainerSizes = { 1 << 10, 1 << 16, 1 << 20 };
+
+	// Quadratic algorithms are only run up to this size
+	constexpr size_t QUADRATIC_SIZE_LIMIT = 1 << 14;
+
+	// -Sorting-
+
+	void BenchmarkSorting(Runner& runner) {
+
+		for (size_t size : s_SortSizes) {
+			for (size_t distributionIndex = 0; distributionIndex < static_cast<size_t>(Distribution::Count); distributionIndex++) {
+
+				Distribution distribution = static_cast<Distribution>(distributionIndex);
+				const char* distributionName = Mist::Benchmark::DistributionName(distribution);
+
+				const std::vector<int32_t> input = Mist::Benchmark::GenerateValues<int32_t>(distribution, size);
+				std::vector<int32_t> values(size);
+				std::vector<int32_t> scratch(size);
+				auto reset = [&]() { std::copy(input.begin(), input.end(), values.begin()); };
+				const int32_t minimum = *std::min_element(input.begin(), input.end());
+				const int32_t maximum = *std::max_element(input.begin(), input.end()) + 1;
+
+				runner.Run("sort", "std::sort", distributionName, size, reset, [&]() {
+					std::sort(values.begin(), values.end());
+				});
+				runner.Run("sort", "std::stable_sort", distributionName, size, reset, [&]() {
+					std::stable_sort(values.begin(), values.end());
+				});
+				runner.Run("sort", "QuickSort", distributionName, size, reset, [&]() {
+					Mist::QuickSort(values.data(), values.data() + size);
+				});
+				runner.Run("sort", "HeapSort", distributionName, size, reset, [&]() {
+					Mist::HeapSort(values.data(), values.data() + size);
+				});
+				runner.Run("sort", "MergeSort", distributionName, size, reset, [&]() {
+					Mist::MergeSort(values.data(), values.data() + size, scratch.data());
+				});
+				runner.Run("sort", "ParallelMergeSort", distributionName, size, reset, [&]() {
+					Mist::ParallelMergeSort(values.data(), values.data() + size);
+				});
+				runner.Run("sort", "RadixSort", distributionName, size, reset, [&]() {
+					Mist::RadixSort(values.data(), values.data() + size, scratch.data(), Mist::Detail::IdentityKey());
+				});
+				runner.Run("sort", "BucketSort", distributionName, size, reset, [&]() {
+					Mist::BucketSort(values.begin(), values.end(), minimum, maximum);
+				});
+
+				// Selecting the 1% smallest values
+				const size_t k = std::max<size_t>(size / 100, 1);
+				runner.Run("select", "std::nth_element", distributionName, size, reset, [&]() {
+					std::nth_element(values.begin(), values.begin() + k, values.end());
+				});
+				runner.Run("select", "NthElement", distributionName, size, reset, [&]() {
+					Mist::NthElement(values.begin(), values.begin() + k, values.end());
+				});
+				runner.Run("select", "std::partial_sort", distributionName, size, reset, [&]() {
+					std::partial_sort(values.begin(), values.begin() + k, values.end());
+				});
+				runner.Run("select", "PartialSort", distributionName, size, reset, [&]() {
+					Mist::PartialSort(values.begin(), values.begin() + k, values.end());
+				});
+				runner.Run("select", "TopK", distributionName, size, []() {}, [&]() {
+					DoNotOptimize(Mist::TopK(input.begin(), input.end(), scratch.data(), k));
+				});
+
+				// Merging a batch of an eighth of the size into a sorted collection
+				std::vector<int32_t> sortedInput(input.begin(), input.end() - size / 8);
+				std::sort(sortedInput.begin(), sortedInput.end());
+				const std::vector<int32_t> batch(input.end() - size / 8, input.end());
+				std::vector<int32_t> destination;
+				auto resetDestination = [&]() { destination = sortedInput; };
+
+				runner.Run("insert", "BulkInsertionSort", distributionName, batch.size(), resetDestination, [&]() {
+					Mist::BulkInsertionSort(batch, &destination);
+				});
+				if (size <= QUADRATIC_SIZE_LIMIT) {
+					runner.Run("insert", "InsertionSort", distributionName, batch.size(), resetDestination, [&]() {
+						Mist::InsertionSort(batch, &destination);
+					});
+				}
+				runner.Run("insert", "std::sort+std::inplace_merge", distributionName, batch.size(), resetDestination, [&]() {
+					size_t middle = destination.size();
+					destination.insert(destination.end(), batch.begin(), batch.end());
+					std::sort(destination.begin() + middle, destination.end());
+					std::inplace_merge(destination.begin(), destination.begin() + middle, destination.end());
+				});
+			}
+		}
+
+		// Sorting networks sort many small blocks
+		const size_t blockCount = 1 << 12;
+		constexpr size_t networkSize = Mist::Detail::MAX_SORTING_NETWORK_SIZE;
+		const std::vector<int32_t> input = Mist::Benchmark::GenerateValues<int32_t>(Distribution::Random, blockCount * networkSize);
+		std::vector<int32_t> values(input.size());
+		auto reset = [&]() { std::copy(input.begin(), input.end(), values.begin()); };
+
+		runner.Run("network", "SortingNetwork<64>", "random", values.size(), reset, [&]() {
+			for (size_t i = 0; i < blockCount; i++) {
+				Mist::SortingNetwork<networkSize>(values.data() + i * networkSize);
+			}
+		});
+		runner.Run("network", "std::sort", "random", values.size(), reset, [&]() {
+			for (size_t i = 0; i < blockCount; i++) {
+				std::sort(values.data() + i * networkSize, values.data() + (i + 1) * networkSize);
+			}
+		});
+	}
+
+	// -Dynamic Array-
+
+	void BenchmarkDynamicArray(Runner& runner) {
+
+		for (size_t size : s_ContainerSizes) {
+
+			runner.Run("array", "std::vector/append", "sorted", size, []() {}, [&]() {
+				std::vector<size_t> values;
+				for (size_t i = 0; i < size; i++) {
+					values.push_back(i);
+				}
+				DoNotOptimize(values.data());
+			});
+			runner.Run("array", "DynamicArray/append", "sorted", size, []() {}, [&]() {
+				Mist::DynamicArray<size_t> values;
+				for (size_t i = 0; i < size; i++) {
+					values.InsertAsLast(i);
+				}
+				DoNotOptimize(values.AsRawArray());
+			});
+			runner.Run("array", "std::vector/append-reserved", "sorted", size, []() {}, [&]() {
+				std::vector<size_t> values;
+				values.reserve(size);
+				for (size_t i = 0; i < size; i++) {
+					values.push_back(i);
+				}
+				DoNotOptimize(values.data());
+			});
+			runner.Run("array", "DynamicArray/append-reserved", "sorted", size, []() {}, [&]() {
+				Mist::DynamicArray<size_t> values(size);
+				for (size_t i = 0; i < size; i++) {
+					values.InsertAsLast(i);
+				}
+				DoNotOptimize(values.AsRawArray());
+			});
+			runner.Run("array", "std::vector/append-string", "sorted", size, []() {}, [&]() {
+				std::vector<std::string> values;
+				for (size_t i = 0; i < size; i++) {
+					values.push_back("a string that doesn't fit the small buffer");
+				}
+				DoNotOptimize(values.data());
+			});
+			runner.Run("array", "DynamicArray/append-string", "sorted", size, []() {}, [&]() {
+				Mist::DynamicArray<std::string> values;
+				for (size_t i = 0; i < size; i++) {
+					values.InsertAsLast("a string that doesn't fit the small buffer");
+				}
+				DoNotOptimize(values.AsRawArray());
+			});
+
+			std::vector<size_t> vector(size);
+			Mist::DynamicArray<size_t> array(size);
+			for (size_t i = 0; i < size; i++) {
+				vector[i] = i;
+				array.InsertAsLast(i);
+			}
+			runner.Run("array", "std::vector/iterate", "sorted", size, []() {}, [&]() {
+				size_t sum = 0;
+				for (size_t value : vector) {
+					sum += value;
+				}
+				DoNotOptimize(sum);
+			});
+			runner.Run("array", "DynamicArray/iterate", "sorted", size, []() {}, [&]() {
+				size_t sum = 0;
+				for (size_t value : array) {
+					sum += value;
+				}
+				DoNotOptimize(sum);
+			});
+		}
+	}
+
+	// -Lists-
+
+	void BenchmarkLists(Runner& runner) {
+
+		for (size_t size : s_ContainerSizes) {
+
+			runner.Run("list", "std::list/append", "sorted", size, []() {}, [&]() {
+				std::list<size_t> list;
+				for (size_t i = 0; i < size; i++) {
+					list.push_back(i);
+				}
+				DoNotOptimize(list.back());
+			});
+			runner.Run("list", "SingleList/append", "sorted", size, []() {}, [&]() {
+				Mist::SingleList<size_t> list;
+				for (size_t i = 0; i < size; i++) {
+					list.InsertAsLast(i);
+				}
+				DoNotOptimize(*list.LastValue());
+			});
+			runner.Run("list", "UnrolledList/append", "sorted", size, []() {}, [&]() {
+				Mist::UnrolledList<size_t> list;
+				for (size_t i = 0; i < size; i++) {
+					list.InsertAsLast(i);
+				}
+				DoNotOptimize(*list.LastValue());
+			});
+
+			std::list<size_t> stdList;
+			Mist::SingleList<size_t> singleList;
+			Mist::UnrolledList<size_t> unrolledList;
+			for (size_t i = 0; i < size; i++) {
+				stdList.push_back(i);
+				singleList.InsertAsLast(i);
+				unrolledList.InsertAsLast(i);
+			}
+
+			runner.Run("list", "std::list/iterate", "sorted", size, []() {}, [&]() {
+				size_t sum = 0;
+				for (size_t value : stdList) {
+					sum += value;
+				}
+				DoNotOptimize(sum);
+			});
+			runner.Run("list", "SingleList/iterate", "sorted", size, []() {}, [&]() {
+				size_t sum = 0;
+				for (auto& node : singleList) {
+					sum += *node.GetValue();
+				}
+				DoNotOptimize(sum);
+			});
+			runner.Run("list", "UnrolledList/iterate", "sorted", size, []() {}, [&]() {
+				size_t sum = 0;
+				for (size_t value : unrolledList) {
+					sum += value;
+				}
+				DoNotOptimize(sum);
+			});
+
+			// Removing every other value, the lists are refilled outside of the timing
+			auto isOdd = [](size_t value) { return value % 2 == 1; };
+			runner.Run("list", "std::list/remove_if", "sorted", size, [&]() {
+				stdList.clear();
+				for (size_t i = 0; i < size; i++) {
+					stdList.push_back(i);
+				}
+			}, [&]() {
+				stdList.remove_if(isOdd);
+			});
+			runner.Run("list", "SingleList/EraseIf", "sorted", size, [&]() {
+				singleList.Clear();
+				for (size_t i = 0; i < size; i++) {
+					singleList.InsertAsLast(i);
+				}
+			}, [&]() {
+				DoNotOptimize(singleList.EraseIf(isOdd));
+			});
+		}
+	}
+
+	// -Ring Buffers-
+
+	constexpr size_t RING_BUFFER_SIZE = 1 << 12;
+
+	void BenchmarkRingBuffers(Runner& runner) {
+
+		const size_t count = 1 << 22;
+		const size_t batchSize = 256;
+
+		auto ringBuffer = std::make_unique<Mist::RingBuffer<size_t, RING_BUFFER_SIZE>>();
+		runner.Run("ring", "RingBuffer/single", "sorted", count, []() {}, [&]() {
+			size_t sum = 0;
+			size_t value = 0;
+			for (size_t i = 0; i < count; i++) {
+				ringBuffer->TryWrite(i);
+				ringBuffer->TryRead(&value);
+				sum += value;
+			}
+			DoNotOptimize(sum);
+		});
+
+		std::vector<size_t> batch(batchSize);
+		runner.Run("ring", "RingBuffer/batched", "sorted", count, []() {}, [&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i += batchSize) {
+				ringBuffer->TryWriteN(batch.data(), batchSize);
+				ringBuffer->TryReadN(batch.data(), batchSize);
+				sum += batch[0];
+			}
+			DoNotOptimize(sum);
+		});
+
+		// The producer and consumer threads are started in the timing, this should be negligible against the count
+		auto spscBuffer = std::make_unique<Mist::SpscRingBuffer<size_t, RING_BUFFER_SIZE>>();
+		runner.Run("ring", "SpscRingBuffer/1x1", "sorted", count, []() {}, [&]() {
+			std::thread producer([&]() {
+				for (size_t i = 0; i < count; i++) {
+					while (spscBuffer->TryWrite(i) == false) {
+						std::this_thread::yield();
+					}
+				}
+			});
+
+			size_t sum = 0;
+			size_t value = 0;
+			for (size_t i = 0; i < count; i++) {
+				while (spscBuffer->TryRead(&value) == false) {
+					std::this_thread::yield();
+				}
+				sum += value;
+			}
+			producer.join();
+			DoNotOptimize(sum);
+		});
+
+		auto mpmcBuffer = std::make_unique<Mist::MpmcRingBuffer<size_t, RING_BUFFER_SIZE>>();
+		const size_t threadCount = 2;
+		runner.Run("ring", "MpmcRingBuffer/2x2", "sorted", count, []() {}, [&]() {
+			std::vector<std::thread> threads;
+			for (size_t thread = 0; thread < threadCount; thread++) {
+				threads.emplace_back([&]() {
+					for (size_t i = 0; i < count / threadCount; i++) {
+						while (mpmcBuffer->TryWrite(i) == false) {
+							std::this_thread::yield();
+						}
+					}
+				});
+				threads.emplace_back([&]() {
+					size_t sum = 0;
+					size_t value = 0;
+					for (size_t i = 0; i < count / threadCount; i++) {
+						while (mpmcBuffer->TryRead(&value) == false) {
+							std::this_thread::yield();
+						}
+						sum += value;
+					}
+					DoNotOptimize(sum);
+				});
+			}
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+		});
+	}
+
+	// -Hash Maps-
+
+	void BenchmarkHashMaps(Runner& runner) {
+
+		for (size_t size : s_ContainerSizes) {
+
+			// Only the first half of the keys is inserted, a part of the lookups miss
+			const std::vector<uint64_t> keys = Mist::Benchmark::GenerateValues<uint64_t>(Distribution::Random, size * 2);
+
+			runner.Run("hash", "std::unordered_map/insert", "random", size, []() {}, [&]() {
+				std::unordered_map<uint64_t, uint64_t> map;
+				map.reserve(size);
+				for (size_t i = 0; i < size; i++) {
+					map.emplace(keys[i], i);
+				}
+				DoNotOptimize(map.size());
+			});
+			runner.Run("hash", "HashMap/insert", "random", size, []() {}, [&]() {
+				Mist::HashMap<uint64_t, uint64_t> map(size);
+				for (size_t i = 0; i < size; i++) {
+					map.Insert(keys[i], i);
+				}
+				DoNotOptimize(map.Size());
+			});
+
+			std::unordered_map<uint64_t, uint64_t> standardMap;
+			Mist::HashMap<uint64_t, uint64_t> map(size);
+			for (size_t i = 0; i < size; i++) {
+				standardMap.emplace(keys[i], i);
+				map.Insert(keys[i], i);
+			}
+
+			runner.Run("hash", "std::unordered_map/find", "random", keys.size(), []() {}, [&]() {
+				uint64_t sum = 0;
+				for (uint64_t key : keys) {
+					auto found = standardMap.find(key);
+					sum += found != standardMap.end() ? found->second : 0;
+				}
+				DoNotOptimize(sum);
+			});
+			runner.Run("hash", "HashMap/find", "random", keys.size(), []() {}, [&]() {
+				uint64_t sum = 0;
+				for (uint64_t key : keys) {
+					uint64_t* value = map.Find(key);
+					sum += value != nullptr ? *value : 0;
+				}
+				DoNotOptimize(sum);
+			});
+
+			std::vector<uint64_t*> values(keys.size());
+			runner.Run("hash", "HashMap/find-batch", "random", keys.size(), []() {}, [&]() {
+				DoNotOptimize(map.FindBatch(keys.data(), keys.size(), values.data()));
+			});
+		}
+	}
+
+	void BenchmarkPriorityQueues(Runner& runner) {
+
+		for (size_t size : s_ContainerSizes) {
+
+			const std::vector<uint64_t> values = Mist::Benchmark::GenerateValues<uint64_t>(Distribution::Random, size);
+
+			// Every value is pushed and then popped, the standard queue pops the largest value first
+			runner.Run("priority-queue", "std::priority_queue/push-pop", "random", size, []() {}, [&]() {
+				std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> queue;
+				for (uint64_t value : values) {
+					queue.push(value);
+				}
+				uint64_t sum = 0;
+				while (queue.empty() == false) {
+					sum += queue.top();
+					queue.pop();
+				}
+				DoNotOptimize(sum);
+			});
+			runner.Run("priority-queue", "PriorityQueue<2>/push-pop", "random", size, []() {}, [&]() {
+				Mist::PriorityQueue<uint64_t, std::less<uint64_t>, 2> queue;
+				for (uint64_t value : values) {
+					queue.Push(value);
+				}
+				uint64_t sum = 0;
+				while (queue.Size() > 0) {
+					sum += queue.Top();
+					queue.Pop();
+				}
+				DoNotOptimize(sum);
+			});
+			runner.Run("priority-queue", "PriorityQueue<4>/push-pop", "random", size, []() {}, [&]() {
+				Mist::PriorityQueue<uint64_t> queue;
+				for (uint64_t value : values) {
+					queue.Push(value);
+				}
+				uint64_t sum = 0;
+				while (queue.Size() > 0) {
+					sum += queue.Top();
+					queue.Pop();
+				}
+				DoNotOptimize(sum);
+			});
+			runner.Run("priority-queue", "PriorityQueue<4>/heapify-pop", "random", size, []() {}, [&]() {
+				Mist::PriorityQueue<uint64_t> queue;
+				queue.Heapify(values.begin(), values.end());
+				uint64_t sum = 0;
+				while (queue.Size() > 0) {
+					sum += queue.Top();
+					queue.Pop();
+				}
+				DoNotOptimize(sum);
+			});
+		}
+	}
+
+	// Parse the argument if it starts with the prefix
+	bool ParseArgument(const char* argument, const char* prefix, std::string* outValue) {
+
+		size_t prefixLength = strlen(prefix);
+		if (strncmp(argument, prefix, prefixLength) != 0) {
+			return false;
+		}
+		*outValue = argument + prefixLength;
+		return true;
+	}
+}
+
+int main(int argumentCount, char** arguments) {
+
+	Mist::Benchmark::Settings settings;
+	Mist::Benchmark::Format format = Mist::Benchmark::Format::Table;
+	std::string outputPath;
+
+	for (int i = 1; i < argumentCount; i++) {
+
+		std::string value;
+		if (ParseArgument(arguments[i], "--format=", &value)) {
+			if (value == "csv") {
+				format = Mist::Benchmark::Format::Csv;
+			}
+			else if (value == "json") {
+				format = Mist::Benchmark::Format::Json;
+			}
+			else if (value != "table") {
+				std::cerr << "Unknown format: " << value << std::endl;
+				return 1;
+			}
+		}
+		else if (ParseArgument(arguments[i], "--output=", &value)) {
+			outputPath = value;
+		}
+		else if (ParseArgument(arguments[i], "--filter=", &value)) {
+			settings.m_Filter = value;
+		}
+		else if (ParseArgument(arguments[i], "--repetitions=", &value)) {
+			settings.m_Repetitions = std::max<size_t>(std::stoul(value), 1);
+		}
+		else if (ParseArgument(arguments[i], "--warmup=", &value)) {
+			settings.m_WarmupRuns = std::stoul(value);
+		}
+		else if (strcmp(arguments[i], "--quick") == 0) {
+			// Smaller sizes in order to check that everything runs
+			s_SortSizes = { 1 << 10 };
+			s_ContainerSizes = { 1 << 10 };
+		}
+		else {
+			std::cerr << "Unknown argument: " << arguments[i] << std::endl;
+			return 1;
+		}
+	}
+
+	Runner runner(settings, format);
+	BenchmarkSorting(runner);
+	BenchmarkDynamicArray(runner);
+	BenchmarkLists(runner);
+	BenchmarkRingBuffers(runner);
+	BenchmarkHashMaps(runner);
+	BenchmarkPriorityQueues(runner);
+
+	if (outputPath.empty() == false) {
+		std::ofstream output(outputPath);
+		runner.Report(output);
+	}
+	else {
+		runner.Report(std::cout);
+	}
+	return 0;
+}
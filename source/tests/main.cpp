@@ -1,11 +1,29 @@
 #include <Mist_Common/include/UtilityMacros.h>
 
 #include "../../include/data-structures/RingBuffer.h"
+#include "../../include/data-structures/SpscRingBuffer.h"
+#include "../../include/data-structures/MpmcRingBuffer.h"
+#include "../../include/data-structures/WorkStealingDeque.h"
+#include "../../include/threading/JobScheduler.h"
 #include "../../include/algorithms/Sorting.h"
+#include "../../include/algorithms/ExternalSort.h"
 #include "../../include/utility/BitManipulations.h"
+#include "../../include/data-structures/BitSet.h"
 #include "../../include/data-structures/SingleList.h"
+#include "../../include/data-structures/UnrolledList.h"
 #include "../../include/allocators/CppAllocator.h"
+#include "../../include/allocators/LinearAllocator.h"
+#include "../../include/allocators/PoolAllocator.h"
+#include "../../include/allocators/TrackingAllocator.h"
+#include "../../include/allocators/LargePageAllocator.h"
 #include "../../include/data-structures/DynamicArray.h"
+#include "../../include/data-structures/SmallDynamicArray.h"
+#include "../../include/data-structures/SoAArray.h"
+#include "../../include/data-structures/HashMap.h"
+#include "../../include/data-structures/PriorityQueue.h"
+#include "../../include/utility/Hash.h"
+#include "../../include/reflection/Reflection.h"
+#include "../../include/reflection/Serialization.h"
 
 #include <cassert>
 #include <iostream>
@@ -15,18 +33,26 @@
 #include <limits>
 #include <ctime>
 #include <memory>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <unordered_map>
 
 
 
-// Simple timer methods
-std::clock_t s_StartTime;
+// Simple timer methods, the timings are only indicative, use the benchmarks in source/benchmarks to measure
+std::chrono::steady_clock::time_point s_StartTime;
 
 void BeginTimer() {
-	s_StartTime = std::clock();
+	s_StartTime = std::chrono::steady_clock::now();
 }
 
+// returns the elapsed time in milliseconds
 double EndTimer() {
-	return (double)(std::clock() - s_StartTime) / (double)(CLOCKS_PER_SEC / 1000);
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - s_StartTime).count();
 }
 
 void Pause() {
@@ -39,66 +65,108 @@ void Pause() {
 
 
 
-//void TestHash() {
-//	
-//	std::cout << "Hashing Test" << std::endl;
-//	
-//	std::vector<uint32_t> results;
-//	results.push_back(Mist::djb2::Hash("lol"));
-//	results.push_back(Mist::djb2::Hash("lol0"));
-//	results.push_back(Mist::djb2::Hash("loldfsdaf"));
-//	results.push_back(Mist::djb2::Hash("loldsafdsafdsafdsafdsafdsa"));
-//	results.push_back(Mist::djb2::Hash("logfrwgvcxzgrl"));
-//	results.push_back(Mist::djb2::Hash("lothrtjn xgtbtbreyl"));
-//	results.push_back(Mist::djb2::Hash("logdsafhudesrv jklb l"));
-//	results.push_back(Mist::djb2::Hash("lot5nbunel"));
-//	results.push_back(Mist::djb2::Hash("lobtyrbtsbgtdsabdtl"));
-//	results.push_back(Mist::djb2::Hash("loniuvgtehrgpb5gs8yniotbsrl"));
-//	results.push_back(Mist::djb2::Hash("lobtrenbpvznurfbhobntrwgal"));
-//	results.push_back(Mist::djb2::Hash("lolngjurenpwijnjivupr"));
-//	results.push_back(Mist::djb2::Hash("looooofodfsaofdsafodasfodl"));
-//	results.push_back(Mist::djb2::Hash("lonyetnusjrnfioNSfNOUfol"));
-//	results.push_back(Mist::djb2::Hash("enbpvznurfbh"));
-//	results.push_back(Mist::djb2::Hash("odfsaofdsafodasfodl"));
-//	results.push_back(Mist::djb2::Hash("lonyetnusjrnfioN"));
-//	results.push_back(Mist::djb2::Hash("loetnusupr"));
-//	results.push_back(Mist::djb2::Hash("lngjureol"));
-//	results.push_back(Mist::djb2::Hash("odfiukmmtnrhb"));
-//	results.push_back(Mist::djb2::Hash("bytbdsfaazrs4b z"));
-//	results.push_back(Mist::djb2::Hash("jkoytmnkodtynd"));
-//	results.push_back(Mist::djb2::Hash("vrehivuorsabeFORNZeu i"));
-//	results.push_back(Mist::djb2::Hash("foo"));
-//	results.push_back(Mist::djb2::Hash("bar"));
-//	results.push_back(Mist::djb2::Hash("vector"));
-//	results.push_back(Mist::djb2::Hash("string"));
-//	results.push_back(Mist::djb2::Hash("hash"));
-//	results.push_back(Mist::djb2::Hash("m_hello"));
-//	results.push_back(Mist::djb2::Hash("m_Lol"));
-//	results.push_back(Mist::djb2::Hash("m_Hi"));
-//	results.push_back(Mist::djb2::Hash("m_Value"));
-//	results.push_back(Mist::djb2::Hash("m_Result"));
-//	results.push_back(Mist::djb2::Hash("m_ShouldRun"));
-//	results.push_back(Mist::djb2::Hash("m_IsActive"));
-//	results.push_back(Mist::djb2::Hash("m_HasLife"));
-//	results.push_back(Mist::djb2::Hash("m_ShouldBe"));
-//	results.push_back(Mist::djb2::Hash("aaaaaaa"));
-//	results.push_back(Mist::djb2::Hash("aaaa"));
-//	results.push_back(Mist::djb2::Hash("aaaaaaaaaaa"));
-//	results.push_back(Mist::djb2::Hash("aaaaaaaaa"));
-//
-//	
-//	for(auto& i : results) {
-//		for(auto& j : results) {
-//			if(&i != &j)
-//			{
-//				MIST_ASSERT(i != j);
-//			}
-//		}
-//	}
-//	
-//	std::cout << "Hashing Test Passed!" << std::endl;
-//	
-//}
+void TestHash() {
+	
+	std::cout << "Hashing Test" << std::endl;
+	
+	std::vector<uint32_t> results;
+	results.push_back(Mist::djb2::Hash("lol"));
+	results.push_back(Mist::djb2::Hash("lol0"));
+	results.push_back(Mist::djb2::Hash("loldfsdaf"));
+	results.push_back(Mist::djb2::Hash("loldsafdsafdsafdsafdsafdsa"));
+	results.push_back(Mist::djb2::Hash("logfrwgvcxzgrl"));
+	results.push_back(Mist::djb2::Hash("lothrtjn xgtbtbreyl"));
+	results.push_back(Mist::djb2::Hash("logdsafhudesrv jklb l"));
+	results.push_back(Mist::djb2::Hash("lot5nbunel"));
+	results.push_back(Mist::djb2::Hash("lobtyrbtsbgtdsabdtl"));
+	results.push_back(Mist::djb2::Hash("loniuvgtehrgpb5gs8yniotbsrl"));
+	results.push_back(Mist::djb2::Hash("lobtrenbpvznurfbhobntrwgal"));
+	results.push_back(Mist::djb2::Hash("lolngjurenpwijnjivupr"));
+	results.push_back(Mist::djb2::Hash("looooofodfsaofdsafodasfodl"));
+	results.push_back(Mist::djb2::Hash("lonyetnusjrnfioNSfNOUfol"));
+	results.push_back(Mist::djb2::Hash("enbpvznurfbh"));
+	results.push_back(Mist::djb2::Hash("odfsaofdsafodasfodl"));
+	results.push_back(Mist::djb2::Hash("lonyetnusjrnfioN"));
+	results.push_back(Mist::djb2::Hash("loetnusupr"));
+	results.push_back(Mist::djb2::Hash("lngjureol"));
+	results.push_back(Mist::djb2::Hash("odfiukmmtnrhb"));
+	results.push_back(Mist::djb2::Hash("bytbdsfaazrs4b z"));
+	results.push_back(Mist::djb2::Hash("jkoytmnkodtynd"));
+	results.push_back(Mist::djb2::Hash("vrehivuorsabeFORNZeu i"));
+	results.push_back(Mist::djb2::Hash("foo"));
+	results.push_back(Mist::djb2::Hash("bar"));
+	results.push_back(Mist::djb2::Hash("vector"));
+	results.push_back(Mist::djb2::Hash("string"));
+	results.push_back(Mist::djb2::Hash("hash"));
+	results.push_back(Mist::djb2::Hash("m_hello"));
+	results.push_back(Mist::djb2::Hash("m_Lol"));
+	results.push_back(Mist::djb2::Hash("m_Hi"));
+	results.push_back(Mist::djb2::Hash("m_Value"));
+	results.push_back(Mist::djb2::Hash("m_Result"));
+	results.push_back(Mist::djb2::Hash("m_ShouldRun"));
+	results.push_back(Mist::djb2::Hash("m_IsActive"));
+	results.push_back(Mist::djb2::Hash("m_HasLife"));
+	results.push_back(Mist::djb2::Hash("m_ShouldBe"));
+	results.push_back(Mist::djb2::Hash("aaaaaaa"));
+	results.push_back(Mist::djb2::Hash("aaaa"));
+	results.push_back(Mist::djb2::Hash("aaaaaaaaaaa"));
+	results.push_back(Mist::djb2::Hash("aaaaaaaaa"));
+
+	
+	for(auto& i : results) {
+		for(auto& j : results) {
+			if(&i != &j)
+			{
+				MIST_ASSERT(i != j);
+			}
+		}
+	}
+	
+	// djb2 can be computed at compile time
+	static_assert(Mist::djb2::Hash("") == 5381, "The hash of an empty string is the initial value.");
+	static_assert(Mist::djb2::Hash("m_Value") != Mist::djb2::Hash("m_Result"), "The field names should not collide.");
+
+	// Hash64 has to hash every size with every read path, the prefixes of a buffer should never collide
+	std::vector<uint64_t> prefixHashes;
+	char buffer[200];
+	for (size_t i = 0; i < sizeof(buffer); ++i) {
+		buffer[i] = static_cast<char>('a' + i % 26);
+	}
+	for (size_t size = 0; size <= sizeof(buffer); ++size) {
+		uint64_t hash = Mist::Hash64(buffer, size);
+		MIST_ASSERT(hash == Mist::Hash64(buffer, size));
+		MIST_ASSERT(hash != Mist::Hash64(buffer, size, 1));
+		prefixHashes.push_back(hash);
+	}
+	std::sort(prefixHashes.begin(), prefixHashes.end());
+	MIST_ASSERT(std::adjacent_find(prefixHashes.begin(), prefixHashes.end()) == prefixHashes.end());
+
+	// Flipping any bit changes the hash
+	uint64_t bufferHash = Mist::Hash64(buffer, 64);
+	for (size_t bit = 0; bit < 64 * 8; ++bit) {
+		buffer[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+		MIST_ASSERT(Mist::Hash64(buffer, 64) != bufferHash);
+		buffer[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+	}
+
+	// The string hash is the same for strings and string literals
+	Mist::Hash<std::string> stringHash;
+	MIST_ASSERT(stringHash(std::string("entity")) == stringHash("entity"));
+	MIST_ASSERT(stringHash("entity") != stringHash("entitz"));
+
+	// Sequential integers spread over the low bits used to select the groups of the hash map
+	Mist::Hash<uint32_t> integerHash;
+	size_t buckets[16] = {};
+	for (uint32_t i = 0; i < 16 * 1024; ++i) {
+		buckets[(integerHash(i) >> 7) % 16]++;
+	}
+	for (size_t bucket : buckets) {
+		MIST_ASSERT(bucket > 900 && bucket < 1150);
+	}
+
+	std::cout << "Hashing Test Passed!" << std::endl;
+	
+}
 
 void TestRingBuffer() {
 	// -Test-
@@ -170,6 +238,369 @@ void TestRingBuffer() {
 	if(exampleBuffer.TryRead(&exampleResult) == false) {
 		std::cout << "Nothing left to read" << std::endl;
 	}
+
+	// -Bulk Test-
+	{
+		// Use a power of two size to exercise the masking path
+		Mist::RingBuffer<size_t, 8> bulkBuffer;
+		size_t values[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		size_t results[10] = {};
+
+		MIST_ASSERT(bulkBuffer.WritableCount() == 7);
+		MIST_ASSERT(bulkBuffer.TryWriteN(values, 5) == 5);
+		MIST_ASSERT(bulkBuffer.ReadableCount() == 5);
+		MIST_ASSERT(bulkBuffer.TryReadN(results, 3) == 3);
+		MIST_ASSERT(results[0] == 0 && results[2] == 2);
+
+		// Assure that writes wrap around the end of the storage
+		MIST_ASSERT(bulkBuffer.TryWriteN(values + 5, 5) == 5);
+		MIST_ASSERT(bulkBuffer.TryWriteN(values, 10) == 0);
+		MIST_ASSERT(bulkBuffer.TryReadN(results, 10) == 7);
+		for (size_t i = 0; i < 7; i++) {
+			MIST_ASSERT(results[i] == i + 3);
+		}
+
+		// Assure that the spans are contiguous and limited by the end of the storage
+		size_t* writeSpan = nullptr;
+		size_t writeSpanSize = bulkBuffer.AcquireWriteSpan(&writeSpan);
+		MIST_ASSERT(writeSpanSize > 0);
+		for (size_t i = 0; i < writeSpanSize; i++) {
+			writeSpan[i] = 100 + i;
+		}
+		bulkBuffer.CommitWrite(writeSpanSize);
+		MIST_ASSERT(bulkBuffer.ReadableCount() == writeSpanSize);
+
+		const size_t* readSpan = nullptr;
+		size_t readSpanSize = bulkBuffer.AcquireReadSpan(&readSpan);
+		MIST_ASSERT(readSpanSize == writeSpanSize);
+		MIST_ASSERT(readSpan[0] == 100);
+		bulkBuffer.CommitRead(readSpanSize);
+		MIST_ASSERT(bulkBuffer.CanRead() == false);
+
+		// Assure that non power of two sizes wrap the same way
+		Mist::RingBuffer<size_t, 6> oddBuffer;
+		for (size_t i = 0; i < 4; i++) {
+			MIST_ASSERT(oddBuffer.TryWriteN(values, 4) == 4);
+			MIST_ASSERT(oddBuffer.TryReadN(results, 4) == 4);
+			MIST_ASSERT(results[0] == 0 && results[3] == 3);
+		}
+	}
+}
+
+void TestSpscRingBuffer() {
+	std::cout << "SpscRingBuffer Test" << std::endl;
+
+	{
+		// Assure that the single threaded behaviour matches the RingBuffer
+		Mist::SpscRingBuffer<size_t, 6> buffer;
+		MIST_ASSERT(buffer.Size() == 6);
+		MIST_ASSERT(buffer.CanRead() == false);
+		for (size_t i = 0; i < 5; i++) {
+			MIST_ASSERT(buffer.TryWrite(i));
+		}
+		MIST_ASSERT(buffer.CanWrite() == false);
+		MIST_ASSERT(buffer.TryWrite(10) == false);
+
+		size_t result = 0;
+		size_t peekResult = 0;
+		for (size_t i = 0; i < 5; i++) {
+			MIST_ASSERT(buffer.TryPeek(&peekResult));
+			MIST_ASSERT(buffer.TryRead(&result));
+			MIST_ASSERT(result == i && peekResult == i);
+		}
+		MIST_ASSERT(buffer.TryRead(&result) == false);
+	}
+
+	{
+		// Assure that the values arrive in order when the producer and consumer are on different threads
+		const size_t VALUE_COUNT = 1000000;
+		std::unique_ptr<Mist::SpscRingBuffer<size_t, 128>> buffer(new Mist::SpscRingBuffer<size_t, 128>());
+
+		std::thread producer([&buffer, VALUE_COUNT]() {
+			for (size_t i = 0; i < VALUE_COUNT; ++i) {
+				while (buffer->TryWrite(i) == false) {}
+			}
+		});
+
+		size_t expected = 0;
+		size_t result = 0;
+		while (expected < VALUE_COUNT) {
+			if (buffer->TryRead(&result)) {
+				MIST_ASSERT(result == expected);
+				++expected;
+			}
+		}
+
+		producer.join();
+		MIST_ASSERT(buffer->CanRead() == false);
+	}
+
+	std::cout << "SpscRingBuffer Tests Passed!" << std::endl;
+}
+
+void TestMpmcRingBuffer() {
+	std::cout << "MpmcRingBuffer Test" << std::endl;
+
+	{
+		// Assure that the single threaded behaviour matches the RingBuffer, all slots can be written
+		Mist::MpmcRingBuffer<size_t, 8> buffer;
+		MIST_ASSERT(buffer.Size() == 8);
+		MIST_ASSERT(buffer.CanRead() == false);
+		for (size_t i = 0; i < 8; i++) {
+			MIST_ASSERT(buffer.CanWrite());
+			MIST_ASSERT(buffer.TryWrite(i));
+		}
+		MIST_ASSERT(buffer.CanWrite() == false);
+		MIST_ASSERT(buffer.TryWrite(10) == false);
+
+		size_t result = 0;
+		size_t peekResult = 0;
+		for (size_t i = 0; i < 8; i++) {
+			MIST_ASSERT(buffer.TryPeek(&peekResult));
+			MIST_ASSERT(buffer.TryRead(&result));
+			MIST_ASSERT(result == i && peekResult == i);
+		}
+		MIST_ASSERT(buffer.TryRead(&result) == false);
+	}
+
+	// Contention benchmark, the same amount of producers and consumers push values through one buffer
+	// Assure that every value is received exactly once by checking the sum
+	using TaskBuffer = Mist::MpmcRingBuffer<size_t, 1024>;
+	const size_t VALUES_PER_PRODUCER = 200000;
+	const size_t MAX_THREAD_COUNT = 16;
+	for (size_t threadCount = 1; threadCount <= MAX_THREAD_COUNT; threadCount *= 2) {
+
+		std::unique_ptr<TaskBuffer> buffer(new TaskBuffer());
+		std::atomic<size_t> receivedCount(0);
+		std::atomic<size_t> receivedSum(0);
+		const size_t totalCount = VALUES_PER_PRODUCER * threadCount;
+
+		auto startTime = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < threadCount; ++i) {
+			threads.emplace_back([&buffer, i, VALUES_PER_PRODUCER]() {
+				for (size_t value = 0; value < VALUES_PER_PRODUCER; ++value) {
+					while (buffer->TryWrite(i * VALUES_PER_PRODUCER + value) == false) {
+						std::this_thread::yield();
+					}
+				}
+			});
+
+			threads.emplace_back([&buffer, &receivedCount, &receivedSum, totalCount]() {
+				size_t value = 0;
+				size_t localSum = 0;
+				while (receivedCount.load(std::memory_order_relaxed) < totalCount) {
+					if (buffer->TryRead(&value)) {
+						localSum += value;
+						receivedCount.fetch_add(1, std::memory_order_relaxed);
+					}
+					else {
+						std::this_thread::yield();
+					}
+				}
+				receivedSum.fetch_add(localSum);
+			});
+		}
+
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+
+		double elapsedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+		MIST_ASSERT(receivedCount.load() == totalCount);
+		MIST_ASSERT(receivedSum.load() == totalCount * (totalCount - 1) / 2);
+		MIST_ASSERT(buffer->CanRead() == false);
+
+		std::cout << threadCount << " producers / " << threadCount << " consumers: " << elapsedTime << "ms" << std::endl;
+	}
+
+	std::cout << "MpmcRingBuffer Tests Passed!" << std::endl;
+}
+
+void TestWorkStealingDeque() {
+	std::cout << "WorkStealingDeque Test" << std::endl;
+
+	{
+		// The owner works in LIFO order and the thieves in FIFO order
+		Mist::WorkStealingDeque<size_t, 8> deque;
+		size_t value = 0;
+		MIST_ASSERT(deque.TryPop(&value) == false);
+		MIST_ASSERT(deque.TrySteal(&value) == false);
+
+		for (size_t i = 0; i < 8; i++) {
+			MIST_ASSERT(deque.TryPush(i));
+		}
+		MIST_ASSERT(deque.TryPush(8) == false);
+		MIST_ASSERT(deque.Size() == 8);
+
+		MIST_ASSERT(deque.TryPop(&value) && value == 7);
+		MIST_ASSERT(deque.TrySteal(&value) && value == 0);
+		MIST_ASSERT(deque.TrySteal(&value) && value == 1);
+		MIST_ASSERT(deque.TryPop(&value) && value == 6);
+		MIST_ASSERT(deque.Size() == 4);
+
+		// The slots freed by the thieves can be reused
+		MIST_ASSERT(deque.TryPush(10));
+		MIST_ASSERT(deque.TryPop(&value) && value == 10);
+	}
+
+	// The owner pushes and pops while thieves steal, every value must be taken exactly once
+	using JobDeque = Mist::WorkStealingDeque<size_t, 256>;
+	const size_t VALUE_COUNT = 500000;
+	const size_t THIEF_COUNT = 3;
+
+	std::unique_ptr<JobDeque> deque(new JobDeque());
+	std::atomic<size_t> takenCount(0);
+	std::atomic<size_t> takenSum(0);
+
+	std::vector<std::thread> thieves;
+	for (size_t i = 0; i < THIEF_COUNT; ++i) {
+		thieves.emplace_back([&]() {
+			size_t value = 0;
+			size_t localSum = 0;
+			size_t localCount = 0;
+			while (takenCount.load(std::memory_order_relaxed) < VALUE_COUNT) {
+				if (deque->TrySteal(&value)) {
+					localSum += value;
+					localCount++;
+					takenCount.fetch_add(1, std::memory_order_relaxed);
+				}
+				else {
+					std::this_thread::yield();
+				}
+			}
+			takenSum.fetch_add(localSum);
+		});
+	}
+
+	size_t ownerSum = 0;
+	size_t value = 0;
+	for (size_t i = 0; i < VALUE_COUNT; ++i) {
+		while (deque->TryPush(i) == false) {
+			if (deque->TryPop(&value)) {
+				ownerSum += value;
+				takenCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		// Pop every other value to race the thieves for the last values
+		if (i % 2 == 0 && deque->TryPop(&value)) {
+			ownerSum += value;
+			takenCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	while (takenCount.load(std::memory_order_relaxed) < VALUE_COUNT) {
+		if (deque->TryPop(&value)) {
+			ownerSum += value;
+			takenCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	for (std::thread& thief : thieves) {
+		thief.join();
+	}
+
+	MIST_ASSERT(takenCount.load() == VALUE_COUNT);
+	MIST_ASSERT(takenSum.load() + ownerSum == VALUE_COUNT * (VALUE_COUNT - 1) / 2);
+
+	std::cout << "WorkStealingDeque Test Passed" << std::endl;
+}
+
+// Fork and join recursively, every level waits on it's children
+size_t ParallelFibonacci(Mist::JobScheduler& scheduler, size_t n) {
+
+	if (n < 12) {
+		return n < 2 ? n : ParallelFibonacci(scheduler, n - 1) + ParallelFibonacci(scheduler, n - 2);
+	}
+
+	size_t left = 0;
+	Mist::JobGroup group;
+	scheduler.Run(group, [&]() { left = ParallelFibonacci(scheduler, n - 1); });
+	size_t right = ParallelFibonacci(scheduler, n - 2);
+	scheduler.Wait(group);
+	return left + right;
+}
+
+void TestJobScheduler() {
+	std::cout << "JobScheduler Test" << std::endl;
+
+	for (size_t workerCount : { 1, 2, 4 }) {
+
+		Mist::JobSchedulerSettings settings;
+		settings.m_WorkerCount = workerCount;
+		settings.m_Affinity = workerCount == 2 ? Mist::WorkerAffinity::PinToCores : Mist::WorkerAffinity::None;
+		Mist::JobScheduler scheduler(settings);
+		MIST_ASSERT(scheduler.ThreadCount() == workerCount + 1);
+
+		// Every index is visited exactly once and the ranges respect the grain size
+		const size_t indexCount = 100000;
+		std::vector<std::atomic<uint8_t>> visits(indexCount);
+		std::atomic<size_t> largestRange(0);
+		scheduler.ParallelFor(0, indexCount, 1000, [&](size_t begin, size_t end) {
+			MIST_ASSERT(end - begin <= 1000);
+			for (size_t i = begin; i < end; ++i) {
+				visits[i].fetch_add(1, std::memory_order_relaxed);
+			}
+			size_t rangeSize = end - begin;
+			size_t largest = largestRange.load();
+			while (rangeSize > largest && largestRange.compare_exchange_weak(largest, rangeSize) == false) {}
+		});
+		for (std::atomic<uint8_t>& visit : visits) {
+			MIST_ASSERT(visit.load() == 1);
+		}
+		MIST_ASSERT(largestRange.load() <= 1000);
+
+		// Empty and single ranges
+		size_t callCount = 0;
+		scheduler.ParallelFor(5, 5, 10, [&](size_t, size_t) { callCount++; });
+		MIST_ASSERT(callCount == 0);
+		scheduler.ParallelFor(0, 3, 10, [&](size_t begin, size_t end) { callCount += end - begin; });
+		MIST_ASSERT(callCount == 3);
+
+		// More jobs than the queues can hold, the extra jobs run inline
+		std::atomic<size_t> jobSum(0);
+		{
+			Mist::JobGroup group;
+			for (size_t i = 0; i < 20000; ++i) {
+				scheduler.Run(group, [&jobSum, i]() { jobSum.fetch_add(i, std::memory_order_relaxed); });
+			}
+			scheduler.Wait(group);
+			MIST_ASSERT(group.IsDone());
+		}
+		MIST_ASSERT(jobSum.load() == 20000ull * 19999ull / 2);
+
+		// Captures too big to be stored in the job are allocated
+		{
+			struct LargeCapture {
+				size_t m_Values[16];
+			};
+			LargeCapture capture;
+			for (size_t i = 0; i < 16; ++i) {
+				capture.m_Values[i] = i;
+			}
+
+			std::atomic<size_t> captureSum(0);
+			Mist::JobGroup group;
+			for (size_t i = 0; i < 100; ++i) {
+				scheduler.Run(group, [capture, &captureSum]() {
+					for (size_t value : capture.m_Values) {
+						captureSum.fetch_add(value, std::memory_order_relaxed);
+					}
+				});
+			}
+			scheduler.Wait(group);
+			MIST_ASSERT(captureSum.load() == 100 * 120);
+		}
+
+		// Nested fork and join helps while waiting instead of blocking the workers
+		MIST_ASSERT(ParallelFibonacci(scheduler, 25) == 75025);
+	}
+
+	// The parallel sorts run on the default scheduler
+	MIST_ASSERT(Mist::JobScheduler::Default().ThreadCount() >= 1);
+
+	std::cout << "JobScheduler Test Passed" << std::endl;
 }
 
 void TestSorting() {
@@ -213,6 +644,56 @@ void TestSorting() {
 	}
 	std::cout << totalSortTime << "ms" << std::endl;
 
+	// Assure that the scratch buffer version sorts every size without allocating
+	{
+		Mist::DynamicArray<size_t> scratch;
+		for (size_t count = 1; count < 300; count++) {
+			std::vector<size_t> values;
+			for (size_t i = 0; i < count; i++) {
+				values.push_back(rand() % ELEMENT_COUNT);
+			}
+
+			scratch.Resize(count);
+			Mist::MergeSort(values.data(), values.data() + values.size(), scratch.AsRawArray());
+			MIST_ASSERT(std::is_sorted(values.begin(), values.end()));
+
+			Mist::MergeSort(&values);
+			MIST_ASSERT(std::is_sorted(values.begin(), values.end()));
+		}
+	}
+
+	std::cout << "Parallel Merge Sort" << std::endl;
+
+	{
+		// Use a small grain size and an odd amount of threads to exercise the unpaired runs and the merge path splits
+		const size_t LARGE_ELEMENT_COUNT = 1000003;
+		std::vector<size_t> parallel;
+		for (size_t i = 0; i < LARGE_ELEMENT_COUNT; i++) {
+			parallel.push_back(rand() % 1000);
+		}
+		std::vector<size_t> expected = parallel;
+		std::sort(expected.begin(), expected.end());
+
+		std::vector<size_t> sequential = parallel;
+		auto startTime = std::chrono::steady_clock::now();
+		Mist::MergeSort(sequential.data(), sequential.data() + sequential.size());
+		std::cout << "1 thread: " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() << "ms" << std::endl;
+
+		const size_t threadCounts[] = { 3, 8 };
+		for (size_t threadCount : threadCounts) {
+			std::vector<size_t> values = parallel;
+			startTime = std::chrono::steady_clock::now();
+			Mist::ParallelMergeSort(values.data(), values.data() + values.size(), threadCount, 1024);
+			std::cout << threadCount << " threads: " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() << "ms" << std::endl;
+			MIST_ASSERT(values == expected);
+		}
+
+		// Assure that small ranges still sort with few workers
+		std::vector<size_t> small(parallel.begin(), parallel.begin() + 5000);
+		Mist::ParallelMergeSort(small.data(), small.data() + small.size(), 16, 1000);
+		MIST_ASSERT(std::is_sorted(small.begin(), small.end()));
+	}
+
 	std::cout << "Quick Sort" << std::endl;
 
 	
@@ -243,6 +724,42 @@ void TestSorting() {
 
 	std::cout << totalSortTime << "ms" << std::endl;
 
+	// Assure that the quick sort handles the distributions that degrade a naive quick sort
+	{
+		const size_t LARGE_ELEMENT_COUNT = 100000;
+		std::vector<size_t> distributions[4];
+		for (size_t i = 0; i < LARGE_ELEMENT_COUNT; i++) {
+			distributions[0].push_back(rand());
+			distributions[1].push_back(i);
+			distributions[2].push_back(LARGE_ELEMENT_COUNT - i);
+			distributions[3].push_back(rand() % 4);
+		}
+
+		for (std::vector<size_t>& distribution : distributions) {
+			std::vector<size_t> expected = distribution;
+			std::sort(expected.begin(), expected.end());
+
+			BeginTimer();
+			Mist::QuickSort(&distribution);
+			std::cout << EndTimer() << "ms" << std::endl;
+			MIST_ASSERT(distribution == expected);
+		}
+
+		// Assure that the custom comparator is used
+		Mist::QuickSort(distributions[0].begin(), distributions[0].end(), std::greater<size_t>());
+		MIST_ASSERT(Mist::IsSorted(distributions[0].rbegin(), distributions[0].rend()));
+
+		// Assure that the small ranges are sorted
+		for (size_t count = 0; count < 40; count++) {
+			std::vector<size_t> small;
+			for (size_t i = 0; i < count; i++) {
+				small.push_back(rand() % 10);
+			}
+			Mist::QuickSort(small.begin(), small.end());
+			MIST_ASSERT(std::is_sorted(small.begin(), small.end()));
+		}
+	}
+
 	std::cout << "Insertion Sort" << std::endl;
 
 	totalSortTime = 0.0;
@@ -271,6 +788,49 @@ void TestSorting() {
 
 	std::cout << totalSortTime << "ms" << std::endl;
 
+	std::cout << "Bulk Insertion Sort" << std::endl;
+
+	totalSortTime = 0.0;
+	for (size_t j = 0; j < SORTING_ITERATIONS; j++) {
+		std::vector<size_t> sortedVector;
+		for (size_t i = 0; i < ELEMENT_COUNT; i++) {
+			sortedVector.push_back(i);
+		}
+
+		m.clear();
+		for (size_t i = 0; i < ELEMENT_COUNT; i++) {
+			m.push_back(rand() % ELEMENT_COUNT);
+		}
+
+		BeginTimer();
+		Mist::BulkInsertionSort(m, &sortedVector);
+		totalSortTime += EndTimer();
+
+		MIST_ASSERT(sortedVector.size() == ELEMENT_COUNT * 2);
+		MIST_ASSERT(Mist::IsSorted(std::begin(sortedVector), std::end(sortedVector)));
+	}
+
+	std::cout << totalSortTime << "ms" << std::endl;
+
+	// Assure that the bulk insertion works with a DynamicArray destination, including an empty one
+	{
+		Mist::DynamicArray<int> sortedArray;
+		std::vector<int> expected;
+		for (size_t frame = 0; frame < 16; frame++) {
+			std::vector<int> newValues;
+			for (size_t i = 0; i < frame * 7; i++) {
+				newValues.push_back(rand() % 100 - 50);
+			}
+
+			Mist::BulkInsertionSort(newValues, &sortedArray);
+			expected.insert(expected.end(), newValues.begin(), newValues.end());
+			std::sort(expected.begin(), expected.end());
+
+			MIST_ASSERT(sortedArray.Size() == expected.size());
+			MIST_ASSERT(std::equal(expected.begin(), expected.end(), sortedArray.begin()));
+		}
+	}
+
 	std::cout << "Bucket Sort" << std::endl;
 
 
@@ -302,9 +862,388 @@ void TestSorting() {
 
 	std::cout << totalSortTime << "ms" << std::endl;
 
+	// Assure that the bucket sort works for ranges that don't start at zero
+	{
+		size_t offsetValues[] = { 15, 12, 10, 14, 12 };
+		Mist::BucketSort(std::begin(offsetValues), std::end(offsetValues), (size_t)10, (size_t)15);
+		MIST_ASSERT(offsetValues[0] == 10 && offsetValues[1] == 12 && offsetValues[4] == 15);
+	}
+
+	std::cout << "Heap Sort" << std::endl;
+
+	{
+		// Assure that the heap sort matches the standard sort, including duplicates and the comparison
+		for (size_t count = 0; count < 300; count += 13) {
+			std::vector<int32_t> values;
+			for (size_t i = 0; i < count; i++) {
+				values.push_back(rand() % 50);
+			}
+			std::vector<int32_t> expected = values;
+			std::sort(expected.begin(), expected.end());
+
+			Mist::HeapSort(values.begin(), values.end());
+			MIST_ASSERT(values == expected);
+
+			Mist::HeapSort(values.begin(), values.end(), std::greater<int32_t>());
+			MIST_ASSERT(std::equal(values.begin(), values.end(), expected.rbegin()));
+		}
+	}
+
+	std::cout << "Radix Sort" << std::endl;
+
+	{
+		const size_t LARGE_ELEMENT_COUNT = 100000;
+
+		std::vector<uint64_t> keys;
+		std::vector<int32_t> signedKeys;
+		std::vector<float> floatKeys;
+		for (size_t i = 0; i < LARGE_ELEMENT_COUNT; i++) {
+			keys.push_back(((uint64_t)rand() << 40) ^ ((uint64_t)rand() << 20) ^ (uint64_t)rand());
+			signedKeys.push_back(rand() - RAND_MAX / 2);
+			floatKeys.push_back((float)(rand() - RAND_MAX / 2) / 1000.0f);
+		}
+		floatKeys.push_back(-0.0f);
+		floatKeys.push_back(0.0f);
+
+		std::vector<uint64_t> expectedKeys = keys;
+		std::sort(expectedKeys.begin(), expectedKeys.end());
+		BeginTimer();
+		Mist::RadixSort(keys.data(), keys.data() + keys.size());
+		std::cout << EndTimer() << "ms" << std::endl;
+		MIST_ASSERT(keys == expectedKeys);
+
+		Mist::RadixSort(signedKeys.data(), signedKeys.data() + signedKeys.size());
+		MIST_ASSERT(std::is_sorted(signedKeys.begin(), signedKeys.end()));
+
+		Mist::RadixSort(floatKeys.data(), floatKeys.data() + floatKeys.size());
+		MIST_ASSERT(std::is_sorted(floatKeys.begin(), floatKeys.end()));
+
+		// Assure that structures are sorted by their key and that the sort is stable
+		struct SortEntry {
+			uint16_t m_Key;
+			size_t m_Order;
+		};
+		std::vector<SortEntry> entries;
+		for (size_t i = 0; i < LARGE_ELEMENT_COUNT; i++) {
+			entries.push_back({ (uint16_t)(rand() % 100), i });
+		}
+		std::vector<SortEntry> scratch(entries.size());
+		Mist::RadixSort(entries.data(), entries.data() + entries.size(), scratch.data(), [](const SortEntry& entry) { return entry.m_Key; });
+		for (size_t i = 1; i < entries.size(); i++) {
+			MIST_ASSERT(entries[i - 1].m_Key <= entries[i].m_Key);
+			MIST_ASSERT(entries[i - 1].m_Key != entries[i].m_Key || entries[i - 1].m_Order < entries[i].m_Order);
+		}
+	}
+
+	std::cout << "Selection" << std::endl;
+
+	{
+		// Assure that the selections match a full sort for every position
+		for (size_t count = 1; count < 200; count += 7) {
+			std::vector<size_t> values;
+			for (size_t i = 0; i < count; i++) {
+				values.push_back(rand() % (count / 2 + 1));
+			}
+			std::vector<size_t> expected = values;
+			std::sort(expected.begin(), expected.end());
+
+			for (size_t nth = 0; nth < count; nth++) {
+				std::vector<size_t> selected = values;
+				Mist::NthElement(selected.begin(), selected.begin() + nth, selected.end());
+				MIST_ASSERT(selected[nth] == expected[nth]);
+				for (size_t i = 0; i < count; i++) {
+					MIST_ASSERT(i > nth || selected[i] <= selected[nth]);
+					MIST_ASSERT(i < nth || selected[i] >= selected[nth]);
+				}
+
+				std::vector<size_t> partial = values;
+				Mist::PartialSort(partial.begin(), partial.begin() + nth, partial.end());
+				MIST_ASSERT(std::equal(expected.begin(), expected.begin() + nth, partial.begin()));
+
+				std::vector<size_t> top(nth);
+				size_t topCount = Mist::TopK(values.begin(), values.end(), top.data(), nth);
+				MIST_ASSERT(topCount == nth);
+				MIST_ASSERT(std::equal(expected.begin(), expected.begin() + nth, top.begin()));
+			}
+
+			// A range smaller than k only writes the range
+			std::vector<size_t> top(count + 10);
+			MIST_ASSERT(Mist::TopK(values.begin(), values.end(), top.begin(), top.size()) == count);
+			MIST_ASSERT(std::equal(expected.begin(), expected.end(), top.begin()));
+		}
+
+		// The largest elements can be selected with the comparison
+		size_t largest[3];
+		std::vector<size_t> values = { 5, 1, 9, 3, 7 };
+		Mist::TopK(values.begin(), values.end(), largest, 3, std::greater<size_t>());
+		MIST_ASSERT(largest[0] == 9 && largest[1] == 7 && largest[2] == 5);
+
+		// Nearest 16 candidates out of 100k
+		const size_t CANDIDATE_COUNT = 100000;
+		std::vector<float> distances;
+		for (size_t i = 0; i < CANDIDATE_COUNT; i++) {
+			distances.push_back((float)rand() / (float)RAND_MAX);
+		}
+
+		std::vector<float> sorted = distances;
+		BeginTimer();
+		Mist::QuickSort(sorted.begin(), sorted.end());
+		std::cout << "Full Sort: " << EndTimer() << "ms" << std::endl;
+
+		std::vector<float> partial = distances;
+		BeginTimer();
+		Mist::PartialSort(partial.begin(), partial.begin() + 16, partial.end());
+		std::cout << "Partial Sort: " << EndTimer() << "ms" << std::endl;
+
+		float nearest[16];
+		BeginTimer();
+		Mist::TopK(distances.begin(), distances.end(), nearest, 16);
+		std::cout << "Top K: " << EndTimer() << "ms" << std::endl;
+
+		MIST_ASSERT(std::equal(sorted.begin(), sorted.begin() + 16, partial.begin()));
+		MIST_ASSERT(std::equal(sorted.begin(), sorted.begin() + 16, nearest));
+	}
+
+	std::cout << "Sorting Networks" << std::endl;
+
+	{
+		// Assure that every network size sorts, including duplicates and the extremes
+		int32_t intValues[64];
+		float floatValues[64];
+		for (size_t iteration = 0; iteration < 100; iteration++) {
+			for (size_t i = 0; i < 64; i++) {
+				intValues[i] = rand() % 32 - 16;
+				floatValues[i] = (float)(rand() % 1000 - 500) / 7.0f;
+			}
+			intValues[iteration % 64] = std::numeric_limits<int32_t>::max();
+			intValues[(iteration + 1) % 64] = std::numeric_limits<int32_t>::min();
+			floatValues[iteration % 64] = std::numeric_limits<float>::infinity();
+
+			Mist::SortingNetwork<8>(intValues);
+			Mist::SortingNetwork<16>(intValues + 16);
+			Mist::SortingNetwork<32>(intValues + 32);
+			MIST_ASSERT(std::is_sorted(intValues, intValues + 8));
+			MIST_ASSERT(std::is_sorted(intValues + 16, intValues + 32));
+			MIST_ASSERT(std::is_sorted(intValues + 32, intValues + 64));
+			Mist::SortingNetwork<64>(intValues);
+			MIST_ASSERT(std::is_sorted(intValues, intValues + 64));
+
+			Mist::SortingNetwork<64>(floatValues);
+			MIST_ASSERT(std::is_sorted(floatValues, floatValues + 64));
+		}
+
+		// The scalar network is used for the other types
+		double doubleValues[16];
+		for (size_t i = 0; i < 16; i++) {
+			doubleValues[i] = (double)(rand() % 100);
+		}
+		Mist::SortingNetwork<16>(doubleValues);
+		MIST_ASSERT(std::is_sorted(doubleValues, doubleValues + 16));
+
+		// Quick sort and merge sort use the networks as their base case, test the sizes around the network sizes
+		for (size_t count = 1; count < 300; count++) {
+			std::vector<int32_t> intVector;
+			std::vector<float> floatVector;
+			for (size_t i = 0; i < count; i++) {
+				intVector.push_back(rand() - RAND_MAX / 2);
+				floatVector.push_back((float)(rand() % 100) - 50.0f);
+			}
+			std::vector<int32_t> expectedInts = intVector;
+			std::sort(expectedInts.begin(), expectedInts.end());
+
+			std::vector<int32_t> quickSorted = intVector;
+			Mist::QuickSort(quickSorted.begin(), quickSorted.end());
+			MIST_ASSERT(quickSorted == expectedInts);
+
+			Mist::MergeSort(intVector.data(), intVector.data() + intVector.size());
+			MIST_ASSERT(intVector == expectedInts);
+
+			std::vector<float> quickSortedFloats = floatVector;
+			Mist::QuickSort(quickSortedFloats.begin(), quickSortedFloats.end());
+			MIST_ASSERT(std::is_sorted(quickSortedFloats.begin(), quickSortedFloats.end()));
+
+			Mist::MergeSort(floatVector.data(), floatVector.data() + floatVector.size());
+			MIST_ASSERT(std::is_sorted(floatVector.begin(), floatVector.end()));
+		}
+
+		// Compare the network against the insertion sort based quick sort for per tile sized lists
+		const size_t SMALL_SORT_COUNT = 100000;
+		std::vector<int32_t> smallLists(SMALL_SORT_COUNT * 32);
+		for (int32_t& value : smallLists) {
+			value = rand();
+		}
+		std::vector<int32_t> networkLists = smallLists;
+
+		BeginTimer();
+		for (size_t i = 0; i < SMALL_SORT_COUNT; i++) {
+			Mist::SortingNetwork<32>(networkLists.data() + i * 32);
+		}
+		std::cout << "Network: " << EndTimer() << "ms" << std::endl;
+
+		BeginTimer();
+		for (size_t i = 0; i < SMALL_SORT_COUNT; i++) {
+			// A custom comparator skips the networks
+			Mist::QuickSort(smallLists.data() + i * 32, smallLists.data() + (i + 1) * 32, [](int32_t left, int32_t right) { return left < right; });
+		}
+		std::cout << "Quick Sort: " << EndTimer() << "ms" << std::endl;
+		MIST_ASSERT(smallLists == networkLists);
+	}
+
 	std::cout << "Sorting Tests Passed!" << std::endl;
 }
 
+void TestExternalSort() {
+	const size_t VALUE_COUNT = 200000;
+
+	std::vector<uint64_t> values;
+	for (size_t i = 0; i < VALUE_COUNT; i++) {
+		values.push_back(((uint64_t)rand() << 40) ^ ((uint64_t)rand() << 20) ^ (uint64_t)rand());
+	}
+	std::vector<uint64_t> expected = values;
+	std::sort(expected.begin(), expected.end());
+
+	// A budget that holds everything never touches the disk
+	{
+		Mist::ExternalSorter<uint64_t> sorter;
+		bool isPushed = sorter.Push(values.data(), values.size());
+		MIST_ASSERT(isPushed);
+		MIST_ASSERT(sorter.RunCount() == 0 && sorter.Size() == VALUE_COUNT);
+
+		std::vector<uint64_t> sorted;
+		bool isFinished = sorter.Finish([&](const uint64_t* block, size_t count) { sorted.insert(sorted.end(), block, block + count); });
+		MIST_ASSERT(isFinished);
+		MIST_ASSERT(sorted == expected);
+		MIST_ASSERT(sorter.Size() == 0);
+	}
+
+	// Spill runs and merge them in a single pass, then with a budget too small for a single pass
+	size_t budgets[] = { 64 * 1024, 16 * 1024 };
+	for (size_t budget : budgets) {
+		Mist::ExternalSortSettings settings;
+		settings.m_MemoryBudget = budget;
+		settings.m_BlockSize = 1024;
+
+		Mist::ExternalSorter<uint64_t> sorter(settings);
+		bool isPushed = true;
+		for (size_t i = 0; i < VALUE_COUNT; i += 1000) {
+			isPushed = sorter.Push(values.data() + i, 1000) && isPushed;
+		}
+		MIST_ASSERT(isPushed);
+		MIST_ASSERT(sorter.RunCount() > 10);
+
+		std::vector<uint64_t> sorted;
+		BeginTimer();
+		bool isFinished = sorter.Finish([&](const uint64_t* block, size_t count) { sorted.insert(sorted.end(), block, block + count); });
+		std::cout << "External Sort: " << EndTimer() << "ms" << std::endl;
+		MIST_ASSERT(isFinished);
+		MIST_ASSERT(sorted == expected);
+
+		// The sorter can be reused with a comparison
+		Mist::ExternalSorter<uint64_t, Mist::CompareOrdering<std::greater<uint64_t>>> reverseSorter(settings);
+		isPushed = reverseSorter.Push(values.data(), values.size());
+		MIST_ASSERT(isPushed);
+		sorted.clear();
+		isFinished = reverseSorter.Finish([&](const uint64_t* block, size_t count) { sorted.insert(sorted.end(), block, block + count); });
+		MIST_ASSERT(isFinished);
+		MIST_ASSERT(std::equal(sorted.begin(), sorted.end(), expected.rbegin()));
+	}
+
+	// The radix ordering is stable across the runs
+	{
+		struct Record {
+			uint16_t m_Key;
+			uint32_t m_Order;
+		};
+		struct RecordKey {
+			uint16_t operator()(const Record& record) const { return record.m_Key; }
+		};
+
+		Mist::ExternalSortSettings settings;
+		settings.m_MemoryBudget = 32 * 1024;
+		settings.m_BlockSize = 512;
+		Mist::ExternalSorter<Record, Mist::RadixKeyOrdering<RecordKey>> sorter(settings);
+		bool isPushed = true;
+		for (uint32_t i = 0; i < VALUE_COUNT; i++) {
+			isPushed = sorter.Push({ (uint16_t)(rand() % 100), i }) && isPushed;
+		}
+		MIST_ASSERT(isPushed);
+
+		std::vector<Record> sorted;
+		bool isFinished = sorter.Finish([&](const Record* block, size_t count) { sorted.insert(sorted.end(), block, block + count); });
+		MIST_ASSERT(isFinished);
+		MIST_ASSERT(sorted.size() == VALUE_COUNT);
+		for (size_t i = 1; i < sorted.size(); i++) {
+			MIST_ASSERT(sorted[i - 1].m_Key <= sorted[i].m_Key);
+			MIST_ASSERT(sorted[i - 1].m_Key != sorted[i].m_Key || sorted[i - 1].m_Order < sorted[i].m_Order);
+		}
+	}
+
+	// Sort a file with named runs in the working directory
+	{
+		FILE* input = fopen("ExternalSortInput.bin", "wb");
+		MIST_ASSERT(input != nullptr);
+		fwrite(values.data(), sizeof(uint64_t), values.size(), input);
+		fclose(input);
+
+		Mist::ExternalSortSettings settings;
+		settings.m_MemoryBudget = 64 * 1024;
+		settings.m_BlockSize = 4096;
+		settings.m_TemporaryDirectory = ".";
+		bool isSorted = Mist::ExternalSortFile<uint64_t>("ExternalSortInput.bin", "ExternalSortOutput.bin", settings);
+		MIST_ASSERT(isSorted);
+
+		std::vector<uint64_t> sorted(VALUE_COUNT + 1);
+		FILE* output = fopen("ExternalSortOutput.bin", "rb");
+		MIST_ASSERT(output != nullptr);
+		size_t readCount = fread(sorted.data(), sizeof(uint64_t), sorted.size(), output);
+		MIST_ASSERT(readCount == VALUE_COUNT);
+		fclose(output);
+		sorted.pop_back();
+		MIST_ASSERT(sorted == expected);
+
+		remove("ExternalSortInput.bin");
+		remove("ExternalSortOutput.bin");
+		isSorted = Mist::ExternalSortFile<uint64_t>("ExternalSortInput.bin", "ExternalSortOutput.bin", settings);
+		MIST_ASSERT(isSorted == false);
+	}
+
+	std::cout << "ExternalSort Test Passed" << std::endl;
+}
+
+// The bit manipulations are usable in constant expressions
+static_assert(Mist::SetBit(0, 31) == 0x80000000u, "");
+static_assert(Mist::SetBitRange(1, 3) == 6, "");
+static_assert(Mist::SetLowerBitRange(4) == 15, "");
+static_assert(Mist::SetUpperBitRange(32) == 0xFFFFFFFFu, "");
+static_assert(Mist::GetBitRange(0xFF, 2, 4) == 12, "");
+static_assert(Mist::CountBitsSet(0xF0F0) == 8, "");
+static_assert(Mist::CountTrailingZeros(0x100) == 8, "");
+static_assert(Mist::CountLeadingZeros64(1) == 63, "");
+static_assert(Mist::ExtractBits(0b1000, 0b1010) == 0b10, "");
+static_assert(Mist::DepositBits(0b10, 0b1010) == 0b1000, "");
+static_assert(Mist::MakeMask<>() == 0, "");
+static_assert(Mist::MakeMask<0, 3, 31>() == (1u | 8u | 0x80000000u), "");
+static_assert(Mist::IsFlagSet(Mist::MakeMask<2, 5>(), Mist::GetBitFlag(5)), "");
+
+constexpr Mist::BitField QUERY_INDICES[] = { 1, 4 };
+static_assert(Mist::GetBitMask(QUERY_INDICES, 2) == 18, "");
+
+// A mask can be used as a template argument
+template< Mist::BitField tMask >
+struct MaskSignature {
+	static constexpr size_t COMPONENT_COUNT = Mist::CountBitsSet(tMask);
+};
+static_assert(MaskSignature<Mist::MakeMask<1, 2, 7>()>::COMPONENT_COUNT == 3, "");
+
+constexpr size_t SumOfSetBits(Mist::BitField mask) {
+	size_t sum = 0;
+	for (size_t bitIndex : Mist::IterateSetBits(mask)) {
+		sum += bitIndex;
+	}
+	return sum;
+}
+static_assert(SumOfSetBits(Mist::MakeMask<1, 2, 7>()) == 10, "");
+
 void TestBitManipulations() {
 	Mist::BitField mask = 0;
 	// All the bits in the mask should be set, thus it's value should be max value
@@ -358,6 +1297,56 @@ void TestBitManipulations() {
 	MIST_ASSERT(Mist::GetMaskDifferences(3, 1) == 2);
 	MIST_ASSERT(Mist::GetMaskDifferences(5, 3) == 2 + 4);
 	MIST_ASSERT(Mist::GetMaskDifferences(8, 2) == 2 + 8);
+
+	// The indices of the upper bits are found as well
+	Mist::GetIndividualBitIndices(0x80000011, ind, &count);
+	MIST_ASSERT(count == 3 && ind[0] == 0 && ind[1] == 4 && ind[2] == 31);
+
+	MIST_ASSERT(Mist::CountBitsSet(0x80000011) == 3);
+	MIST_ASSERT(Mist::CountBitsSet64(0xFFFFFFFFFFFFFFFFull) == 64);
+	MIST_ASSERT(Mist::CountBitsSet64(0x8000000000000001ull) == 2);
+
+	MIST_ASSERT(Mist::CountTrailingZeros(0) == 32);
+	MIST_ASSERT(Mist::CountTrailingZeros(1) == 0);
+	MIST_ASSERT(Mist::CountTrailingZeros(0x80000000) == 31);
+	MIST_ASSERT(Mist::CountTrailingZeros64(0) == 64);
+	MIST_ASSERT(Mist::CountTrailingZeros64(1ull << 40) == 40);
+
+	MIST_ASSERT(Mist::CountLeadingZeros(0) == 32);
+	MIST_ASSERT(Mist::CountLeadingZeros(1) == 31);
+	MIST_ASSERT(Mist::CountLeadingZeros(0x80000000) == 0);
+	MIST_ASSERT(Mist::CountLeadingZeros64(0) == 64);
+	MIST_ASSERT(Mist::CountLeadingZeros64(1ull << 40) == 23);
+
+	MIST_ASSERT(Mist::ExtractBits(0b1000, 0b1010) == 0b10);
+	MIST_ASSERT(Mist::ExtractBits(0xFFFFFFFF, 0xF0F0) == 0xFF);
+	MIST_ASSERT(Mist::DepositBits(0b10, 0b1010) == 0b1000);
+	MIST_ASSERT(Mist::DepositBits(0xFF, 0xF0F0) == 0xF0F0);
+	for (size_t i = 0; i < 1000; i++) {
+		Mist::BitField value = (Mist::BitField)rand() * 7919u;
+		Mist::BitField selection = (Mist::BitField)rand() * 104729u;
+		MIST_ASSERT(Mist::DepositBits(Mist::ExtractBits(value, selection), selection) == (value & selection));
+		MIST_ASSERT(Mist::CountBitsSet(value) == Mist::Detail::PopCountFallback(value));
+		MIST_ASSERT(Mist::CountTrailingZeros(value) == Mist::Detail::CountTrailingZerosFallback(value, 32));
+		MIST_ASSERT(Mist::CountLeadingZeros(value) == Mist::Detail::CountLeadingZerosFallback(value, 32));
+	}
+
+	// Iterate the set bits without filling an array
+	size_t visitedBits[64];
+	size_t visitedCount = 0;
+	for (size_t bitIndex : Mist::IterateSetBits(0x8000000000000005ull)) {
+		visitedBits[visitedCount++] = bitIndex;
+	}
+	MIST_ASSERT(visitedCount == 3 && visitedBits[0] == 0 && visitedBits[1] == 2 && visitedBits[2] == 63);
+
+	visitedCount = 0;
+	Mist::ForEachSetBit(Mist::BitField(0x30), [&](size_t bitIndex) { visitedBits[visitedCount++] = bitIndex; });
+	MIST_ASSERT(visitedCount == 2 && visitedBits[0] == 4 && visitedBits[1] == 5);
+
+	for (size_t bitIndex : Mist::IterateSetBits(0)) {
+		MIST_ASSERT(false);
+		(void)bitIndex;
+	}
 }
 
 void TestSingleList() {
@@ -447,9 +1436,235 @@ void TestSingleList() {
 
 	// Assure that moving works
 	Mist::SingleList<size_t> newList(std::move(list));
+	MIST_ASSERT(newList.Size() == 9);
+	MIST_ASSERT(list.Size() == 0);
+	MIST_ASSERT((list.begin() != list.end()) == false);
+
+	// Removing an interior node keeps the rest of the list linked
+	newList.Remove(newList.RetrieveNodeAt(3));
+	MIST_ASSERT(newList.Size() == 8);
+	MIST_ASSERT(*newList.RetrieveValueAt(3) == 5);
+	MIST_ASSERT(*newList.LastValue() == 9);
+
+	newList.Remove(newList.LastNode());
+	MIST_ASSERT(*newList.LastValue() == 8);
+	MIST_ASSERT(newList.Size() == 7);
+
+	newList.RemoveAfter(newList.FirstNode());
+	MIST_ASSERT(*newList.RetrieveValueAt(1) == 3);
+	newList.RemoveAfter(newList.RetrieveNodeAt(newList.Size() - 2));
+	MIST_ASSERT(*newList.LastValue() == 7);
+	MIST_ASSERT(newList.Size() == 5);
+	newList.InsertAsLast(8);
+	MIST_ASSERT(*newList.LastValue() == 8);
+
+	// Erase the odd values in a single pass
+	size_t removedCount = newList.EraseIf([](size_t value) { return value % 2 == 1; });
+	MIST_ASSERT(removedCount == 4);
+	MIST_ASSERT(newList.Size() == 2);
+	MIST_ASSERT(*newList.FirstValue() == 6);
+	MIST_ASSERT(*newList.LastValue() == 8);
+	for (auto& i : newList) {
+		MIST_ASSERT(*i.GetValue() % 2 == 0);
+	}
 
-	std::cout << "Single List Tests Passed" << std::endl;
-}
+	// Removing the tail should update the last value
+	MIST_ASSERT(newList.EraseIf([](size_t value) { return value == 8; }) == 1);
+	MIST_ASSERT(*newList.LastValue() == 6);
+	MIST_ASSERT(newList.EraseIf([](size_t) { return true; }) == 1);
+	MIST_ASSERT(newList.Size() == 0);
+	newList.InsertAsLast(1);
+	MIST_ASSERT(*newList.FirstValue() == 1);
+	MIST_ASSERT(*newList.LastValue() == 1);
+
+	// Splicing moves the nodes without reallocating them
+	Mist::SingleList<size_t> otherList;
+	newList.Splice(otherList);
+	MIST_ASSERT(newList.Size() == 1);
+	for (size_t i = 2; i < 6; i++) {
+		otherList.InsertAsLast(i);
+	}
+	Mist::SingleList<size_t>::Node* splicedNode = otherList.FirstNode();
+	newList.Splice(otherList);
+	MIST_ASSERT(otherList.Size() == 0);
+	MIST_ASSERT(newList.Size() == 5);
+	MIST_ASSERT(newList.RetrieveNodeAt(1) == splicedNode);
+	MIST_ASSERT(*newList.LastValue() == 5);
+	otherList.Splice(newList);
+	MIST_ASSERT(otherList.Size() == 5);
+	MIST_ASSERT(*otherList.FirstValue() == 1);
+	otherList.InsertAsLast(6);
+	MIST_ASSERT(*otherList.LastValue() == 6);
+
+	// Purging a large list should be linear
+	{
+		Mist::SingleList<size_t> purgeList;
+		for (size_t i = 0; i < 1000000; i++) {
+			purgeList.InsertAsLast(i);
+		}
+		auto start = std::chrono::high_resolution_clock::now();
+		MIST_ASSERT(purgeList.EraseIf([](size_t value) { return value % 3 != 0; }) == 666666);
+		auto purgeTime = std::chrono::high_resolution_clock::now() - start;
+		MIST_ASSERT(purgeList.Size() == 333334);
+		std::cout << "Single List EraseIf of 666666 nodes: " << std::chrono::duration_cast<std::chrono::microseconds>(purgeTime).count() << "us" << std::endl;
+	}
+
+	std::cout << "Single List Tests Passed" << std::endl;
+}
+
+void TestUnrolledList() {
+
+	std::cout << "UnrolledList Tests" << std::endl;
+
+	Mist::UnrolledList<size_t, 4> list;
+	MIST_ASSERT(list.Size() == 0);
+	MIST_ASSERT((list.begin() != list.end()) == false);
+
+	list.InsertAsFirst(0);
+	MIST_ASSERT(list.Size() == 1);
+	MIST_ASSERT(*list.FirstValue() == 0);
+	MIST_ASSERT(*list.LastValue() == 0);
+
+	list.Remove(list.begin());
+	MIST_ASSERT(list.Size() == 0);
+	MIST_ASSERT(list.NodeCount() == 0);
+
+	// Appending fills the nodes before allocating new ones
+	for (size_t i = 0; i < 10; i++) {
+		list.InsertAsLast(i);
+	}
+	MIST_ASSERT(list.Size() == 10);
+	MIST_ASSERT(list.NodeCount() == 3);
+	MIST_ASSERT(*list.FirstValue() == 0);
+	MIST_ASSERT(*list.LastValue() == 9);
+	for (size_t i = 0; i < list.Size(); i++) {
+		MIST_ASSERT(*list.RetrieveValueAt(i) == i);
+	}
+
+	// Inserting into a full node splits it
+	Mist::UnrolledList<size_t, 4>::Iterator position = list.begin();
+	++position;
+	position = list.InsertAfter(position, 100);
+	MIST_ASSERT(*position == 100);
+	MIST_ASSERT(*list.RetrieveValueAt(2) == 100);
+	MIST_ASSERT(*list.RetrieveValueAt(3) == 2);
+	MIST_ASSERT(list.Size() == 11);
+	MIST_ASSERT(list.NodeCount() == 4);
+
+	list.InsertAsFirst(200);
+	MIST_ASSERT(*list.FirstValue() == 200);
+	MIST_ASSERT(*list.RetrieveValueAt(1) == 0);
+
+	// Inserting into a full head splits it in place, an iterator to the head keeps a valid previous node
+	{
+		Mist::UnrolledList<int, 4> head;
+		for (int i = 0; i < 4; i++) {
+			head.InsertAsLast(i);
+		}
+		Mist::UnrolledList<int, 4>::Iterator it = head.begin();
+		head.InsertAsFirst(-1);
+		MIST_ASSERT(head.NodeCount() == 2 && *head.FirstValue() == -1);
+		for (int i = 0; i < 4; i++) {
+			it = head.Remove(it);
+		}
+		MIST_ASSERT(head.Size() == 1 && head.NodeCount() == 1);
+		MIST_ASSERT(*head.FirstValue() == 3 && *head.LastValue() == 3);
+		MIST_ASSERT(it != head.end() && *it == 3);
+	}
+
+	// Compare a sequence of random inserts and removals against the std::list
+	std::list<size_t> reference;
+	for (size_t value : list) {
+		reference.push_back(value);
+	}
+	srand(7);
+	for (size_t i = 0; i < 2000; i++) {
+
+		size_t target = rand() % list.Size();
+		Mist::UnrolledList<size_t, 4>::Iterator it = list.begin();
+		std::list<size_t>::iterator referenceIt = reference.begin();
+		for (size_t j = 0; j < target; j++) {
+			++it;
+			++referenceIt;
+		}
+
+		if (rand() % 2 == 0 || list.Size() < 2) {
+			it = list.InsertAfter(it, i);
+			referenceIt = reference.insert(std::next(referenceIt), i);
+			MIST_ASSERT(*it == *referenceIt);
+		}
+		else {
+			it = list.Remove(it);
+			referenceIt = reference.erase(referenceIt);
+			MIST_ASSERT((it != list.end()) == (referenceIt != reference.end()));
+			MIST_ASSERT(it == list.end() || *it == *referenceIt);
+		}
+
+		MIST_ASSERT(list.Size() == reference.size());
+	}
+	std::list<size_t>::iterator referenceIt = reference.begin();
+	for (size_t value : list) {
+		MIST_ASSERT(value == *referenceIt);
+		++referenceIt;
+	}
+	MIST_ASSERT(*list.LastValue() == reference.back());
+
+	// Removing everything frees all of the nodes
+	while (list.Size() > 0) {
+		list.Remove(list.begin());
+	}
+	MIST_ASSERT(list.NodeCount() == 0);
+	list.InsertAsLast(1);
+	MIST_ASSERT(*list.FirstValue() == 1);
+
+	// Values that aren't trivial should be constructed and destroyed correctly
+	{
+		Mist::UnrolledList<std::string, 4> strings;
+		for (size_t i = 0; i < 20; i++) {
+			strings.InsertAsLast(std::to_string(i) + " a string long enough to allocate");
+		}
+		strings.InsertAfter(strings.begin(), std::string("inserted"));
+		strings.InsertAsFirst(std::string("first"));
+		MIST_ASSERT(*strings.RetrieveValueAt(2) == "inserted");
+		strings.Remove(strings.begin());
+		MIST_ASSERT(*strings.FirstValue() == "0 a string long enough to allocate");
+
+		Mist::UnrolledList<std::string, 4> movedStrings(std::move(strings));
+		MIST_ASSERT(strings.Size() == 0);
+		MIST_ASSERT(movedStrings.Size() == 21);
+	}
+
+	// Iterating should be faster than the single list, as only one pointer needs to be followed per node
+	{
+		const size_t count = 1 << 20;
+		Mist::SingleList<size_t> singleList;
+		Mist::UnrolledList<size_t> unrolledList;
+		for (size_t i = 0; i < count; i++) {
+			singleList.InsertAsLast(i);
+			unrolledList.InsertAsLast(i);
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		size_t singleSum = 0;
+		for (auto& node : singleList) {
+			singleSum += *node.GetValue();
+		}
+		auto singleTime = std::chrono::high_resolution_clock::now() - start;
+
+		start = std::chrono::high_resolution_clock::now();
+		size_t unrolledSum = 0;
+		for (size_t value : unrolledList) {
+			unrolledSum += value;
+		}
+		auto unrolledTime = std::chrono::high_resolution_clock::now() - start;
+
+		MIST_ASSERT(singleSum == unrolledSum);
+		std::cout << "Single List iteration: " << std::chrono::duration_cast<std::chrono::microseconds>(singleTime).count() << "us (sum " << singleSum << ")" << std::endl;
+		std::cout << "Unrolled List iteration: " << std::chrono::duration_cast<std::chrono::microseconds>(unrolledTime).count() << "us (sum " << unrolledSum << ")" << std::endl;
+	}
+
+	std::cout << "Unrolled List Tests Passed" << std::endl;
+}
 
 void TestAllocator()
 {
@@ -485,6 +1700,386 @@ void TestAllocator()
 	std::cout << "Cpp Allocator Tests passed" << std::endl;
 }
 
+void TestLinearAllocator() {
+
+	std::cout << "Linear Allocator Tests" << std::endl;
+
+	struct TestArena {};
+	using Arena = Mist::LinearAllocator<TestArena>;
+
+	Arena::Initialize(64 * 1024);
+	MIST_ASSERT(Arena::UsedSize() == 0);
+
+	size_t* pointer = Arena::Alloc<size_t>(5);
+	MIST_ASSERT(pointer != nullptr && *pointer == 5);
+	// Assure that freeing the last allocation gives the memory back
+	Arena::Free(pointer);
+	MIST_ASSERT(Arena::UsedSize() == 0);
+
+	void* block = Arena::Alloc(100);
+	*(size_t*)block = 10;
+	// Assure that the last block grows in place
+	void* grownBlock = Arena::Realloc(block, 200);
+	MIST_ASSERT(grownBlock == block);
+
+	void* otherBlock = Arena::Alloc(16);
+	MIST_ASSERT(((size_t)otherBlock & (alignof(std::max_align_t) - 1)) == 0);
+	// Assure that the block is copied when it isn't the last allocation
+	void* movedBlock = Arena::Realloc(grownBlock, 400);
+	MIST_ASSERT(movedBlock != grownBlock);
+	MIST_ASSERT(*(size_t*)movedBlock == 10);
+
+	{
+		Arena::ScopedMarker marker;
+		size_t usedSize = Arena::UsedSize();
+
+		Mist::DynamicArray<size_t, Arena> array;
+		Mist::SingleList<size_t, Arena> list;
+		for (size_t i = 0; i < 100; ++i) {
+			array.InsertAsLast(i);
+			list.InsertAsLast(i);
+		}
+		MIST_ASSERT(array[99] == 99);
+		MIST_ASSERT(*list.LastValue() == 99);
+		MIST_ASSERT(Arena::UsedSize() > usedSize);
+	}
+
+	Arena::Reset();
+	MIST_ASSERT(Arena::UsedSize() == 0);
+	Arena::Shutdown();
+
+	{
+		// Assure that containers can each use their own arena instance
+		Mist::LinearArena firstArena;
+		Mist::LinearArena secondArena;
+		firstArena.Initialize(16 * 1024);
+		secondArena.Initialize(16 * 1024);
+
+		using ArenaReference = Mist::AllocatorReference<Mist::LinearArena>;
+		ArenaReference firstReference(&firstArena);
+		ArenaReference secondReference(&secondArena);
+		Mist::DynamicArray<size_t, ArenaReference> firstArray(firstReference);
+		Mist::SingleList<size_t, ArenaReference> secondList(secondReference);
+
+		{
+			Mist::LinearArena::ScopedMarker marker(&secondArena);
+			for (size_t i = 0; i < 100; ++i) {
+				firstArray.InsertAsLast(i);
+			}
+			MIST_ASSERT(secondArena.UsedSize() == 0);
+			MIST_ASSERT(firstArena.UsedSize() >= 100 * sizeof(size_t));
+		}
+
+		secondList.InsertAsLast(10);
+		MIST_ASSERT(secondArena.UsedSize() > 0);
+		MIST_ASSERT(secondList.GetAllocator().GetTarget() == &secondArena);
+
+		// Assure that the allocator follows the memory when moving
+		Mist::DynamicArray<size_t, ArenaReference> movedArray(std::move(firstArray));
+		MIST_ASSERT(movedArray.GetAllocator().GetTarget() == &firstArena);
+		MIST_ASSERT(movedArray[99] == 99);
+	}
+
+	// Assure that stateless allocators don't take any space in the containers
+	static_assert(sizeof(Mist::DynamicArray<size_t>) == sizeof(void*) + sizeof(size_t) * 2, "The CppAllocator should not add to the size of the array.");
+	static_assert(sizeof(Mist::SingleList<size_t>) == sizeof(void*) * 2 + sizeof(size_t), "The CppAllocator should not add to the size of the list.");
+
+	std::cout << "Linear Allocator Tests passed" << std::endl;
+}
+
+void TestPoolAllocator() {
+
+	std::cout << "Pool Allocator Tests" << std::endl;
+
+	struct TestPool {};
+	using Pool = Mist::PoolAllocator<TestPool, 16>;
+	using PooledList = Mist::SingleList<size_t, Pool>;
+
+	{
+		PooledList list;
+		for (size_t i = 0; i < 100; ++i) {
+			list.InsertAsLast(i);
+		}
+		MIST_ASSERT(Pool::LiveCount<PooledList::Node>() == 100);
+		// 100 nodes with 16 nodes per chunk
+		MIST_ASSERT(Pool::ChunkCount<PooledList::Node>() == 7);
+
+		// Assure that the nodes are laid out contiguously
+		PooledList::Node* first = list.FirstNode();
+		PooledList::Node* second = first->NextNode();
+		MIST_ASSERT((size_t)second - (size_t)first == sizeof(PooledList::Node));
+
+		// Assure that freed nodes are recycled
+		list.Remove(list.FirstNode());
+		MIST_ASSERT(Pool::LiveCount<PooledList::Node>() == 99);
+		list.InsertAsFirst(0);
+		MIST_ASSERT(list.FirstNode() == first);
+		MIST_ASSERT(Pool::ChunkCount<PooledList::Node>() == 7);
+
+		list.Clear();
+		MIST_ASSERT(Pool::LiveCount<PooledList::Node>() == 0);
+
+		for (size_t i = 0; i < 100; ++i) {
+			list.InsertAsLast(i);
+		}
+		// Release the whole list at once
+		list.Abandon();
+		MIST_ASSERT(list.Size() == 0);
+		Pool::ReleaseAll<PooledList::Node>();
+		MIST_ASSERT(Pool::ChunkCount<PooledList::Node>() == 0);
+		MIST_ASSERT(Pool::LiveCount<PooledList::Node>() == 0);
+	}
+
+	// Odd sized types with a small alignment still get slots aligned for the free list
+	{
+		struct OddName {
+			char m_Characters[9];
+		};
+		static_assert(alignof(OddName) == 1, "The test expects a type aligned to a single byte.");
+
+		OddName* names[40];
+		for (size_t i = 0; i < 40; ++i) {
+			names[i] = Pool::Alloc<OddName>();
+			memset(names[i]->m_Characters, (int)i, sizeof(names[i]->m_Characters));
+			MIST_ASSERT((size_t)names[i] % alignof(void*) == 0);
+		}
+		MIST_ASSERT(Pool::LiveCount<OddName>() == 40);
+
+		// Free every other slot, the free list is written in the freed slots
+		for (size_t i = 0; i < 40; i += 2) {
+			Pool::Free(names[i]);
+		}
+		for (size_t i = 1; i < 40; i += 2) {
+			MIST_ASSERT(names[i]->m_Characters[0] == (char)i && names[i]->m_Characters[8] == (char)i);
+		}
+
+		for (size_t i = 0; i < 40; i += 2) {
+			names[i] = Pool::Alloc<OddName>();
+			MIST_ASSERT((size_t)names[i] % alignof(void*) == 0);
+		}
+		MIST_ASSERT(Pool::ChunkCount<OddName>() == 3);
+
+		for (size_t i = 0; i < 40; ++i) {
+			Pool::Free(names[i]);
+		}
+		MIST_ASSERT(Pool::LiveCount<OddName>() == 0);
+		Pool::ReleaseAll<OddName>();
+	}
+
+	std::cout << "Pool Allocator Tests passed" << std::endl;
+}
+
+void TestTrackingAllocator() {
+
+	std::cout << "Tracking Allocator Tests" << std::endl;
+
+	MIST_ALLOCATION_TAG(TrackedListTag);
+	using TrackedAllocator = Mist::TrackingAllocator<TrackedListTag>;
+	using TrackedList = Mist::SingleList<size_t, TrackedAllocator>;
+
+	static_assert(sizeof(TrackedList) == sizeof(Mist::SingleList<size_t>), "The tracking allocator should not add to the size of the list.");
+
+	{
+		TrackedList list;
+		for (size_t i = 0; i < 100; ++i) {
+			list.InsertAsLast(i);
+		}
+
+		Mist::AllocationStatistics statistics = TrackedAllocator::GetStatistics();
+		MIST_ASSERT(strcmp(statistics.m_Name, "TrackedListTag") == 0);
+		MIST_ASSERT(statistics.m_AllocationCount == 100);
+		MIST_ASSERT(statistics.m_FreeCount == 0);
+		MIST_ASSERT(statistics.m_LiveBytes == 100 * sizeof(TrackedList::Node));
+		MIST_ASSERT(statistics.m_Histogram[Mist::Detail::AllocationHistogramBucket(sizeof(TrackedList::Node))] == 100);
+
+		list.Clear();
+		statistics = TrackedAllocator::GetStatistics();
+		MIST_ASSERT(statistics.m_FreeCount == 100);
+		MIST_ASSERT(statistics.m_LiveBytes == 0);
+		MIST_ASSERT(statistics.m_PeakBytes == 100 * sizeof(TrackedList::Node));
+		MIST_ASSERT(statistics.m_AllocatedBytes == 100 * sizeof(TrackedList::Node));
+	}
+
+	// The histogram buckets are powers of two
+	MIST_ASSERT(Mist::Detail::AllocationHistogramBucket(1) == 0);
+	MIST_ASSERT(Mist::Detail::AllocationHistogramBucket(2) == 1);
+	MIST_ASSERT(Mist::Detail::AllocationHistogramBucket(3) == 2);
+	MIST_ASSERT(Mist::Detail::AllocationHistogramBucket(4) == 2);
+	MIST_ASSERT(Mist::Detail::AllocationHistogramBucket(1025) == 11);
+	MIST_ASSERT(Mist::Detail::AllocationHistogramBucket(size_t(1) << 40) == Mist::ALLOCATION_HISTOGRAM_BUCKET_COUNT - 1);
+
+	// Reallocations of a dynamic array are tracked
+	MIST_ALLOCATION_TAG(TrackedArrayTag);
+	using TrackedArrayAllocator = Mist::TrackingAllocator<TrackedArrayTag>;
+	{
+		Mist::DynamicArray<size_t, TrackedArrayAllocator> array;
+		for (size_t i = 0; i < 1000; ++i) {
+			array.InsertAsLast(i);
+		}
+		for (size_t i = 0; i < 1000; ++i) {
+			MIST_ASSERT(array[i] == i);
+		}
+
+		Mist::AllocationStatistics statistics = TrackedArrayAllocator::GetStatistics();
+		MIST_ASSERT(statistics.m_AllocationCount + statistics.m_ReallocationCount > 1);
+		MIST_ASSERT(statistics.m_LiveBytes == static_cast<int64_t>(array.ReservedSize() * sizeof(size_t)));
+	}
+	MIST_ASSERT(TrackedArrayAllocator::GetStatistics().m_LiveBytes == 0);
+
+	// Blocks allocated on one thread and freed on another are counted once
+	{
+		std::vector<void*> blocks(64);
+		std::thread allocatingThread([&blocks]() {
+			TrackedAllocator allocator;
+			for (void*& block : blocks) {
+				block = allocator.Alloc(32);
+			}
+		});
+		allocatingThread.join();
+
+		Mist::AllocationStatistics statistics = TrackedAllocator::GetStatistics();
+		MIST_ASSERT(statistics.m_AllocationCount == 164);
+		MIST_ASSERT(statistics.m_LiveBytes == 64 * 32);
+
+		TrackedAllocator allocator;
+		for (void* block : blocks) {
+			allocator.Free(block);
+		}
+		statistics = TrackedAllocator::GetStatistics();
+		MIST_ASSERT(statistics.m_FreeCount == 164);
+		MIST_ASSERT(statistics.m_LiveBytes == 0);
+	}
+
+	// Every tag can be reported at once
+	std::vector<Mist::AllocationStatistics> allStatistics = Mist::GetAllocationStatistics();
+	MIST_ASSERT(allStatistics.size() >= 2);
+	for (const Mist::AllocationStatistics& statistics : allStatistics) {
+		std::cout << statistics.m_Name << " (" << statistics.m_Location << "): " << statistics.m_AllocationCount << " allocations, "
+			<< statistics.m_PeakBytes << " peak bytes" << std::endl;
+	}
+
+	std::cout << "Tracking Allocator Tests passed" << std::endl;
+}
+
+void TestAlignedAllocation() {
+
+	std::cout << "Aligned Allocation Tests" << std::endl;
+
+	auto isAligned = [](const void* pointer, size_t alignment) { return reinterpret_cast<uintptr_t>(pointer) % alignment == 0; };
+
+	// The unaligned blocks keep the fundamental alignment, even with the debug header
+	void* block = Mist::CppAllocator::Alloc(24);
+	MIST_ASSERT(isAligned(block, alignof(std::max_align_t)));
+	Mist::CppAllocator::Free(block);
+
+	for (size_t alignment : { size_t(8), size_t(32), size_t(64), size_t(256) }) {
+
+		uint8_t* aligned = static_cast<uint8_t*>(Mist::CppAllocator::Alloc(100, alignment));
+		MIST_ASSERT(isAligned(aligned, alignment));
+		for (size_t i = 0; i < 100; i++) {
+			aligned[i] = static_cast<uint8_t>(i);
+		}
+
+		// Reallocating keeps the alignment and the contents
+		aligned = static_cast<uint8_t*>(Mist::CppAllocator::Realloc(aligned, 10000, alignment));
+		MIST_ASSERT(isAligned(aligned, alignment));
+		for (size_t i = 0; i < 100; i++) {
+			MIST_ASSERT(aligned[i] == static_cast<uint8_t>(i));
+		}
+		aligned = static_cast<uint8_t*>(Mist::CppAllocator::Realloc(aligned, 50, alignment));
+		MIST_ASSERT(isAligned(aligned, alignment));
+		for (size_t i = 0; i < 50; i++) {
+			MIST_ASSERT(aligned[i] == static_cast<uint8_t>(i));
+		}
+		Mist::CppAllocator::Free(static_cast<void*>(aligned), alignment);
+	}
+
+	// The arrays stay aligned as they grow
+	{
+		Mist::AlignedDynamicArray<float, Mist::AVX_ALIGNMENT> floats;
+		static_assert(decltype(floats)::ALIGNMENT == 32, "The array should be aligned for AVX.");
+		for (size_t i = 0; i < 1000; i++) {
+			floats.InsertAsLast(static_cast<float>(i));
+			MIST_ASSERT(isAligned(floats.AsRawArray(), Mist::AVX_ALIGNMENT));
+		}
+		floats.ShrinkToSize();
+		MIST_ASSERT(isAligned(floats.AsRawArray(), Mist::AVX_ALIGNMENT));
+		MIST_ASSERT(floats[999] == 999.0f);
+
+		Mist::AlignedDynamicArray<std::string> strings;
+		for (size_t i = 0; i < 100; i++) {
+			strings.InsertAsLast(std::to_string(i));
+			MIST_ASSERT(isAligned(strings.AsRawArray(), Mist::CACHE_LINE_ALIGNMENT));
+		}
+		MIST_ASSERT(strings[99] == "99");
+
+		// The alignment of the value type is always respected
+		struct alignas(64) CacheLine { float m_Values[16]; };
+		Mist::DynamicArray<CacheLine> lines;
+		static_assert(decltype(lines)::ALIGNMENT == 64, "The array should respect the alignment of it's values.");
+		for (size_t i = 0; i < 20; i++) {
+			lines.InsertAsLast();
+			MIST_ASSERT(isAligned(lines.AsRawArray(), 64));
+		}
+	}
+
+	// Aligned arrays can be tracked
+	MIST_ALLOCATION_TAG(AlignedArrayTag);
+	using TrackedAllocator = Mist::TrackingAllocator<AlignedArrayTag>;
+	{
+		Mist::AlignedDynamicArray<size_t, Mist::CACHE_LINE_ALIGNMENT, TrackedAllocator> values;
+		for (size_t i = 0; i < 1000; i++) {
+			values.InsertAsLast(i);
+			MIST_ASSERT(isAligned(values.AsRawArray(), Mist::CACHE_LINE_ALIGNMENT));
+		}
+		MIST_ASSERT(values[500] == 500);
+		MIST_ASSERT(TrackedAllocator::GetStatistics().m_LiveBytes == static_cast<int64_t>(values.ReservedSize() * sizeof(size_t)));
+	}
+	MIST_ASSERT(TrackedAllocator::GetStatistics().m_LiveBytes == 0);
+
+	// Large arrays are mapped straight from the OS
+	{
+		using LargeAllocator = Mist::LargePageAllocator<>;
+		Mist::AlignedDynamicArray<uint32_t, Mist::AVX_ALIGNMENT, LargeAllocator> values;
+		const size_t count = 4 * 1024 * 1024;
+		for (size_t i = 0; i < count; i++) {
+			values.InsertAsLast(static_cast<uint32_t>(i));
+			MIST_ASSERT(i % 4096 != 0 || isAligned(values.AsRawArray(), Mist::CACHE_LINE_ALIGNMENT));
+		}
+		for (size_t i = 0; i < count; i += 97) {
+			MIST_ASSERT(values[i] == i);
+		}
+#if MIST_LARGE_PAGES_MMAP || MIST_LARGE_PAGES_WINDOWS
+		MIST_ASSERT(LargeAllocator::IsMapped(values.AsRawArray()));
+#endif
+
+		// Small blocks come from the CppAllocator
+		void* smallBlock = LargeAllocator::Alloc(128);
+		MIST_ASSERT(LargeAllocator::IsMapped(smallBlock) == false);
+		MIST_ASSERT(isAligned(smallBlock, Mist::CACHE_LINE_ALIGNMENT));
+		memset(smallBlock, 0xAB, 128);
+
+		// Growing a small block past the threshold maps it
+		uint8_t* grownBlock = static_cast<uint8_t*>(LargeAllocator::Realloc(smallBlock, Mist::LARGE_PAGE_SIZE * 2));
+		MIST_ASSERT(grownBlock[127] == 0xAB);
+#if MIST_LARGE_PAGES_MMAP || MIST_LARGE_PAGES_WINDOWS
+		MIST_ASSERT(LargeAllocator::IsMapped(grownBlock));
+#endif
+		grownBlock[Mist::LARGE_PAGE_SIZE * 2 - 1] = 1;
+		grownBlock = static_cast<uint8_t*>(LargeAllocator::Realloc(grownBlock, Mist::LARGE_PAGE_SIZE * 8));
+		MIST_ASSERT(grownBlock[127] == 0xAB);
+		MIST_ASSERT(grownBlock[Mist::LARGE_PAGE_SIZE * 2 - 1] == 1);
+
+		// And shrinking it back gives it back to the CppAllocator
+		grownBlock = static_cast<uint8_t*>(LargeAllocator::Realloc(grownBlock, 64));
+		MIST_ASSERT(LargeAllocator::IsMapped(grownBlock) == false);
+		MIST_ASSERT(grownBlock[63] == 0xAB);
+		LargeAllocator::Free(static_cast<void*>(grownBlock));
+	}
+
+	std::cout << "Aligned Allocation Tests passed" << std::endl;
+}
+
 void TestDynamicArray() {
 
 	std::cout << "Testing Dynamic Array" << std::endl;
@@ -573,21 +2168,976 @@ void TestDynamicArray() {
 		MIST_ASSERT(constructionCount == 0);
 	}
 
+	{
+		// Assure that the geometric growth doesn't reallocate on every few insertions
+		Mist::DynamicArray<size_t> growthArray;
+		size_t reallocationCount = 0;
+		size_t previousReservedSize = 0;
+		for (size_t i = 0; i < 1000; ++i) {
+			growthArray.InsertAsLast(i);
+			if (growthArray.ReservedSize() != previousReservedSize) {
+				previousReservedSize = growthArray.ReservedSize();
+				++reallocationCount;
+			}
+		}
+		MIST_ASSERT(growthArray.Size() == 1000);
+		MIST_ASSERT(reallocationCount < 50);
+
+		// Assure that the fixed growth keeps the old behaviour
+		Mist::DynamicArray<size_t, Mist::CppAllocator, Mist::FixedGrowth<5>> fixedArray;
+		fixedArray.InsertAsLast(0);
+		MIST_ASSERT(fixedArray.ReservedSize() == 5);
+
+		size_t values[] = { 1, 2, 3, 4, 5, 6, 7 };
+		fixedArray.InsertRange(std::begin(values), std::end(values));
+		MIST_ASSERT(fixedArray.Size() == 8);
+		for (size_t i = 0; i < fixedArray.Size(); ++i) {
+			MIST_ASSERT(fixedArray[i] == i);
+		}
+
+		fixedArray.AppendN(4, (size_t)42);
+		MIST_ASSERT(fixedArray.Size() == 12);
+		MIST_ASSERT(*fixedArray.LastValue() == 42);
+		MIST_ASSERT(fixedArray[8] == 42);
+	}
+
+	{
+		// Assure that the trivial fast paths behave like the element-wise paths
+		struct Particle {
+			float x, y, z;
+		};
+
+		Mist::DynamicArray<Particle> particles;
+		particles.Resize(1000);
+		MIST_ASSERT(particles.Size() == 1000);
+		MIST_ASSERT(particles[999].x == 0.0f && particles[999].z == 0.0f);
+
+		particles.Resize(10, Particle{ 1.0f, 2.0f, 3.0f });
+		MIST_ASSERT(particles.Size() == 10);
+
+		particles.Resize(20, Particle{ 1.0f, 2.0f, 3.0f });
+		MIST_ASSERT(particles[19].y == 2.0f);
+		MIST_ASSERT(particles[9].y == 0.0f);
+
+		// Assure that non-trivially relocatable types get moved into the new memory
+		Mist::DynamicArray<std::unique_ptr<size_t>> pointers;
+		for (size_t i = 0; i < 100; ++i) {
+			pointers.InsertAsLast(new size_t(i));
+		}
+		for (size_t i = 0; i < 100; ++i) {
+			MIST_ASSERT(*pointers[i] == i);
+		}
+		pointers.Resize(50);
+		pointers.ShrinkToSize();
+		MIST_ASSERT(*pointers[49] == 49);
+		pointers.Clear();
+		MIST_ASSERT(pointers.Size() == 0);
+	}
+
 
 
 	std::cout << "Dynamic Array Tests Passed" << std::endl;
 }
 
+void TestSmallDynamicArray() {
+
+	std::cout << "Testing Small Dynamic Array" << std::endl;
+
+	MIST_ALLOCATION_TAG(SmallArrayTag);
+	using SmallArrayAllocator = Mist::TrackingAllocator<SmallArrayTag>;
+
+	// The first values are stored inline without allocating
+	{
+		Mist::SmallDynamicArray<size_t, 8, SmallArrayAllocator> testArray;
+		MIST_ASSERT(testArray.Size() == 0);
+		MIST_ASSERT(testArray.ReservedSize() == 8);
+		MIST_ASSERT(testArray.IsInline());
+
+		for (size_t i = 0; i < 8; ++i) {
+			testArray.InsertAsLast(i);
+		}
+		MIST_ASSERT(testArray.IsInline());
+		MIST_ASSERT(SmallArrayAllocator::GetStatistics().m_AllocationCount == 0);
+
+		// Spill to the allocator
+		testArray.InsertAsLast(8);
+		MIST_ASSERT(testArray.IsInline() == false);
+		MIST_ASSERT(testArray.ReservedSize() > 8);
+		MIST_ASSERT(SmallArrayAllocator::GetStatistics().m_AllocationCount == 1);
+
+		for (size_t i = 9; i < 100; ++i) {
+			testArray.InsertAsLast(i);
+		}
+		for (size_t i = 0; i < 100; ++i) {
+			MIST_ASSERT(testArray[i] == i);
+		}
+
+		// Shrinking to the inline capacity releases the memory
+		testArray.Resize(4);
+		MIST_ASSERT(testArray.Size() == 4);
+		testArray.ShrinkToSize();
+		MIST_ASSERT(testArray.IsInline());
+		MIST_ASSERT(testArray.ReservedSize() == 8);
+		MIST_ASSERT(SmallArrayAllocator::GetStatistics().m_LiveBytes == 0);
+		for (size_t i = 0; i < 4; ++i) {
+			MIST_ASSERT(testArray[i] == i);
+		}
+
+		testArray.AppendN(10, size_t(42));
+		MIST_ASSERT(testArray.Size() == 14);
+		MIST_ASSERT(*testArray.LastValue() == 42);
+		MIST_ASSERT(*testArray.FirstValue() == 0);
+
+		testArray.Clear();
+		MIST_ASSERT(testArray.Size() == 0);
+		MIST_ASSERT(testArray.IsInline());
+	}
+	MIST_ASSERT(SmallArrayAllocator::GetStatistics().m_LiveBytes == 0);
+
+	// Values that aren't trivially relocatable are moved in and out of the inline storage
+	{
+		Mist::SmallDynamicArray<std::string, 2> testArray;
+		testArray.InsertAsLast("A string long enough to not fit in the small string buffer");
+		testArray.InsertAsLast("b");
+		MIST_ASSERT(testArray.IsInline());
+
+		testArray.InsertAsLast("c");
+		MIST_ASSERT(testArray.IsInline() == false);
+		MIST_ASSERT(testArray[0] == "A string long enough to not fit in the small string buffer");
+		MIST_ASSERT(testArray[2] == "c");
+
+		testArray.RemoveLast();
+		testArray.ShrinkToSize();
+		MIST_ASSERT(testArray.IsInline());
+		MIST_ASSERT(testArray[0] == "A string long enough to not fit in the small string buffer");
+		MIST_ASSERT(testArray[1] == "b");
+
+		std::vector<std::string> range = { "d", "e", "f" };
+		testArray.InsertRange(range.begin(), range.end());
+		MIST_ASSERT(testArray.Size() == 5);
+		MIST_ASSERT(testArray[4] == "f");
+
+		size_t index = 0;
+		for (const std::string& value : testArray) {
+			MIST_ASSERT(value.empty() == false);
+			index++;
+		}
+		MIST_ASSERT(index == 5);
+	}
+
+	// Moving an inline array moves the values, moving a spilled array steals the memory
+	{
+		Mist::SmallDynamicArray<std::string, 4> inlineArray;
+		inlineArray.InsertAsLast("inline");
+
+		Mist::SmallDynamicArray<std::string, 4> movedInline(std::move(inlineArray));
+		MIST_ASSERT(inlineArray.Size() == 0);
+		MIST_ASSERT(movedInline.Size() == 1);
+		MIST_ASSERT(movedInline.IsInline());
+		MIST_ASSERT(movedInline[0] == "inline");
+
+		Mist::SmallDynamicArray<std::string, 4> heapArray(16);
+		MIST_ASSERT(heapArray.IsInline() == false);
+		heapArray.InsertAsLast("heap");
+		const std::string* heapValues = heapArray.AsRawArray();
+
+		movedInline = std::move(heapArray);
+		MIST_ASSERT(heapArray.Size() == 0);
+		MIST_ASSERT(heapArray.IsInline());
+		MIST_ASSERT(movedInline.AsRawArray() == heapValues);
+		MIST_ASSERT(movedInline.Size() == 1);
+		MIST_ASSERT(movedInline[0] == "heap");
+	}
+
+	// The allocator follows an inline array when it's moved, the moved array spills into the same arena
+	{
+		Mist::LinearArena arena;
+		arena.Initialize(16 * 1024);
+
+		using ArenaReference = Mist::AllocatorReference<Mist::LinearArena>;
+		Mist::SmallDynamicArray<int, 2, ArenaReference> inlineArray{ ArenaReference(&arena) };
+		inlineArray.InsertAsLast(1);
+
+		Mist::SmallDynamicArray<int, 2, ArenaReference> movedArray(std::move(inlineArray));
+		MIST_ASSERT(movedArray.GetAllocator().GetTarget() == &arena);
+		movedArray.InsertAsLast(2);
+		movedArray.InsertAsLast(3);
+		MIST_ASSERT(movedArray.IsInline() == false);
+		MIST_ASSERT(arena.UsedSize() > 0);
+		MIST_ASSERT(movedArray[0] == 1 && movedArray[2] == 3);
+
+		Mist::SmallDynamicArray<int, 2, ArenaReference> assignedArray;
+		Mist::SmallDynamicArray<int, 2, ArenaReference> otherArray{ ArenaReference(&arena) };
+		otherArray.InsertAsLast(4);
+		assignedArray = std::move(otherArray);
+		MIST_ASSERT(assignedArray.GetAllocator().GetTarget() == &arena);
+		assignedArray.AppendN(4, 5);
+		MIST_ASSERT(assignedArray.Size() == 5 && assignedArray[4] == 5);
+	}
+
+	std::cout << "Small Dynamic Array Tests Passed" << std::endl;
+}
+
+void TestSoAArray() {
+
+	std::cout << "Testing Structure Of Arrays" << std::endl;
+
+	MIST_ALLOCATION_TAG(SoAArrayTag);
+	using SoAAllocator = Mist::TrackingAllocator<SoAArrayTag>;
+
+	{
+		Mist::BasicSoAArray<SoAAllocator, Mist::DefaultGrowth, float, int32_t, std::string> particles;
+		MIST_ASSERT(particles.Size() == 0);
+		MIST_ASSERT(particles.Column<0>().Size() == 0);
+
+		for (int32_t i = 0; i < 100; ++i) {
+			particles.InsertAsLast(static_cast<float>(i), 100 - i, std::to_string(i));
+		}
+		MIST_ASSERT(particles.Size() == 100);
+		MIST_ASSERT(particles.ReservedSize() >= 100);
+
+		// Every column is aligned and all of them share a single allocation
+		MIST_ASSERT(reinterpret_cast<uintptr_t>(particles.Column<0>().AsRawArray()) % decltype(particles)::COLUMN_ALIGNMENT == 0);
+		MIST_ASSERT(reinterpret_cast<uintptr_t>(particles.Column<1>().AsRawArray()) % decltype(particles)::COLUMN_ALIGNMENT == 0);
+		MIST_ASSERT(reinterpret_cast<uintptr_t>(particles.Column<2>().AsRawArray()) % decltype(particles)::COLUMN_ALIGNMENT == 0);
+		MIST_ASSERT(SoAAllocator::GetStatistics().m_AllocationCount - SoAAllocator::GetStatistics().m_FreeCount == 1);
+
+		for (int32_t i = 0; i < 100; ++i) {
+			MIST_ASSERT(*particles.GetValue<0>(i) == static_cast<float>(i));
+			MIST_ASSERT(*particles.GetValue<1>(i) == 100 - i);
+			MIST_ASSERT(*particles.GetValue<2>(i) == std::to_string(i));
+		}
+
+		// A column can be processed on it's own
+		Mist::SoAColumn<float> positions = particles.Column<0>();
+		for (float& position : positions) {
+			position += 1.0f;
+		}
+		MIST_ASSERT(positions[0] == 1.0f);
+
+		// Swap remove moves the last element in the removed element's place
+		particles.SwapRemove(0);
+		MIST_ASSERT(particles.Size() == 99);
+		MIST_ASSERT(*particles.GetValue<1>(0) == 1);
+		MIST_ASSERT(*particles.GetValue<2>(0) == "99");
+
+		particles.RemoveLast();
+		MIST_ASSERT(particles.Size() == 98);
+		MIST_ASSERT(*particles.GetValue<2>(97) == "97");
+
+		// Sorting by a column moves the elements of every column
+		particles.SortBy<1>();
+		for (size_t i = 1; i < particles.Size(); ++i) {
+			MIST_ASSERT(*particles.GetValue<1>(i - 1) <= *particles.GetValue<1>(i));
+		}
+		for (size_t i = 0; i < particles.Size(); ++i) {
+			int32_t original = 100 - *particles.GetValue<1>(i);
+			MIST_ASSERT(*particles.GetValue<0>(i) == static_cast<float>(original + 1));
+			MIST_ASSERT(*particles.GetValue<2>(i) == std::to_string(original));
+		}
+
+		particles.SortBy<2>(std::greater<std::string>());
+		for (size_t i = 1; i < particles.Size(); ++i) {
+			MIST_ASSERT(*particles.GetValue<2>(i - 1) >= *particles.GetValue<2>(i));
+		}
+
+		particles.Resize(10);
+		MIST_ASSERT(particles.Size() == 10);
+		particles.ShrinkToSize();
+		MIST_ASSERT(particles.ReservedSize() == 10);
+
+		particles.Resize(20, 5.0f, 5, std::string("five"));
+		MIST_ASSERT(particles.Size() == 20);
+		MIST_ASSERT(*particles.GetValue<0>(19) == 5.0f);
+		MIST_ASSERT(*particles.GetValue<2>(19) == "five");
+
+		particles.Resize(25);
+		MIST_ASSERT(*particles.GetValue<1>(24) == 0);
+		MIST_ASSERT(particles.GetValue<2>(24)->empty());
+
+		decltype(particles) movedParticles(std::move(particles));
+		MIST_ASSERT(particles.Size() == 0);
+		MIST_ASSERT(movedParticles.Size() == 25);
+		MIST_ASSERT(*movedParticles.GetValue<2>(19) == "five");
+	}
+	MIST_ASSERT(SoAAllocator::GetStatistics().m_LiveBytes == 0);
+
+	// Sorting the permutation keeps the order of equal keys
+	{
+		const int keys[] = { 3, 1, 2, 1, 3, 0 };
+		size_t permutation[6];
+		Mist::SortPermutation(keys, keys + 6, permutation);
+
+		const size_t expected[] = { 5, 1, 3, 2, 0, 4 };
+		for (size_t i = 0; i < 6; ++i) {
+			MIST_ASSERT(permutation[i] == expected[i]);
+		}
+	}
+
+	std::cout << "Structure Of Arrays Tests Passed" << std::endl;
+}
+
+void TestHashMap() {
+
+	std::cout << "Testing Hash Map" << std::endl;
+
+	MIST_ALLOCATION_TAG(HashMapTag);
+	using HashMapAllocator = Mist::TrackingAllocator<HashMapTag>;
+
+	{
+		Mist::HashMap<uint32_t, uint32_t, Mist::Hash<uint32_t>, std::equal_to<>, HashMapAllocator> map;
+		MIST_ASSERT(map.Size() == 0);
+		MIST_ASSERT(map.Find(10) == nullptr);
+		MIST_ASSERT(map.Remove(10) == false);
+
+		for (uint32_t i = 0; i < 10000; ++i) {
+			uint32_t* value = map.Insert(i, i * 2);
+			MIST_ASSERT(value != nullptr && *value == i * 2);
+		}
+		MIST_ASSERT(map.Size() == 10000);
+		MIST_ASSERT((map.ReservedSize() & (map.ReservedSize() - 1)) == 0);
+
+		// Inserting an existing key returns the existing value
+		MIST_ASSERT(*map.Insert(5, 1000u) == 10);
+		MIST_ASSERT(map.Size() == 10000);
+
+		for (uint32_t i = 0; i < 10000; ++i) {
+			MIST_ASSERT(map.Contains(i));
+			MIST_ASSERT(*map.Find(i) == i * 2);
+		}
+		MIST_ASSERT(map.Find(10000) == nullptr);
+
+		// Remove every odd key, the even keys should still be found through the tombstones
+		for (uint32_t i = 1; i < 10000; i += 2) {
+			MIST_ASSERT(map.Remove(i));
+		}
+		MIST_ASSERT(map.Size() == 5000);
+		for (uint32_t i = 0; i < 10000; ++i) {
+			MIST_ASSERT(map.Contains(i) == (i % 2 == 0));
+		}
+
+		// Removing and inserting in a loop reuses the tombstones instead of growing forever
+		size_t reservedSize = map.ReservedSize();
+		for (uint32_t i = 0; i < 100000; ++i) {
+			map.Insert(100000 + i, i);
+			MIST_ASSERT(map.Remove(100000 + i));
+		}
+		MIST_ASSERT(map.ReservedSize() == reservedSize);
+
+		size_t visitedCount = 0;
+		uint64_t keySum = 0;
+		for (auto& entry : map) {
+			MIST_ASSERT(entry.m_Value == entry.m_Key * 2);
+			keySum += entry.m_Key;
+			visitedCount++;
+		}
+		MIST_ASSERT(visitedCount == 5000);
+		MIST_ASSERT(keySum == 2 * (4999ull * 5000ull / 2));
+
+		// Batch lookups find the same values as the single lookups
+		std::vector<uint32_t> keys;
+		for (uint32_t i = 0; i < 1000; ++i) {
+			keys.push_back(i * 7);
+		}
+		std::vector<uint32_t*> values(keys.size());
+		size_t foundCount = map.FindBatch(keys.data(), keys.size(), values.data());
+		size_t expectedCount = 0;
+		for (size_t i = 0; i < keys.size(); ++i) {
+			MIST_ASSERT(values[i] == map.Find(keys[i]));
+			expectedCount += values[i] != nullptr;
+		}
+		MIST_ASSERT(foundCount == expectedCount);
+
+		map[3] = 42;
+		MIST_ASSERT(*map.Find(3) == 42);
+		MIST_ASSERT(map[20000] == 0);
+
+		decltype(map) movedMap(std::move(map));
+		MIST_ASSERT(map.Size() == 0);
+		MIST_ASSERT(map.Find(4) == nullptr);
+		MIST_ASSERT(*movedMap.Find(4) == 8);
+	}
+	MIST_ASSERT(HashMapAllocator::GetStatistics().m_LiveBytes == 0);
+
+	// Reserving up front allocates once
+	MIST_ALLOCATION_TAG(ReservedHashMapTag);
+	using ReservedHashMapAllocator = Mist::TrackingAllocator<ReservedHashMapTag>;
+	{
+		Mist::HashMap<uint64_t, uint64_t, Mist::Hash<uint64_t>, std::equal_to<>, ReservedHashMapAllocator> map(5000);
+		MIST_ASSERT(map.ReservedSize() * 7 / 8 >= 5000);
+		for (uint64_t i = 0; i < 5000; ++i) {
+			map.Insert(i * 0x9E3779B97F4A7C15ull, i);
+		}
+		MIST_ASSERT(ReservedHashMapAllocator::GetStatistics().m_AllocationCount == 1);
+	}
+
+	// String keys can be searched with string literals
+	{
+		Mist::HashMap<std::string, std::string> map;
+		map.Insert("player", "A string long enough to not fit in the small string buffer");
+		map.Insert(std::string("enemy"), "ogre");
+		for (size_t i = 0; i < 200; ++i) {
+			map.Insert("entity" + std::to_string(i), std::to_string(i));
+		}
+
+		MIST_ASSERT(map.Size() == 202);
+		MIST_ASSERT(*map.Find("player") == "A string long enough to not fit in the small string buffer");
+		MIST_ASSERT(*map.Find(std::string("enemy")) == "ogre");
+		MIST_ASSERT(map.Find("npc") == nullptr);
+		MIST_ASSERT(map.Contains("entity150"));
+
+		const char* names[] = { "entity0", "npc", "entity199" };
+		std::string* values[3];
+		MIST_ASSERT(map.FindBatch(names, 3, values) == 2);
+		MIST_ASSERT(*values[0] == "0" && values[1] == nullptr && *values[2] == "199");
+
+		MIST_ASSERT(map.Remove("enemy"));
+		MIST_ASSERT(map.Contains("enemy") == false);
+		MIST_ASSERT(map.Size() == 201);
+	}
+
+	// The map matches the standard map under random insertions and removals
+	{
+		std::mt19937 generator(1234);
+		std::uniform_int_distribution<uint32_t> keyDistribution(0, 2000);
+		Mist::HashMap<uint32_t, uint32_t> map;
+		std::unordered_map<uint32_t, uint32_t> expected;
+		for (uint32_t i = 0; i < 50000; ++i) {
+			uint32_t key = keyDistribution(generator);
+			if (generator() % 3 == 0) {
+				MIST_ASSERT(map.Remove(key) == (expected.erase(key) == 1));
+			}
+			else {
+				map.Insert(key, i);
+				expected.emplace(key, i);
+			}
+		}
+
+		MIST_ASSERT(map.Size() == expected.size());
+		for (auto& entry : expected) {
+			MIST_ASSERT(*map.Find(entry.first) == entry.second);
+		}
+	}
+
+	std::cout << "Hash Map Tests Passed" << std::endl;
+}
+
+void TestPriorityQueue() {
+	std::cout << "Testing Priority Queue" << std::endl;
+
+	const size_t VALUE_COUNT = 10000;
+	std::vector<uint32_t> values;
+	for (size_t i = 0; i < VALUE_COUNT; i++) {
+		values.push_back((uint32_t)(rand() % 1000));
+	}
+	std::vector<uint32_t> expected = values;
+	std::sort(expected.begin(), expected.end());
+
+	// The values come out in the order of the comparison
+	{
+		Mist::PriorityQueue<uint32_t> queue;
+		for (uint32_t value : values) {
+			queue.Push(value);
+		}
+		MIST_ASSERT(queue.Size() == VALUE_COUNT);
+
+		for (size_t i = 0; i < VALUE_COUNT; i++) {
+			MIST_ASSERT(queue.Top() == expected[i]);
+			uint32_t value;
+			queue.Pop(&value);
+			MIST_ASSERT(value == expected[i]);
+		}
+		MIST_ASSERT(queue.Size() == 0);
+
+		// The heap can be built from a range and pushed into with a range
+		queue.Heapify(values.begin(), values.begin() + VALUE_COUNT / 2);
+		queue.PushRange(values.begin() + VALUE_COUNT / 2, values.begin() + VALUE_COUNT / 2 + 10);
+		queue.PushRange(values.begin() + VALUE_COUNT / 2 + 10, values.end());
+		for (size_t i = 0; i < VALUE_COUNT; i++) {
+			MIST_ASSERT(queue.Top() == expected[i]);
+			queue.Pop();
+		}
+	}
+
+	// Binary heaps and the largest values first
+	{
+		Mist::PriorityQueue<uint32_t, std::greater<uint32_t>, 2> queue;
+		queue.PushRange(values.begin(), values.end());
+		for (size_t i = 0; i < VALUE_COUNT; i++) {
+			MIST_ASSERT(queue.Top() == expected[VALUE_COUNT - i - 1]);
+			queue.Pop();
+		}
+	}
+
+	// Values that can only be moved
+	{
+		struct LowerPointee {
+			bool operator()(const std::unique_ptr<int>& left, const std::unique_ptr<int>& right) const { return *left < *right; }
+		};
+		Mist::PriorityQueue<std::unique_ptr<int>, LowerPointee, 8> queue;
+		for (int i = 100; i > 0; i--) {
+			queue.Push(new int(i));
+		}
+		for (int i = 1; i <= 100; i++) {
+			std::unique_ptr<int> value;
+			queue.Pop(&value);
+			MIST_ASSERT(*value == i);
+		}
+	}
+
+	// The handles find their value after it moved in the heap
+	{
+		Mist::IndexedPriorityQueue<uint32_t> queue;
+		std::vector<Mist::IndexedPriorityQueue<uint32_t>::Handle> handles(VALUE_COUNT);
+		queue.PushRange(values.begin(), values.end(), handles.data());
+		for (size_t i = 0; i < VALUE_COUNT; i++) {
+			MIST_ASSERT(queue.Contains(handles[i]) && *queue.GetValue(handles[i]) == values[i]);
+		}
+
+		// Decrease half of the values and remove a tenth of them
+		std::vector<uint32_t> remaining;
+		for (size_t i = 0; i < VALUE_COUNT; i++) {
+			if (i % 10 == 3) {
+				queue.Remove(handles[i]);
+				MIST_ASSERT(queue.Contains(handles[i]) == false);
+				continue;
+			}
+
+			if (i % 2 == 0) {
+				values[i] /= 2;
+				queue.DecreaseKey(handles[i], values[i]);
+			}
+			remaining.push_back(values[i]);
+			MIST_ASSERT(*queue.GetValue(handles[i]) == values[i]);
+		}
+		std::sort(remaining.begin(), remaining.end());
+
+		MIST_ASSERT(queue.Size() == remaining.size());
+		for (size_t i = 0; i < remaining.size(); i++) {
+			Mist::IndexedPriorityQueue<uint32_t>::Handle top = queue.TopHandle();
+			MIST_ASSERT(queue.Top() == remaining[i] && *queue.GetValue(top) == remaining[i]);
+			queue.Pop();
+			MIST_ASSERT(queue.Contains(top) == false);
+		}
+
+		// The handles are reused once their values left the queue
+		Mist::IndexedPriorityQueue<uint32_t>::Handle handle = queue.Push(5u);
+		MIST_ASSERT(handle < VALUE_COUNT && queue.Contains(handle) && queue.Size() == 1);
+		queue.Clear();
+		MIST_ASSERT(queue.Contains(handle) == false);
+	}
+
+	// Shortest paths on a grid, checked against a queue that never decreases the keys
+	{
+		const int32_t GRID_SIZE = 64;
+		std::vector<uint32_t> weights;
+		for (int32_t i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+			weights.push_back(1 + rand() % 9);
+		}
+
+		struct OpenNode {
+			uint32_t m_Cost;
+			int32_t m_Node;
+		};
+		struct LowerCost {
+			bool operator()(const OpenNode& left, const OpenNode& right) const { return left.m_Cost < right.m_Cost; }
+		};
+
+		auto neighbours = [&](int32_t node, int32_t* outNeighbours) {
+			int32_t count = 0;
+			int32_t x = node % GRID_SIZE, y = node / GRID_SIZE;
+			if (x > 0) outNeighbours[count++] = node - 1;
+			if (x < GRID_SIZE - 1) outNeighbours[count++] = node + 1;
+			if (y > 0) outNeighbours[count++] = node - GRID_SIZE;
+			if (y < GRID_SIZE - 1) outNeighbours[count++] = node + GRID_SIZE;
+			return count;
+		};
+
+		std::vector<uint32_t> costs(weights.size(), UINT32_MAX);
+		std::vector<Mist::IndexedPriorityQueue<OpenNode, LowerCost>::Handle> handles(weights.size());
+		Mist::IndexedPriorityQueue<OpenNode, LowerCost> open;
+		costs[0] = 0;
+		handles[0] = open.Push(OpenNode{ 0, 0 });
+		while (open.Size() > 0) {
+			OpenNode current;
+			open.Pop(&current);
+
+			int32_t adjacent[4];
+			int32_t count = neighbours(current.m_Node, adjacent);
+			for (int32_t i = 0; i < count; i++) {
+				int32_t next = adjacent[i];
+				uint32_t cost = current.m_Cost + weights[next];
+				if (cost >= costs[next]) {
+					continue;
+				}
+
+				if (costs[next] != UINT32_MAX && open.Contains(handles[next])) {
+					open.DecreaseKey(handles[next], OpenNode{ cost, next });
+				}
+				else {
+					handles[next] = open.Push(OpenNode{ cost, next });
+				}
+				costs[next] = cost;
+			}
+		}
+
+		// Lazy deletion with the plain queue gives the same costs
+		std::vector<uint32_t> expectedCosts(weights.size(), UINT32_MAX);
+		Mist::PriorityQueue<OpenNode, LowerCost> lazyOpen;
+		expectedCosts[0] = 0;
+		lazyOpen.Push(OpenNode{ 0, 0 });
+		while (lazyOpen.Size() > 0) {
+			OpenNode current = lazyOpen.Top();
+			lazyOpen.Pop();
+			if (current.m_Cost > expectedCosts[current.m_Node]) {
+				continue;
+			}
+
+			int32_t adjacent[4];
+			int32_t count = neighbours(current.m_Node, adjacent);
+			for (int32_t i = 0; i < count; i++) {
+				uint32_t cost = current.m_Cost + weights[adjacent[i]];
+				if (cost < expectedCosts[adjacent[i]]) {
+					expectedCosts[adjacent[i]] = cost;
+					lazyOpen.Push(OpenNode{ cost, adjacent[i] });
+				}
+			}
+		}
+		MIST_ASSERT(costs == expectedCosts);
+	}
+
+	std::cout << "Priority Queue Tests Passed" << std::endl;
+}
+
+struct ReflectedVertex {
+	float m_Position[3];
+	float m_Normal[3];
+	uint32_t m_Color;
+};
+MIST_REFLECT(ReflectedVertex, MIST_FIELD(m_Position), MIST_FIELD(m_Normal), MIST_FIELD(m_Color))
+
+struct ReflectedMesh {
+	std::string m_Name;
+	Mist::DynamicArray<ReflectedVertex> m_Vertices;
+	Mist::DynamicArray<uint16_t> m_Indices;
+	int32_t m_MaterialId = -1;
+};
+MIST_REFLECT(ReflectedMesh, MIST_FIELD(m_Name), MIST_FIELD(m_Vertices), MIST_FIELD(m_Indices), MIST_FIELD(m_MaterialId))
+
+struct ReflectedSpawn {
+	uint32_t m_Id;
+	double m_Time;
+};
+MIST_REFLECT(ReflectedSpawn, MIST_FIELD(m_Id), MIST_FIELD(m_Time))
+
+// Every query is a constant expression
+static_assert(Mist::IsReflected<ReflectedVertex>::value && Mist::IsReflected<int>::value == false, "");
+static_assert(Mist::FieldCount<ReflectedMesh>() == 4, "");
+static_assert(Mist::FindFieldIndex<ReflectedMesh>("m_Indices") == 2, "");
+static_assert(Mist::FindFieldIndex<ReflectedMesh>("m_Index") == Mist::FIELD_NOT_FOUND, "");
+static_assert(Mist::IsBitwiseSerializable<ReflectedVertex>::value, "");
+static_assert(Mist::IsBitwiseSerializable<ReflectedMesh>::value == false, "");
+static_assert(Mist::IsBitwiseSerializable<int*>::value == false, "");
+
+void TestReflection() {
+	std::cout << "Testing Reflection" << std::endl;
+
+	// Visit the fields
+	{
+		const char* names[3];
+		size_t fieldCount = 0;
+		Mist::ForEachFieldDescriptor<ReflectedVertex>([&](const auto& field) { names[fieldCount++] = field.m_Name; });
+		MIST_ASSERT(fieldCount == 3 && strcmp(names[0], "m_Position") == 0 && strcmp(names[2], "m_Color") == 0);
+		MIST_ASSERT(strcmp(Mist::TypeDescriptor<ReflectedVertex>::Name(), "ReflectedVertex") == 0);
+
+		ReflectedSpawn spawn = { 5, 2.5 };
+		double sum = 0.0;
+		Mist::ForEachField(spawn, [&](const auto&, auto& value) { sum += value; value *= 2; });
+		MIST_ASSERT(sum == 7.5 && spawn.m_Id == 10 && spawn.m_Time == 5.0);
+
+		const ReflectedSpawn& constSpawn = spawn;
+		size_t visitCount = 0;
+		Mist::ForEachField(constSpawn, [&](const auto& field, const auto& value) {
+			visitCount++;
+			MIST_ASSERT(&field.Get(constSpawn) == &value);
+		});
+		MIST_ASSERT(visitCount == 2);
+	}
+
+	// Arrays of bitwise values are a single copy
+	{
+		Mist::DynamicArray<ReflectedVertex> vertices;
+		for (uint32_t i = 0; i < 1000; i++) {
+			vertices.InsertAsLast(ReflectedVertex{ { (float)i, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, i });
+		}
+
+		Mist::MemoryWriter writer;
+		MIST_ASSERT(Mist::SaveBinary(writer, vertices));
+		MIST_ASSERT(writer.Size() == sizeof(uint64_t) + vertices.Size() * sizeof(ReflectedVertex));
+
+		Mist::DynamicArray<ReflectedVertex> loaded;
+		loaded.InsertAsLast(ReflectedVertex());
+		Mist::MemoryReader reader(writer.Data(), writer.Size());
+		MIST_ASSERT(Mist::LoadBinary(reader, &loaded));
+		MIST_ASSERT(reader.RemainingSize() == 0 && loaded.Size() == vertices.Size());
+		MIST_ASSERT(memcmp(loaded.AsRawArray(), vertices.AsRawArray(), vertices.Size() * sizeof(ReflectedVertex)) == 0);
+
+		// Truncated data fails and leaves the array empty
+		Mist::MemoryReader truncatedReader(writer.Data(), writer.Size() - 1);
+		MIST_ASSERT(Mist::LoadBinary(truncatedReader, &loaded) == false);
+		MIST_ASSERT(loaded.Size() == 0);
+	}
+
+	// Types with fields that can't be copied are serialized field by field, the bitwise fields are still copied in bulk
+	{
+		Mist::DynamicArray<ReflectedMesh> meshes;
+		for (int32_t i = 0; i < 10; i++) {
+			ReflectedMesh mesh;
+			mesh.m_Name = "Mesh" + std::to_string(i);
+			for (uint32_t v = 0; v < (uint32_t)i * 3; v++) {
+				mesh.m_Vertices.InsertAsLast(ReflectedVertex{ { (float)v, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, v });
+				mesh.m_Indices.InsertAsLast((uint16_t)v);
+			}
+			mesh.m_MaterialId = i;
+			meshes.InsertAsLast(std::move(mesh));
+		}
+
+		FILE* file = tmpfile();
+		MIST_ASSERT(file != nullptr);
+		Mist::FileWriter writer(file);
+		MIST_ASSERT(Mist::SaveBinary(writer, meshes));
+		rewind(file);
+
+		Mist::DynamicArray<ReflectedMesh> loaded;
+		Mist::FileReader reader(file);
+		MIST_ASSERT(Mist::LoadBinary(reader, &loaded));
+		MIST_ASSERT(loaded.Size() == meshes.Size());
+		for (size_t i = 0; i < meshes.Size(); i++) {
+			MIST_ASSERT(loaded[i].m_Name == meshes[i].m_Name && loaded[i].m_MaterialId == meshes[i].m_MaterialId);
+			MIST_ASSERT(loaded[i].m_Vertices.Size() == meshes[i].m_Vertices.Size() && loaded[i].m_Indices.Size() == meshes[i].m_Indices.Size());
+			for (size_t v = 0; v < meshes[i].m_Indices.Size(); v++) {
+				MIST_ASSERT(loaded[i].m_Indices[v] == meshes[i].m_Indices[v] && loaded[i].m_Vertices[v].m_Color == meshes[i].m_Vertices[v].m_Color);
+			}
+		}
+		fclose(file);
+	}
+
+	// Lists keep the order of their values
+	{
+		Mist::SingleList<std::string> names;
+		names.InsertAsLast(std::string("First"));
+		names.InsertAsLast(std::string(""));
+		names.InsertAsLast(std::string("Last"));
+
+		Mist::MemoryWriter writer;
+		MIST_ASSERT(Mist::SaveBinary(writer, names));
+
+		Mist::SingleList<std::string> loaded;
+		loaded.InsertAsLast(std::string("Removed"));
+		Mist::MemoryReader reader(writer.Data(), writer.Size());
+		MIST_ASSERT(Mist::LoadBinary(reader, &loaded));
+		MIST_ASSERT(loaded.Size() == 3 && *loaded.FirstValue() == "First" && loaded.RetrieveValueAt(1)->empty() && *loaded.LastValue() == "Last");
+
+		Mist::SingleList<ReflectedSpawn> spawns;
+		Mist::MemoryWriter emptyWriter;
+		MIST_ASSERT(Mist::SaveBinary(emptyWriter, spawns));
+		Mist::MemoryReader emptyReader(emptyWriter.Data(), emptyWriter.Size());
+		MIST_ASSERT(Mist::LoadBinary(emptyReader, &spawns) && spawns.Size() == 0);
+	}
+
+	// Ring buffers save their readable values without consuming them, even when they wrap around the storage
+	{
+		Mist::RingBuffer<ReflectedSpawn, 16> buffer;
+		for (uint32_t i = 0; i < 12; i++) {
+			MIST_ASSERT(buffer.TryWrite(ReflectedSpawn{ i, (double)i }));
+		}
+		ReflectedSpawn spawn;
+		for (uint32_t i = 0; i < 10; i++) {
+			MIST_ASSERT(buffer.TryRead(&spawn));
+		}
+		for (uint32_t i = 12; i < 20; i++) {
+			MIST_ASSERT(buffer.TryWrite(ReflectedSpawn{ i, (double)i }));
+		}
+		MIST_ASSERT(buffer.ReadableCount() == 10);
+
+		Mist::MemoryWriter writer;
+		MIST_ASSERT(Mist::SaveBinary(writer, buffer));
+		MIST_ASSERT(buffer.ReadableCount() == 10);
+
+		// Load into a buffer with one value left, the values are written after it
+		Mist::RingBuffer<ReflectedSpawn, 16> loaded;
+		for (uint32_t i = 0; i < 14; i++) {
+			MIST_ASSERT(loaded.TryWrite(ReflectedSpawn{ 100, 0.0 }));
+		}
+		for (uint32_t i = 0; i < 13; i++) {
+			MIST_ASSERT(loaded.TryRead(&spawn));
+		}
+		Mist::MemoryReader reader(writer.Data(), writer.Size());
+		MIST_ASSERT(Mist::LoadBinary(reader, &loaded));
+		MIST_ASSERT(loaded.TryRead(&spawn) && spawn.m_Id == 100);
+		for (uint32_t i = 10; i < 20; i++) {
+			MIST_ASSERT(loaded.TryRead(&spawn) && spawn.m_Id == i && spawn.m_Time == (double)i);
+		}
+		MIST_ASSERT(loaded.CanRead() == false);
+
+		// A buffer without room for the values refuses them
+		Mist::RingBuffer<ReflectedSpawn, 8> small;
+		Mist::MemoryReader smallReader(writer.Data(), writer.Size());
+		MIST_ASSERT(Mist::LoadBinary(smallReader, &small) == false && small.CanRead() == false);
+	}
+
+	std::cout << "Reflection Tests Passed" << std::endl;
+}
+
+void TestBitSet() {
+
+	std::cout << "Testing Bit Set" << std::endl;
+
+	Mist::BitSet<256> bits;
+	MIST_ASSERT(bits.IsEmpty());
+	MIST_ASSERT(bits.CountBitsSet() == 0);
+	MIST_ASSERT(Mist::BitSet<256>::WordCount() == 4);
+	MIST_ASSERT(Mist::BitSet<65>::WordCount() == 2);
+
+	bits.SetBit(0);
+	bits.SetBit(63);
+	bits.SetBit(64);
+	bits.SetBit(255);
+	MIST_ASSERT(bits.IsBitSet(0) && bits.IsBitSet(63) && bits.IsBitSet(64) && bits.IsBitSet(255));
+	MIST_ASSERT(bits.IsBitSet(1) == false);
+	MIST_ASSERT(bits.CountBitsSet() == 4);
+
+	size_t indices[256];
+	size_t indexCount;
+	bits.GetIndividualBitIndices(indices, &indexCount);
+	MIST_ASSERT(indexCount == 4 && indices[0] == 0 && indices[1] == 63 && indices[2] == 64 && indices[3] == 255);
+
+	bits.ToggleBit(63);
+	bits.UnsetBit(255);
+	MIST_ASSERT(bits.IsBitSet(63) == false && bits.IsBitSet(255) == false);
+	MIST_ASSERT(bits.CountBitsSet() == 2);
+
+	// Ranges that cross the word boundaries
+	bits.Clear();
+	bits.SetBitRange(60, 200);
+	MIST_ASSERT(bits.CountBitsSet() == 140);
+	MIST_ASSERT(bits.IsBitSet(59) == false && bits.IsBitSet(60) && bits.IsBitSet(199) && bits.IsBitSet(200) == false);
+
+	Mist::BitSet<256> flags;
+	flags.SetBitRange(100, 120);
+	MIST_ASSERT(bits.IsFlagSet(flags));
+	flags.SetBit(10);
+	MIST_ASSERT(bits.IsFlagSet(flags) == false);
+
+	MIST_ASSERT((bits & flags).CountBitsSet() == 20);
+	MIST_ASSERT((bits | flags).CountBitsSet() == 141);
+	MIST_ASSERT((bits ^ flags).CountBitsSet() == 121);
+	Mist::BitSet<256> remaining = bits;
+	remaining.AndNot(flags);
+	MIST_ASSERT(remaining.CountBitsSet() == 120);
+	MIST_ASSERT(remaining != bits);
+	remaining |= flags;
+	remaining.UnsetBit(10);
+	MIST_ASSERT(remaining == bits);
+
+	// Match against the scalar reference for random sets
+	for (size_t iteration = 0; iteration < 100; iteration++) {
+		Mist::BitSet<200> randomBits;
+		size_t expectedCount = 0;
+		for (size_t i = 0; i < 200; i++) {
+			if (rand() % 3 == 0) {
+				randomBits.SetBit(i);
+				++expectedCount;
+			}
+		}
+		MIST_ASSERT(randomBits.CountBitsSet() == expectedCount);
+	}
+
+	// Dynamic bit set
+	Mist::DynamicBitSet<> dynamicBits(130);
+	MIST_ASSERT(dynamicBits.Size() == 130 && dynamicBits.WordCount() == 3);
+	MIST_ASSERT(dynamicBits.IsEmpty());
+	dynamicBits.SetBitRange(0, 130);
+	MIST_ASSERT(dynamicBits.CountBitsSet() == 130);
+
+	// Shrinking turns off the removed bits, they don't come back when growing again
+	dynamicBits.Resize(70);
+	MIST_ASSERT(dynamicBits.CountBitsSet() == 70);
+	dynamicBits.Resize(1000);
+	MIST_ASSERT(dynamicBits.CountBitsSet() == 70);
+	MIST_ASSERT(dynamicBits.IsBitSet(69) && dynamicBits.IsBitSet(70) == false);
+
+	Mist::DynamicBitSet<> dynamicFlags(1000);
+	dynamicFlags.SetBit(5);
+	dynamicFlags.SetBit(999);
+	MIST_ASSERT(dynamicBits.IsFlagSet(dynamicFlags) == false);
+	dynamicBits |= dynamicFlags;
+	MIST_ASSERT(dynamicBits.IsFlagSet(dynamicFlags));
+	dynamicBits.AndNot(dynamicFlags);
+	MIST_ASSERT(dynamicBits.CountBitsSet() == 69);
+	dynamicBits ^= dynamicFlags;
+	dynamicBits &= dynamicFlags;
+	MIST_ASSERT(dynamicBits == dynamicFlags);
+	dynamicBits.GetIndividualBitIndices(indices, &indexCount);
+	MIST_ASSERT(indexCount == 2 && indices[0] == 5 && indices[1] == 999);
+	size_t visitedSum = 0;
+	dynamicBits.ForEachSetBit([&](size_t index) { visitedSum += index; });
+	MIST_ASSERT(visitedSum == 5 + 999);
+	dynamicBits.Resize(0);
+	MIST_ASSERT(dynamicBits.IsEmpty() && dynamicBits.Size() == 0);
+
+	// Archetype matching across a large amount of entities
+	const size_t ENTITY_COUNT = 50000;
+	std::vector<Mist::BitSet<256>> archetypes(ENTITY_COUNT);
+	for (Mist::BitSet<256>& archetype : archetypes) {
+		for (size_t i = 0; i < 16; i++) {
+			archetype.SetBit(rand() % 32);
+		}
+	}
+	Mist::BitSet<256> query;
+	query.SetBit(3);
+	query.SetBit(7);
+
+	std::vector<size_t> matches(ENTITY_COUNT);
+	BeginTimer();
+	size_t matchCount = Mist::FindBitSetsWithFlags(archetypes.data(), archetypes.size(), query, matches.data());
+	std::cout << EndTimer() << "ms" << std::endl;
+
+	size_t expectedMatches = 0;
+	for (const Mist::BitSet<256>& archetype : archetypes) {
+		expectedMatches += archetype.IsBitSet(3) && archetype.IsBitSet(7) ? 1 : 0;
+	}
+	MIST_ASSERT(matchCount == expectedMatches);
+	MIST_ASSERT(matchCount == 0 || archetypes[matches[0]].IsFlagSet(query));
+
+	std::cout << "Bit Set Tests Passed" << std::endl;
+}
+
 int main() {
 
 	TestRingBuffer();
+	TestSpscRingBuffer();
+	TestMpmcRingBuffer();
+	TestWorkStealingDeque();
+	TestJobScheduler();
 	TestSorting();
+	TestExternalSort();
 	TestBitManipulations();
-	//TestReflection();
-	//TestHash();
+	TestBitSet();
+	TestReflection();
+	TestHash();
 	TestSingleList();
+	TestUnrolledList();
 	TestAllocator();
+	TestLinearAllocator();
+	TestPoolAllocator();
+	TestTrackingAllocator();
+	TestAlignedAllocation();
 	TestDynamicArray();
+	TestSmallDynamicArray();
+	TestSoAArray();
+	TestHashMap();
+	TestPriorityQueue();
 
 	Pause();
 	return 0;